@@ -4951,7 +4951,9 @@ _EXTERN_C_ int QMPI_Init (int *argc, char ***argv, int level,  vector* v){
   return PMPI_Init (argc, argv);
 }
 
-_EXTERN_C_ int MPI_Init (int *argc, char ***argv) { 
+/* Loads the tools listed in TOOLS and links their interceptions into the
+   tables of the levels above them, for MPI_Init and MPI_Init_thread. */
+static void qmpi_load_tools (void) {
   vector_init (&v);
 
   struct dynamic_lib dl0={"./qmpi",NULL,NULL,NULL,0};
@@ -5043,6 +5045,10 @@ _EXTERN_C_ int MPI_Init (int *argc, char ***argv) {
       }
     }
   }
+}
+
+_EXTERN_C_ int MPI_Init (int *argc, char ***argv) { 
+  qmpi_load_tools ();
   void* f_dl=NULL;
   QMPI_TABLE_QUERY (_MPI_Init,&f_dl, (*VECTOR_GET (&v, 0)).table );
   //int ret=EXEC_FUNC (f_dl,0,_MPI_Init,&v,argc,argv);
@@ -7866,6 +7872,7 @@ _EXTERN_C_ int QMPI_Init_thread (int *argc, char ***argv, int required, int *pro
   return PMPI_Init_thread (argc, argv, required, provided);
 }
 _EXTERN_C_ int MPI_Init_thread (int *argc, char ***argv, int required, int *provided) { 
+  qmpi_load_tools ();
   void* f_dl=NULL;
   QMPI_TABLE_QUERY (_MPI_Init_thread,&f_dl, (*VECTOR_GET (&v, 0)).table );
   //int ret=EXEC_FUNC (f_dl,0,_MPI_Init_thread,&v,argc, argv, required, provided);
@@ -8347,8 +8354,10 @@ _EXTERN_C_ int MPI_Pcontrol (const int level, ...) {
   for  (;i<vector_total (&v)-1;)
   {	
 	//printf ( " I n   P c o n t r o l   i = %d   , v e c t o r  s z : %d\n", i, vector_total (&v));
-	 (    (pcontrol_func)     ( (*VECTOR_GET (&v,i)).table[_MPI_Pcontrol].func_ptr) )  (level, i, &v);
-	i= (  (*VECTOR_GET (&v,i)).table[_MPI_Pcontrol].level );
+	/* the tool is called with its own level, as by the other wrappers */
+	int next= (  (*VECTOR_GET (&v,i)).table[_MPI_Pcontrol].level );
+	 (    (pcontrol_func)     ( (*VECTOR_GET (&v,i)).table[_MPI_Pcontrol].func_ptr) )  (level, next, &v);
+	i= next;
   }
   
   return ret;
@@ -28,164 +28,446 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "collectives.h"
+#include "comm_matrix.h"
 #include "counter.h"
+#include "datatype_layout.h"
 #include "interceptions.h"
+#include "nonblocking.h"
+#include "point_to_point.h"
+#include "record_gather.h"
+#include "rma_io.h"
 
 void send_data_record(int count, MPI_Datatype datatype) {
-    switch (datatype) {
-    case MPI_UINT8_T:
-    case MPI_INT8_T:
-    case MPI_CHAR:
-    case MPI_UNSIGNED_CHAR:
-    case MPI_SIGNED_CHAR:
-    case MPI_BYTE:
-        I8_SEND_COUNT++;
-        break;
-
-    case MPI_UINT16_T:
-    case MPI_INT16_T:
-        I16_SEND_COUNT++;
-        break;
-
-    case MPI_UINT32_T:
-    case MPI_INT32_T:
-        I32_SEND_COUNT++;
-        break;
-
-    case MPI_UINT64_T:
-    case MPI_INT64_T:
-        I64_SEND_COUNT++;
-        break;
-
-    case MPI_INT:
-    case MPI_UNSIGNED:
-        INT_SEND_COUNT++;
-        break;
-
-    case MPI_FLOAT:
-        FLOAT_SEND_COUNT++;
-        break;
-
-    case MPI_DOUBLE:
-        DOUBLE_SEND_COUNT++;
-        break;
-    }
+    type_layout_account(datatype, count, SEND_COUNTERS);
 }
 void recv_data_record(int count, MPI_Datatype datatype) {
-    switch (datatype) {
-    case MPI_UINT8_T:
-    case MPI_INT8_T:
-    case MPI_CHAR:
-    case MPI_UNSIGNED_CHAR:
-    case MPI_SIGNED_CHAR:
-    case MPI_BYTE:
-        I8_RECV_COUNT++;
-        break;
-
-    case MPI_UINT16_T:
-    case MPI_INT16_T:
-        I16_RECV_COUNT++;
-        break;
-
-    case MPI_UINT32_T:
-    case MPI_INT32_T:
-        I32_RECV_COUNT++;
-        break;
-
-    case MPI_UINT64_T:
-    case MPI_INT64_T:
-        I64_RECV_COUNT++;
-        break;
-
-    case MPI_INT:
-    case MPI_UNSIGNED:
-        INT_RECV_COUNT++;
-        break;
-
-    case MPI_FLOAT:
-        FLOAT_RECV_COUNT++;
-        break;
-
-    case MPI_DOUBLE:
-        DOUBLE_RECV_COUNT++;
-        break;
-    }
+    type_layout_account(datatype, count, RECV_COUNTERS);
 }
 void reduce_data_record(int count, MPI_Datatype datatype) {
-    switch (datatype) {
-    case MPI_UINT8_T:
-    case MPI_INT8_T:
-    case MPI_CHAR:
-    case MPI_UNSIGNED_CHAR:
-    case MPI_SIGNED_CHAR:
-    case MPI_BYTE:
-        I8_RDC_COUNT++;
-        break;
-
-    case MPI_UINT16_T:
-    case MPI_INT16_T:
-        I16_RDC_COUNT++;
-        break;
-
-    case MPI_UINT32_T:
-    case MPI_INT32_T:
-        I32_RDC_COUNT++;
-        break;
-
-    case MPI_UINT64_T:
-    case MPI_INT64_T:
-        I64_RDC_COUNT++;
-        break;
-
-    case MPI_INT:
-    case MPI_UNSIGNED:
-        INT_RDC_COUNT++;
-        break;
-
-    case MPI_FLOAT:
-        FLOAT_RDC_COUNT++;
-        break;
-
-    case MPI_DOUBLE:
-        DOUBLE_RDC_COUNT++;
-        break;
+    type_layout_account(datatype, count, RDC_COUNTERS);
+}
+
+void matrix_data_record(int count, MPI_Datatype datatype, int dest,
+                        MPI_Comm comm) {
+    if (dest == MPI_PROC_NULL) {
+        return;
+    }
+    int world_dest = world_rank_of(comm, dest);
+    if (world_dest == MPI_UNDEFINED) {
+        return;
+    }
+    int type_size;
+    if (PMPI_Type_size(datatype, &type_size) == MPI_SUCCESS) {
+        matrix_row_add(&comm_row, world_dest, (uint64_t)count * type_size);
+    }
+}
+
+void nonblocking_post_record(int kind, int count, MPI_Datatype datatype,
+                             int peer, MPI_Comm comm, MPI_Request request) {
+    if (peer == MPI_PROC_NULL) {
+        return;
+    }
+    int type_size;
+    if (PMPI_Type_size(datatype, &type_size) == MPI_SUCCESS) {
+        nb_post(kind, peer_locality(comm, peer), request,
+                (uint64_t)count * type_size);
+    }
+}
+
+/* Accounts a blocking transfer to `dest` and/or from `source`; either may be
+ * MPI_PROC_NULL. An exchange with peers of different classes is mixed. */
+void p2p_locality_record(MPI_Comm comm, int dest, int source, uint64_t bytes,
+                         double seconds) {
+    if (dest == MPI_PROC_NULL && source == MPI_PROC_NULL) {
+        return;
+    }
+    int loc;
+    if (dest == MPI_PROC_NULL) {
+        loc = peer_locality(comm, source);
+    } else {
+        loc = peer_locality(comm, dest);
+        if (source != MPI_PROC_NULL && peer_locality(comm, source) != loc) {
+            loc = LOC_MIXED;
+        }
+    }
+    locality_record(TRAFFIC_P2P, loc, bytes, seconds);
+}
+
+void locality_stats_reduce(loc_stats global[TRAFFIC_KINDS]) {
+    for (int t = 0; t < TRAFFIC_KINDS; t++) {
+        loc_stats *local = &traffic_locality[t];
+        PMPI_Reduce(local->calls, global[t].calls, LOC_KINDS, MPI_UINT64_T,
+                    MPI_SUM, 0, MPI_COMM_WORLD);
+        PMPI_Reduce(local->bytes, global[t].bytes, LOC_KINDS, MPI_UINT64_T,
+                    MPI_SUM, 0, MPI_COMM_WORLD);
+        PMPI_Reduce(local->time, global[t].time, LOC_KINDS, MPI_DOUBLE,
+                    MPI_SUM, 0, MPI_COMM_WORLD);
+    }
+}
+
+/* Bytes count both directions: a message is accounted by its sender and by
+ * its receiver, so local and network shares compare directly. */
+void locality_stats_print(const loc_stats global[TRAFFIC_KINDS]) {
+    printf("Traffic by locality:\n");
+    printf("%-30s %10s %14s %12s %16s\n", "Class", "Calls", "Bytes [MB]",
+           "Time [s]", "Bandwidth [MB/s]");
+    for (int t = 0; t < TRAFFIC_KINDS; t++) {
+        for (int loc = 0; loc < LOC_KINDS; loc++) {
+            if (global[t].calls[loc] == 0) {
+                continue;
+            }
+            char label[64];
+            snprintf(label, sizeof(label), "%s %s", TRAFFIC_NAMES[t],
+                     LOC_NAMES[loc]);
+            double bandwidth =
+                global[t].time[loc] > 0
+                    ? global[t].bytes[loc] / global[t].time[loc] / 1e6
+                    : 0.0;
+            printf("%-30s %10llu %14.3f %12.6f %16.2f\n", label,
+                   (unsigned long long)global[t].calls[loc],
+                   global[t].bytes[loc] / 1e6, global[t].time[loc], bandwidth);
+        }
+    }
+}
+
+void nonblocking_stats_reduce(nb_stats global[NB_KINDS]) {
+    for (int kind = 0; kind < NB_KINDS; kind++) {
+        nb_stats *local = &nb_bucket_stats[kind];
+        PMPI_Reduce(local->count, global[kind].count, SIZE_BUCKETS,
+                    MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        PMPI_Reduce(local->bytes, global[kind].bytes, SIZE_BUCKETS,
+                    MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        PMPI_Reduce(local->time, global[kind].time, SIZE_BUCKETS, MPI_DOUBLE,
+                    MPI_SUM, 0, MPI_COMM_WORLD);
+        PMPI_Reduce(local->blocked, global[kind].blocked, SIZE_BUCKETS,
+                    MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    }
+}
+
+/* Achieved bandwidth is bytes over the time from post to completion.
+ * Overlap is the share of that time the application did not spend blocked
+ * in a Wait or Test call. */
+void nonblocking_stats_print(const nb_stats global[NB_KINDS]) {
+    static const char *kind_names[NB_KINDS] = {"sends", "receives"};
+    for (int kind = 0; kind < NB_KINDS; kind++) {
+        const nb_stats *s = &global[kind];
+        int header = 0;
+        for (unsigned b = 0; b < SIZE_BUCKETS; b++) {
+            if (s->count[b] == 0) {
+                continue;
+            }
+            if (!header) {
+                printf("Nonblocking %s, post to completion:\n", kind_names[kind]);
+                printf("%-22s %10s %14s %16s %8s\n", "Size", "Count",
+                       "Avg time [us]", "Bandwidth [MB/s]", "Overlap");
+                header = 1;
+            }
+            char label[32];
+            size_bucket_label(b, label, sizeof(label));
+            double bandwidth =
+                s->time[b] > 0 ? s->bytes[b] / s->time[b] / 1e6 : 0.0;
+            double overlap =
+                s->time[b] > 0 ? 100.0 * (1.0 - s->blocked[b] / s->time[b])
+                               : 0.0;
+            printf("%-22s %10llu %14.2f %16.2f %7.1f%%\n", label,
+                   (unsigned long long)s->count[b],
+                   1e6 * s->time[b] / s->count[b], bandwidth, overlap);
+        }
+    }
+}
+
+void collective_stats_reduce(coll_stats *global) {
+    PMPI_Reduce(coll_op_stats.calls, global->calls, COLL_KINDS, MPI_UINT64_T,
+                MPI_SUM, 0, MPI_COMM_WORLD);
+    PMPI_Reduce(coll_op_stats.sent, global->sent, COLL_KINDS, MPI_UINT64_T,
+                MPI_SUM, 0, MPI_COMM_WORLD);
+    PMPI_Reduce(coll_op_stats.received, global->received, COLL_KINDS,
+                MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+    PMPI_Reduce(coll_op_stats.time, global->time, COLL_KINDS, MPI_DOUBLE,
+                MPI_SUM, 0, MPI_COMM_WORLD);
+    PMPI_Reduce(coll_op_stats.bus_bytes, global->bus_bytes, COLL_KINDS,
+                MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+}
+
+/* Calls and times are summed over ranks, so the average time is per rank
+ * and call, and the bus bandwidth the mean seen by a single rank. */
+void collective_stats_print(const coll_stats *global) {
+    int header = 0;
+    for (int op = 0; op < COLL_KINDS; op++) {
+        if (global->calls[op] == 0) {
+            continue;
+        }
+        if (!header) {
+            printf("Collectives:\n");
+            printf("%-22s %10s %14s %14s %14s %14s\n", "Operation", "Calls",
+                   "Sent [MB]", "Received [MB]", "Avg time [us]",
+                   "Bus bw [MB/s]");
+            header = 1;
+        }
+        double bus_bandwidth =
+            global->time[op] > 0
+                ? global->bus_bytes[op] / global->time[op] / 1e6
+                : 0.0;
+        printf("%-22s %10llu %14.3f %14.3f %14.2f %14.2f\n", COLL_INFO[op].name,
+               (unsigned long long)global->calls[op], global->sent[op] / 1e6,
+               global->received[op] / 1e6,
+               1e6 * global->time[op] / global->calls[op], bus_bandwidth);
+    }
+}
+
+void size_hist_reduce(uint64_t p2p_global[P2P_KINDS][SIZE_BUCKETS],
+                      uint64_t coll_global[COLL_KINDS][SIZE_BUCKETS]) {
+    PMPI_Reduce(p2p_size_hist, p2p_global, P2P_KINDS * SIZE_BUCKETS,
+                MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+    PMPI_Reduce(coll_op_stats.sizes, coll_global, COLL_KINDS * SIZE_BUCKETS,
+                MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+}
+
+void size_hist_print_all(uint64_t p2p_global[P2P_KINDS][SIZE_BUCKETS],
+                         uint64_t coll_global[COLL_KINDS][SIZE_BUCKETS]) {
+    printf("Message size distributions:\n");
+    for (int fn = 0; fn < P2P_KINDS; fn++) {
+        size_hist_print(P2P_NAMES[fn], p2p_global[fn]);
+    }
+    for (int op = 0; op < COLL_KINDS; op++) {
+        size_hist_print(COLL_INFO[op].name, coll_global[op]);
+    }
+}
+
+static void res_stats_merge(void *into, const void *from) {
+    res_stats *m = into;
+    const res_stats *r = from;
+    m->ranks += r->ranks;
+    m->ops += r->ops;
+    m->bytes_out += r->bytes_out;
+    m->bytes_in += r->bytes_in;
+    m->intervals += r->intervals;
+    m->call_time += r->call_time;
+    m->interval_time += r->interval_time;
+    if (r->max_interval_bytes > m->max_interval_bytes) {
+        m->max_interval_bytes = r->max_interval_bytes;
+    }
+}
+
+/* Gathers the window and file records of all ranks on rank 0. Records with
+ * the same kind, sequence number and name (a window or file opened
+ * collectively) are merged there. Returns the number of merged records. */
+size_t rma_io_gather(res_stats **merged) {
+    res_close_all();
+    return records_gather(closed_res.records, closed_res.len,
+                          sizeof(res_stats), MPI_COMM_WORLD, res_stats_cmp,
+                          res_stats_merge, (void **)merged);
+}
+
+/* Times are summed over ranks, so per-interval averages are per rank. */
+void rma_io_print(const res_stats *merged, size_t n) {
+    static const char *titles[RES_KINDS] = {"RMA windows", "MPI-IO files"};
+    static const char *intervals[RES_KINDS] = {"Epochs", "Opens"};
+    static const char *directions[RES_KINDS][2] = {{"Put [MB]", "Get [MB]"},
+                                                   {"Write [MB]", "Read [MB]"}};
+    for (int kind = 0; kind < RES_KINDS; kind++) {
+        int header = 0;
+        for (size_t k = 0; k < n; k++) {
+            const res_stats *r = &merged[k];
+            if (r->kind != kind) {
+                continue;
+            }
+            if (!header) {
+                printf("%s:\n", titles[kind]);
+                printf("%-24s %6s %10s %8s %12s %12s %13s %17s %17s\n",
+                       "Name", "Ranks", "Ops", intervals[kind],
+                       directions[kind][0], directions[kind][1],
+                       "Call time [s]", "Avg interval [ms]",
+                       "Max interval [MB]");
+                header = 1;
+            }
+            double avg_interval =
+                r->intervals > 0 ? 1e3 * r->interval_time / r->intervals : 0.0;
+            printf("%-24.24s %6d %10llu %8llu %12.3f %12.3f %13.6f %17.3f "
+                   "%17.3f\n",
+                   r->name, r->ranks, (unsigned long long)r->ops,
+                   (unsigned long long)r->intervals, r->bytes_out / 1e6,
+                   r->bytes_in / 1e6, r->call_time, avg_interval,
+                   r->max_interval_bytes / 1e6);
+        }
     }
 }
 
+/* Writes the matrix as CSR in parallel with MPI-IO; row r is written by
+ * rank r. Layout (native byte order), see CSR_MAGIC:
+ *   char     magic[8]
+ *   uint64_t nrows, nnz
+ *   uint64_t row_ptr[nrows + 1]
+ *   uint64_t bytes[nnz]
+ *   uint64_t messages[nnz]
+ *   int32_t  col_idx[nnz]
+ */
+int write_csr_file(const char *path, uint64_t row_start, uint64_t nnz,
+                   uint64_t nnz_total, uint64_t *bytes, uint64_t *messages,
+                   int32_t *cols) {
+    int rank, size;
+    PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    PMPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    MPI_File fh;
+    int ret = PMPI_File_open(MPI_COMM_WORLD, path,
+                             MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                             &fh);
+    if (ret != MPI_SUCCESS) {
+        return ret;
+    }
+    PMPI_File_set_size(fh, 0);
+
+    char header[8 + 2 * sizeof(uint64_t)];
+    uint64_t dims[2] = {(uint64_t)size, nnz_total};
+    memcpy(header, CSR_MAGIC, 8);
+    memcpy(header + 8, dims, sizeof(dims));
+
+    MPI_Offset row_ptr_off = sizeof(header);
+    MPI_Offset bytes_off = row_ptr_off + (size + 1) * sizeof(uint64_t);
+    MPI_Offset messages_off = bytes_off + nnz_total * sizeof(uint64_t);
+    MPI_Offset cols_off = messages_off + nnz_total * sizeof(uint64_t);
+
+    // the last rank also writes the end of the final row
+    uint64_t row_ptr[2] = {row_start, row_start + nnz};
+
+    ret = PMPI_File_write_at_all(fh, 0, header,
+                                 rank == 0 ? (int)sizeof(header) : 0, MPI_BYTE,
+                                 MPI_STATUS_IGNORE);
+    if (ret == MPI_SUCCESS) {
+        ret = PMPI_File_write_at_all(
+            fh, row_ptr_off + rank * sizeof(uint64_t), row_ptr,
+            rank == size - 1 ? 2 : 1, MPI_UINT64_T, MPI_STATUS_IGNORE);
+    }
+    if (ret == MPI_SUCCESS) {
+        ret = PMPI_File_write_at_all(
+            fh, bytes_off + row_start * sizeof(uint64_t), bytes, (int)nnz,
+            MPI_UINT64_T, MPI_STATUS_IGNORE);
+    }
+    if (ret == MPI_SUCCESS) {
+        ret = PMPI_File_write_at_all(
+            fh, messages_off + row_start * sizeof(uint64_t), messages,
+            (int)nnz, MPI_UINT64_T, MPI_STATUS_IGNORE);
+    }
+    if (ret == MPI_SUCCESS) {
+        ret = PMPI_File_write_at_all(
+            fh, cols_off + row_start * sizeof(int32_t), cols, (int)nnz,
+            MPI_INT32_T, MPI_STATUS_IGNORE);
+    }
+
+    PMPI_File_close(&fh);
+    return ret;
+}
+
+int write_comm_matrix(const char *path, uint64_t *nnz_total) {
+    int rank;
+    PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    uint64_t nnz = comm_row.entries == NULL ? 0 : matrix_row_compact(&comm_row);
+    uint64_t row_start = 0;
+    PMPI_Exscan(&nnz, &row_start, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+    if (rank == 0) {
+        row_start = 0; // MPI_Exscan leaves rank 0 undefined
+    }
+    PMPI_Allreduce(&nnz, nnz_total, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+
+    uint64_t *bytes = malloc((nnz + 1) * sizeof(uint64_t));
+    uint64_t *messages = malloc((nnz + 1) * sizeof(uint64_t));
+    int32_t *cols = malloc((nnz + 1) * sizeof(int32_t));
+
+    // all ranks have to agree before entering the collective file calls
+    int alloc_ok = bytes != NULL && messages != NULL && cols != NULL;
+    int all_ok;
+    PMPI_Allreduce(&alloc_ok, &all_ok, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+
+    int ret = MPI_ERR_NO_MEM;
+    if (all_ok) {
+        for (uint64_t k = 0; k < nnz; k++) {
+            bytes[k] = comm_row.entries[k].bytes;
+            messages[k] = comm_row.entries[k].messages;
+            cols[k] = comm_row.entries[k].dest;
+        }
+        ret = write_csr_file(path, row_start, nnz, *nnz_total, bytes, messages,
+                             cols);
+    }
+
+    free(bytes);
+    free(messages);
+    free(cols);
+    return ret;
+}
+
 /* ================== C Wrappers for MPI_Finalize ================== */
 
 int E_Finalize(int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(138, &f_dl, (*VECTOR_GET(v, i)).table);
 
-    int counters_copy[COUNTERS_LEN];
+    uint64_t counters_copy[COUNTERS_LEN];
     for (size_t i = 0; i < COUNTERS_LEN; i++) {
         counters_copy[i] = counters[i];
     }
 
-    int smmd_counters[COUNTERS_LEN];
-    int red_scc = MPI_Reduce(counters_copy, smmd_counters, COUNTERS_LEN,
-                             MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    uint64_t smmd_counters[COUNTERS_LEN];
+    int red_scc = PMPI_Reduce(counters_copy, smmd_counters, COUNTERS_LEN,
+                              MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
     if (red_scc != MPI_SUCCESS) {
         return red_scc;
     }
 
     int rank;
-    int cr_scc = MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    int cr_scc = PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
     if (cr_scc != MPI_SUCCESS) {
         return red_scc;
     }
 
+    char *matrix_file = getenv("BANDWIDTH_MATRIX_FILE");
+    uint64_t matrix_nnz = 0;
+    int matrix_scc = MPI_SUCCESS;
+    if (matrix_file != NULL) {
+        matrix_scc = write_comm_matrix(matrix_file, &matrix_nnz);
+    }
+
+    nb_stats nb_global[NB_KINDS];
+    nonblocking_stats_reduce(nb_global);
+    coll_stats coll_global;
+    collective_stats_reduce(&coll_global);
+    uint64_t p2p_hist_global[P2P_KINDS][SIZE_BUCKETS];
+    uint64_t coll_hist_global[COLL_KINDS][SIZE_BUCKETS];
+    size_hist_reduce(p2p_hist_global, coll_hist_global);
+    loc_stats loc_global[TRAFFIC_KINDS];
+    locality_stats_reduce(loc_global);
+    res_stats *res_merged;
+    size_t res_count = rma_io_gather(&res_merged);
+
     char *fin_debug = getenv("FINALIZE_DEBUG_CONFIRM");
     if (rank == 0 && (fin_debug == NULL || strcmp(fin_debug, "1") == 0)) {
         for (size_t counter_id = 0; counter_id < COUNTERS_LEN; counter_id++) {
-            int count = smmd_counters[counter_id];
+            uint64_t count = smmd_counters[counter_id];
             if (count != 0) {
-                printf("%s: %u\n", COUNTER_NAMES[counter_id], (unsigned)count);
+                printf("%s: %llu (%llu B)\n", COUNTER_NAMES[counter_id],
+                       (unsigned long long)count,
+                       (unsigned long long)count *
+                           PRIM_SIZE[counter_id % PRIM_KINDS]);
             }
         }
+        nonblocking_stats_print(nb_global);
+        collective_stats_print(&coll_global);
+        size_hist_print_all(p2p_hist_global, coll_hist_global);
+        locality_stats_print(loc_global);
+        rma_io_print(res_merged, res_count);
+        if (matrix_file != NULL && matrix_scc == MPI_SUCCESS) {
+            printf("Communication matrix (%llu entries) written to %s\n",
+                   (unsigned long long)matrix_nnz, matrix_file);
+        } else if (matrix_file != NULL) {
+            printf("Could not write communication matrix to %s\n",
+                   matrix_file);
+        }
     }
 
+    free(res_merged);
+
     int ret = EXEC_FUNC(f_dl, i, 138, v);
     return ret;
 }
@@ -196,10 +478,16 @@ int E_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag,
            MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(258, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 258, v, buf, count, datatype, dest, tag, comm);
+    double elapsed = PMPI_Wtime() - start;
 
     if (ret == MPI_SUCCESS){
         send_data_record(count, datatype);
+        matrix_data_record(count, datatype, dest, comm);
+        uint64_t bytes = type_bytes(count, datatype);
+        p2p_record(P2P_SEND, bytes);
+        p2p_locality_record(comm, dest, MPI_PROC_NULL, bytes, elapsed);
     }
 
     return ret;
@@ -210,10 +498,16 @@ int E_Bsend(const void *buf, int count, MPI_Datatype datatype, int dest,
             int tag, MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(18, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 18, v, buf, count, datatype, dest, tag, comm);
+    double elapsed = PMPI_Wtime() - start;
 
     if (ret == MPI_SUCCESS){
         send_data_record(count, datatype);
+        matrix_data_record(count, datatype, dest, comm);
+        uint64_t bytes = type_bytes(count, datatype);
+        p2p_record(P2P_BSEND, bytes);
+        p2p_locality_record(comm, dest, MPI_PROC_NULL, bytes, elapsed);
     }
 
     return ret;
@@ -224,11 +518,17 @@ int E_Rsend(const void *ibuf, int count, MPI_Datatype datatype, int dest,
             int tag, MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(253, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 253, v, ibuf, count, datatype, dest, tag, comm);
+    double elapsed = PMPI_Wtime() - start;
 
     if (ret == MPI_SUCCESS){
         send_data_record(count, datatype);
+        matrix_data_record(count, datatype, dest, comm);
+        uint64_t bytes = type_bytes(count, datatype);
+        p2p_record(P2P_RSEND, bytes);
+        p2p_locality_record(comm, dest, MPI_PROC_NULL, bytes, elapsed);
     }
 
     return ret;
@@ -239,10 +539,16 @@ int E_Ssend(const void *buf, int count, MPI_Datatype datatype, int dest,
             int tag, MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(262, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 262, v, buf, count, datatype, dest, tag, comm);
+    double elapsed = PMPI_Wtime() - start;
 
     if (ret == MPI_SUCCESS){
         send_data_record(count, datatype);
+        matrix_data_record(count, datatype, dest, comm);
+        uint64_t bytes = type_bytes(count, datatype);
+        p2p_record(P2P_SSEND, bytes);
+        p2p_locality_record(comm, dest, MPI_PROC_NULL, bytes, elapsed);
     }
 
     return ret;
@@ -255,8 +561,10 @@ int E_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
     QMPI_TABLE_QUERY(241, &f_dl, (*VECTOR_GET(v, i)).table);
 
     MPI_Status local_status;
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 241, v, buf, count, datatype, source, tag,
                         comm, &local_status);
+    double elapsed = PMPI_Wtime() - start;
     if (status != MPI_STATUS_IGNORE) {
         *status = local_status;
     }
@@ -266,6 +574,14 @@ int E_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
         if (ret == MPI_SUCCESS) {
             recv_data_record(count, datatype);
         }
+        int received;
+        if (PMPI_Get_count(&local_status, MPI_BYTE, &received) ==
+                MPI_SUCCESS &&
+            received != MPI_UNDEFINED) {
+            p2p_record(P2P_RECV, received);
+            p2p_locality_record(comm, MPI_PROC_NULL, local_status.MPI_SOURCE,
+                                received, elapsed);
+        }
     }
 
     return ret;
@@ -280,14 +596,27 @@ int E_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     QMPI_TABLE_QUERY(260, &f_dl, (*VECTOR_GET(v, i)).table);
 
     MPI_Status local_status;
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 260, v, sendbuf, sendcount, sendtype, dest, sendtag,
                   recvbuf, recvcount, recvtype, source, recvtag, comm, &local_status);
+    double elapsed = PMPI_Wtime() - start;
     if (status != MPI_STATUS_IGNORE) {
       *status = local_status;
     }
 
     if (ret == MPI_SUCCESS){
+        matrix_data_record(sendcount, sendtype, dest, comm);
+        uint64_t bytes = type_bytes(sendcount, sendtype);
+        p2p_record(P2P_SENDRECV, bytes);
+        int received;
+        if (PMPI_Get_count(&local_status, MPI_BYTE, &received) ==
+                MPI_SUCCESS &&
+            received != MPI_UNDEFINED) {
+            bytes += received;
+        }
+        p2p_locality_record(comm, dest, local_status.MPI_SOURCE, bytes,
+                            elapsed);
         ret = PMPI_Get_count(&local_status, recvtype, &recvcount);
         if (ret == MPI_SUCCESS) {
             recv_data_record(recvcount, recvtype);
@@ -302,7 +631,18 @@ int E_Bcast(void *buffer, int count, MPI_Datatype datatype, int root,
             MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(17, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 17, v, buffer, count, datatype, root, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t bytes = type_bytes(count, datatype);
+        int is_root = coll_is_root(comm, root);
+        coll_record(COLL_BCAST, comm, size, is_root ? bytes : 0,
+                    is_root ? 0 : bytes, bytes, elapsed);
+    }
 
     if (ret == MPI_SUCCESS){
         int curr_rank;
@@ -329,8 +669,17 @@ int E_Allreduce(const void *sendbuf, void *recvbuf, int count,
                 vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(9, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 9, v, sendbuf, recvbuf, count, datatype, op, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t bytes = type_bytes(count, datatype);
+        coll_record(COLL_ALLREDUCE, comm, size, bytes, bytes, bytes, elapsed);
+    }
 
     if (ret == MPI_SUCCESS){
         reduce_data_record(count, datatype);
@@ -347,6 +696,11 @@ int E_Init(int *argc, char ***argv, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(200, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 200, v, argc, argv);
+
+    if (ret == MPI_SUCCESS) {
+        locality_init();
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Abort ================== 0*/
@@ -366,9 +720,16 @@ int E_Accumulate(const void *origin_addr, int origin_count,
                  vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(1, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 1, v, origin_addr, origin_count,
                         origin_datatype, target_rank, target_disp, target_count,
                         target_datatype, op, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1,
+                   type_bytes(origin_count, origin_datatype), 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Add_error_class ================== 2*/
@@ -410,8 +771,21 @@ int E_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
                 MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(6, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 6, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcount, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t block = type_bytes(recvcount, recvtype);
+        uint64_t sent = sendbuf == MPI_IN_PLACE
+                            ? block
+                            : type_bytes(sendcount, sendtype);
+        coll_record(COLL_ALLGATHER, comm, size, sent, peers * block,
+                    peers * block, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Allgatherv ================== 7*/
@@ -421,8 +795,23 @@ int E_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
                  MPI_Datatype recvtype, MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(7, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 7, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcounts, displs, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers, rank;
+        coll_comm_sizes(comm, &size, &peers);
+        PMPI_Comm_rank(comm, &rank);
+        uint64_t received =
+            type_bytes(1, recvtype) * sum_counts(recvcounts, peers);
+        uint64_t sent = sendbuf == MPI_IN_PLACE
+                            ? type_bytes(recvcounts[rank], recvtype)
+                            : type_bytes(sendcount, sendtype);
+        coll_record(COLL_ALLGATHERV, comm, size, sent, received, received,
+                    elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Alloc_mem ================== 8*/
@@ -440,8 +829,20 @@ int E_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
                MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(10, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 10, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcount, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t received = peers * type_bytes(recvcount, recvtype);
+        uint64_t sent = sendbuf == MPI_IN_PLACE
+                            ? received
+                            : peers * type_bytes(sendcount, sendtype);
+        coll_record(COLL_ALLTOALL, comm, size, sent, received, sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Alltoallv ================== 11*/
@@ -452,8 +853,22 @@ int E_Alltoallv(const void *sendbuf, const int sendcounts[],
                 MPI_Datatype recvtype, MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(11, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 11, v, sendbuf, sendcounts, sdispls, sendtype,
                         recvbuf, recvcounts, rdispls, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t received =
+            type_bytes(1, recvtype) * sum_counts(recvcounts, peers);
+        uint64_t sent = sendbuf == MPI_IN_PLACE
+                            ? received
+                            : type_bytes(1, sendtype) *
+                                  sum_counts(sendcounts, peers);
+        coll_record(COLL_ALLTOALLV, comm, size, sent, received, sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Alltoallw ================== 12*/
@@ -465,8 +880,20 @@ int E_Alltoallw(const void *sendbuf, const int sendcounts[],
                 vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(12, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 12, v, sendbuf, sendcounts, sdispls, sendtypes,
                         recvbuf, recvcounts, rdispls, recvtypes, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t received = sum_typed_counts(recvcounts, recvtypes, peers);
+        uint64_t sent = sendbuf == MPI_IN_PLACE
+                            ? received
+                            : sum_typed_counts(sendcounts, sendtypes, peers);
+        coll_record(COLL_ALLTOALLW, comm, size, sent, received, sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Attr_delete ================== 13*/
@@ -923,8 +1350,15 @@ int E_Compare_and_swap(const void *origin_addr, const void *compare_addr,
                        int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(65, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 65, v, origin_addr, compare_addr, result_addr,
                         datatype, target_rank, target_disp, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        uint64_t bytes = type_bytes(1, datatype);
+        res_record(win_slot(win), 1, bytes, bytes, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Dims_create ================== */
@@ -1047,8 +1481,17 @@ int E_Exscan(const void *sendbuf, void *recvbuf, int count,
              vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(77, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 77, v, sendbuf, recvbuf, count, datatype, op, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t bytes = type_bytes(count, datatype);
+        coll_record(COLL_EXSCAN, comm, size, bytes, bytes, bytes, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Fetch_and_op ================== */
@@ -1058,8 +1501,15 @@ int E_Fetch_and_op(const void *origin_addr, void *result_addr,
                    MPI_Op op, MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(78, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 78, v, origin_addr, result_addr, datatype,
                         target_rank, target_disp, op, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        uint64_t bytes = type_bytes(1, datatype);
+        res_record(win_slot(win), 1, bytes, bytes, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_call_errhandler ==================
@@ -1076,6 +1526,10 @@ int E_File_call_errhandler(MPI_File fh, int errorcode, int i, vector *v) {
 int E_File_close(MPI_File *fh, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(80, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    // the handle is reset to MPI_FILE_NULL by the call
+    file_close(*fh);
+
     int ret = EXEC_FUNC(f_dl, i, 80, v, fh);
     return ret;
 }
@@ -1201,7 +1655,14 @@ int E_File_iread(MPI_File fh, void *buf, int count, MPI_Datatype datatype,
                  MPI_Request *request, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(94, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 94, v, fh, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iread_all ================== */
@@ -1210,7 +1671,14 @@ int E_File_iread_all(MPI_File fh, void *buf, int count, MPI_Datatype datatype,
                      MPI_Request *request, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(95, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 95, v, fh, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 
@@ -1221,8 +1689,15 @@ int E_File_iread_at(MPI_File fh, MPI_Offset offset, void *buf, int count,
                     vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(96, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 96, v, fh, offset, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iread_at_all ================== */
@@ -1232,8 +1707,15 @@ int E_File_iread_at_all(MPI_File fh, MPI_Offset offset, void *buf, int count,
                         vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(97, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 97, v, fh, offset, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iread_shared ================== */
@@ -1243,7 +1725,14 @@ int E_File_iread_shared(MPI_File fh, void *buf, int count,
                         vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(98, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 98, v, fh, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iwrite ================== */
@@ -1253,7 +1742,14 @@ int E_File_iwrite(MPI_File fh, const void *buf, int count,
                   vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(99, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 99, v, fh, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iwrite_all ================== */
@@ -1263,7 +1759,14 @@ int E_File_iwrite_all(MPI_File fh, const void *buf, int count,
                       vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(100, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 100, v, fh, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iwrite_at ================== */
@@ -1273,8 +1776,15 @@ int E_File_iwrite_at(MPI_File fh, MPI_Offset offset, const void *buf, int count,
                      vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(101, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 101, v, fh, offset, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iwrite_at_all ==================
@@ -1285,8 +1795,15 @@ int E_File_iwrite_at_all(MPI_File fh, MPI_Offset offset, const void *buf,
                          int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(102, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 102, v, fh, offset, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_iwrite_shared ==================
@@ -1297,7 +1814,14 @@ int E_File_iwrite_shared(MPI_File fh, const void *buf, int count,
                          vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(103, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 103, v, fh, buf, count, datatype, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_open ================== */
@@ -1307,6 +1831,10 @@ int E_File_open(MPI_Comm comm, const char *filename, int amode, MPI_Info info,
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(104, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 104, v, comm, filename, amode, info, fh);
+
+    if (ret == MPI_SUCCESS) {
+        file_open(*fh, filename);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_preallocate ================== */
@@ -1323,7 +1851,14 @@ int E_File_read(MPI_File fh, void *buf, int count, MPI_Datatype datatype,
                 MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(106, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 106, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_all ================== */
@@ -1332,7 +1867,14 @@ int E_File_read_all(MPI_File fh, void *buf, int count, MPI_Datatype datatype,
                     MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(107, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 107, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_all_begin ==================
@@ -1342,7 +1884,14 @@ int E_File_read_all_begin(MPI_File fh, void *buf, int count,
                           MPI_Datatype datatype, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(108, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 108, v, fh, buf, count, datatype);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_all_end ================== */
@@ -1351,7 +1900,13 @@ int E_File_read_all_end(MPI_File fh, void *buf, MPI_Status *status, int i,
                         vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(109, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 109, v, fh, buf, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 0, 0, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_at ================== */
@@ -1361,8 +1916,15 @@ int E_File_read_at(MPI_File fh, MPI_Offset offset, void *buf, int count,
                    vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(110, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 110, v, fh, offset, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_at_all ================== */
@@ -1372,8 +1934,15 @@ int E_File_read_at_all(MPI_File fh, MPI_Offset offset, void *buf, int count,
                        vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(111, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 111, v, fh, offset, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_at_all_begin
@@ -1384,7 +1953,14 @@ int E_File_read_at_all_begin(MPI_File fh, MPI_Offset offset, void *buf,
                              vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(112, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 112, v, fh, offset, buf, count, datatype);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_at_all_end ==================
@@ -1394,7 +1970,13 @@ int E_File_read_at_all_end(MPI_File fh, void *buf, MPI_Status *status, int i,
                            vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(113, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 113, v, fh, buf, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 0, 0, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_ordered ================== */
@@ -1404,7 +1986,14 @@ int E_File_read_ordered(MPI_File fh, void *buf, int count,
                         vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(114, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 114, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_ordered_begin
@@ -1414,7 +2003,14 @@ int E_File_read_ordered_begin(MPI_File fh, void *buf, int count,
                               MPI_Datatype datatype, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(115, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 115, v, fh, buf, count, datatype);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_ordered_end
@@ -1424,7 +2020,13 @@ int E_File_read_ordered_end(MPI_File fh, void *buf, MPI_Status *status, int i,
                             vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(116, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 116, v, fh, buf, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 0, 0, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_read_shared ================== */
@@ -1433,7 +2035,14 @@ int E_File_read_shared(MPI_File fh, void *buf, int count, MPI_Datatype datatype,
                        MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(117, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 117, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, 0, type_bytes(count, datatype),
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_seek ================== */
@@ -1513,7 +2122,14 @@ int E_File_write(MPI_File fh, const void *buf, int count, MPI_Datatype datatype,
                  MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(126, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 126, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_all ================== */
@@ -1523,7 +2139,14 @@ int E_File_write_all(MPI_File fh, const void *buf, int count,
                      vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(127, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 127, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_all_begin ==================
@@ -1533,7 +2156,14 @@ int E_File_write_all_begin(MPI_File fh, const void *buf, int count,
                            MPI_Datatype datatype, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(128, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 128, v, fh, buf, count, datatype);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_all_end ==================
@@ -1543,7 +2173,13 @@ int E_File_write_all_end(MPI_File fh, const void *buf, MPI_Status *status,
                          int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(129, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 129, v, fh, buf, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 0, 0, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_at ================== */
@@ -1553,8 +2189,15 @@ int E_File_write_at(MPI_File fh, MPI_Offset offset, const void *buf, int count,
                     vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(130, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 130, v, fh, offset, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_at_all ================== */
@@ -1564,8 +2207,15 @@ int E_File_write_at_all(MPI_File fh, MPI_Offset offset, const void *buf,
                         int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(131, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 131, v, fh, offset, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_at_all_begin
@@ -1576,7 +2226,14 @@ int E_File_write_at_all_begin(MPI_File fh, MPI_Offset offset, const void *buf,
                               vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(132, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 132, v, fh, offset, buf, count, datatype);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_at_all_end
@@ -1586,7 +2243,13 @@ int E_File_write_at_all_end(MPI_File fh, const void *buf, MPI_Status *status,
                             int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(133, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 133, v, fh, buf, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 0, 0, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_ordered ==================
@@ -1597,7 +2260,14 @@ int E_File_write_ordered(MPI_File fh, const void *buf, int count,
                          vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(134, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 134, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_ordered_begin
@@ -1607,7 +2277,14 @@ int E_File_write_ordered_begin(MPI_File fh, const void *buf, int count,
                                MPI_Datatype datatype, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(135, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 135, v, fh, buf, count, datatype);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_ordered_end
@@ -1617,7 +2294,13 @@ int E_File_write_ordered_end(MPI_File fh, const void *buf, MPI_Status *status,
                              int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(136, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 136, v, fh, buf, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 0, 0, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_File_write_shared ================== */
@@ -1627,7 +2310,14 @@ int E_File_write_shared(MPI_File fh, const void *buf, int count,
                         vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(137, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 137, v, fh, buf, count, datatype, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(file_slot(fh), 1, type_bytes(count, datatype), 0,
+                   elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Finalized ================== */
@@ -1653,8 +2343,22 @@ int E_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
              MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(141, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 141, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcount, recvtype, root, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t block = type_bytes(recvcount, recvtype);
+        int is_root = coll_is_root(comm, root);
+        uint64_t sent = is_root && sendbuf == MPI_IN_PLACE
+                            ? block
+                            : type_bytes(sendcount, sendtype);
+        coll_record(COLL_GATHER, comm, size, sent, is_root ? peers * block : 0,
+                    is_root ? peers * block : peers * sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Gatherv ================== */
@@ -1665,8 +2369,26 @@ int E_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
               vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(142, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 142, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcounts, displs, recvtype, root, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers, rank;
+        coll_comm_sizes(comm, &size, &peers);
+        PMPI_Comm_rank(comm, &rank);
+        int is_root = coll_is_root(comm, root);
+        uint64_t sent = is_root && sendbuf == MPI_IN_PLACE
+                            ? type_bytes(recvcounts[rank], recvtype)
+                            : type_bytes(sendcount, sendtype);
+        // only the root knows the total; other ranks assume equal blocks
+        uint64_t received =
+            is_root ? type_bytes(1, recvtype) * sum_counts(recvcounts, peers)
+                    : 0;
+        coll_record(COLL_GATHERV, comm, size, sent, received,
+                    is_root ? received : peers * sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Get ================== */
@@ -1676,9 +2398,16 @@ int E_Get(void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
           MPI_Datatype target_datatype, MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(143, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 143, v, origin_addr, origin_count, origin_datatype,
                   target_rank, target_disp, target_count, target_datatype, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1, 0,
+                   type_bytes(origin_count, origin_datatype), elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Get_accumulate ================== */
@@ -1691,10 +2420,18 @@ int E_Get_accumulate(const void *origin_addr, int origin_count,
                      int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(144, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 144, v, origin_addr, origin_count, origin_datatype,
                   result_addr, result_count, result_datatype, target_rank,
                   target_disp, target_count, target_datatype, op, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1,
+                   type_bytes(origin_count, origin_datatype),
+                   type_bytes(result_count, result_datatype), elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Get_address ================== */
@@ -2039,6 +2776,14 @@ int E_Ibsend(const void *buf, int count, MPI_Datatype datatype, int dest,
     QMPI_TABLE_QUERY(180, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 180, v, buf, count, datatype, dest, tag, comm,
                         request);
+
+    if (ret == MPI_SUCCESS) {
+        matrix_data_record(count, datatype, dest, comm);
+        p2p_record(P2P_IBSEND, type_bytes(count, datatype));
+        nonblocking_post_record(NB_SEND, count, datatype, dest, comm,
+                                *request);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Iexscan ================== */
@@ -2248,6 +2993,11 @@ int E_Init_thread(int *argc, char ***argv, int required, int *provided, int i,
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(201, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 201, v, argc, argv, required, provided);
+
+    if (ret == MPI_SUCCESS) {
+        locality_init();
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Initialized ================== */
@@ -2295,6 +3045,12 @@ int E_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
     QMPI_TABLE_QUERY(206, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 206, v, buf, count, datatype, source, tag,
                         comm, request);
+
+    if (ret == MPI_SUCCESS) {
+        nonblocking_post_record(NB_RECV, count, datatype, source, comm,
+                                *request);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Ireduce ================== */
@@ -2339,6 +3095,14 @@ int E_Irsend(const void *buf, int count, MPI_Datatype datatype, int dest,
     QMPI_TABLE_QUERY(210, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 210, v, buf, count, datatype, dest, tag, comm,
                         request);
+
+    if (ret == MPI_SUCCESS) {
+        matrix_data_record(count, datatype, dest, comm);
+        p2p_record(P2P_IRSEND, type_bytes(count, datatype));
+        nonblocking_post_record(NB_SEND, count, datatype, dest, comm,
+                                *request);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Is_thread_main ================== */
@@ -2391,6 +3155,14 @@ int E_Isend(const void *buf, int count, MPI_Datatype datatype, int dest,
     QMPI_TABLE_QUERY(215, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 215, v, buf, count, datatype, dest, tag, comm,
                         request);
+
+    if (ret == MPI_SUCCESS) {
+        matrix_data_record(count, datatype, dest, comm);
+        p2p_record(P2P_ISEND, type_bytes(count, datatype));
+        nonblocking_post_record(NB_SEND, count, datatype, dest, comm,
+                                *request);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Issend ================== */
@@ -2401,6 +3173,14 @@ int E_Issend(const void *buf, int count, MPI_Datatype datatype, int dest,
     QMPI_TABLE_QUERY(216, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 216, v, buf, count, datatype, dest, tag, comm,
                         request);
+
+    if (ret == MPI_SUCCESS) {
+        matrix_data_record(count, datatype, dest, comm);
+        p2p_record(P2P_ISSEND, type_bytes(count, datatype));
+        nonblocking_post_record(NB_SEND, count, datatype, dest, comm,
+                                *request);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Keyval_create ================== */
@@ -2457,8 +3237,18 @@ int E_Neighbor_allgather(const void *sendbuf, int sendcount,
                          vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(222, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 222, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcount, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int indegree, outdegree;
+        neighbor_degrees(comm, &indegree, &outdegree);
+        uint64_t sent = outdegree * type_bytes(sendcount, sendtype);
+        coll_record(COLL_NEIGHBOR_ALLGATHER, comm, indegree + 1, sent,
+                    indegree * type_bytes(recvcount, recvtype), sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Neighbor_allgatherv ==================
@@ -2471,8 +3261,19 @@ int E_Neighbor_allgatherv(const void *sendbuf, int sendcount,
                           vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(223, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 223, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcounts, displs, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int indegree, outdegree;
+        neighbor_degrees(comm, &indegree, &outdegree);
+        uint64_t sent = outdegree * type_bytes(sendcount, sendtype);
+        coll_record(COLL_NEIGHBOR_ALLGATHERV, comm, indegree + 1, sent,
+                    type_bytes(1, recvtype) * sum_counts(recvcounts, indegree),
+                    sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Neighbor_alltoall ================== */
@@ -2483,8 +3284,18 @@ int E_Neighbor_alltoall(const void *sendbuf, int sendcount,
                         vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(224, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 224, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcount, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int indegree, outdegree;
+        neighbor_degrees(comm, &indegree, &outdegree);
+        uint64_t sent = outdegree * type_bytes(sendcount, sendtype);
+        coll_record(COLL_NEIGHBOR_ALLTOALL, comm, indegree + 1, sent,
+                    indegree * type_bytes(recvcount, recvtype), sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Neighbor_alltoallv ==================
@@ -2497,8 +3308,20 @@ int E_Neighbor_alltoallv(const void *sendbuf, const int sendcounts[],
                          MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(225, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 225, v, sendbuf, sendcounts, sdispls, sendtype,
                         recvbuf, recvcounts, rdispls, recvtype, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int indegree, outdegree;
+        neighbor_degrees(comm, &indegree, &outdegree);
+        uint64_t sent =
+            type_bytes(1, sendtype) * sum_counts(sendcounts, outdegree);
+        coll_record(COLL_NEIGHBOR_ALLTOALLV, comm, indegree + 1, sent,
+                    type_bytes(1, recvtype) * sum_counts(recvcounts, indegree),
+                    sent, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Neighbor_alltoallw ==================
@@ -2512,9 +3335,20 @@ int E_Neighbor_alltoallw(const void *sendbuf, const int sendcounts[],
                          vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(226, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 226, v, sendbuf, sendcounts, sdispls, sendtypes,
                   recvbuf, recvcounts, rdispls, recvtypes, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int indegree, outdegree;
+        neighbor_degrees(comm, &indegree, &outdegree);
+        uint64_t sent = sum_typed_counts(sendcounts, sendtypes, outdegree);
+        coll_record(COLL_NEIGHBOR_ALLTOALLW, comm, indegree + 1, sent,
+                    sum_typed_counts(recvcounts, recvtypes, indegree), sent,
+                    elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Op_commutative ================== */
@@ -2625,9 +3459,16 @@ int E_Put(const void *origin_addr, int origin_count,
           vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(238, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 238, v, origin_addr, origin_count, origin_datatype,
                   target_rank, target_disp, target_count, target_datatype, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1,
+                   type_bytes(origin_count, origin_datatype), 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Query_thread ================== */
@@ -2647,9 +3488,16 @@ int E_Raccumulate(const void *origin_addr, int origin_count,
                   MPI_Request *request, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(240, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 240, v, origin_addr, origin_count,
                         origin_datatype, target_rank, target_disp, target_count,
                         target_datatype, op, win, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1,
+                   type_bytes(origin_count, origin_datatype), 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Recv_init ================== */
@@ -2670,8 +3518,18 @@ int E_Reduce(const void *sendbuf, void *recvbuf, int count,
              vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(243, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 243, v, sendbuf, recvbuf, count, datatype, op,
                         root, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t bytes = type_bytes(count, datatype);
+        coll_record(COLL_REDUCE, comm, size, bytes,
+                    coll_is_root(comm, root) ? bytes : 0, bytes, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Reduce_local ================== */
@@ -2690,8 +3548,19 @@ int E_Reduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts[],
                      vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(245, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 245, v, sendbuf, recvbuf, recvcounts, datatype,
                         op, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers, rank;
+        coll_comm_sizes(comm, &size, &peers);
+        PMPI_Comm_rank(comm, &rank);
+        uint64_t total = type_bytes(1, datatype) * sum_counts(recvcounts, size);
+        coll_record(COLL_REDUCE_SCATTER, comm, size, total,
+                    type_bytes(recvcounts[rank], datatype), total, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Reduce_scatter_block ==================
@@ -2702,8 +3571,18 @@ int E_Reduce_scatter_block(const void *sendbuf, void *recvbuf, int recvcount,
                            int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(246, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 246, v, sendbuf, recvbuf, recvcount, datatype,
                         op, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t block = type_bytes(recvcount, datatype);
+        coll_record(COLL_REDUCE_SCATTER_BLOCK, comm, size, size * block, block,
+                    size * block, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Register_datarep ================== */
@@ -2724,6 +3603,10 @@ int E_Register_datarep(const char *datarep,
 int E_Request_free(MPI_Request *request, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(248, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    // a freed request's completion is never observed
+    nb_forget(*request);
+
     int ret = EXEC_FUNC(f_dl, i, 248, v, request);
     return ret;
 }
@@ -2745,9 +3628,16 @@ int E_Rget(void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
            int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(250, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 250, v, origin_addr, origin_count,
                         origin_datatype, target_rank, target_disp, target_count,
                         target_datatype, win, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1, 0,
+                   type_bytes(origin_count, origin_datatype), elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Rget_accumulate ================== */
@@ -2760,10 +3650,18 @@ int E_Rget_accumulate(const void *origin_addr, int origin_count,
                       MPI_Request *request, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(251, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 251, v, origin_addr, origin_count, origin_datatype,
                   result_addr, result_count, result_datatype, target_rank,
                   target_disp, target_count, target_datatype, op, win, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1,
+                   type_bytes(origin_count, origin_datatype),
+                   type_bytes(result_count, result_datatype), elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Rput ================== */
@@ -2774,9 +3672,16 @@ int E_Rput(const void *origin_addr, int origin_count,
            MPI_Request *request, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(252, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 252, v, origin_addr, origin_count,
                         origin_datatype, target_rank, target_disp, target_cout,
                         target_datatype, win, request);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        res_record(win_slot(win), 1,
+                   type_bytes(origin_count, origin_datatype), 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Rsend_init ================== */
@@ -2796,8 +3701,17 @@ int E_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype,
            MPI_Op op, MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(255, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret =
         EXEC_FUNC(f_dl, i, 255, v, sendbuf, recvbuf, count, datatype, op, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        uint64_t bytes = type_bytes(count, datatype);
+        coll_record(COLL_SCAN, comm, size, bytes, bytes, bytes, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Scatter ================== */
@@ -2807,8 +3721,22 @@ int E_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
               MPI_Comm comm, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(256, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 256, v, sendbuf, sendcount, sendtype, recvbuf,
                         recvcount, recvtype, root, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers;
+        coll_comm_sizes(comm, &size, &peers);
+        int is_root = coll_is_root(comm, root);
+        uint64_t block = recvbuf == MPI_IN_PLACE
+                             ? type_bytes(sendcount, sendtype)
+                             : type_bytes(recvcount, recvtype);
+        uint64_t sent = is_root ? peers * type_bytes(sendcount, sendtype) : 0;
+        coll_record(COLL_SCATTER, comm, size, sent, block, peers * block,
+                    elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Scatterv ================== */
@@ -2819,8 +3747,26 @@ int E_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[],
                vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(257, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 257, v, sendbuf, sendcounts, displs, sendtype,
                         recvbuf, recvcount, recvtype, root, comm);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        int size, peers, rank;
+        coll_comm_sizes(comm, &size, &peers);
+        PMPI_Comm_rank(comm, &rank);
+        int is_root = coll_is_root(comm, root);
+        uint64_t received = is_root && recvbuf == MPI_IN_PLACE
+                                ? type_bytes(sendcounts[rank], sendtype)
+                                : type_bytes(recvcount, recvtype);
+        // only the root knows the total; other ranks assume equal blocks
+        uint64_t sent =
+            is_root ? type_bytes(1, sendtype) * sum_counts(sendcounts, peers)
+                    : 0;
+        coll_record(COLL_SCATTERV, comm, size, sent, received,
+                    is_root ? sent : peers * received, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Send_init ================== */
@@ -2841,8 +3787,18 @@ int E_Sendrecv_replace(void *buf, int count, MPI_Datatype datatype, int dest,
                        MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(261, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 261, v, buf, count, datatype, dest, sendtag,
                         source, recvtag, comm, status);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        matrix_data_record(count, datatype, dest, comm);
+        uint64_t bytes = type_bytes(count, datatype);
+        p2p_record(P2P_SENDRECV_REPLACE, bytes);
+        p2p_locality_record(comm, dest, source, 2 * bytes, elapsed);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Ssend_init ================== */
@@ -2907,7 +3863,20 @@ int E_Test(MPI_Request *request, int *flag, MPI_Status *status, int i,
            vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(269, &f_dl, (*VECTOR_GET(v, i)).table);
-    int ret = EXEC_FUNC(f_dl, i, 269, v, request, flag, status);
+
+    MPI_Request posted = *request;
+    MPI_Status local_status;
+    double start = PMPI_Wtime();
+    int ret = EXEC_FUNC(f_dl, i, 269, v, request, flag, &local_status);
+    if (status != MPI_STATUS_IGNORE) {
+        *status = local_status;
+    }
+
+    if (ret == MPI_SUCCESS && *flag) {
+        double now = PMPI_Wtime();
+        nb_complete(posted, &local_status, now, now - start);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Test_cancelled ================== */
@@ -2924,8 +3893,27 @@ int E_Testall(int count, MPI_Request array_of_requests[], int *flag,
               MPI_Status array_of_statuses[], int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(271, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    nb_snapshot snap;
+    if (outstanding.len == 0 ||
+        !nb_snapshot_take(&snap, count, array_of_requests, array_of_statuses,
+                          1)) {
+        return EXEC_FUNC(f_dl, i, 271, v, count, array_of_requests, flag,
+                         array_of_statuses);
+    }
+
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 271, v, count, array_of_requests, flag,
-                        array_of_statuses);
+                        snap.statuses);
+
+    if (ret == MPI_SUCCESS && *flag) {
+        double now = PMPI_Wtime();
+        for (int k = 0; k < count; k++) {
+            nb_complete(snap.requests[k], &snap.statuses[k], now, now - start);
+        }
+    }
+
+    nb_snapshot_release(&snap);
     return ret;
 }
 /* ================== C Wrappers for MPI_Testany ================== */
@@ -2934,8 +3922,28 @@ int E_Testany(int count, MPI_Request array_of_requests[], int *index, int *flag,
               MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(272, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    nb_snapshot snap;
+    if (outstanding.len == 0 ||
+        !nb_snapshot_take(&snap, count, array_of_requests, NULL, 0)) {
+        return EXEC_FUNC(f_dl, i, 272, v, count, array_of_requests, index,
+                         flag, status);
+    }
+
+    MPI_Status local_status;
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 272, v, count, array_of_requests, index, flag,
-                        status);
+                        &local_status);
+    if (status != MPI_STATUS_IGNORE) {
+        *status = local_status;
+    }
+
+    if (ret == MPI_SUCCESS && *flag && *index != MPI_UNDEFINED) {
+        double now = PMPI_Wtime();
+        nb_complete(snap.requests[*index], &local_status, now, now - start);
+    }
+
+    nb_snapshot_release(&snap);
     return ret;
 }
 /* ================== C Wrappers for MPI_Testsome ================== */
@@ -2945,8 +3953,28 @@ int E_Testsome(int incount, MPI_Request array_of_requests[], int *outcount,
                vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(273, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    nb_snapshot snap;
+    if (outstanding.len == 0 ||
+        !nb_snapshot_take(&snap, incount, array_of_requests,
+                          array_of_statuses, 1)) {
+        return EXEC_FUNC(f_dl, i, 273, v, incount, array_of_requests, outcount,
+                         array_of_indices, array_of_statuses);
+    }
+
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 273, v, incount, array_of_requests, outcount,
-                        array_of_indices, array_of_statuses);
+                        array_of_indices, snap.statuses);
+
+    if (ret == MPI_SUCCESS && *outcount != MPI_UNDEFINED) {
+        double now = PMPI_Wtime();
+        for (int k = 0; k < *outcount; k++) {
+            nb_complete(snap.requests[array_of_indices[k]], &snap.statuses[k],
+                        now, now - start);
+        }
+    }
+
+    nb_snapshot_release(&snap);
     return ret;
 }
 /* ================== C Wrappers for MPI_Topo_test ================== */
@@ -2963,6 +3991,11 @@ int E_Type_commit(MPI_Datatype *type, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(275, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 275, v, type);
+
+    if (ret == MPI_SUCCESS) {
+        type_layout_cache(*type);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Type_contiguous ================== */
@@ -3389,7 +4422,20 @@ int E_Unpublish_name(const char *service_name, MPI_Info info,
 int E_Wait(MPI_Request *request, MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(317, &f_dl, (*VECTOR_GET(v, i)).table);
-    int ret = EXEC_FUNC(f_dl, i, 317, v, request, status);
+
+    MPI_Request posted = *request;
+    MPI_Status local_status;
+    double start = PMPI_Wtime();
+    int ret = EXEC_FUNC(f_dl, i, 317, v, request, &local_status);
+    if (status != MPI_STATUS_IGNORE) {
+        *status = local_status;
+    }
+
+    if (ret == MPI_SUCCESS) {
+        double now = PMPI_Wtime();
+        nb_complete(posted, &local_status, now, now - start);
+    }
+
     return ret;
 }
 /* ================== C Wrappers for MPI_Waitall ================== */
@@ -3398,8 +4444,27 @@ int E_Waitall(int count, MPI_Request array_of_requests[],
               MPI_Status *array_of_statuses, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(318, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    nb_snapshot snap;
+    if (outstanding.len == 0 ||
+        !nb_snapshot_take(&snap, count, array_of_requests, array_of_statuses,
+                          1)) {
+        return EXEC_FUNC(f_dl, i, 318, v, count, array_of_requests,
+                         array_of_statuses);
+    }
+
+    double start = PMPI_Wtime();
     int ret =
-        EXEC_FUNC(f_dl, i, 318, v, count, array_of_requests, array_of_statuses);
+        EXEC_FUNC(f_dl, i, 318, v, count, array_of_requests, snap.statuses);
+
+    if (ret == MPI_SUCCESS) {
+        double now = PMPI_Wtime();
+        for (int k = 0; k < count; k++) {
+            nb_complete(snap.requests[k], &snap.statuses[k], now, now - start);
+        }
+    }
+
+    nb_snapshot_release(&snap);
     return ret;
 }
 /* ================== C Wrappers for MPI_Waitany ================== */
@@ -3408,8 +4473,28 @@ int E_Waitany(int count, MPI_Request array_of_requests[], int *index,
               MPI_Status *status, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(319, &f_dl, (*VECTOR_GET(v, i)).table);
-    int ret =
-        EXEC_FUNC(f_dl, i, 319, v, count, array_of_requests, index, status);
+
+    nb_snapshot snap;
+    if (outstanding.len == 0 ||
+        !nb_snapshot_take(&snap, count, array_of_requests, NULL, 0)) {
+        return EXEC_FUNC(f_dl, i, 319, v, count, array_of_requests, index,
+                         status);
+    }
+
+    MPI_Status local_status;
+    double start = PMPI_Wtime();
+    int ret = EXEC_FUNC(f_dl, i, 319, v, count, array_of_requests, index,
+                        &local_status);
+    if (status != MPI_STATUS_IGNORE) {
+        *status = local_status;
+    }
+
+    if (ret == MPI_SUCCESS && *index != MPI_UNDEFINED) {
+        double now = PMPI_Wtime();
+        nb_complete(snap.requests[*index], &local_status, now, now - start);
+    }
+
+    nb_snapshot_release(&snap);
     return ret;
 }
 /* ================== C Wrappers for MPI_Waitsome ================== */
@@ -3419,8 +4504,28 @@ int E_Waitsome(int incount, MPI_Request array_of_requests[], int *outcount,
                vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(320, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    nb_snapshot snap;
+    if (outstanding.len == 0 ||
+        !nb_snapshot_take(&snap, incount, array_of_requests,
+                          array_of_statuses, 1)) {
+        return EXEC_FUNC(f_dl, i, 320, v, incount, array_of_requests, outcount,
+                         array_of_indices, array_of_statuses);
+    }
+
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 320, v, incount, array_of_requests, outcount,
-                        array_of_indices, array_of_statuses);
+                        array_of_indices, snap.statuses);
+
+    if (ret == MPI_SUCCESS && *outcount != MPI_UNDEFINED) {
+        double now = PMPI_Wtime();
+        for (int k = 0; k < *outcount; k++) {
+            nb_complete(snap.requests[array_of_indices[k]], &snap.statuses[k],
+                        now, now - start);
+        }
+    }
+
+    nb_snapshot_release(&snap);
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_allocate ================== */
@@ -3431,6 +4536,10 @@ int E_Win_allocate(MPI_Aint size, int disp_unit, MPI_Info info, MPI_Comm comm,
     QMPI_TABLE_QUERY(321, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret =
         EXEC_FUNC(f_dl, i, 321, v, size, disp_unit, info, comm, baseptr, win);
+
+    if (ret == MPI_SUCCESS) {
+        win_open(*win);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_allocate_shared ==================
@@ -3443,6 +4552,10 @@ int E_Win_allocate_shared(MPI_Aint size, int disp_unit, MPI_Info info,
     QMPI_TABLE_QUERY(322, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret =
         EXEC_FUNC(f_dl, i, 322, v, size, disp_unit, info, comm, baseptr, win);
+
+    if (ret == MPI_SUCCESS) {
+        win_open(*win);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_attach ================== */
@@ -3467,7 +4580,13 @@ int E_Win_call_errhandler(MPI_Win win, int errorcode, int i, vector *v) {
 int E_Win_complete(MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(325, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 325, v, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        win_epoch_end(win, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_create ================== */
@@ -3478,6 +4597,10 @@ int E_Win_create(void *base, MPI_Aint size, int disp_unit, MPI_Info info,
     QMPI_TABLE_QUERY(326, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret =
         EXEC_FUNC(f_dl, i, 326, v, base, size, disp_unit, info, comm, win);
+
+    if (ret == MPI_SUCCESS) {
+        win_open(*win);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_create_dynamic ==================
@@ -3488,6 +4611,10 @@ int E_Win_create_dynamic(MPI_Info info, MPI_Comm comm, MPI_Win *win, int i,
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(327, &f_dl, (*VECTOR_GET(v, i)).table);
     int ret = EXEC_FUNC(f_dl, i, 327, v, info, comm, win);
+
+    if (ret == MPI_SUCCESS) {
+        win_open(*win);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_create_errhandler
@@ -3532,7 +4659,13 @@ int E_Win_detach(MPI_Win win, const void *base, int i, vector *v) {
 int E_Win_fence(int assert, MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(332, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 332, v, assert, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        win_fence(win, assert, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_flush ================== */
@@ -3573,6 +4706,10 @@ int E_Win_flush_local_all(MPI_Win win, int i, vector *v) {
 int E_Win_free(MPI_Win *win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(337, &f_dl, (*VECTOR_GET(v, i)).table);
+
+    // the handle is reset to MPI_WIN_NULL by the call
+    win_close(*win);
+
     int ret = EXEC_FUNC(f_dl, i, 337, v, win);
     return ret;
 }
@@ -3634,7 +4771,13 @@ int E_Win_lock(int lock_type, int rank, int assert, MPI_Win win, int i,
                vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(344, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 344, v, lock_type, rank, assert, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        win_epoch_begin(win, 1, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_lock_all ================== */
@@ -3642,7 +4785,13 @@ int E_Win_lock(int lock_type, int rank, int assert, MPI_Win win, int i,
 int E_Win_lock_all(int assert, MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(345, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 345, v, assert, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        win_epoch_begin(win, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_post ================== */
@@ -3702,7 +4851,13 @@ int E_Win_shared_query(MPI_Win win, int rank, MPI_Aint *size, int *disp_unit,
 int E_Win_start(MPI_Group group, int assert, MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(352, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 352, v, group, assert, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        win_epoch_begin(win, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_sync ================== */
@@ -3726,7 +4881,13 @@ int E_Win_test(MPI_Win win, int *flag, int i, vector *v) {
 int E_Win_unlock(int rank, MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(355, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 355, v, rank, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        win_epoch_end(win, 1, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_unlock_all ================== */
@@ -3734,7 +4895,13 @@ int E_Win_unlock(int rank, MPI_Win win, int i, vector *v) {
 int E_Win_unlock_all(MPI_Win win, int i, vector *v) {
     void *f_dl = NULL;
     QMPI_TABLE_QUERY(356, &f_dl, (*VECTOR_GET(v, i)).table);
+    double start = PMPI_Wtime();
     int ret = EXEC_FUNC(f_dl, i, 356, v, win);
+    double elapsed = PMPI_Wtime() - start;
+
+    if (ret == MPI_SUCCESS) {
+        win_epoch_end(win, 0, elapsed);
+    }
     return ret;
 }
 /* ================== C Wrappers for MPI_Win_wait ================== */
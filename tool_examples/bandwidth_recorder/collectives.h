@@ -0,0 +1,188 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+
+#include "comm_matrix.h"
+#include "size_bucket.h"
+
+/* Per-collective byte model. For every call we record the bytes this rank
+ * contributes from its send buffer, the bytes landing in its receive buffer,
+ * and the NCCL-tests style "bus bytes": the operation size scaled by the
+ * factor that makes the result comparable to the link bandwidth. */
+
+enum {
+    COLL_BCAST,
+    COLL_REDUCE,
+    COLL_ALLREDUCE,
+    COLL_ALLGATHER,
+    COLL_ALLGATHERV,
+    COLL_ALLTOALL,
+    COLL_ALLTOALLV,
+    COLL_ALLTOALLW,
+    COLL_GATHER,
+    COLL_GATHERV,
+    COLL_SCATTER,
+    COLL_SCATTERV,
+    COLL_REDUCE_SCATTER,
+    COLL_REDUCE_SCATTER_BLOCK,
+    COLL_SCAN,
+    COLL_EXSCAN,
+    COLL_NEIGHBOR_ALLGATHER,
+    COLL_NEIGHBOR_ALLGATHERV,
+    COLL_NEIGHBOR_ALLTOALL,
+    COLL_NEIGHBOR_ALLTOALLV,
+    COLL_NEIGHBOR_ALLTOALLW,
+    COLL_KINDS
+};
+
+/* Bus bandwidth correction factors, see the nccl-tests PERFORMANCE.md:
+ * a ring allreduce moves 2(n-1)/n of the buffer over every link,
+ * allgather, alltoall and reduce_scatter move (n-1)/n of the total. */
+enum { BUS_ONE, BUS_ALLREDUCE, BUS_SPREAD };
+
+typedef struct {
+    const char *name;
+    int bus;
+} coll_info;
+
+const coll_info COLL_INFO[COLL_KINDS] = {
+    [COLL_BCAST] = {"Bcast", BUS_ONE},
+    [COLL_REDUCE] = {"Reduce", BUS_ONE},
+    [COLL_ALLREDUCE] = {"Allreduce", BUS_ALLREDUCE},
+    [COLL_ALLGATHER] = {"Allgather", BUS_SPREAD},
+    [COLL_ALLGATHERV] = {"Allgatherv", BUS_SPREAD},
+    [COLL_ALLTOALL] = {"Alltoall", BUS_SPREAD},
+    [COLL_ALLTOALLV] = {"Alltoallv", BUS_SPREAD},
+    [COLL_ALLTOALLW] = {"Alltoallw", BUS_SPREAD},
+    [COLL_GATHER] = {"Gather", BUS_SPREAD},
+    [COLL_GATHERV] = {"Gatherv", BUS_SPREAD},
+    [COLL_SCATTER] = {"Scatter", BUS_SPREAD},
+    [COLL_SCATTERV] = {"Scatterv", BUS_SPREAD},
+    [COLL_REDUCE_SCATTER] = {"Reduce_scatter", BUS_SPREAD},
+    [COLL_REDUCE_SCATTER_BLOCK] = {"Reduce_scatter_block", BUS_SPREAD},
+    [COLL_SCAN] = {"Scan", BUS_ONE},
+    [COLL_EXSCAN] = {"Exscan", BUS_ONE},
+    [COLL_NEIGHBOR_ALLGATHER] = {"Neighbor_allgather", BUS_ONE},
+    [COLL_NEIGHBOR_ALLGATHERV] = {"Neighbor_allgatherv", BUS_ONE},
+    [COLL_NEIGHBOR_ALLTOALL] = {"Neighbor_alltoall", BUS_ONE},
+    [COLL_NEIGHBOR_ALLTOALLV] = {"Neighbor_alltoallv", BUS_ONE},
+    [COLL_NEIGHBOR_ALLTOALLW] = {"Neighbor_alltoallw", BUS_ONE},
+};
+
+typedef struct {
+    uint64_t calls[COLL_KINDS];
+    uint64_t sent[COLL_KINDS];     // contributed from the send buffer
+    uint64_t received[COLL_KINDS]; // written to the receive buffer
+    double time[COLL_KINDS];
+    double bus_bytes[COLL_KINDS];
+    uint64_t sizes[COLL_KINDS][SIZE_BUCKETS]; // histogram of `size` below
+} coll_stats;
+
+coll_stats coll_op_stats;
+
+/* `size` is the operation size in the nccl-tests sense, `comm_size` the
+ * number of processes taking part. */
+static void coll_record(int op, MPI_Comm comm, int comm_size, uint64_t sent,
+                        uint64_t received, uint64_t size, double seconds) {
+    double factor = 1.0;
+    if (comm_size > 0 && COLL_INFO[op].bus == BUS_ALLREDUCE) {
+        factor = 2.0 * (comm_size - 1) / comm_size;
+    } else if (comm_size > 0 && COLL_INFO[op].bus == BUS_SPREAD) {
+        factor = (double)(comm_size - 1) / comm_size;
+    }
+    coll_op_stats.calls[op]++;
+    coll_op_stats.sent[op] += sent;
+    coll_op_stats.received[op] += received;
+    coll_op_stats.time[op] += seconds;
+    coll_op_stats.bus_bytes[op] += size * factor;
+    coll_op_stats.sizes[op][size_bucket(size)]++;
+    locality_record(TRAFFIC_COLL, comm_locality(comm), sent + received,
+                    seconds);
+}
+
+static uint64_t type_bytes(int count, MPI_Datatype datatype) {
+    int type_size;
+    if (PMPI_Type_size(datatype, &type_size) != MPI_SUCCESS) {
+        return 0;
+    }
+    return (uint64_t)count * type_size;
+}
+
+/* Sums a count array. The plain widening reduction is vectorized by the
+ * compiler at -O3, which matters for alltoallv on large communicators. */
+static uint64_t sum_counts(const int *counts, int n) {
+    int64_t total = 0;
+    for (int k = 0; k < n; k++) {
+        total += counts[k];
+    }
+    return (uint64_t)total;
+}
+
+/* Byte total of the per-peer counts of the w variants. Type sizes are
+ * looked up once per run of equal types, as most codes pass a single one. */
+static uint64_t sum_typed_counts(const int *counts,
+                                 const MPI_Datatype *types, int n) {
+    uint64_t total = 0;
+    int k = 0;
+    while (k < n) {
+        int run = k + 1;
+        while (run < n && types[run] == types[k]) {
+            run++;
+        }
+        int type_size;
+        if (PMPI_Type_size(types[k], &type_size) == MPI_SUCCESS) {
+            total += sum_counts(counts + k, run - k) * type_size;
+        }
+        k = run;
+    }
+    return total;
+}
+
+/* Number of processes in `comm` and number of peers a rooted or all-to-all
+ * collective exchanges data with; the latter is the remote group size of an
+ * intercommunicator. */
+static void coll_comm_sizes(MPI_Comm comm, int *size, int *peers) {
+    int is_inter = 0;
+    PMPI_Comm_size(comm, size);
+    PMPI_Comm_test_inter(comm, &is_inter);
+    if (is_inter) {
+        PMPI_Comm_remote_size(comm, peers);
+    } else {
+        *peers = *size;
+    }
+}
+
+static int coll_is_root(MPI_Comm comm, int root) {
+    int rank;
+    if (root == MPI_ROOT) {
+        return 1;
+    }
+    if (root == MPI_PROC_NULL || PMPI_Comm_rank(comm, &rank) != MPI_SUCCESS) {
+        return 0;
+    }
+    int is_inter = 0;
+    PMPI_Comm_test_inter(comm, &is_inter);
+    return !is_inter && rank == root;
+}
+
+/* In- and out-degree of a process topology, 0 if `comm` has none. */
+static void neighbor_degrees(MPI_Comm comm, int *indegree, int *outdegree) {
+    int topology = MPI_UNDEFINED;
+    *indegree = 0;
+    *outdegree = 0;
+    PMPI_Topo_test(comm, &topology);
+    if (topology == MPI_CART) {
+        int ndims;
+        PMPI_Cartdim_get(comm, &ndims);
+        *indegree = *outdegree = 2 * ndims;
+    } else if (topology == MPI_GRAPH) {
+        int rank, neighbors;
+        PMPI_Comm_rank(comm, &rank);
+        PMPI_Graph_neighbors_count(comm, rank, &neighbors);
+        *indegree = *outdegree = neighbors;
+    } else if (topology == MPI_DIST_GRAPH) {
+        int weighted;
+        PMPI_Dist_graph_neighbors_count(comm, indegree, outdegree, &weighted);
+    }
+}
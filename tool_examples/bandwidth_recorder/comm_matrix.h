@@ -0,0 +1,174 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "key_map.h"
+#include "locality.h"
+
+/* Sparse row of the rank-to-rank communication matrix. Only the peers this
+ * rank actually sent to get a slot, so memory is O(peers), never O(N). */
+
+#define CSR_MAGIC "QMPICSR1"
+
+typedef struct {
+    int dest; // world rank
+    uint64_t bytes;
+    uint64_t messages;
+} matrix_entry;
+
+typedef struct {
+    key_map ids; // dest + 1 -> index + 1
+    size_t len, capacity;
+    matrix_entry *entries;
+} matrix_row;
+
+matrix_row comm_row = {{0, 0, NULL}, 0, 0, NULL};
+
+static void matrix_row_add(matrix_row *row, int dest, uint64_t bytes) {
+    key_map_entry *e =
+        key_map_get(&row->ids, (uint64_t)(uint32_t)dest + 1, 0);
+    if (e == NULL) {
+        return;
+    }
+    if (e->value == 0) {
+        if (!reserve((void **)&row->entries, &row->capacity, row->len,
+                     sizeof(matrix_entry))) {
+            key_map_remove(&row->ids, e);
+            return;
+        }
+        matrix_entry *m = &row->entries[row->len];
+        m->dest = dest;
+        m->bytes = 0;
+        m->messages = 0;
+        e->value = ++row->len;
+    }
+    matrix_entry *m = &row->entries[e->value - 1];
+    m->bytes += bytes;
+    m->messages++;
+}
+
+static int matrix_entry_cmp(const void *a, const void *b) {
+    int da = ((const matrix_entry *)a)->dest;
+    int db = ((const matrix_entry *)b)->dest;
+    return (da > db) - (da < db);
+}
+
+/* Sorts the entries by destination, as required for the column indices of
+ * a CSR row, and drops the index. Returns the number of entries. The row
+ * must not be updated afterwards. */
+static size_t matrix_row_compact(matrix_row *row) {
+    qsort(row->entries, row->len, sizeof(matrix_entry), matrix_entry_cmp);
+    key_map_free(&row->ids);
+    return row->len;
+}
+
+/* ---- communicator rank -> world rank translation ---- */
+
+/* Cached as a communicator attribute, so the table is built once per
+ * communicator and released by MPI when the communicator is freed. */
+typedef struct {
+    int size;
+    int locality; // LOC_* class of the peers in world_ranks
+    int world_ranks[];
+} rank_table;
+
+int rank_table_keyval = MPI_KEYVAL_INVALID;
+
+static int rank_table_delete(MPI_Comm comm, int keyval, void *attribute_val,
+                             void *extra_state) {
+    free(attribute_val);
+    return MPI_SUCCESS;
+}
+
+static rank_table *rank_table_build(MPI_Comm comm) {
+    int is_inter;
+    MPI_Group group, world_group;
+
+    // peers of an intercommunicator live in the remote group
+    PMPI_Comm_test_inter(comm, &is_inter);
+    if (is_inter) {
+        PMPI_Comm_remote_group(comm, &group);
+    } else {
+        PMPI_Comm_group(comm, &group);
+    }
+    PMPI_Comm_group(MPI_COMM_WORLD, &world_group);
+
+    int size;
+    PMPI_Group_size(group, &size);
+    rank_table *table = malloc(sizeof(rank_table) + size * sizeof(int));
+    int *ranks = malloc(size * sizeof(int));
+    if (table != NULL && ranks != NULL) {
+        table->size = size;
+        for (int r = 0; r < size; r++) {
+            ranks[r] = r;
+        }
+        PMPI_Group_translate_ranks(group, size, ranks, world_group,
+                                   table->world_ranks);
+        int self;
+        PMPI_Comm_rank(MPI_COMM_WORLD, &self);
+        table->locality = locality_of_peers(table->world_ranks, size, self);
+    } else {
+        free(table);
+        table = NULL;
+    }
+    free(ranks);
+
+    PMPI_Group_free(&group);
+    PMPI_Group_free(&world_group);
+    return table;
+}
+
+/* Returns the cached table of `comm`, building it on first use. */
+static rank_table *rank_table_get(MPI_Comm comm) {
+    if (rank_table_keyval == MPI_KEYVAL_INVALID &&
+        PMPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, rank_table_delete,
+                                &rank_table_keyval, NULL) != MPI_SUCCESS) {
+        return NULL;
+    }
+
+    rank_table *table = NULL;
+    int found = 0;
+    PMPI_Comm_get_attr(comm, rank_table_keyval, &table, &found);
+    if (!found) {
+        table = rank_table_build(comm);
+        if (table != NULL) {
+            PMPI_Comm_set_attr(comm, rank_table_keyval, table);
+        }
+    }
+    return table;
+}
+
+/* Returns the MPI_COMM_WORLD rank of `rank` in `comm`, or MPI_UNDEFINED if
+ * it has none (e.g. a process from a spawned world). */
+static int world_rank_of(MPI_Comm comm, int rank) {
+    if (comm == MPI_COMM_WORLD) {
+        return rank;
+    }
+
+    rank_table *table = rank_table_get(comm);
+    if (table == NULL || rank < 0 || rank >= table->size) {
+        return MPI_UNDEFINED;
+    }
+    return table->world_ranks[rank];
+}
+
+/* LOC_* class of the traffic of a collective on `comm`. */
+static int comm_locality(MPI_Comm comm) {
+    if (comm == MPI_COMM_WORLD) {
+        return world_locality;
+    }
+    rank_table *table = rank_table_get(comm);
+    return table != NULL ? table->locality : LOC_MIXED;
+}
+
+/* LOC_* class of the traffic with `rank` in `comm`. A wildcard receive gets
+ * the class of the whole communicator. */
+static int peer_locality(MPI_Comm comm, int rank) {
+    if (rank == MPI_ANY_SOURCE) {
+        return comm_locality(comm);
+    }
+    return on_my_node(world_rank_of(comm, rank)) ? LOC_NODE : LOC_CROSS;
+}
@@ -1,15 +1,15 @@
 #pragma once
 
-#include <signal.h>
-#include <stdalign.h>
-
-_Static_assert(sizeof(sig_atomic_t) == sizeof(int),
-               "sig_atomic_t has to be int for MPI to work!");
-_Static_assert(alignof(sig_atomic_t) == alignof(int),
-               "sig_atomic_t has to be int for MPI to work!");
+#include <stdint.h>
 
+/* Element counts per primitive class, in the PRIM_* order of
+ * datatype_layout.h: one block each for sent, received and reduced data. */
 #define COUNTERS_LEN 21
-int _Atomic counters[COUNTERS_LEN] = {0};
+uint64_t _Atomic counters[COUNTERS_LEN] = {0};
+
+#define SEND_COUNTERS (&counters[0])
+#define RECV_COUNTERS (&counters[7])
+#define RDC_COUNTERS (&counters[14])
 
 #define I8_SEND_COUNT counters[0]
 #define I16_SEND_COUNT counters[1]
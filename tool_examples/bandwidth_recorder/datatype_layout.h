@@ -0,0 +1,248 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Decomposition of datatypes into counts of the primitive classes the
+ * counters track. Derived types are decoded once at commit time with
+ * MPI_Type_get_envelope/MPI_Type_get_contents and the result is cached as a
+ * datatype attribute, so accounting a call is a multiply-add over at most
+ * PRIM_KINDS entries. */
+
+enum {
+    PRIM_I8,
+    PRIM_I16,
+    PRIM_I32,
+    PRIM_I64,
+    PRIM_FLOAT,
+    PRIM_DOUBLE,
+    PRIM_INT,
+    PRIM_KINDS
+};
+
+const unsigned PRIM_SIZE[PRIM_KINDS] = {
+    [PRIM_I8] = 1,    [PRIM_I16] = 2,    [PRIM_I32] = 4,
+    [PRIM_I64] = 8,   [PRIM_FLOAT] = 4,  [PRIM_DOUBLE] = 8,
+    [PRIM_INT] = sizeof(int),
+};
+
+typedef struct {
+    int len;
+    struct {
+        int prim;
+        uint64_t count; // elements of `prim` per element of the type
+    } parts[PRIM_KINDS];
+} type_layout;
+
+int type_layout_keyval = MPI_KEYVAL_INVALID;
+
+/* Primitive class of a predefined type, -1 if it is not tracked. Handles
+ * are compared one by one since they are pointers in some MPIs. */
+static int named_prim(MPI_Datatype t) {
+    if (t == MPI_UINT8_T || t == MPI_INT8_T || t == MPI_CHAR ||
+        t == MPI_UNSIGNED_CHAR || t == MPI_SIGNED_CHAR || t == MPI_BYTE) {
+        return PRIM_I8;
+    }
+    if (t == MPI_UINT16_T || t == MPI_INT16_T) {
+        return PRIM_I16;
+    }
+    if (t == MPI_UINT32_T || t == MPI_INT32_T) {
+        return PRIM_I32;
+    }
+    if (t == MPI_UINT64_T || t == MPI_INT64_T) {
+        return PRIM_I64;
+    }
+    if (t == MPI_INT || t == MPI_UNSIGNED) {
+        return PRIM_INT;
+    }
+    if (t == MPI_FLOAT) {
+        return PRIM_FLOAT;
+    }
+    if (t == MPI_DOUBLE) {
+        return PRIM_DOUBLE;
+    }
+    return -1;
+}
+
+static void layout_add(type_layout *layout, int prim, uint64_t count) {
+    for (int k = 0; k < layout->len; k++) {
+        if (layout->parts[k].prim == prim) {
+            layout->parts[k].count += count;
+            return;
+        }
+    }
+    layout->parts[layout->len].prim = prim;
+    layout->parts[layout->len].count = count;
+    layout->len++;
+}
+
+static void layout_decode(MPI_Datatype t, uint64_t multiplier,
+                          type_layout *layout);
+
+/* Counts `multiplier` elements of `t` by its size, for the constructors
+ * whose element count is not a simple function of their arguments. */
+static void layout_decode_by_size(MPI_Datatype t, MPI_Datatype oldtype,
+                                  uint64_t multiplier, type_layout *layout) {
+    int size, old_size;
+    if (PMPI_Type_size(t, &size) == MPI_SUCCESS &&
+        PMPI_Type_size(oldtype, &old_size) == MPI_SUCCESS && old_size > 0) {
+        layout_decode(oldtype, multiplier * (size / old_size), layout);
+    }
+}
+
+static void layout_decode(MPI_Datatype t, uint64_t multiplier,
+                          type_layout *layout) {
+    int num_ints, num_addrs, num_types, combiner;
+    if (multiplier == 0 ||
+        PMPI_Type_get_envelope(t, &num_ints, &num_addrs, &num_types,
+                               &combiner) != MPI_SUCCESS) {
+        return;
+    }
+    if (combiner == MPI_COMBINER_NAMED) {
+        int prim = named_prim(t);
+        if (prim >= 0) {
+            layout_add(layout, prim, multiplier);
+        }
+        return;
+    }
+
+    int *ints = malloc((num_ints + 1) * sizeof(int));
+    MPI_Aint *addrs = malloc((num_addrs + 1) * sizeof(MPI_Aint));
+    MPI_Datatype *types = malloc((num_types + 1) * sizeof(MPI_Datatype));
+    if (ints == NULL || addrs == NULL || types == NULL ||
+        PMPI_Type_get_contents(t, num_ints, num_addrs, num_types, ints, addrs,
+                               types) != MPI_SUCCESS) {
+        free(ints);
+        free(addrs);
+        free(types);
+        return;
+    }
+
+    switch (combiner) {
+    case MPI_COMBINER_DUP:
+    case MPI_COMBINER_RESIZED:
+        layout_decode(types[0], multiplier, layout);
+        break;
+    case MPI_COMBINER_CONTIGUOUS:
+        layout_decode(types[0], multiplier * ints[0], layout);
+        break;
+    case MPI_COMBINER_VECTOR:
+    case MPI_COMBINER_HVECTOR:
+    case MPI_COMBINER_INDEXED_BLOCK:
+    case MPI_COMBINER_HINDEXED_BLOCK:
+        layout_decode(types[0], multiplier * ints[0] * ints[1], layout);
+        break;
+    case MPI_COMBINER_INDEXED:
+    case MPI_COMBINER_HINDEXED: {
+        uint64_t elements = 0;
+        for (int k = 0; k < ints[0]; k++) {
+            elements += ints[1 + k];
+        }
+        layout_decode(types[0], multiplier * elements, layout);
+        break;
+    }
+    case MPI_COMBINER_STRUCT:
+        for (int k = 0; k < ints[0]; k++) {
+            layout_decode(types[k], multiplier * ints[1 + k], layout);
+        }
+        break;
+    case MPI_COMBINER_SUBARRAY: {
+        int ndims = ints[0];
+        uint64_t elements = 1;
+        for (int k = 0; k < ndims; k++) {
+            elements *= ints[1 + ndims + k];
+        }
+        layout_decode(types[0], multiplier * elements, layout);
+        break;
+    }
+    default:
+        // darray and the Fortran parameterized types
+        if (num_types > 0) {
+            layout_decode_by_size(t, types[0], multiplier, layout);
+        }
+        break;
+    }
+
+    // derived types returned by get_contents are new handles to be freed
+    for (int k = 0; k < num_types; k++) {
+        int ni, na, nt, c;
+        PMPI_Type_get_envelope(types[k], &ni, &na, &nt, &c);
+        if (c != MPI_COMBINER_NAMED) {
+            PMPI_Type_free(&types[k]);
+        }
+    }
+    free(ints);
+    free(addrs);
+    free(types);
+}
+
+static int type_layout_copy(MPI_Datatype oldtype, int keyval,
+                            void *extra_state, void *attribute_val_in,
+                            void *attribute_val_out, int *flag) {
+    type_layout *copy = malloc(sizeof(type_layout));
+    *flag = copy != NULL;
+    if (copy != NULL) {
+        *copy = *(type_layout *)attribute_val_in;
+        *(type_layout **)attribute_val_out = copy;
+    }
+    return MPI_SUCCESS;
+}
+
+static int type_layout_delete(MPI_Datatype type, int keyval,
+                              void *attribute_val, void *extra_state) {
+    free(attribute_val);
+    return MPI_SUCCESS;
+}
+
+/* Decodes `t` and caches the result on it. Called at commit time. */
+static type_layout *type_layout_cache(MPI_Datatype t) {
+    if (type_layout_keyval == MPI_KEYVAL_INVALID &&
+        PMPI_Type_create_keyval(type_layout_copy, type_layout_delete,
+                                &type_layout_keyval, NULL) != MPI_SUCCESS) {
+        return NULL;
+    }
+    type_layout *layout = malloc(sizeof(type_layout));
+    if (layout == NULL) {
+        return NULL;
+    }
+    layout->len = 0;
+    layout_decode(t, 1, layout);
+    if (PMPI_Type_set_attr(t, type_layout_keyval, layout) != MPI_SUCCESS) {
+        free(layout);
+        return NULL;
+    }
+    return layout;
+}
+
+/* Adds `count` elements of `t` to counters[0..PRIM_KINDS). */
+static void type_layout_account(MPI_Datatype t, uint64_t count,
+                                uint64_t _Atomic counters[PRIM_KINDS]) {
+    int prim = named_prim(t);
+    if (prim >= 0) {
+        counters[prim] += count;
+        return;
+    }
+
+    type_layout *layout = NULL;
+    int found = 0;
+    if (type_layout_keyval != MPI_KEYVAL_INVALID) {
+        PMPI_Type_get_attr(t, type_layout_keyval, &layout, &found);
+    }
+    if (!found) {
+        // committed before the tool saw it, or an untracked predefined type
+        int ni, na, nt, combiner;
+        if (PMPI_Type_get_envelope(t, &ni, &na, &nt, &combiner) !=
+                MPI_SUCCESS ||
+            combiner == MPI_COMBINER_NAMED) {
+            return;
+        }
+        layout = type_layout_cache(t);
+        if (layout == NULL) {
+            return;
+        }
+    }
+    for (int k = 0; k < layout->len; k++) {
+        counters[layout->parts[k].prim] += count * layout->parts[k].count;
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Classifies traffic as node-local (shared memory), cross-node (network) or
+ * mixed. The processes sharing this node are found once at init with
+ * MPI_Comm_split_type and kept as a sorted list of world ranks. */
+
+enum { LOC_NODE, LOC_CROSS, LOC_MIXED, LOC_KINDS };
+
+const char *LOC_NAMES[LOC_KINDS] = {"node-local", "cross-node", "mixed"};
+
+enum { TRAFFIC_P2P, TRAFFIC_COLL, TRAFFIC_KINDS };
+
+const char *TRAFFIC_NAMES[TRAFFIC_KINDS] = {"Point-to-point", "Collective"};
+
+typedef struct {
+    uint64_t calls[LOC_KINDS];
+    uint64_t bytes[LOC_KINDS];
+    double time[LOC_KINDS];
+} loc_stats;
+
+loc_stats traffic_locality[TRAFFIC_KINDS];
+
+int *node_world_ranks = NULL;
+int node_size = 0;
+int world_locality = LOC_MIXED;
+
+static int int_cmp(const void *a, const void *b) {
+    int ia = *(const int *)a, ib = *(const int *)b;
+    return (ia > ib) - (ia < ib);
+}
+
+/* Collective over MPI_COMM_WORLD, called right after MPI is initialized. */
+static void locality_init(void) {
+    MPI_Comm node_comm;
+    if (PMPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+                             MPI_INFO_NULL, &node_comm) != MPI_SUCCESS) {
+        return;
+    }
+
+    MPI_Group node_group, world_group;
+    PMPI_Comm_group(node_comm, &node_group);
+    PMPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    PMPI_Group_size(node_group, &node_size);
+
+    int *ranks = malloc(node_size * sizeof(int));
+    node_world_ranks = malloc(node_size * sizeof(int));
+    if (ranks != NULL && node_world_ranks != NULL) {
+        for (int r = 0; r < node_size; r++) {
+            ranks[r] = r;
+        }
+        PMPI_Group_translate_ranks(node_group, node_size, ranks, world_group,
+                                   node_world_ranks);
+        qsort(node_world_ranks, node_size, sizeof(int), int_cmp);
+
+        int world_size;
+        PMPI_Comm_size(MPI_COMM_WORLD, &world_size);
+        world_locality = node_size == world_size ? LOC_NODE
+                         : node_size == 1        ? LOC_CROSS
+                                                 : LOC_MIXED;
+    } else {
+        free(node_world_ranks);
+        node_world_ranks = NULL;
+        node_size = 0;
+    }
+    free(ranks);
+
+    PMPI_Group_free(&node_group);
+    PMPI_Group_free(&world_group);
+    PMPI_Comm_free(&node_comm);
+}
+
+static int on_my_node(int world_rank) {
+    return node_world_ranks != NULL && world_rank != MPI_UNDEFINED &&
+           bsearch(&world_rank, node_world_ranks, node_size, sizeof(int),
+                   int_cmp) != NULL;
+}
+
+/* Class of the traffic between this process and the given peers; `self` is
+ * skipped so that a communicator of one node counts as node-local. */
+static int locality_of_peers(const int world_ranks[], int size, int self) {
+    int local = 0, remote = 0;
+    for (int r = 0; r < size; r++) {
+        if (world_ranks[r] == self) {
+            continue;
+        }
+        if (on_my_node(world_ranks[r])) {
+            local++;
+        } else {
+            remote++;
+        }
+    }
+    return remote == 0 ? LOC_NODE : local == 0 ? LOC_CROSS : LOC_MIXED;
+}
+
+static void locality_record(int traffic, int loc, uint64_t bytes,
+                            double seconds) {
+    loc_stats *s = &traffic_locality[traffic];
+    s->calls[loc]++;
+    s->bytes[loc] += bytes;
+    s->time[loc] += seconds;
+}
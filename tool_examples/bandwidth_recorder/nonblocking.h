@@ -0,0 +1,186 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "key_map.h"
+#include "locality.h"
+#include "point_to_point.h"
+#include "size_bucket.h"
+
+/* Outstanding nonblocking point-to-point requests, timed from the post
+ * until a Wait or Test call reports their completion. Completions seen by
+ * Test are only as precise as the application's polling. */
+
+enum { NB_SEND = 0, NB_RECV = 1, NB_KINDS };
+
+typedef struct {
+    MPI_Request request;
+    int kind;
+    int locality;
+    uint64_t bytes;
+    double posted;
+} nb_entry;
+
+typedef struct {
+    uint64_t count[SIZE_BUCKETS];
+    uint64_t bytes[SIZE_BUCKETS];
+    double time[SIZE_BUCKETS];    // post to observed completion
+    double blocked[SIZE_BUCKETS]; // spent inside the completing call
+} nb_stats;
+
+key_map outstanding_ids = {0, 0, NULL}; // request handle -> index + 1
+struct {
+    size_t len, capacity;
+    nb_entry *entries;
+} outstanding = {0, 0, NULL};
+nb_stats nb_bucket_stats[NB_KINDS];
+
+static uint64_t nb_key(MPI_Request request) {
+    // handles are ints in some MPIs and pointers in others
+    uint64_t key = 0;
+    memcpy(&key, &request,
+           sizeof(request) < sizeof(key) ? sizeof(request) : sizeof(key));
+    return key + 1;
+}
+
+static void nb_post(int kind, int locality, MPI_Request request,
+                    uint64_t bytes) {
+    if (request == MPI_REQUEST_NULL) {
+        return;
+    }
+    key_map_entry *e = key_map_get(&outstanding_ids, nb_key(request), 0);
+    if (e == NULL) {
+        return;
+    }
+    if (e->value == 0) {
+        if (!reserve((void **)&outstanding.entries, &outstanding.capacity,
+                     outstanding.len, sizeof(nb_entry))) {
+            key_map_remove(&outstanding_ids, e);
+            return;
+        }
+        e->value = ++outstanding.len;
+    }
+    nb_entry *n = &outstanding.entries[e->value - 1];
+    n->request = request;
+    n->kind = kind;
+    n->locality = locality;
+    n->bytes = bytes;
+    n->posted = PMPI_Wtime();
+}
+
+/* Removes the entry for `request` and copies it to `out`. The last entry
+ * moves into its place, so the array stays dense. */
+static int nb_remove(MPI_Request request, nb_entry *out) {
+    if (outstanding.len == 0 || request == MPI_REQUEST_NULL) {
+        return 0;
+    }
+    key_map_entry *e = key_map_find(&outstanding_ids, nb_key(request), 0);
+    if (e == NULL) {
+        return 0;
+    }
+    size_t k = e->value - 1;
+    *out = outstanding.entries[k];
+    key_map_remove(&outstanding_ids, e);
+
+    if (k != --outstanding.len) {
+        outstanding.entries[k] = outstanding.entries[outstanding.len];
+        key_map_find(&outstanding_ids,
+                     nb_key(outstanding.entries[k].request), 0)
+            ->value = k + 1;
+    }
+    return 1;
+}
+
+/* Accounts the completion of `request` observed at `now` by a call that
+ * blocked for `blocked` seconds. */
+static void nb_complete(MPI_Request request, const MPI_Status *status,
+                        double now, double blocked) {
+    nb_entry e;
+    if (!nb_remove(request, &e)) {
+        return;
+    }
+
+    // a receive may match a message shorter than its buffer
+    if (e.kind == NB_RECV && status != MPI_STATUS_IGNORE) {
+        int received;
+        if (PMPI_Get_count(status, MPI_BYTE, &received) == MPI_SUCCESS &&
+            received != MPI_UNDEFINED) {
+            e.bytes = received;
+        }
+        p2p_record(P2P_IRECV, e.bytes);
+    }
+
+    double elapsed = now - e.posted;
+    unsigned b = size_bucket(e.bytes);
+    nb_stats *s = &nb_bucket_stats[e.kind];
+    s->count[b]++;
+    s->bytes[b] += e.bytes;
+    s->time[b] += elapsed;
+    s->blocked[b] += blocked < elapsed ? blocked : elapsed;
+    locality_record(TRAFFIC_P2P, e.locality, e.bytes, elapsed);
+}
+
+static void nb_forget(MPI_Request request) {
+    nb_entry e;
+    nb_remove(request, &e);
+}
+
+/* ---- request snapshots for the completion calls ---- */
+
+#define NB_STACK_LEN 32
+
+/* Wait/Test calls overwrite completed handles with MPI_REQUEST_NULL, so the
+ * handles are copied before the call. Statuses are redirected to a local
+ * array when the application passes MPI_STATUSES_IGNORE. */
+typedef struct {
+    MPI_Request *requests;
+    MPI_Status *statuses;
+    int requests_owned;
+    int statuses_owned;
+    MPI_Request request_buf[NB_STACK_LEN];
+    MPI_Status status_buf[NB_STACK_LEN];
+} nb_snapshot;
+
+/* `statuses` is the application's status array; `has_statuses` is 0 for
+ * the calls that only return a single status. Returns 0 if memory could
+ * not be allocated. */
+static int nb_snapshot_take(nb_snapshot *snap, int count,
+                            const MPI_Request requests[], MPI_Status *statuses,
+                            int has_statuses) {
+    snap->requests_owned = count > NB_STACK_LEN;
+    snap->requests = snap->requests_owned
+                         ? malloc(count * sizeof(MPI_Request))
+                         : snap->request_buf;
+    snap->statuses_owned = 0;
+    snap->statuses = statuses;
+    if (has_statuses && statuses == MPI_STATUSES_IGNORE) {
+        snap->statuses_owned = count > NB_STACK_LEN;
+        snap->statuses = snap->statuses_owned
+                             ? malloc(count * sizeof(MPI_Status))
+                             : snap->status_buf;
+    }
+    if (snap->requests == NULL ||
+        (snap->statuses_owned && snap->statuses == NULL)) {
+        if (snap->requests_owned) {
+            free(snap->requests);
+        }
+        if (snap->statuses_owned) {
+            free(snap->statuses);
+        }
+        return 0;
+    }
+    memcpy(snap->requests, requests, count * sizeof(MPI_Request));
+    return 1;
+}
+
+static void nb_snapshot_release(nb_snapshot *snap) {
+    if (snap->requests_owned) {
+        free(snap->requests);
+    }
+    if (snap->statuses_owned) {
+        free(snap->statuses);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "size_bucket.h"
+
+/* Per-function message size histograms of the point-to-point calls. Receives
+ * are recorded with the matched message size, not the buffer size. */
+
+enum {
+    P2P_SEND,
+    P2P_BSEND,
+    P2P_RSEND,
+    P2P_SSEND,
+    P2P_ISEND,
+    P2P_IBSEND,
+    P2P_IRSEND,
+    P2P_ISSEND,
+    P2P_RECV,
+    P2P_IRECV,
+    P2P_SENDRECV,
+    P2P_SENDRECV_REPLACE,
+    P2P_KINDS
+};
+
+const char *P2P_NAMES[P2P_KINDS] = {
+    [P2P_SEND] = "Send",
+    [P2P_BSEND] = "Bsend",
+    [P2P_RSEND] = "Rsend",
+    [P2P_SSEND] = "Ssend",
+    [P2P_ISEND] = "Isend",
+    [P2P_IBSEND] = "Ibsend",
+    [P2P_IRSEND] = "Irsend",
+    [P2P_ISSEND] = "Issend",
+    [P2P_RECV] = "Recv",
+    [P2P_IRECV] = "Irecv",
+    [P2P_SENDRECV] = "Sendrecv",
+    [P2P_SENDRECV_REPLACE] = "Sendrecv_replace",
+};
+
+uint64_t p2p_size_hist[P2P_KINDS][SIZE_BUCKETS];
+
+static inline void p2p_record(int fn, uint64_t bytes) {
+    p2p_size_hist[fn][size_bucket(bytes)]++;
+}
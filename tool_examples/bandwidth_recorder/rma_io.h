@@ -0,0 +1,260 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* One-sided and file traffic, accounted per window and per file handle.
+ * A window's intervals are its access epochs (fence to fence, lock to
+ * unlock, start to complete); a file's interval is open to close. When a
+ * window is freed or a file closed its record moves to a closed list that
+ * is reported at finalize. */
+
+enum { RES_WIN, RES_FILE, RES_KINDS };
+
+#define RES_NAME_LEN 64
+
+typedef struct {
+    char name[RES_NAME_LEN];
+    int kind;
+    int seq;   // k-th window or file opened by this rank
+    int ranks; // that opened it, 1 until records are merged
+    uint64_t ops;
+    uint64_t bytes_out; // put and accumulate origin data, file writes
+    uint64_t bytes_in;  // get and fetch results, file reads
+    uint64_t intervals;
+    uint64_t max_interval_bytes;
+    double call_time;     // inside the data movement and sync calls
+    double interval_time; // summed length of the intervals
+} res_stats;
+
+typedef struct {
+    MPI_Win win;
+    MPI_File fh;
+    res_stats stats;
+    int in_interval;
+    int lock_depth;
+    double interval_start;
+    uint64_t interval_bytes;
+} res_slot;
+
+typedef struct {
+    size_t capacity;
+    size_t len;
+    res_slot *slots;
+} res_table;
+
+typedef struct {
+    size_t capacity;
+    size_t len;
+    res_stats *records;
+} res_list;
+
+// windows and files are few, so a linear scan with a last-hit cache is enough
+res_table open_res = {0, 0, NULL};
+res_list closed_res = {0, 0, NULL};
+int res_opened[RES_KINDS] = {0};
+size_t res_last_hit = 0;
+
+static res_slot *win_slot(MPI_Win win) {
+    if (res_last_hit < open_res.len &&
+        open_res.slots[res_last_hit].stats.kind == RES_WIN &&
+        open_res.slots[res_last_hit].win == win) {
+        return &open_res.slots[res_last_hit];
+    }
+    for (size_t k = 0; k < open_res.len; k++) {
+        if (open_res.slots[k].stats.kind == RES_WIN &&
+            open_res.slots[k].win == win) {
+            res_last_hit = k;
+            return &open_res.slots[k];
+        }
+    }
+    return NULL;
+}
+
+static res_slot *file_slot(MPI_File fh) {
+    if (res_last_hit < open_res.len &&
+        open_res.slots[res_last_hit].stats.kind == RES_FILE &&
+        open_res.slots[res_last_hit].fh == fh) {
+        return &open_res.slots[res_last_hit];
+    }
+    for (size_t k = 0; k < open_res.len; k++) {
+        if (open_res.slots[k].stats.kind == RES_FILE &&
+            open_res.slots[k].fh == fh) {
+            res_last_hit = k;
+            return &open_res.slots[k];
+        }
+    }
+    return NULL;
+}
+
+static res_slot *res_open(int kind, const char *name) {
+    if (open_res.len == open_res.capacity) {
+        size_t capacity = open_res.capacity == 0 ? 8 : 2 * open_res.capacity;
+        res_slot *slots = realloc(open_res.slots, capacity * sizeof(res_slot));
+        if (slots == NULL) {
+            return NULL;
+        }
+        open_res.slots = slots;
+        open_res.capacity = capacity;
+    }
+    res_slot *slot = &open_res.slots[open_res.len++];
+    memset(slot, 0, sizeof(res_slot));
+    slot->win = MPI_WIN_NULL;
+    slot->fh = MPI_FILE_NULL;
+    slot->stats.kind = kind;
+    slot->stats.seq = res_opened[kind]++;
+    slot->stats.ranks = 1;
+    if (name != NULL && name[0] != '\0') {
+        snprintf(slot->stats.name, RES_NAME_LEN, "%s", name);
+    } else {
+        snprintf(slot->stats.name, RES_NAME_LEN, "%s %d",
+                 kind == RES_WIN ? "window" : "file", slot->stats.seq);
+    }
+    return slot;
+}
+
+static void res_interval_begin(res_slot *slot) {
+    if (!slot->in_interval) {
+        slot->in_interval = 1;
+        slot->interval_start = PMPI_Wtime();
+        slot->interval_bytes = 0;
+    }
+}
+
+static void res_interval_end(res_slot *slot) {
+    if (slot->in_interval) {
+        slot->in_interval = 0;
+        slot->stats.intervals++;
+        slot->stats.interval_time += PMPI_Wtime() - slot->interval_start;
+        if (slot->interval_bytes > slot->stats.max_interval_bytes) {
+            slot->stats.max_interval_bytes = slot->interval_bytes;
+        }
+    }
+}
+
+/* Ends the slot's interval and moves its record to the closed list. */
+static void res_close(res_slot *slot) {
+    res_interval_end(slot);
+    if (closed_res.len == closed_res.capacity) {
+        size_t capacity =
+            closed_res.capacity == 0 ? 8 : 2 * closed_res.capacity;
+        res_stats *records =
+            realloc(closed_res.records, capacity * sizeof(res_stats));
+        if (records != NULL) {
+            closed_res.records = records;
+            closed_res.capacity = capacity;
+        }
+    }
+    if (closed_res.len < closed_res.capacity) {
+        closed_res.records[closed_res.len++] = slot->stats;
+    }
+    *slot = open_res.slots[--open_res.len];
+}
+
+static void res_record(res_slot *slot, uint64_t ops, uint64_t bytes_out,
+                       uint64_t bytes_in, double seconds) {
+    if (slot == NULL) {
+        return;
+    }
+    slot->stats.ops += ops;
+    slot->stats.bytes_out += bytes_out;
+    slot->stats.bytes_in += bytes_in;
+    slot->stats.call_time += seconds;
+    slot->interval_bytes += bytes_out + bytes_in;
+}
+
+/* ---- window epochs ---- */
+
+static void win_open(MPI_Win win) {
+    char name[MPI_MAX_OBJECT_NAME] = "";
+    int len = 0;
+    PMPI_Win_get_name(win, name, &len);
+    res_slot *slot = res_open(RES_WIN, name);
+    if (slot != NULL) {
+        slot->win = win;
+    }
+}
+
+static void win_close(MPI_Win win) {
+    res_slot *slot = win_slot(win);
+    if (slot != NULL) {
+        res_close(slot);
+    }
+}
+
+/* A fence ends the current epoch and, unless no RMA follows, opens the
+ * next one. */
+static void win_fence(MPI_Win win, int assert, double seconds) {
+    res_slot *slot = win_slot(win);
+    if (slot == NULL) {
+        return;
+    }
+    res_record(slot, 0, 0, 0, seconds);
+    res_interval_end(slot);
+    if (!(assert & MPI_MODE_NOSUCCEED)) {
+        res_interval_begin(slot);
+    }
+}
+
+/* Lock epochs to several targets nest; the window's epoch spans from the
+ * first lock to the last unlock. */
+static void win_epoch_begin(MPI_Win win, int locks, double seconds) {
+    res_slot *slot = win_slot(win);
+    if (slot == NULL) {
+        return;
+    }
+    res_record(slot, 0, 0, 0, seconds);
+    slot->lock_depth += locks;
+    res_interval_begin(slot);
+}
+
+static void win_epoch_end(MPI_Win win, int locks, double seconds) {
+    res_slot *slot = win_slot(win);
+    if (slot == NULL) {
+        return;
+    }
+    res_record(slot, 0, 0, 0, seconds);
+    slot->lock_depth -= locks;
+    if (slot->lock_depth <= 0) {
+        slot->lock_depth = 0;
+        res_interval_end(slot);
+    }
+}
+
+/* ---- file open/close intervals ---- */
+
+static void file_open(MPI_File fh, const char *filename) {
+    res_slot *slot = res_open(RES_FILE, filename);
+    if (slot != NULL) {
+        slot->fh = fh;
+        res_interval_begin(slot);
+    }
+}
+
+static void file_close(MPI_File fh) {
+    res_slot *slot = file_slot(fh);
+    if (slot != NULL) {
+        res_close(slot);
+    }
+}
+
+/* Closes the records of windows and files still open at finalize. */
+static void res_close_all(void) {
+    while (open_res.len > 0) {
+        res_close(&open_res.slots[open_res.len - 1]);
+    }
+}
+
+static int res_stats_cmp(const void *a, const void *b) {
+    const res_stats *ra = a, *rb = b;
+    if (ra->kind != rb->kind) {
+        return ra->kind - rb->kind;
+    }
+    if (ra->seq != rb->seq) {
+        return ra->seq - rb->seq;
+    }
+    return strcmp(ra->name, rb->name);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Identifies the application call that entered MPI by walking the stack
+ * past the frames of the tool and of the QMPI layer. Needs _GNU_SOURCE for
+ * dladdr and linking with -ldl. */
+
+#define CALLSITE_MAX_FRAMES 16
+#define CALLSITE_NAME_LEN 96
+
+static int is_interposed_frame(const char *name) {
+    return strncmp(name, "MPI_", 4) == 0 || strncmp(name, "PMPI_", 5) == 0 ||
+           strncmp(name, "E_", 2) == 0 || strncmp(name, "QMPI_", 5) == 0 ||
+           strcmp(name, "exec_func") == 0;
+}
+
+/* The first return address outside the tools and the QMPI layer. */
+static uintptr_t callsite_capture(void) {
+    void *frames[CALLSITE_MAX_FRAMES];
+    int depth = backtrace(frames, CALLSITE_MAX_FRAMES);
+    Dl_info self, info;
+    dladdr((void *)callsite_capture, &self);
+    for (int k = 1; k < depth; k++) {
+        if (dladdr(frames[k], &info) == 0) {
+            return (uintptr_t)frames[k];
+        }
+        if (info.dli_fbase == self.dli_fbase ||
+            (info.dli_sname != NULL && is_interposed_frame(info.dli_sname))) {
+            continue;
+        }
+        return (uintptr_t)frames[k];
+    }
+    return depth > 0 ? (uintptr_t)frames[depth - 1] : 1;
+}
+
+/* Names a callsite as symbol+offset, or object+offset without symbols, so
+ * that it means the same in every rank despite address randomization. */
+static void callsite_name(uintptr_t callsite, char *buf, size_t len) {
+    Dl_info info;
+    if (dladdr((void *)callsite, &info) == 0) {
+        snprintf(buf, len, "0x%lx", (unsigned long)callsite);
+    } else if (info.dli_sname != NULL) {
+        snprintf(buf, len, "%s+0x%lx", info.dli_sname,
+                 (unsigned long)(callsite - (uintptr_t)info.dli_saddr));
+    } else {
+        const char *object = strrchr(info.dli_fname, '/');
+        snprintf(buf, len, "%s+0x%lx",
+                 object != NULL ? object + 1 : info.dli_fname,
+                 (unsigned long)(callsite - (uintptr_t)info.dli_fbase));
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Cheap statistics over a payload sample. The zero and repeat counts are
+ * branch-free loops over bytes that the compiler turns into vector compares
+ * at -O3; the byte histogram uses four interleaved tables so consecutive
+ * equal bytes do not serialize on one counter. */
+
+#define LZ_HASH_BITS 12
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 65535
+#define LZ_MATCH_COST 3 // token and 16-bit offset, as in LZ4
+
+typedef struct {
+    uint64_t bytes;
+    uint64_t zeros;
+    uint64_t repeats;     // bytes equal to their predecessor
+    uint64_t lz_bytes;    // estimated size after LZ compression
+    double entropy_bits;  // order-0 entropy of the sample times its length
+} payload_stats;
+
+static uint64_t count_zero_bytes(const uint8_t *p, size_t n) {
+    uint64_t zeros = 0;
+    for (size_t k = 0; k < n; k++) {
+        zeros += p[k] == 0;
+    }
+    return zeros;
+}
+
+static uint64_t count_repeats(const uint8_t *p, size_t n) {
+    uint64_t repeats = 0;
+    for (size_t k = 1; k < n; k++) {
+        repeats += p[k] == p[k - 1];
+    }
+    return repeats;
+}
+
+static double entropy_bits(const uint8_t *p, size_t n) {
+    uint32_t hist[4][256];
+    memset(hist, 0, sizeof(hist));
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        hist[0][p[k]]++;
+        hist[1][p[k + 1]]++;
+        hist[2][p[k + 2]]++;
+        hist[3][p[k + 3]]++;
+    }
+    for (; k < n; k++) {
+        hist[0][p[k]]++;
+    }
+
+    // n * H = n log2 n - sum c log2 c
+    double bits = n > 0 ? n * log2((double)n) : 0.0;
+    for (int b = 0; b < 256; b++) {
+        uint32_t c = hist[0][b] + hist[1][b] + hist[2][b] + hist[3][b];
+        if (c > 0) {
+            bits -= c * log2((double)c);
+        }
+    }
+    return bits;
+}
+
+static uint32_t load_u32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/* Greedy single-probe LZ77 parse, the scheme of LZ4's fast mode: a literal
+ * costs one byte, a match of at least LZ_MIN_MATCH bytes LZ_MATCH_COST. */
+static uint64_t lz_estimate(const uint8_t *p, size_t n) {
+    static uint32_t table[1 << LZ_HASH_BITS];
+    if (n < LZ_MIN_MATCH) {
+        return n;
+    }
+    // positions are stored plus one so that zero marks an empty slot
+    memset(table, 0, sizeof(table));
+
+    uint64_t out = 0;
+    size_t k = 0;
+    while (k + LZ_MIN_MATCH <= n) {
+        uint32_t seq = load_u32(p + k);
+        uint32_t h = (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+        size_t candidate = table[h];
+        table[h] = (uint32_t)(k + 1);
+        if (candidate > 0 && k + 1 - candidate <= LZ_MAX_OFFSET &&
+            load_u32(p + candidate - 1) == seq) {
+            size_t len = LZ_MIN_MATCH;
+            while (k + len < n && p[candidate - 1 + len] == p[k + len]) {
+                len++;
+            }
+            out += LZ_MATCH_COST;
+            k += len;
+        } else {
+            out++;
+            k++;
+        }
+    }
+    return out + (n - k);
+}
+
+static void payload_analyze(const uint8_t *p, size_t n, payload_stats *s) {
+    s->bytes += n;
+    s->zeros += count_zero_bytes(p, n);
+    s->repeats += count_repeats(p, n);
+    s->entropy_bits += entropy_bits(p, n);
+    s->lz_bytes += lz_estimate(p, n);
+}
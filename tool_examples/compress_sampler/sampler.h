@@ -0,0 +1,208 @@
+#pragma once
+
+#include <mpi.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "callsite.h"
+#include "key_map.h"
+#include "payload_stats.h"
+#include "size_bucket.h"
+
+/* Samples a fraction of the send buffers. The wrapper only copies (or packs)
+ * a bounded prefix of the buffer into a job; the statistics are computed by
+ * a background thread, so the MPI call returns quickly. When the queue is
+ * full the sample is dropped rather than blocking the application. */
+
+#define SAMPLE_QUEUE_LEN 256
+#define SAMPLE_DEFAULT_RATE 0.01
+#define SAMPLE_DEFAULT_BYTES 65536
+
+typedef struct {
+    uintptr_t callsite;
+    unsigned bucket; // of the whole message, not of the sampled prefix
+    size_t len;
+    uint8_t data[];
+} sample_job;
+
+typedef struct {
+    uintptr_t callsite;
+    unsigned bucket;
+    uint64_t samples;
+    payload_stats stats;
+} sample_entry;
+
+/* Owned by the worker thread until it is joined at finalize. */
+key_map sample_ids = {0, 0, NULL}; // callsite and bucket -> index + 1
+struct {
+    size_t len, capacity;
+    sample_entry *entries;
+} sample_stats = {0, 0, NULL};
+
+struct {
+    pthread_mutex_t lock;
+    pthread_cond_t nonempty;
+    sample_job *jobs[SAMPLE_QUEUE_LEN];
+    size_t head, len;
+    int stop;
+} sample_queue = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER};
+
+pthread_t sample_worker;
+int sampler_state = 0; // 0 not started, 1 running, -1 disabled
+uint64_t sample_threshold;
+size_t sample_max_bytes;
+uint64_t sample_rng = 0x9E3779B97F4A7C15ull;
+uint64_t samples_taken = 0, samples_dropped = 0;
+
+static sample_entry *sample_table_get(uintptr_t callsite, unsigned bucket) {
+    key_map_entry *e = key_map_get(&sample_ids, callsite, bucket);
+    if (e == NULL) {
+        return NULL;
+    }
+    if (e->value == 0) {
+        if (!reserve((void **)&sample_stats.entries, &sample_stats.capacity,
+                     sample_stats.len, sizeof(sample_entry))) {
+            key_map_remove(&sample_ids, e);
+            return NULL;
+        }
+        sample_entry *s = &sample_stats.entries[sample_stats.len];
+        memset(s, 0, sizeof(sample_entry));
+        s->callsite = callsite;
+        s->bucket = bucket;
+        e->value = ++sample_stats.len;
+    }
+    return &sample_stats.entries[e->value - 1];
+}
+
+static void *sample_worker_main(void *arg) {
+    for (;;) {
+        pthread_mutex_lock(&sample_queue.lock);
+        while (sample_queue.len == 0 && !sample_queue.stop) {
+            pthread_cond_wait(&sample_queue.nonempty, &sample_queue.lock);
+        }
+        if (sample_queue.len == 0) {
+            pthread_mutex_unlock(&sample_queue.lock);
+            return NULL;
+        }
+        sample_job *job = sample_queue.jobs[sample_queue.head];
+        sample_queue.head = (sample_queue.head + 1) % SAMPLE_QUEUE_LEN;
+        sample_queue.len--;
+        pthread_mutex_unlock(&sample_queue.lock);
+
+        sample_entry *e = sample_table_get(job->callsite, job->bucket);
+        if (e != NULL) {
+            e->samples++;
+            payload_analyze(job->data, job->len, &e->stats);
+        }
+        free(job);
+    }
+}
+
+static void sampler_start(void) {
+    char *rate_env = getenv("COMPRESS_SAMPLE_RATE");
+    char *bytes_env = getenv("COMPRESS_SAMPLE_BYTES");
+    double rate = rate_env != NULL ? atof(rate_env) : SAMPLE_DEFAULT_RATE;
+    long max_bytes =
+        bytes_env != NULL ? atol(bytes_env) : SAMPLE_DEFAULT_BYTES;
+
+    if (rate <= 0.0 || max_bytes <= 0 ||
+        pthread_create(&sample_worker, NULL, sample_worker_main, NULL) != 0) {
+        sampler_state = -1;
+        return;
+    }
+    sample_threshold = rate >= 1.0 ? UINT64_MAX : (uint64_t)(rate * 0x1p64);
+    sample_max_bytes = max_bytes;
+    sampler_state = 1;
+}
+
+static void sampler_stop(void) {
+    if (sampler_state != 1) {
+        return;
+    }
+    pthread_mutex_lock(&sample_queue.lock);
+    sample_queue.stop = 1;
+    pthread_cond_signal(&sample_queue.nonempty);
+    pthread_mutex_unlock(&sample_queue.lock);
+    pthread_join(sample_worker, NULL);
+    sampler_state = -1;
+}
+
+/* xorshift64*, compared against rate * 2^64 */
+static int sample_this(void) {
+    if (sampler_state == 0) {
+        sampler_start();
+    }
+    if (sampler_state != 1) {
+        return 0;
+    }
+    sample_rng ^= sample_rng >> 12;
+    sample_rng ^= sample_rng << 25;
+    sample_rng ^= sample_rng >> 27;
+    return sample_rng * 0x2545F4914F6CDD1Dull <= sample_threshold;
+}
+
+static void sample_enqueue(sample_job *job) {
+    pthread_mutex_lock(&sample_queue.lock);
+    if (sample_queue.len == SAMPLE_QUEUE_LEN) {
+        pthread_mutex_unlock(&sample_queue.lock);
+        samples_dropped++;
+        free(job);
+        return;
+    }
+    sample_queue.jobs[(sample_queue.head + sample_queue.len) %
+                      SAMPLE_QUEUE_LEN] = job;
+    sample_queue.len++;
+    pthread_cond_signal(&sample_queue.nonempty);
+    pthread_mutex_unlock(&sample_queue.lock);
+    samples_taken++;
+}
+
+/* Copies a prefix of the send buffer of `count` elements of `datatype` for
+ * analysis. Noncontiguous data is packed first, as it would be on the wire. */
+static void sample_send_buffer(const void *buf, int count,
+                               MPI_Datatype datatype, MPI_Comm comm) {
+    int type_size;
+    if (count <= 0 || !sample_this() ||
+        PMPI_Type_size(datatype, &type_size) != MPI_SUCCESS ||
+        type_size == 0) {
+        return;
+    }
+    uint64_t bytes = (uint64_t)count * type_size;
+    size_t len = bytes < sample_max_bytes ? bytes : sample_max_bytes;
+
+    MPI_Aint lb, extent, true_lb, true_extent;
+    PMPI_Type_get_extent(datatype, &lb, &extent);
+    PMPI_Type_get_true_extent(datatype, &true_lb, &true_extent);
+    int contiguous = true_extent == type_size &&
+                     (count == 1 || extent == type_size);
+
+    sample_job *job;
+    if (contiguous) {
+        job = malloc(sizeof(sample_job) + len);
+        if (job == NULL) {
+            return;
+        }
+        memcpy(job->data, (const char *)buf + true_lb, len);
+        job->len = len;
+    } else {
+        int elements = (len + type_size - 1) / type_size;
+        int pack_size, position = 0;
+        if (PMPI_Pack_size(elements, datatype, comm, &pack_size) !=
+                MPI_SUCCESS ||
+            (job = malloc(sizeof(sample_job) + pack_size)) == NULL) {
+            return;
+        }
+        if (PMPI_Pack(buf, elements, datatype, job->data, pack_size,
+                      &position, comm) != MPI_SUCCESS) {
+            free(job);
+            return;
+        }
+        job->len = (size_t)position < len ? (size_t)position : len;
+    }
+    job->callsite = callsite_capture();
+    job->bucket = size_bucket(bytes);
+    sample_enqueue(job);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Open addressing map from a pair of 64-bit keys to a 64-bit value. A slot
+ * whose k0 is 0 is free, so k0 must never be 0. Removal shifts the entries
+ * of the probe sequence back instead of leaving tombstones.
+ *
+ * Tools keep their records in a dense array and map the keys to the index
+ * + 1 of the record, so a value of 0 marks a record still to be added.
+ * Scanning the records then does not have to skip free slots. */
+
+typedef struct {
+    uint64_t k0, k1;
+    uint64_t value; // 0 in a newly inserted entry
+} key_map_entry;
+
+typedef struct {
+    size_t capacity; // always a power of two
+    size_t len;
+    key_map_entry *entries;
+} key_map;
+
+static inline size_t key_map_index(uint64_t k0, uint64_t k1, size_t mask) {
+    uint64_t h = k0 * 0x9E3779B97F4A7C15ull ^ k1 * 0xC2B2AE3D27D4EB4Full;
+    h ^= h >> 31;
+    h *= 0x165667B19E3779F9ull;
+    return (h ^ (h >> 29)) & mask;
+}
+
+static inline key_map_entry *key_map_slot(key_map_entry *entries,
+                                          size_t capacity, uint64_t k0,
+                                          uint64_t k1) {
+    size_t mask = capacity - 1;
+    size_t idx = key_map_index(k0, k1, mask);
+    while (entries[idx].k0 != 0 &&
+           (entries[idx].k0 != k0 || entries[idx].k1 != k1)) {
+        idx = (idx + 1) & mask;
+    }
+    return &entries[idx];
+}
+
+static inline key_map_entry *key_map_find(key_map *m, uint64_t k0,
+                                          uint64_t k1) {
+    if (m->len == 0) {
+        return NULL;
+    }
+    key_map_entry *e = key_map_slot(m->entries, m->capacity, k0, k1);
+    return e->k0 != 0 ? e : NULL;
+}
+
+/* The entry of the keys, inserted if it is not there; NULL if out of
+ * memory. */
+static inline key_map_entry *key_map_get(key_map *m, uint64_t k0,
+                                         uint64_t k1) {
+    if (2 * (m->len + 1) > m->capacity) {
+        size_t capacity = m->capacity == 0 ? 64 : 2 * m->capacity;
+        key_map_entry *entries = calloc(capacity, sizeof(key_map_entry));
+        if (entries == NULL) {
+            return NULL;
+        }
+        for (size_t k = 0; k < m->capacity; k++) {
+            key_map_entry *e = &m->entries[k];
+            if (e->k0 != 0) {
+                *key_map_slot(entries, capacity, e->k0, e->k1) = *e;
+            }
+        }
+        free(m->entries);
+        m->entries = entries;
+        m->capacity = capacity;
+    }
+    key_map_entry *e = key_map_slot(m->entries, m->capacity, k0, k1);
+    if (e->k0 == 0) {
+        e->k0 = k0;
+        e->k1 = k1;
+        e->value = 0;
+        m->len++;
+    }
+    return e;
+}
+
+static inline void key_map_remove(key_map *m, key_map_entry *e) {
+    size_t mask = m->capacity - 1;
+    size_t hole = e - m->entries;
+    for (size_t k = (hole + 1) & mask; m->entries[k].k0 != 0;
+         k = (k + 1) & mask) {
+        size_t home = key_map_index(m->entries[k].k0, m->entries[k].k1, mask);
+        // the entry may fill the hole if the hole lies between its home
+        // slot and its slot
+        if (((k - home) & mask) >= ((k - hole) & mask)) {
+            m->entries[hole] = m->entries[k];
+            hole = k;
+        }
+    }
+    m->entries[hole].k0 = 0;
+    m->len--;
+}
+
+static inline void key_map_free(key_map *m) {
+    free(m->entries);
+    m->entries = NULL;
+    m->capacity = m->len = 0;
+}
+
+/* Makes room for element `len` of a dense array of `size`-byte elements,
+ * doubling it when full. Returns 0 if out of memory. */
+static inline int reserve(void **array, size_t *capacity, size_t len,
+                          size_t size) {
+    if (len < *capacity) {
+        return 1;
+    }
+    size_t n = *capacity == 0 ? 64 : 2 * *capacity;
+    void *p = realloc(*array, n * size);
+    if (p == NULL) {
+        return 0;
+    }
+    *array = p;
+    *capacity = n;
+    return 1;
+}
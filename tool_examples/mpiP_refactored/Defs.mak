@@ -75,6 +75,8 @@ ifeq ($(OS),Linux)
   ifeq ($(ARCH),ppc64)
     CPPFLAGS += -Dppc64
   endif
+  #  the -u fp and -u cache stack capture modes walk mpiP's own frames
+  CFLAGS += -fno-omit-frame-pointer
 
 endif
 
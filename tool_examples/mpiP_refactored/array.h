@@ -66,7 +66,7 @@
    "NULL", "NULL", "NULL",
    "NULL", "NULL", "NULL",
    "NULL", "NULL", "TMPI_Init",
-   "NULL", "NULL", "TMPI_Intercomm_create",
+   "TMPI_Init_thread", "NULL", "TMPI_Intercomm_create",
    "TMPI_Intercomm_merge", "TMPI_Iprobe", "TMPI_Irecv",
    "TMPI_Ireduce", "TMPI_Ireduce_scatter", "TMPI_Ireduce_scatter_block",
    "TMPI_Irsend", "NULL", "TMPI_Iscan",
@@ -77,7 +77,7 @@
    "NULL", "NULL", "NULL",
    "NULL", "NULL", "NULL",
    "TMPI_Pack", "NULL", "NULL",
-   "NULL", "NULL", "TMPI_Probe",
+   "NULL", "TMPI_Pcontrol", "TMPI_Probe",
    "NULL", "TMPI_Put", "NULL",
    "TMPI_Raccumulate", "TMPI_Recv", "TMPI_Recv_init",
    "TMPI_Reduce", "NULL", "TMPI_Reduce_scatter",
@@ -0,0 +1,206 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   callpath.c -- interned call stacks
+
+   Every distinct stack of return addresses is stored once in an arena
+   and named by its index, so that callsite records are keyed by a path
+   id rather than by copies of the stack.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+static unsigned
+callpath_hash (void **pc, int depth)
+{
+  unsigned long long h = 52271;
+  int i;
+  for (i = 0; i < depth; i++)
+    h = (h ^ (unsigned long long) (size_t) pc[i]) * 0x9E3779B97F4A7C15ULL;
+  return (unsigned) (h >> 32);
+}
+
+void
+mpiPi_callpath_init (mpiPi_callpaths_t * cp, int depth)
+{
+  bzero (cp, sizeof (mpiPi_callpaths_t));
+  cp->depth = depth;
+}
+
+void
+mpiPi_callpath_free (mpiPi_callpaths_t * cp)
+{
+  free (cp->pcs);
+  free (cp->hashes);
+  free (cp->index);
+  mpiPi_callpath_init (cp, cp->depth);
+}
+
+/*  The index is kept at most half full; it only stores path ids, so
+    growing it moves no stacks.  */
+static int
+callpath_grow_index (mpiPi_callpaths_t * cp)
+{
+  int size = cp->index_size == 0 ? 256 : 2 * cp->index_size;
+  unsigned *hashes = (unsigned *) calloc (size, sizeof (unsigned));
+  int *index = (int *) calloc (size, sizeof (int));
+  int i;
+
+  if (hashes == NULL || index == NULL)
+    {
+      free (hashes);
+      free (index);
+      return 0;
+    }
+  for (i = 0; i < cp->index_size; i++)
+    {
+      unsigned j;
+      if (cp->index[i] == 0)
+	continue;
+      for (j = cp->hashes[i] & (size - 1); index[j] != 0;
+	   j = (j + 1) & (size - 1))
+	;
+      hashes[j] = cp->hashes[i];
+      index[j] = cp->index[i];
+    }
+  free (cp->hashes);
+  free (cp->index);
+  cp->hashes = hashes;
+  cp->index = index;
+  cp->index_size = size;
+  return 1;
+}
+
+/*  Returns the id of the path pc[0..depth), adding it if it is new, or
+    -1 if memory ran out.  */
+int
+mpiPi_callpath_intern (mpiPi_callpaths_t * cp, void **pc)
+{
+  unsigned hash = callpath_hash (pc, cp->depth);
+  unsigned mask, j;
+  int id;
+
+  if (2 * (cp->count + 1) > cp->index_size && !callpath_grow_index (cp))
+    return -1;
+
+  mask = cp->index_size - 1;
+  for (j = hash & mask; cp->index[j] != 0; j = (j + 1) & mask)
+    {
+      id = cp->index[j] - 1;
+      if (cp->hashes[j] == hash
+	  && memcmp (&cp->pcs[id * cp->depth], pc,
+		     cp->depth * sizeof (void *)) == 0)
+	return id;
+    }
+
+  if (cp->count == cp->capacity)
+    {
+      int capacity = cp->capacity == 0 ? 256 : 2 * cp->capacity;
+      /*  the extra byte keeps a stack depth of 0 from asking for nothing  */
+      void **pcs = (void **) realloc (cp->pcs,
+				      (size_t) capacity * cp->depth
+				      * sizeof (void *) + 1);
+      if (pcs == NULL)
+	return -1;
+      cp->pcs = pcs;
+      cp->capacity = capacity;
+    }
+  id = cp->count++;
+  memcpy (&cp->pcs[id * cp->depth], pc, cp->depth * sizeof (void *));
+  cp->hashes[j] = hash;
+  cp->index[j] = id + 1;
+  return id;
+}
+
+/*  The depth return addresses of path id.  */
+void **
+mpiPi_callpath_pcs (mpiPi_callpaths_t * cp, int id)
+{
+  return &cp->pcs[id * cp->depth];
+}
+
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
@@ -0,0 +1,189 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   hist_cells.c -- sparse collective and point-to-point histograms
+
+   A cell is named by its (op, comm size bin, data size bin) key and
+   kept in an open addressing table that doubles at half load, so a
+   histogram takes memory in proportion to the cells that were used.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <stdlib.h>
+
+#include "mpiPi.h"
+
+static mpiPi_hist_cell_t *
+hist_cells_slot (mpiPi_hist_cell_t * cells, int size, unsigned key)
+{
+  unsigned mask = size - 1;
+  unsigned i = (key * 2654435761u) & mask;
+
+  while (cells[i].key != 0 && cells[i].key != key)
+    i = (i + 1) & mask;
+  return &cells[i];
+}
+
+
+static int
+hist_cells_grow (mpiPi_hist_cells_t * h)
+{
+  int size = h->size == 0 ? 64 : 2 * h->size;
+  mpiPi_hist_cell_t *cells;
+  int i;
+
+  cells = (mpiPi_hist_cell_t *) calloc (size, sizeof (mpiPi_hist_cell_t));
+  if (cells == NULL)
+    return -1;
+  for (i = 0; i < h->size; i++)
+    if (h->cells[i].key != 0)
+      *hist_cells_slot (cells, size, h->cells[i].key) = h->cells[i];
+  free (h->cells);
+  h->cells = cells;
+  h->size = size;
+  return 0;
+}
+
+
+/*  Returns the value of the cell, or NULL if it has not been used.  */
+double *
+mpiPi_hist_cells_get (mpiPi_hist_cells_t * h, unsigned key)
+{
+  mpiPi_hist_cell_t *c;
+
+  if (h->size == 0)
+    return NULL;
+  c = hist_cells_slot (h->cells, h->size, key);
+  return c->key == 0 ? NULL : &c->value;
+}
+
+
+/*  Adds value to the cell, creating it if needed.  Returns 0, or -1 if
+    the table could not grow.  */
+int
+mpiPi_hist_cells_add (mpiPi_hist_cells_t * h, unsigned key, double value)
+{
+  mpiPi_hist_cell_t *c;
+
+  if (2 * (h->count + 1) > h->size && hist_cells_grow (h) != 0)
+    return -1;
+  c = hist_cells_slot (h->cells, h->size, key);
+  if (c->key == 0)
+    {
+      c->key = key;
+      c->value = 0;
+      h->count++;
+    }
+  c->value += value;
+  return 0;
+}
+
+
+/*  Copies the used cells into a new array.  Returns their number, or -1
+    if the array could not be allocated.  */
+int
+mpiPi_hist_cells_gather (mpiPi_hist_cells_t * h, mpiPi_hist_cell_t ** cells)
+{
+  int i, n = 0;
+
+  *cells = (mpiPi_hist_cell_t *) malloc ((h->count + 1) *
+					 sizeof (mpiPi_hist_cell_t));
+  if (*cells == NULL)
+    return -1;
+  for (i = 0; i < h->size; i++)
+    if (h->cells[i].key != 0)
+      (*cells)[n++] = h->cells[i];
+  return n;
+}
+
+
+void
+mpiPi_hist_cells_free (mpiPi_hist_cells_t * h)
+{
+  free (h->cells);
+  h->cells = NULL;
+  h->count = 0;
+  h->size = 0;
+}
+
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
@@ -0,0 +1,228 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   latency.c -- log-linear histograms of callsite durations
+
+   Durations are counted in nanoseconds.  Each power of two range is
+   split into 2^sub_bits equal buckets, so a bucket is at most 2^-sub_bits
+   of its values wide, and values below 2^sub_bits have a bucket each.
+   A histogram has a fixed number of buckets and is kept in an arena,
+   named by its index like the call paths in callpath.c, so callsite
+   records can be copied freely and histograms merged by adding counts.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+/*  Durations from 2^MPIP_LATENCY_MAX_BITS ns (about 18 minutes) up share
+    the last bucket.  */
+#define MPIP_LATENCY_MAX_BITS 40
+
+static int
+latency_floor_log2 (unsigned long long x)
+{
+#ifdef __GNUC__
+  return 63 - __builtin_clzll (x);
+#else
+  int k = 0;
+  while (x >>= 1)
+    k++;
+  return k;
+#endif
+}
+
+/*  sub_bits of 0 disables the histograms.  */
+void
+mpiPi_latency_init (mpiPi_latency_t * lt, int sub_bits)
+{
+  bzero (lt, sizeof (mpiPi_latency_t));
+  lt->sub_bits = sub_bits;
+  if (sub_bits > 0)
+    lt->buckets = (MPIP_LATENCY_MAX_BITS + 1 - sub_bits) << sub_bits;
+}
+
+void
+mpiPi_latency_free (mpiPi_latency_t * lt)
+{
+  free (lt->counts);
+  mpiPi_latency_init (lt, lt->sub_bits);
+}
+
+/*  Returns the id + 1 of a new empty histogram, 0 if they are disabled,
+    or -1 if memory ran out.  */
+int
+mpiPi_latency_new (mpiPi_latency_t * lt)
+{
+  if (lt->buckets == 0)
+    return 0;
+  if (lt->count == lt->capacity)
+    {
+      int capacity = lt->capacity == 0 ? 64 : 2 * lt->capacity;
+      long long *counts = (long long *) realloc (lt->counts,
+						 (size_t) capacity
+						 * lt->buckets
+						 * sizeof (long long));
+      if (counts == NULL)
+	return -1;
+      lt->counts = counts;
+      lt->capacity = capacity;
+    }
+  bzero (&lt->counts[(size_t) lt->count * lt->buckets],
+	 lt->buckets * sizeof (long long));
+  return ++lt->count;
+}
+
+/*  The buckets of histogram id + 1.  */
+long long *
+mpiPi_latency_counts (mpiPi_latency_t * lt, int id)
+{
+  return &lt->counts[(size_t) (id - 1) * lt->buckets];
+}
+
+/*  The bucket of a duration of dur microseconds.  With k the position of
+    the highest bit of the value in ns, at least sub_bits, the bucket is
+    the top sub_bits + 1 bits of the value after the (k - sub_bits)
+    ranges below it.  */
+int
+mpiPi_latency_bucket (mpiPi_latency_t * lt, double dur)
+{
+  unsigned long long ns, limit = 1ULL << MPIP_LATENCY_MAX_BITS;
+  int s = lt->sub_bits, k;
+
+  ns = dur * 1000.0 < (double) limit ?
+    (unsigned long long) (dur * 1000.0 + 0.5) : limit - 1;
+  k = latency_floor_log2 (ns | (1ULL << s));
+  return ((k - s) << s) + (int) (ns >> (k - s));
+}
+
+void
+mpiPi_latency_record (mpiPi_latency_t * lt, int id, double dur)
+{
+  mpiPi_latency_counts (lt, id)[mpiPi_latency_bucket (lt, dur)]++;
+}
+
+/*  Adds the counts of histogram b to those of a.  */
+void
+mpiPi_latency_merge (mpiPi_latency_t * lt, int a, int b)
+{
+  long long *ca = mpiPi_latency_counts (lt, a);
+  long long *cb = mpiPi_latency_counts (lt, b);
+  int i;
+
+  for (i = 0; i < lt->buckets; i++)
+    ca[i] += cb[i];
+}
+
+/*  The q quantile, 0 < q <= 1, of histogram id in microseconds: the
+    middle of the bucket holding it.  Returns 0 for an empty one.  */
+double
+mpiPi_latency_quantile (mpiPi_latency_t * lt, int id, double q)
+{
+  long long *c = mpiPi_latency_counts (lt, id);
+  long long total = 0, rank, seen = 0;
+  int i, s = lt->sub_bits;
+
+  for (i = 0; i < lt->buckets; i++)
+    total += c[i];
+  if (total == 0)
+    return 0;
+  rank = (long long) (q * total + 0.999999);
+  if (rank < 1)
+    rank = 1;
+  for (i = 0; i < lt->buckets; i++)
+    {
+      seen += c[i];
+      if (seen >= rank)
+	break;
+    }
+  {
+    int shift = (i >> s) > 0 ? (i >> s) - 1 : 0;
+    double lo = (double) ((unsigned long long) (i - (shift << s)) << shift);
+
+    return (lo + ((1ULL << shift) - 1) / 2.0) / 1000.0;
+  }
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
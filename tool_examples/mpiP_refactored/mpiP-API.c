@@ -74,7 +74,7 @@ mpiP_record_traceback (void *pc_array[], int max_stack,int qmpi_lvl,vector * v)
 
 extern int
 mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
-		   char **o_funct_str);
+		   char **o_funct_str, int qmpi_lvl, vector * v);
 
 int
 mpiP_open_executable (char *filename, int qmpi_lvl,vector * v)
@@ -91,7 +91,7 @@ mpiP_open_executable (char *filename, int qmpi_lvl,vector * v)
 
 #ifdef ENABLE_BFD
 
-  open_bfd_executable (filename);
+  open_bfd_executable (filename, qmpi_lvl, v);
 
 #elif defined(USE_LIBDWARF)
 
@@ -104,10 +104,10 @@ mpiP_open_executable (char *filename, int qmpi_lvl,vector * v)
 
 
 void
-mpiP_close_executable ()
+mpiP_close_executable (int qmpi_lvl, vector * v)
 {
 #ifdef ENABLE_BFD
-  close_bfd_executable ();
+  close_bfd_executable (qmpi_lvl, v);
 #elif defined(USE_LIBDWARF)
   close_dwarf_executable ();
 #endif
@@ -143,6 +143,16 @@ mpiP_get_executable_name (int qmpi_lvl,vector * v)
   return NULL;
 }
 
+#ifndef ENABLE_API_ONLY
+/*  Enters the phase of the name, see phase.c; NULL returns to phase 0.
+    Returns the phase, or -1 if there are no more.  */
+int
+mpiP_enter_phase (const char *name, int qmpi_lvl, vector * v)
+{
+  return mpiPi_phase_enter_named (name, qmpi_lvl, v);
+}
+#endif
+
 
 
 /* 
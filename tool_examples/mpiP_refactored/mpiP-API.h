@@ -17,6 +17,8 @@
     mpiP_record_traceback may be called at any time.
     mpiP_find_src_loc must be called after a successful call to
     mpiP_open_executable and prior to mpiP_close_executable.
+    mpiP_enter_phase starts a named phase of the profile, see also
+    MPI_Pcontrol.
 */
 
 #include "mpip_timers.h"
@@ -27,12 +29,14 @@
 extern void mpiP_init_api (int qmpi_lvl,vector* v);
 extern int mpiP_record_traceback (void *pc_array[], int max_stack,int qmpi_lvl,vector* v);
 extern int mpiP_open_executable (char *filename,int qmpi_lvl,vector* v);
-extern void mpiP_close_executable (void);
+extern void mpiP_close_executable (int qmpi_lvl,vector* v);
 extern mpiP_TIMER mpiP_gettime (void);
 extern char *mpiP_get_executable_name (int qmpi_lvl, vector* v);
 extern int mpiP_find_src_loc (void *i_addr_hex, char **o_file_str,
-			      int *o_lineno, char **o_funct_str);
+			      int *o_lineno, char **o_funct_str,
+			      int qmpi_lvl,vector* v);
 extern char *mpiP_format_address (void *pval, char *addr_buf);
+extern int mpiP_enter_phase (const char *name, int qmpi_lvl, vector * v);
 
 #else /* __STDC__ */
 
@@ -44,6 +48,7 @@ extern mpiP_TIMER mpiP_gettime ( /* void */ );
 extern char *mpiP_get_executable_name ( /* void */ );
 extern int mpiP_find_src_loc ( /* void */ );
 extern char *mpiP_format_address ( /*void* pval*, char* addr_buf */ );
+extern int mpiP_enter_phase ( /* const char* name */ );
 #endif /* __STDC__ */
 #endif /* __CEXTRACT__ */
 
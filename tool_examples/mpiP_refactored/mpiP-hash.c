@@ -17,12 +17,72 @@ static char *svnid = "$Id$";
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
-#include <strings.h>
 
 #include "mpiP-hash.h"
 
 #define Abort(str) {printf("HASH: ABORTING (%s:%d): %s\n",__FILE__,__LINE__,str); exit(-1);}
 
+/*  Open addressing with linear probing.  Each slot keeps the entry's hash
+    next to its pointer, so a probe compares hashes and only calls the
+    comparator on a match, and growing the table rehashes without calling
+    back into the user's hash function.  The slots are the only storage,
+    so inserting does not allocate unless the table grows.  */
+
+/*  The tables are grown once more than half of the slots are in use.  */
+#define H_FULL(ht, n) (2 * (n) > (ht)->size)
+
+/*  The callers' hash functions XOR addresses together, which leaves the
+    low bits poorly distributed; mix them before masking.  */
+static unsigned
+h_mix (int key)
+{
+  unsigned h = (unsigned) key * 0x9E3779B1u;
+  return h ^ (h >> 16);
+}
+
+/*  Index of the slot holding an entry equal to key, or of the empty slot
+    that ends its probe sequence.  */
+static int
+h_find_slot (h_t * ht, const void *key, unsigned hash, int qmpi_lvl,
+	     vector * v)
+{
+  unsigned mask = ht->size - 1;
+  unsigned i = hash & mask;
+  while (ht->table[i].ptr != NULL)
+    {
+      if (ht->table[i].hash == hash
+	  && ht->hc (ht->table[i].ptr, key, qmpi_lvl, v) == 0)
+	return i;
+      i = (i + 1) & mask;
+    }
+  return i;
+}
+
+static void
+h_grow (h_t * ht)
+{
+  int i, old_size = ht->size;
+  h_entry_t *old_table = ht->table;
+  unsigned mask;
+
+  ht->size *= 2;
+  ht->table = (h_entry_t *) calloc (ht->size, sizeof (h_entry_t));
+  if (ht->table == NULL)
+    Abort ("malloc error");
+  mask = ht->size - 1;
+  for (i = 0; i < old_size; i++)
+    {
+      unsigned j;
+      if (old_table[i].ptr == NULL)
+	continue;
+      for (j = old_table[i].hash & mask; ht->table[j].ptr != NULL;
+	   j = (j + 1) & mask)
+	;
+      ht->table[j] = old_table[i];
+    }
+  free (old_table);
+}
+
 h_t *
 h_open (int size, h_HashFunct hf, h_Comparator hc)
 {
@@ -32,7 +92,10 @@ h_open (int size, h_HashFunct hf, h_Comparator hc)
     Abort ("malloc error");
   if (size < 2)
     Abort ("size too small for hash table");
-  ht->size = size;
+  /*  size is the initial number of slots, rounded up to a power of two  */
+  ht->size = 2;
+  while (ht->size < size)
+    ht->size *= 2;
   ht->count = 0;
   if (hf == NULL)
     Abort ("hash key function not defined");
@@ -40,10 +103,9 @@ h_open (int size, h_HashFunct hf, h_Comparator hc)
   if (hc == NULL)
     Abort ("hash comparator function not defined");
   ht->hc = hc;
-  ht->table = (h_entry_t **) malloc (sizeof (h_entry_t *) * size);
+  ht->table = (h_entry_t *) calloc (ht->size, sizeof (h_entry_t));
   if (ht->table == NULL)
     Abort ("malloc error");
-  bzero (ht->table, sizeof (h_entry_t *) * size);
   return ht;
 }
 
@@ -71,41 +133,26 @@ h_count (h_t * ht)
 int
 h_insert (h_t * ht, void *ptr,int qmpi_lvl, vector* v)
 {
-  unsigned tableIndex;
-  h_entry_t *het = NULL;
-  h_entry_t *het_index = NULL;
+  unsigned hash;
+  int i;
   if (ht == NULL)
     Abort ("hash table uninitialized");
-  het = (h_entry_t *) malloc (sizeof (h_entry_t));
-  if (het == NULL)
-    Abort ("hash table entry malloc error");
   if (ptr == NULL)
     Abort ("h_insert: ptr == NULL");
-  het->ptr = ptr;
-  het->next = NULL;
-  tableIndex = (ht->hf (ptr,qmpi_lvl,v));
-  tableIndex %= (ht->size);
-  if (ht->table[tableIndex] != NULL)
+  hash = h_mix (ht->hf (ptr, qmpi_lvl, v));
+  i = h_find_slot (ht, ptr, hash, qmpi_lvl, v);
+  if (ht->table[i].ptr != NULL)
     {
-      /* search list for similar key, if not, append it to list */
-      /* OPTIMIZATION: remove this and let users deal with it :) */
-      for (het_index = ht->table[tableIndex];
-	   het_index != NULL; het_index = het_index->next)
-	{
-	  if (ht->hc (het_index->ptr, ptr,qmpi_lvl,v) == 0)
-	    {
-	      printf
-		("hash: warning: tried to insert identical entry again\n");
-	      return 1;
-	    }
-	}
-      het->next = ht->table[tableIndex];
-      ht->table[tableIndex] = het;
+      printf ("hash: warning: tried to insert identical entry again\n");
+      return 1;
     }
-  else
+  if (H_FULL (ht, ht->count + 1))
     {
-      ht->table[tableIndex] = het;
+      h_grow (ht);
+      i = h_find_slot (ht, ptr, hash, qmpi_lvl, v);
     }
+  ht->table[i].hash = hash;
+  ht->table[i].ptr = ptr;
   ht->count++;
   return 0;
 }
@@ -113,76 +160,55 @@ h_insert (h_t * ht, void *ptr,int qmpi_lvl, vector* v)
 void *
 h_search (h_t * ht, void *key, void **ptr,int qmpi_lvl, vector* v)
 {
-  unsigned tableIndex;
-  h_entry_t *het_index = NULL;
+  int i;
   if (ht == NULL)
     Abort ("hash table uninitialized");
   if (key == NULL)
     Abort ("h_search: key == NULL");
   if (ptr == NULL)
     Abort ("h_search: ptr == NULL");
-  *ptr = NULL;
-  tableIndex = (ht->hf (key,qmpi_lvl,v));
-  tableIndex %= (ht->size);
-  if (ht->table[tableIndex] != NULL)
-    {
-      /* search list for similar key  */
-      for (het_index = ht->table[tableIndex];
-	   het_index != NULL; het_index = het_index->next)
-	{
-	  if (ht->hc (het_index->ptr, key,qmpi_lvl,v) == 0)
-	    {
-	      *ptr = het_index->ptr;
-	      return *ptr;
-	    }
-	}
-    }
-  return NULL;
+  i = h_find_slot (ht, key, h_mix (ht->hf (key, qmpi_lvl, v)), qmpi_lvl, v);
+  *ptr = ht->table[i].ptr;
+  return *ptr;
 }
 
 void *
 h_delete (h_t * ht, void *key, void **ptr,int qmpi_lvl, vector* v)
 {
-  unsigned tableIndex;
-  h_entry_t *het_index = NULL;
-  h_entry_t **next_addr = NULL;
+  unsigned i, j, home, mask;
   if (ht == NULL)
     Abort ("hash table uninitialized");
   if (ptr == NULL)
     Abort ("h_insert: ptr == NULL");
   if (key == NULL)
     Abort ("h_insert: key == NULL");
-  *ptr = NULL;
-  tableIndex = (ht->hf (key,qmpi_lvl,v));
-  tableIndex %= (ht->size);
-  if (ht->table[tableIndex] != NULL)
+  i = h_find_slot (ht, key, h_mix (ht->hf (key, qmpi_lvl, v)), qmpi_lvl, v);
+  *ptr = ht->table[i].ptr;
+  if (*ptr == NULL)
+    return NULL;
+
+  /*  Shift later entries of the probe sequence back into the hole, unless
+      that would move them before their home slot, so that lookups never
+      need tombstones.  */
+  mask = ht->size - 1;
+  for (j = (i + 1) & mask; ht->table[j].ptr != NULL; j = (j + 1) & mask)
     {
-      /* search list for similar key  */
-      for (het_index = ht->table[tableIndex],
-	   next_addr = &(ht->table[tableIndex]);
-	   het_index != NULL; het_index = het_index->next)
+      home = ht->table[j].hash & mask;
+      if (((j - home) & mask) >= ((j - i) & mask))
 	{
-	  if (ht->hc (het_index->ptr, key,qmpi_lvl,v) == 0)
-	    {
-	      /* match */
-	      *ptr = het_index->ptr;
-	      *next_addr = het_index->next;
-	      free (het_index);
-	      ht->count--;
-	      return *ptr;
-	    }
-
-	  next_addr = &(het_index->next);
+	  ht->table[i] = ht->table[j];
+	  i = j;
 	}
     }
-  return NULL;
+  ht->table[i].ptr = NULL;
+  ht->count--;
+  return *ptr;
 }
 
 int
 h_gather_data (h_t * ht, int *ac, void ***ptr)
 {
   int i;
-  h_entry_t *het_index = NULL;
   if (ht == NULL)
     Abort ("hash table uninitialized");
   if (ptr == NULL)
@@ -192,14 +218,10 @@ h_gather_data (h_t * ht, int *ac, void ***ptr)
   *ptr = (void **) malloc (sizeof (void *) * ht->count);
   for (i = 0; i < ht->size; i++)
     {
-      if (ht->table[i] != NULL)
+      if (ht->table[i].ptr != NULL)
 	{
-	  for (het_index = ht->table[i];
-	       het_index != NULL; het_index = het_index->next)
-	    {
-	      (*ptr)[*ac] = het_index->ptr;
-	      (*ac)++;
-	    }
+	  (*ptr)[*ac] = ht->table[i].ptr;
+	  (*ac)++;
 	}
     }
   return *ac;
@@ -21,18 +21,18 @@ typedef int (*h_Comparator) (const void *, const void *,int qmpi_lvl,vector* v);
 
 typedef struct _h_entry_t
 {
-  void *ptr;
-  struct _h_entry_t *next;
+  unsigned hash;		/* mixed hash of ptr */
+  void *ptr;			/* NULL for an empty slot */
 }
 h_entry_t;
 
 typedef struct _h_t
 {
-  int size;
+  int size;			/* number of slots, a power of two */
   int count;
   h_HashFunct hf;		/* given an element compute the hash number */
   h_Comparator hc;		/* given two elements, do they match? 0 for yes */
-  h_entry_t **table;		/* table[size] of pointers to lists of entries */
+  h_entry_t *table;		/* table[size] of slots, probed linearly */
 }
 h_t;
 
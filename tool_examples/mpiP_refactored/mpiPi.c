@@ -30,32 +30,18 @@ char *strdup (const char *s)
   return (char *) memcpy (new, s, len);
 }
 */
-static int
-mpiPi_callsite_stats_pc_hashkey (const void *p,int qmpi_lvl,vector* v)
+int
+mpiPi_callsite_stats_path_hashkey (const void *p,int qmpi_lvl,vector* v)
 {
-	//CHANGE BEGIN
-	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
-	// CHANGE END
-
-  int res = 0;
-  int i;
   callsite_stats_t *csp = (callsite_stats_t *) p;
   MPIP_CALLSITE_STATS_COOKIE_ASSERT (csp);
-  for (i = 0; i < gs_ptr->mpiPi.stackDepth; i++)
-    {
-      res ^= (unsigned) (long) csp->pc[i];
-    }
-  return 52271 ^ csp->op ^ res ^ csp->rank;
+  return 52271 ^ csp->op ^ (csp->path << 8) ^ csp->rank
+    ^ ((unsigned) csp->phase << 24);
 }
 
-static int
-mpiPi_callsite_stats_pc_comparator (const void *p1, const void *p2,int qmpi_lvl,vector* v)
+int
+mpiPi_callsite_stats_path_comparator (const void *p1, const void *p2,int qmpi_lvl,vector* v)
 {
-	//CHANGE BEGIN
-	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
-	// CHANGE END
-
-  int i;
   callsite_stats_t *csp_1 = (callsite_stats_t *) p1;
   callsite_stats_t *csp_2 = (callsite_stats_t *) p2;
   MPIP_CALLSITE_STATS_COOKIE_ASSERT (csp_1);
@@ -64,11 +50,8 @@ mpiPi_callsite_stats_pc_comparator (const void *p1, const void *p2,int qmpi_lvl,
 #define express(f) {if ((csp_1->f) > (csp_2->f)) {return 1;} if ((csp_1->f) < (csp_2->f)) {return -1;}}
   express (op);
   express (rank);
-
-  for (i = 0; i < gs_ptr->mpiPi.stackDepth; i++)
-    {
-      express (pc[i]);
-    }
+  express (path);
+  express (phase);
 #undef express
 
   return 0;
@@ -77,10 +60,12 @@ mpiPi_callsite_stats_pc_comparator (const void *p1, const void *p2,int qmpi_lvl,
 static int
 mpiPi_callsite_stats_src_hashkey (const void *p,int qmpi_lvl,vector* v)
 {
-  int res = 0;
   callsite_stats_t *csp = (callsite_stats_t *) p;
   MPIP_CALLSITE_STATS_COOKIE_ASSERT (csp);
-  return 52271 ^ csp->op ^ res ^ csp->rank ^ csp->csid;
+  /* XORing rank and csid maps many (rank, site) pairs of a large job to
+     one key; combine them so each task's records spread out.  */
+  return 52271 ^ csp->op ^ (int) ((unsigned) csp->csid * 65599u
+				  + csp->rank);
 }
 
 static int
@@ -217,16 +202,36 @@ mpiPi_init (char *appName, int qmpi_lvl , vector* v)
   gs_ptr->mpiPi.collective_report = 0;
 #endif
   gs_ptr->mpiPi.disable_finalize_report = 0;
+  gs_ptr->mpiPi.binaryProfile = 0;
+  gs_ptr->mpiPi.traceRate = 0;
+  gs_ptr->mpiPi.trace = NULL;
+  gs_ptr->mpiPi.do_thread_report = 0;
   gs_ptr->mpiPi.do_collective_stats_report = 0;
   gs_ptr->mpiPi.do_pt2pt_stats_report = 0;
 #ifdef SO_LOOKUP
   gs_ptr->mpiPi.so_info = NULL;
+  gs_ptr->mpiPi.so_count = 0;
+  gs_ptr->mpiPi.so_ranges = NULL;
+  gs_ptr->mpiPi.so_range_count = 0;
 #endif
+  mpiPi_latency_init (&gs_ptr->mpiPi.latency, MPIP_LATENCY_SUB_BITS);
+  mpiPi_phase_init (qmpi_lvl, v);
   mpiPi_getenv (qmpi_lvl,v);
 
+  mpiPi_callpath_init (&gs_ptr->mpiPi.callpaths, gs_ptr->mpiPi.stackDepth);
   gs_ptr->mpiPi.task_callsite_stats =
-    h_open (gs_ptr->mpiPi.tableSize, mpiPi_callsite_stats_pc_hashkey,
-	    mpiPi_callsite_stats_pc_comparator);
+    h_open (gs_ptr->mpiPi.tableSize, mpiPi_callsite_stats_path_hashkey,
+	    mpiPi_callsite_stats_path_comparator);
+  if (gs_ptr->mpiPi.traceRate > 0)
+    mpiPi_trace_init (qmpi_lvl, v);
+
+  gs_ptr->mpiPi.coll_time_stats.count = 0;
+  gs_ptr->mpiPi.coll_time_stats.size = 0;
+  gs_ptr->mpiPi.coll_time_stats.cells = NULL;
+  gs_ptr->mpiPi.pt2pt_send_stats.count = 0;
+  gs_ptr->mpiPi.pt2pt_send_stats.size = 0;
+  gs_ptr->mpiPi.pt2pt_send_stats.cells = NULL;
+  mpiPi_thread_init (qmpi_lvl, v);
 
   if (gs_ptr->mpiPi.do_collective_stats_report == 1)
     {
@@ -300,6 +305,55 @@ callsite_pc_cache_hashkey (const void *p1,int qmpi_lvl, vector* v)
   return 662917 ^ ((long) cs1->pc);
 }
 
+#if defined(ENABLE_BFD) || defined(USE_LIBDWARF)
+static int mpiPi_exe_state = 0;	/* 1 open, -1 unreadable */
+
+/*  Opens the executable for source lookup on first use, so that a
+    report served from the symbol cache never reads debug info.
+    Returns 1 if it is open.  */
+static int
+mpiPi_open_executable (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  if (mpiPi_exe_state != 0)
+    return mpiPi_exe_state;
+
+  mpiPi_exe_state = -1;
+  if (gs_ptr->mpiPi.appFullName != NULL)
+    {
+#ifdef ENABLE_BFD
+      if (open_bfd_executable (gs_ptr->mpiPi.appFullName, qmpi_lvl, v) != 0)
+	mpiPi_exe_state = 1;
+#else
+      if (open_dwarf_executable (gs_ptr->mpiPi.appFullName) != 0)
+	mpiPi_exe_state = 1;
+#endif
+    }
+  else
+    mpiPi_msg_warn
+      (qmpi_lvl,v,"Failed to open executable.  The mpiP -x runtime flag may address this issue.\n");
+  return mpiPi_exe_state;
+}
+
+
+static void
+mpiPi_close_executable (int qmpi_lvl, vector * v)
+{
+  if (mpiPi_exe_state == 1)
+    {
+#ifdef ENABLE_BFD
+      close_bfd_executable (qmpi_lvl, v);
+#else
+      close_dwarf_executable ();
+#endif
+    }
+  mpiPi_exe_state = 0;
+}
+#endif
+
 int
 mpiPi_query_pc ( int qmpi_lvl , vector* v, void *pc, char **filename, char **functname, int *lineno)
 {
@@ -321,8 +375,18 @@ mpiPi_query_pc ( int qmpi_lvl , vector* v, void *pc, char **filename, char **fun
 	(callsite_pc_cache_entry_t *)
 	malloc (sizeof (callsite_pc_cache_entry_t));
       csp->pc = pc;
+      if (mpiPi_symcache_find (pc, &csp->filename, &csp->functname,
+			       &csp->line) == 0)
+	{
+	  mpiPi_msg_debug
+	    (qmpi_lvl,v,"Symbol cache hit for [%s]: %s, %d, %s\n",
+	     mpiP_format_address (pc, addr_buf), csp->filename, csp->line,
+	     csp->functname);
+	}
 #if defined(ENABLE_BFD) || defined(USE_LIBDWARF)
-      if (mpiP_find_src_loc (pc, filename, lineno, functname) == 0)
+      else if (mpiPi_open_executable (qmpi_lvl, v) == 1
+	       && mpiP_find_src_loc (pc, filename, lineno, functname,
+				   qmpi_lvl, v) == 0)
 	{
 	  if (*filename == NULL || strcmp (*filename, "??") == 0)
 	    *filename = "[unknown]";
@@ -338,20 +402,22 @@ mpiPi_query_pc ( int qmpi_lvl , vector* v, void *pc, char **filename, char **fun
 	  csp->filename = strdup (*filename);
 	  csp->functname = strdup (*functname);
 	  csp->line = *lineno;
+	  mpiPi_symcache_add (pc, csp->filename, csp->functname, csp->line);
 	}
+#endif
       else
 	{
-	  mpiPi_msg_debug (qmpi_lvl,v,,"Unsuccessful Source lookup for [%s]\n",
+	  mpiPi_msg_debug (qmpi_lvl,v,"Unsuccessful Source lookup for [%s]\n",
 			   mpiP_format_address (pc, addr_buf));
 	  csp->filename = strdup ("[unknown]");
 	  csp->functname = strdup ("[unknown]");
 	  csp->line = 0;
-	}
-#else /* ! ENABLE_BFD || USE_LIBDWARF */
-      csp->filename = strdup ("[unknown]");
-      csp->functname = strdup ("[unknown]");
-      csp->line = 0;
+#if defined(ENABLE_BFD) || defined(USE_LIBDWARF)
+	  /*  Cache the pcs the executable has no debug info for, too.  */
+	  if (mpiPi_exe_state == 1)
+	    mpiPi_symcache_add (pc, csp->filename, csp->functname, 0);
 #endif
+	}
       h_insert (callsite_pc_cache, csp,qmpi_lvl,v);
     }
 
@@ -458,28 +524,32 @@ mpiPi_query_src (callsite_stats_t * p, int qmpi_lvl , vector* v)
   int i;
   callsite_src_id_cache_entry_t key;
   callsite_src_id_cache_entry_t *csp;
+  void **pc;
+  char *filename, *functname;
+  int lineno;
   assert (p);
 
   /* Because multiple pcs can map to the same source line, we must
      check that mapping here. If we got unknown, then we assign
      different ids */
   bzero (&key, sizeof (callsite_src_id_cache_entry_t));
+  pc = mpiPi_callpath_pcs (&gs_ptr->mpiPi.callpaths, p->path);
 
-  for (i = 0; (i < gs_ptr->mpiPi.stackDepth) && (p->pc[i] != NULL); i++)
+  for (i = 0; (i < gs_ptr->mpiPi.stackDepth) && (pc[i] != NULL); i++)
     {
       if (gs_ptr->mpiPi.do_lookup == 1)
-	mpiPi_query_pc (qmpi_lvl,v, p->pc[i], &(p->filename[i]), &(p->functname[i]),&(p->lineno[i]));
+	mpiPi_query_pc (qmpi_lvl,v, pc[i], &filename, &functname, &lineno);
       else
 	{
-	  p->filename[i] = strdup ("[unknown]");
-	  p->functname[i] = strdup ("[unknown]");
-	  p->lineno[i] = 0;
+	  filename = "[unknown]";
+	  functname = "[unknown]";
+	  lineno = 0;
 	}
 
-      key.filename[i] = p->filename[i];
-      key.functname[i] = p->functname[i];
-      key.line[i] = p->lineno[i];
-      key.pc[i] = p->pc[i];
+      key.filename[i] = filename;
+      key.functname[i] = functname;
+      key.line[i] = lineno;
+      key.pc[i] = pc[i];
     }
 
   /* MPI ID is compared when stack depth is 0 */
@@ -494,12 +564,12 @@ mpiPi_query_src (callsite_stats_t * p, int qmpi_lvl , vector* v)
 	malloc (sizeof (callsite_src_id_cache_entry_t));
       bzero (csp, sizeof (callsite_src_id_cache_entry_t));
 
-      for (i = 0; (i < gs_ptr->mpiPi.stackDepth) && (p->pc[i] != NULL); i++)
+      for (i = 0; (i < gs_ptr->mpiPi.stackDepth) && (pc[i] != NULL); i++)
 	{
 	  csp->filename[i] = strdup (key.filename[i]);
 	  csp->functname[i] = strdup (key.functname[i]);
 	  csp->line[i] = key.line[i];
-	  csp->pc[i] = p->pc[i];
+	  csp->pc[i] = pc[i];
 	}
       csp->op = p->op;
       if (gs_ptr->mpiPi.stackDepth == 0)
@@ -516,7 +586,7 @@ mpiPi_query_src (callsite_stats_t * p, int qmpi_lvl , vector* v)
 }
 
 
-static void
+void
 mpiPi_merge_individual_callsite_records (callsite_stats_t * a,
 					 callsite_stats_t * b)
 {
@@ -538,6 +608,23 @@ mpiPi_merge_individual_callsite_records (callsite_stats_t * a,
 }
 
 
+/*  Combines the spread of per-task times of b into a, as in Chan et al.  */
+static void
+mpiPi_merge_site_times (callsite_stats_t * a, callsite_stats_t * b)
+{
+  long long n = a->siteCount + b->siteCount;
+  double delta = b->siteMean - a->siteMean;
+
+  if (n == 0)
+    return;
+  a->siteM2 += b->siteM2 + delta * delta * a->siteCount * b->siteCount / n;
+  a->siteMean += delta * b->siteCount / n;
+  a->siteCount = n;
+}
+
+
+/*  Adds a task record to the per-task callsite table.  Only the single
+    collector report keeps one.  */
 static int
 mpiPi_insert_callsite_records (callsite_stats_t * p, int qmpi_lvl , vector* v)
 {
@@ -551,27 +638,37 @@ mpiPi_insert_callsite_records (callsite_stats_t * p, int qmpi_lvl , vector* v)
 
   /* If exists, accumulate, otherwise insert. This is
      specifically for optimizations that have multiple PCs for
-     one src line. We aggregate across rank after this. 
-
-     The collective_report reporting approach does not aggregate individual 
-     process callsite information at the collector process.
-   */
-  if (gs_ptr->mpiPi.collective_report == 0)
+     one src line. */
+  if (NULL == h_search (gs_ptr->mpiPi.global_callsite_stats, p, (void **) &csp,qmpi_lvl,v))
     {
-      if (NULL == h_search (gs_ptr->mpiPi.global_callsite_stats, p, (void **) &csp,qmpi_lvl,v))
-	{
-	  callsite_stats_t *newp = NULL;
-	  newp = (callsite_stats_t *) malloc (sizeof (callsite_stats_t));
+      callsite_stats_t *newp = NULL;
+      newp = (callsite_stats_t *) malloc (sizeof (callsite_stats_t));
 
-	  memcpy (newp, p, sizeof (callsite_stats_t));
-	  /* insert new record into global */
-	  h_insert (gs_ptr->mpiPi.global_callsite_stats, newp,qmpi_lvl,v);
-	}
-      else
-	mpiPi_merge_individual_callsite_records (csp, p);
+      memcpy (newp, p, sizeof (callsite_stats_t));
+      newp->lat = 0;		/* percentiles are reported per callsite */
+      /* insert new record into global */
+      h_insert (gs_ptr->mpiPi.global_callsite_stats, newp,qmpi_lvl,v);
     }
+  else
+    mpiPi_merge_individual_callsite_records (csp, p);
+
+  return 1;
+}
+
+
+/*  Adds a record merged across tasks to the callsite summary, which is
+    independent of rank.  */
+static int
+mpiPi_insert_callsite_agg (callsite_stats_t * p, int qmpi_lvl , vector* v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  callsite_stats_t *csp = NULL;
+
+  mpiPi_query_src (p, qmpi_lvl, v);
 
-  /* Collect aggregate callsite summary information indpendent of rank. */
   if (NULL == h_search (gs_ptr->mpiPi.global_callsite_stats_agg, p, (void **) &csp,qmpi_lvl,v))
     {
       callsite_stats_t *newp = NULL;
@@ -580,42 +677,19 @@ mpiPi_insert_callsite_records (callsite_stats_t * p, int qmpi_lvl , vector* v)
       memcpy (newp, p, sizeof (callsite_stats_t));
       newp->rank = -1;
 
-      if (gs_ptr->mpiPi.calcCOV)
-	{
-	  newp->siteData = (double *) malloc (gs_ptr->mpiPi.size * sizeof (double));
-	  newp->siteData[0] = p->cumulativeTime;
-	  newp->siteDataIdx = 1;
-	}
-
       /* insert new record into global */
       h_insert (gs_ptr->mpiPi.global_callsite_stats_agg, newp,qmpi_lvl,v);
     }
   else
     {
       mpiPi_merge_individual_callsite_records (csp, p);
-
-      if (gs_ptr->mpiPi.calcCOV)
-	{
-	  csp->siteData[csp->siteDataIdx] = p->cumulativeTime;
-	  csp->siteDataIdx += 1;
-	}
-    }
-
-  /* Do global accumulation while we are iterating through individual callsites */
-  gs_ptr->mpiPi.global_task_mpi_time[p->rank] += p->cumulativeTime;
-
-  gs_ptr->mpiPi.global_mpi_time += p->cumulativeTime;
-  assert (gs_ptr->mpiPi.global_mpi_time >= 0);
-  gs_ptr->mpiPi.global_mpi_size += p->cumulativeDataSent;
-  gs_ptr->mpiPi.global_mpi_io += p->cumulativeIO;
-  gs_ptr->mpiPi.global_mpi_rma += p->cumulativeRMA;
-  if (p->cumulativeTime > 0)
-    gs_ptr->mpiPi.global_time_callsite_count++;
-
-  if (p->cumulativeDataSent > 0)
-    {
-      gs_ptr->mpiPi.global_mpi_msize_threshold_count += p->arbitraryMessageCount;
-      gs_ptr->mpiPi.global_mpi_sent_count += p->count;
+      mpiPi_merge_site_times (csp, p);
+      /* the merged records own their histograms, p's is taken over or
+         added in */
+      if (csp->lat == 0)
+	csp->lat = p->lat;
+      else if (p->lat > 0)
+	mpiPi_latency_merge (&gs_ptr->mpiPi.latency, csp->lat, p->lat);
     }
 
   return 1;
@@ -695,6 +769,7 @@ mpiPi_insert_MPI_records ( int qmpi_lvl , vector* v)
 	      memcpy (newp, p, sizeof (callsite_stats_t));
 	      newp->rank = -1;
 	      newp->csid = p->op - mpiPi_BASE;
+	      newp->lat = 0;
 
 	      /* insert new record into global */
 	      h_insert (gs_ptr->mpiPi.global_MPI_stats_agg, newp,qmpi_lvl,v);
@@ -709,8 +784,459 @@ mpiPi_insert_MPI_records ( int qmpi_lvl , vector* v)
   return 1;
 }
 
+
+/*  Opens the tables the single collector report is printed from, for a
+    profile read by mpiPi_profile_read.  */
+void
+mpiPi_open_report_tables (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  gs_ptr->mpiPi.global_callsite_stats = h_open (gs_ptr->mpiPi.tableSize,
+					mpiPi_callsite_stats_src_hashkey,
+					mpiPi_callsite_stats_src_comparator);
+  gs_ptr->mpiPi.global_callsite_stats_agg = h_open (gs_ptr->mpiPi.tableSize,
+					    mpiPi_callsite_stats_src_id_hashkey,
+					    mpiPi_callsite_stats_src_id_comparator);
+  gs_ptr->mpiPi.global_MPI_stats_agg = h_open (gs_ptr->mpiPi.tableSize,
+				       mpiPi_callsite_stats_MPI_id_hashkey,
+				       mpiPi_callsite_stats_op_comparator);
+  gs_ptr->mpiPi.global_phase_stats = h_open (gs_ptr->mpiPi.tableSize,
+				     mpiPi_callsite_stats_src_hashkey,
+				     mpiPi_callsite_stats_src_comparator);
+  gs_ptr->callsite_src_id_cache = h_open (gs_ptr->mpiPi.tableSize,
+				  callsite_src_id_cache_hashkey,
+				  callsite_src_id_cache_comparator);
+}
+
 #ifndef ENABLE_API_ONLY		/* { */
 
+/*  Receives packed callsite records from source, interning their call
+    paths.  Returns their number, and a new array of them in *buf.  */
+static int
+mpiPi_recv_callsites (int source, callsite_stats_t ** buf, int qmpi_lvl,
+		      vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  MPI_Status status;
+  char *wire;
+  int wire_len, count;
+
+  PMPI_Probe (source, gs_ptr->mpiPi.tag, gs_ptr->mpiPi.comm, &status);
+  PMPI_Get_count (&status, MPI_CHAR, &wire_len);
+  wire = (char *) malloc (wire_len + 1);
+  if (wire == NULL)
+    mpiPi_abort (qmpi_lvl,v,"failed to allocate memory to collect callsite info\n");
+  PMPI_Recv (wire, wire_len, MPI_CHAR, status.MPI_SOURCE, gs_ptr->mpiPi.tag,
+	     gs_ptr->mpiPi.comm, &status);
+  count = mpiPi_wire_unpack (wire, wire_len, &gs_ptr->mpiPi.callpaths,
+			     &gs_ptr->mpiPi.latency, buf);
+  if (count < 0)
+    mpiPi_abort (qmpi_lvl,v,"failed to unpack callsite records from task %d\n",
+		 status.MPI_SOURCE);
+  free (wire);
+  return count;
+}
+
+
+/*  Adds p, with rank -1 and a path id of this task, to the records
+    merged across tasks.  */
+static void
+mpiPi_tree_merge_record (h_t * merged, callsite_stats_t * p, int qmpi_lvl,
+			 vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  mpiPi_latency_t *lt = &gs_ptr->mpiPi.latency;
+  callsite_stats_t *csp = NULL;
+
+  if (NULL == h_search (merged, p, (void **) &csp, qmpi_lvl, v))
+    {
+      csp = (callsite_stats_t *) malloc (sizeof (callsite_stats_t));
+      memcpy (csp, p, sizeof (callsite_stats_t));
+      /* the merged record gets a histogram of its own */
+      if (p->lat > 0)
+	{
+	  csp->lat = mpiPi_latency_new (lt);
+	  if (csp->lat < 0)
+	    mpiPi_abort (qmpi_lvl,v,"failed to allocate latency histograms\n");
+	  mpiPi_latency_merge (lt, csp->lat, p->lat);
+	}
+      h_insert (merged, csp, qmpi_lvl, v);
+    }
+  else
+    {
+      mpiPi_merge_individual_callsite_records (csp, p);
+      mpiPi_merge_site_times (csp, p);
+      if (csp->lat > 0 && p->lat > 0)
+	mpiPi_latency_merge (lt, csp->lat, p->lat);
+    }
+}
+
+
+/*  Merges the callsite records of all tasks up a binomial tree rooted at
+    the collector.  Each task merges the records of its children into its
+    own by op and call path, then sends them to its parent, so no task
+    receives more than log2(size) messages.  Returns the merged records
+    at the collector and NULL elsewhere.  */
+static h_t *
+mpiPi_tree_merge (callsite_stats_t ** av, int ac, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  mpiPi_callpaths_t *cp = &gs_ptr->mpiPi.callpaths;
+  int size = gs_ptr->mpiPi.size;
+  int root = gs_ptr->mpiPi.collectorRank;
+  int rel = (gs_ptr->mpiPi.rank - root + size) % size;
+  int i, mask, count;
+  callsite_stats_t **mv;
+  callsite_stats_t *buf;
+  h_t *merged;
+
+  merged = h_open (gs_ptr->mpiPi.tableSize,
+		   mpiPi_callsite_stats_path_hashkey,
+		   mpiPi_callsite_stats_path_comparator);
+
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t rec = *av[i];
+      rec.rank = -1;
+      rec.siteCount = 1;
+      rec.siteMean = rec.cumulativeTime;
+      rec.siteM2 = 0;
+      mpiPi_tree_merge_record (merged, &rec, qmpi_lvl, v);
+    }
+
+  for (mask = 1; mask < size; mask <<= 1)
+    {
+      if (rel & mask)
+	{
+	  int parent = (rel - mask + root) % size;
+	  char *wire;
+	  int wire_len;
+
+	  h_gather_data (merged, &count, (void ***) &mv);
+	  wire_len = mpiPi_wire_pack (mv, count, cp, &gs_ptr->mpiPi.latency,
+				      &wire);
+	  if (wire_len < 0)
+	    mpiPi_abort (qmpi_lvl,v,"failed to pack callsite records\n");
+	  PMPI_Send (wire, wire_len, MPI_CHAR, parent, gs_ptr->mpiPi.tag,
+		     gs_ptr->mpiPi.comm);
+	  for (i = 0; i < count; i++)
+	    free (mv[i]);
+	  free (wire);
+	  free (mv);
+	  h_close (merged);
+	  return NULL;
+	}
+      else if (rel + mask < size)
+	{
+	  int child = (rel + mask + root) % size;
+
+	  count = mpiPi_recv_callsites (child, &buf, qmpi_lvl, v);
+	  for (i = 0; i < count; i++)
+	    mpiPi_tree_merge_record (merged, &buf[i], qmpi_lvl, v);
+	  free (buf);
+	}
+    }
+
+  return merged;
+}
+
+
+/*  Sums the task totals of the report at the collector.  */
+static void
+mpiPi_reduce_totals (callsite_stats_t ** av, int ac, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  double sums[4] = { 0, 0, 0, 0 }, global_sums[4];
+  long long counts[3] = { 0, 0, 0 }, global_counts[3];
+  int i;
+
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t *p = av[i];
+
+      sums[0] += p->cumulativeTime;
+      sums[1] += p->cumulativeDataSent;
+      sums[2] += p->cumulativeIO;
+      sums[3] += p->cumulativeRMA;
+      if (p->cumulativeTime > 0)
+	counts[0]++;
+      if (p->cumulativeDataSent > 0)
+	{
+	  counts[1] += p->arbitraryMessageCount;
+	  counts[2] += p->count;
+	}
+    }
+
+  PMPI_Reduce (sums, global_sums, 4, MPI_DOUBLE, MPI_SUM,
+	       gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+  PMPI_Reduce (counts, global_counts, 3, MPI_LONG_LONG, MPI_SUM,
+	       gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+  PMPI_Gather (&sums[0], 1, MPI_DOUBLE,
+	       gs_ptr->mpiPi.global_task_mpi_time, 1, MPI_DOUBLE,
+	       gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+
+  if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+    {
+      gs_ptr->mpiPi.global_mpi_time = global_sums[0];
+      gs_ptr->mpiPi.global_mpi_size = global_sums[1];
+      gs_ptr->mpiPi.global_mpi_io = global_sums[2];
+      gs_ptr->mpiPi.global_mpi_rma = global_sums[3];
+      gs_ptr->mpiPi.global_time_callsite_count = global_counts[0];
+      gs_ptr->mpiPi.global_mpi_msize_threshold_count = global_counts[1];
+      gs_ptr->mpiPi.global_mpi_sent_count = global_counts[2];
+    }
+}
+
+
+/*  Opens the pc cache for source lookup and, at the collector, the
+    symbol cache (-i).  */
+void
+mpiPi_open_lookup (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  if (callsite_pc_cache == NULL)
+    {
+      callsite_pc_cache = h_open (gs_ptr->mpiPi.tableSize,
+				  callsite_pc_cache_hashkey,
+				  callsite_pc_cache_comparator);
+    }
+
+  if (gs_ptr->mpiPi.symcacheDir != NULL
+      && gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+    {
+      if (mpiPi_symcache_open (gs_ptr->mpiPi.symcacheDir,
+			       gs_ptr->mpiPi.appName) == 0)
+	mpiPi_msg_debug (qmpi_lvl,v,"Using symbol cache %s\n",
+			 mpiPi_symcache_path ());
+      else
+	mpiPi_msg_warn (qmpi_lvl,v,"Symbol cache in %s not used: the "
+			"executable has no build-id or the cache is not "
+			"an mpiP symbol cache.\n",
+			gs_ptr->mpiPi.symcacheDir);
+    }
+}
+
+
+/*  Closes what source lookups opened, but keeps the pc cache.  */
+void
+mpiPi_close_lookup (int qmpi_lvl, vector * v)
+{
+#if defined(ENABLE_BFD) || defined(USE_LIBDWARF)
+  mpiPi_close_executable (qmpi_lvl, v);
+#endif
+  mpiPi_symcache_close ();
+}
+
+
+#if defined(ENABLE_BFD) || defined(USE_LIBDWARF)
+static int
+mpiPi_pc_sort (const void *a, const void *b)
+{
+  char *pa = *(char **) a;
+  char *pb = *(char **) b;
+
+  return pa < pb ? -1 : pa > pb;
+}
+
+
+/*  Resolves the unique pcs of the merged records ahead of the report.
+    The collector broadcasts them, consecutive slices of about
+    MPIP_LOOKUP_CHUNK pcs are resolved by as many tasks from the
+    collector on, and their results are gathered into the collector's
+    callsite_pc_cache.  A slice whose task could not open the
+    executable is left to the collector's own lookups.  */
+static void
+mpiPi_lookup_pcs (h_t * merged, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  int size = gs_ptr->mpiPi.size;
+  int root = gs_ptr->mpiPi.collectorRank;
+  int rel = (gs_ptr->mpiPi.rank - root + size) % size;
+  int count = 0, helpers, first, last, len, i, r;
+  int *lens = NULL, *displs = NULL;
+  char *out = NULL, *all = NULL;
+  void **pcs = NULL;
+
+  if (rel == 0 && gs_ptr->mpiPi.do_lookup == 1 && gs_ptr->mpiPi.stackDepth > 0)
+    {
+      callsite_stats_t **mv;
+      int mc, j;
+
+      h_gather_data (merged, &mc, (void ***) &mv);
+      pcs = (void **) malloc ((mc * gs_ptr->mpiPi.stackDepth + 1) *
+			      sizeof (void *));
+      for (i = 0; i < mc; i++)
+	{
+	  void **pc = mpiPi_callpath_pcs (&gs_ptr->mpiPi.callpaths,
+					  mv[i]->path);
+	  for (j = 0; j < gs_ptr->mpiPi.stackDepth && pc[j] != NULL; j++)
+	    pcs[count++] = pc[j];
+	}
+      free (mv);
+      qsort (pcs, count, sizeof (void *), mpiPi_pc_sort);
+
+      /*  pcs in the symbol cache are resolved here, the rest below.  */
+      for (i = j = 0; i < count; i++)
+	{
+	  char *filename, *functname;
+	  int lineno;
+
+	  if (j > 0 && pcs[i] == pcs[j - 1])
+	    continue;
+	  if (mpiPi_symcache_find (pcs[i], NULL, NULL, NULL) == 0)
+	    mpiPi_query_pc (qmpi_lvl, v, pcs[i], &filename, &functname,
+			    &lineno);
+	  else
+	    pcs[j++] = pcs[i];
+	}
+      count = j;
+    }
+
+  PMPI_Bcast (&count, 1, MPI_INT, root, gs_ptr->mpiPi.comm);
+  if (count == 0)
+    {
+      free (pcs);
+      return;
+    }
+  if (rel != 0)
+    pcs = (void **) malloc (count * sizeof (void *));
+  PMPI_Bcast (pcs, count * sizeof (void *), MPI_CHAR, root,
+	      gs_ptr->mpiPi.comm);
+
+  helpers = (count + MPIP_LOOKUP_CHUNK - 1) / MPIP_LOOKUP_CHUNK;
+  if (helpers > size)
+    helpers = size;
+
+  /*  Resolve this task's slice.  The collector's results are already in
+      its cache; the others are sent as line, file, and function.  */
+  len = 0;
+  if (rel < helpers)
+    {
+      int cap = 0;
+
+      first = (long long) rel * count / helpers;
+      last = (long long) (rel + 1) * count / helpers;
+      if (rel != 0)
+	{
+	  mpiPi_open_lookup (qmpi_lvl, v);
+	  if (mpiPi_open_executable (qmpi_lvl, v) != 1)
+	    last = first;	/* the collector resolves this slice */
+	}
+      for (i = first; i < last; i++)
+	{
+	  char *filename, *functname, *p;
+	  int lineno, need;
+
+	  mpiPi_query_pc (qmpi_lvl, v, pcs[i], &filename, &functname, &lineno);
+	  if (rel == 0)
+	    continue;
+	  need = sizeof (int) + strlen (filename) + strlen (functname) + 2;
+	  if (len + need > cap)
+	    {
+	      cap = 2 * (len + need);
+	      out = (char *) realloc (out, cap);
+	      if (out == NULL)
+		mpiPi_abort (qmpi_lvl,v,"failed to allocate source lookup results\n");
+	    }
+	  p = out + len;
+	  memcpy (p, &lineno, sizeof (int));
+	  p += sizeof (int);
+	  strcpy (p, filename);
+	  p += strlen (filename) + 1;
+	  strcpy (p, functname);
+	  len += need;
+	}
+      if (rel != 0)
+	mpiPi_close_executable (qmpi_lvl, v);
+    }
+
+  if (rel == 0)
+    {
+      lens = (int *) malloc (size * sizeof (int));
+      displs = (int *) malloc (size * sizeof (int));
+    }
+  PMPI_Gather (&len, 1, MPI_INT, lens, 1, MPI_INT, root, gs_ptr->mpiPi.comm);
+  if (rel == 0)
+    {
+      int total = 0;
+
+      for (r = 0; r < size; r++)
+	{
+	  displs[r] = total;
+	  total += lens[r];
+	}
+      all = (char *) malloc (total + 1);
+    }
+  PMPI_Gatherv (out, len, MPI_CHAR, all, lens, displs, MPI_CHAR, root,
+		gs_ptr->mpiPi.comm);
+
+  if (rel == 0)
+    {
+      for (r = 1; r < helpers; r++)
+	{
+	  int task = (r + root) % size;
+	  char *p = all + displs[task];
+
+	  if (lens[task] == 0)
+	    continue;
+	  first = (long long) r * count / helpers;
+	  last = (long long) (r + 1) * count / helpers;
+	  for (i = first; i < last; i++)
+	    {
+	      callsite_pc_cache_entry_t key, *csp;
+
+	      key.pc = pcs[i];
+	      if (h_search (callsite_pc_cache, &key, (void **) &csp, qmpi_lvl,
+			    v) != NULL)
+		{
+		  p += sizeof (int);
+		  p += strlen (p) + 1;
+		  p += strlen (p) + 1;
+		  continue;
+		}
+	      csp = (callsite_pc_cache_entry_t *)
+		malloc (sizeof (callsite_pc_cache_entry_t));
+	      csp->pc = pcs[i];
+	      memcpy (&csp->line, p, sizeof (int));
+	      p += sizeof (int);
+	      csp->filename = strdup (p);
+	      p += strlen (p) + 1;
+	      csp->functname = strdup (p);
+	      p += strlen (p) + 1;
+	      h_insert (callsite_pc_cache, csp, qmpi_lvl, v);
+	      mpiPi_symcache_add (csp->pc, csp->filename, csp->functname,
+				  csp->line);
+	    }
+	}
+      mpiPi_msg_debug (qmpi_lvl,v,"resolved %d pcs on %d tasks\n", count,
+		       helpers);
+    }
+
+  free (lens);
+  free (displs);
+  free (all);
+  free (out);
+  free (pcs);
+}
+#endif
+
+
 static int
 mpiPi_mergeResults ( int qmpi_lvl , vector* v)
 {
@@ -720,16 +1246,13 @@ mpiPi_mergeResults ( int qmpi_lvl , vector* v)
   int ac;
   callsite_stats_t **av;
   int totalCount = 0;
-  int maxCount = 0;
   int retval = 1, sendval;
+  h_t *merged;
 
   /* gather local task data */
   h_gather_data (gs_ptr->mpiPi.task_callsite_stats, &ac, (void ***) &av);
 
-  /* determine size of space necessary on collector */
   PMPI_Allreduce (&ac, &totalCount, 1, MPI_INT, MPI_SUM, gs_ptr->mpiPi.comm);
-  PMPI_Reduce (&ac, &maxCount, 1, MPI_INT, MPI_MAX, gs_ptr->mpiPi.collectorRank,
-	       gs_ptr->mpiPi.comm);
 
   if (totalCount < 1)
     {
@@ -740,47 +1263,29 @@ mpiPi_mergeResults ( int qmpi_lvl , vector* v)
       return 0;
     }
 
-  /* gather global data at collector */
-  if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
-    {
-      int i;
-      int ndx = 0;
+  mpiPi_reduce_totals (av, ac, qmpi_lvl, v);
+  merged = mpiPi_tree_merge (av, ac, qmpi_lvl, v);
 
-#ifdef ENABLE_BFD
-      if (gs_ptr->mpiPi.appFullName != NULL)
-	{
-	  if (open_bfd_executable (gs_ptr->mpiPi.appFullName) == 0)
-	    gs_ptr->mpiPi.do_lookup = 0;
-	}
-#elif defined(USE_LIBDWARF)
-      if (gs_ptr->mpiPi.appFullName != NULL)
-	{
-	  if (open_dwarf_executable (gs_ptr->mpiPi.appFullName) == 0)
-	    gs_ptr->mpiPi.do_lookup = 0;
-	}
-#endif
+  if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+    mpiPi_open_lookup (qmpi_lvl, v);
 #if defined(ENABLE_BFD) || defined(USE_LIBDWARF)
-      else
-	{
-	  mpiPi_msg_warn
-	    ("Failed to open executable.  The mpiP -x runtime flag may address this issue.\n");
-	  gs_ptr->mpiPi.do_lookup = 0;
-	}
+  mpiPi_lookup_pcs (merged, qmpi_lvl, v);
 #endif
 
+  if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+    {
+      int i;
+      int mc;
+      callsite_stats_t **mv;
+
       /* Open call site hash tables.  */
-      gs_ptr->mpiPi.global_callsite_stats = h_open (gs_ptr->mpiPi.tableSize,
+      if (gs_ptr->mpiPi.collective_report == 0)
+	gs_ptr->mpiPi.global_callsite_stats = h_open (gs_ptr->mpiPi.tableSize,
 					    mpiPi_callsite_stats_src_hashkey,
 					    mpiPi_callsite_stats_src_comparator);
       gs_ptr->mpiPi.global_callsite_stats_agg = h_open (gs_ptr->mpiPi.tableSize,
 						mpiPi_callsite_stats_src_id_hashkey,
 						mpiPi_callsite_stats_src_id_comparator);
-      if (callsite_pc_cache == NULL)
-	{
-	  callsite_pc_cache = h_open (gs_ptr->mpiPi.tableSize,
-				      callsite_pc_cache_hashkey,
-				      callsite_pc_cache_comparator);
-	}
       if (gs_ptr->callsite_src_id_cache == NULL)
 	{
 	  gs_ptr->callsite_src_id_cache = h_open ( (gs_ptr->mpiPi).tableSize,
@@ -788,63 +1293,54 @@ mpiPi_mergeResults ( int qmpi_lvl , vector* v)
 					  callsite_src_id_cache_comparator);
 
 	}
-      /* Try to allocate space for max count of callsite info from all tasks  */
-      gs_ptr->mpiPi.rawCallsiteData =
-	(callsite_stats_t *) calloc (maxCount, sizeof (callsite_stats_t));
-      if (gs_ptr->mpiPi.rawCallsiteData == NULL)
+
+      /* The summary comes from the records merged up the tree.  */
+      h_gather_data (merged, &mc, (void ***) &mv);
+      for (i = 0; i < mc; i++)
 	{
-	  mpiPi_msg_warn
-	    (qmpi_lvl,v,"Failed to allocate memory to collect callsite info");
-	  retval = 0;
+	  mpiPi_insert_callsite_agg (mv[i],qmpi_lvl,v);
+	  free (mv[i]);
 	}
+      free (mv);
+      h_close (merged);
 
-      /* Clear global_mpi_time and global_mpi_size before accumulation in mpiPi_insert_callsite_records */
-      gs_ptr->mpiPi.global_mpi_time = 0.0;
-      gs_ptr->mpiPi.global_mpi_size = 0.0;
-
-      if (retval == 1)
+      /* The single collector report also lists every task's records,
+         which only the collector can gather.  */
+      if (gs_ptr->mpiPi.collective_report == 0)
 	{
-	  /* Insert collector callsite data into global and task-specific hash tables */
+	  int ndx;
+
+	  /* Insert collector callsite data into the task-specific hash table */
 	  for (ndx = 0; ndx < ac; ndx++)
 	    {
 	      mpiPi_insert_callsite_records (av[ndx],qmpi_lvl,v);
 	    }
-	  ndx = 0;
 	  for (i = 1; i < gs_ptr->mpiPi.size; i++)	/* n-1 */
 	    {
-	      MPI_Status status;
-	      int count;
-	      int j;
+	      callsite_stats_t *buf;
+	      int count, j;
 
 	      /* okay in any order */
-	      PMPI_Probe (MPI_ANY_SOURCE, gs_ptr->mpiPi.tag, gs_ptr->mpiPi.comm, &status);
-	      PMPI_Get_count (&status, MPI_CHAR, &count);
-	      PMPI_Recv (&(gs_ptr->mpiPi.rawCallsiteData[ndx]), count, MPI_CHAR,
-			 status.MPI_SOURCE, gs_ptr->mpiPi.tag, gs_ptr->mpiPi.comm, &status);
-	      count /= sizeof (callsite_stats_t);
-
-
+	      count = mpiPi_recv_callsites (MPI_ANY_SOURCE, &buf, qmpi_lvl, v);
 	      for (j = 0; j < count; j++)
-		{
-		  mpiPi_insert_callsite_records (&(gs_ptr->mpiPi.rawCallsiteData[j]),qmpi_lvl,v);
-		}
+		mpiPi_insert_callsite_records (&buf[j],qmpi_lvl,v);
+	      free (buf);
 	    }
-	  free (gs_ptr->mpiPi.rawCallsiteData);
 	}
     }
-  else
+  else if (gs_ptr->mpiPi.collective_report == 0)
     {
-      int ndx;
-      char *sbuf = (char *) malloc (ac * sizeof (callsite_stats_t));
-      for (ndx = 0; ndx < ac; ndx++)
-	{
-	  bcopy (av[ndx],
-		 &(sbuf[ndx * sizeof (callsite_stats_t)]),
-		 sizeof (callsite_stats_t));
-	}
-      PMPI_Send (sbuf, ac * sizeof (callsite_stats_t),
-		 MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.tag, gs_ptr->mpiPi.comm);
-      free (sbuf);
+      char *wire;
+      int wire_len;
+
+      /* the per-task records are sent without histograms */
+      wire_len = mpiPi_wire_pack (av, ac, &gs_ptr->mpiPi.callpaths, NULL,
+				  &wire);
+      if (wire_len < 0)
+	mpiPi_abort (qmpi_lvl,v,"failed to pack callsite records\n");
+      PMPI_Send (wire, wire_len, MPI_CHAR, gs_ptr->mpiPi.collectorRank,
+		 gs_ptr->mpiPi.tag, gs_ptr->mpiPi.comm);
+      free (wire);
     }
   if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank && retval == 1)
     {
@@ -862,17 +1358,7 @@ mpiPi_mergeResults ( int qmpi_lvl , vector* v)
   free (av);
 
   if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
-    {
-      if (gs_ptr->mpiPi.do_lookup == 1)
-	{
-#ifdef ENABLE_BFD
-	  /* clean up */
-	  close_bfd_executable ();
-#elif defined(USE_LIBDWARF)
-	  close_dwarf_executable ();
-#endif
-	}
-    }
+    mpiPi_close_lookup (qmpi_lvl, v);
 
   /*  Quadrics MPI does not appear to support MPI_IN_PLACE   */
   sendval = retval;
@@ -881,6 +1367,83 @@ mpiPi_mergeResults ( int qmpi_lvl , vector* v)
 }
 
 
+/*  Broadcasts the collector's summary record p, and its call path, for
+    the collective report.  On the other tasks p->path becomes the id of
+    the same path among their own.  */
+void
+mpiPi_bcast_callsite (callsite_stats_t * p, int qmpi_lvl , vector* v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  mpiPi_callpaths_t *cp = &gs_ptr->mpiPi.callpaths;
+  void *pc[MPIP_CALLSITE_STACK_DEPTH_MAX + 1];
+
+  PMPI_Bcast (p, sizeof (callsite_stats_t),
+	      MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+  if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+    memcpy (pc, mpiPi_callpath_pcs (cp, p->path), cp->depth * sizeof (void *));
+  PMPI_Bcast (pc, cp->depth * sizeof (void *),
+	      MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+  if (gs_ptr->mpiPi.rank != gs_ptr->mpiPi.collectorRank)
+    {
+      p->path = mpiPi_callpath_intern (cp, pc);
+      if (p->path < 0)
+	mpiPi_abort (qmpi_lvl,v,"failed to allocate call paths\n");
+    }
+}
+
+
+/*  Sums the histogram cells of all tasks into the collector's up a
+    binomial tree.  Only the cells a task used are sent.  */
+static void
+mpiPi_merge_hist_cells (mpiPi_hist_cells_t * h, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  int size = gs_ptr->mpiPi.size;
+  int root = gs_ptr->mpiPi.collectorRank;
+  int rel = (gs_ptr->mpiPi.rank - root + size) % size;
+  mpiPi_hist_cell_t *cells;
+  MPI_Status status;
+  int i, mask, count;
+
+  for (mask = 1; mask < size; mask <<= 1)
+    {
+      if (rel & mask)
+	{
+	  int parent = (rel - mask + root) % size;
+
+	  count = mpiPi_hist_cells_gather (h, &cells);
+	  if (count < 0)
+	    mpiPi_abort (qmpi_lvl,v,"failed to allocate histogram cells\n");
+	  PMPI_Send (cells, count * sizeof (mpiPi_hist_cell_t), MPI_CHAR,
+		     parent, gs_ptr->mpiPi.tag, gs_ptr->mpiPi.comm);
+	  free (cells);
+	  return;
+	}
+      else if (rel + mask < size)
+	{
+	  int child = (rel + mask + root) % size;
+
+	  PMPI_Probe (child, gs_ptr->mpiPi.tag, gs_ptr->mpiPi.comm, &status);
+	  PMPI_Get_count (&status, MPI_CHAR, &count);
+	  cells = (mpiPi_hist_cell_t *) malloc (count + 1);
+	  if (cells == NULL)
+	    mpiPi_abort (qmpi_lvl,v,"failed to allocate histogram cells\n");
+	  PMPI_Recv (cells, count, MPI_CHAR, child, gs_ptr->mpiPi.tag,
+		     gs_ptr->mpiPi.comm, &status);
+	  count /= sizeof (mpiPi_hist_cell_t);
+	  for (i = 0; i < count; i++)
+	    if (mpiPi_hist_cells_add (h, cells[i].key, cells[i].value) != 0)
+	      mpiPi_abort (qmpi_lvl,v,"failed to allocate histogram cells\n");
+	  free (cells);
+	}
+    }
+}
+
+
 static int
 mpiPi_mergeCollectiveStats ( int qmpi_lvl , vector* v)
 {
@@ -888,40 +1451,11 @@ mpiPi_mergeCollectiveStats ( int qmpi_lvl , vector* v)
 	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
 	// CHANGE END
 
-  int matrix_size;
-  int all_call_count;
-  double *coll_time_results, *coll_time_local;
-  int i, x, y, z;
-
   if (gs_ptr->mpiPi.do_collective_stats_report)
     {
-      all_call_count = mpiPi_DEF_END - mpiPi_BASE + 1;
-      matrix_size =
-	all_call_count * gs_ptr->mpiPi.coll_comm_histogram.hist_size *
-	gs_ptr->mpiPi.coll_size_histogram.hist_size;
-      mpiPi_msg_debug (qmpi_lvl,v,"matrix_size is %d, histogram data is %d\n",
-		       matrix_size, sizeof (gs_ptr->mpiPi.coll_time_stats));
-      coll_time_local = (double *) malloc (matrix_size * sizeof (double));
-      coll_time_results = (double *) malloc (matrix_size * sizeof (double));
-
-      i = 0;
-      for (x = 0; x < mpiPi_DEF_END - mpiPi_BASE; x++)
-	for (y = 0; y < 32; y++)
-	  for (z = 0; z < 32; z++)
-	    coll_time_local[i++] = gs_ptr->mpiPi.coll_time_stats[x][y][z];
-
-      /*  Collect Collective statistic data were used  */
-      PMPI_Reduce (coll_time_local, coll_time_results, matrix_size,
-		   MPI_DOUBLE, MPI_SUM, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
-
-      i = 0;
-      for (x = 0; x < mpiPi_DEF_END - mpiPi_BASE; x++)
-	for (y = 0; y < 32; y++)
-	  for (z = 0; z < 32; z++)
-	    gs_ptr->mpiPi.coll_time_stats[x][y][z] = coll_time_results[i++];
-
-      free (coll_time_local);
-      free (coll_time_results);
+      mpiPi_msg_debug (qmpi_lvl,v,"merging %d collective histogram cells\n",
+		       gs_ptr->mpiPi.coll_time_stats.count);
+      mpiPi_merge_hist_cells (&gs_ptr->mpiPi.coll_time_stats, qmpi_lvl, v);
     }
 
   return 1;
@@ -935,40 +1469,119 @@ mpiPi_mergept2ptStats ( int qmpi_lvl , vector* v)
 	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
 	// CHANGE END
 
-  int matrix_size;
-  int all_call_count;
-  double *pt2pt_send_results, *pt2pt_send_local;
-  int i, x, y, z;
-
   if (gs_ptr->mpiPi.do_pt2pt_stats_report)
     {
-      all_call_count = mpiPi_DEF_END - mpiPi_BASE + 1;
-      matrix_size =
-	all_call_count * gs_ptr->mpiPi.pt2pt_comm_histogram.hist_size *
-	gs_ptr->mpiPi.pt2pt_size_histogram.hist_size;
-      mpiPi_msg_debug (qmpi_lvl,v,"matrix_size is %d, histogram data is %d\n",
-		       matrix_size, sizeof (gs_ptr->mpiPi.pt2pt_send_stats));
-      pt2pt_send_local = (double *) malloc (matrix_size * sizeof (double));
-      pt2pt_send_results = (double *) malloc (matrix_size * sizeof (double));
-
-      i = 0;
-      for (x = 0; x < mpiPi_DEF_END - mpiPi_BASE; x++)
-	for (y = 0; y < 32; y++)
-	  for (z = 0; z < 32; z++)
-	    pt2pt_send_local[i++] = gs_ptr->mpiPi.pt2pt_send_stats[x][y][z];
-
-      /*  Collect Collective statistic data were used  */
-      PMPI_Reduce (pt2pt_send_local, pt2pt_send_results, matrix_size,
-		   MPI_DOUBLE, MPI_SUM, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
-
-      i = 0;
-      for (x = 0; x < mpiPi_DEF_END - mpiPi_BASE; x++)
-	for (y = 0; y < 32; y++)
-	  for (z = 0; z < 32; z++)
-	    gs_ptr->mpiPi.pt2pt_send_stats[x][y][z] = pt2pt_send_results[i++];
-
-      free (pt2pt_send_local);
-      free (pt2pt_send_results);
+      mpiPi_msg_debug (qmpi_lvl,v,"merging %d point-to-point histogram cells\n",
+		       gs_ptr->mpiPi.pt2pt_send_stats.count);
+      mpiPi_merge_hist_cells (&gs_ptr->mpiPi.pt2pt_send_stats, qmpi_lvl, v);
+    }
+
+  return 1;
+}
+
+
+/*  Merges the phase records of the tasks, set aside by
+    mpiPi_phase_collapse, and their totals at the collector.  There the
+    phase takes the place of the rank in the records.  */
+static int
+mpiPi_mergePhaseStats (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+  double sums[2 * MPIP_PHASES_MAX], global_sums[2 * MPIP_PHASES_MAX];
+  long long calls[MPIP_PHASES_MAX], global_calls[MPIP_PHASES_MAX];
+  callsite_stats_t **av, **rv, *recs;
+  h_t *merged;
+  int i, ac;
+
+  bzero (sums, sizeof (sums));
+  bzero (calls, sizeof (calls));
+  mpiPi_phase_times (sums, qmpi_lvl, v);
+
+  h_gather_data (gs_ptr->mpiPi.phaseTable, &ac, (void ***) &av);
+  recs = (callsite_stats_t *) malloc (ac * sizeof (callsite_stats_t) + 1);
+  rv = (callsite_stats_t **) malloc (ac * sizeof (callsite_stats_t *) + 1);
+  if (recs == NULL || rv == NULL)
+    mpiPi_abort (qmpi_lvl,v,"failed to allocate phase records\n");
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t *p = av[i];
+
+      sums[MPIP_PHASES_MAX + p->phase] += p->cumulativeTime;
+      calls[p->phase] += p->count;
+      recs[i] = *p;
+      recs[i].lat = 0;		/* percentiles are reported per callsite */
+      rv[i] = &recs[i];
+    }
+
+  PMPI_Reduce (sums, global_sums, 2 * MPIP_PHASES_MAX, MPI_DOUBLE, MPI_SUM,
+	       gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+  PMPI_Reduce (calls, global_calls, MPIP_PHASES_MAX, MPI_LONG_LONG, MPI_SUM,
+	       gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+
+  /* the collector may still be receiving the records of the report */
+  gs_ptr->mpiPi.tag++;
+  merged = mpiPi_tree_merge (rv, ac, qmpi_lvl, v);
+  gs_ptr->mpiPi.tag--;
+  free (recs);
+  free (rv);
+  free (av);
+
+  if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+    {
+      mpiPi_phase_t *ph;
+      callsite_stats_t **mv;
+      int mc;
+
+      if (gs_ptr->mpiPi.global_phases == NULL)
+	gs_ptr->mpiPi.global_phases =
+	  (mpiPi_phase_t *) calloc (MPIP_PHASES_MAX, sizeof (mpiPi_phase_t));
+      ph = gs_ptr->mpiPi.global_phases;
+      if (ph == NULL)
+	mpiPi_abort (qmpi_lvl,v,"failed to allocate phase totals\n");
+
+      gs_ptr->mpiPi.global_phase_count = 0;
+      for (i = 0; i < MPIP_PHASES_MAX; i++)
+	{
+	  mpiPi_phase_label (i, ph[i].name, sizeof (ph[i].name), qmpi_lvl, v);
+	  ph[i].appTime = global_sums[i];
+	  ph[i].mpiTime = global_sums[MPIP_PHASES_MAX + i];
+	  ph[i].calls = global_calls[i];
+	  if (ph[i].calls > 0 || (i > 0 && ph[i].appTime > 0))
+	    gs_ptr->mpiPi.global_phase_count = i + 1;
+	}
+
+      if (gs_ptr->mpiPi.global_phase_stats != NULL)
+	{
+	  h_gather_data (gs_ptr->mpiPi.global_phase_stats, &mc, (void ***) &mv);
+	  for (i = 0; i < mc; i++)
+	    free (mv[i]);
+	  free (mv);
+	  h_close (gs_ptr->mpiPi.global_phase_stats);
+	}
+      gs_ptr->mpiPi.global_phase_stats = h_open (gs_ptr->mpiPi.tableSize,
+					 mpiPi_callsite_stats_src_hashkey,
+					 mpiPi_callsite_stats_src_comparator);
+
+      h_gather_data (merged, &mc, (void ***) &mv);
+      for (i = 0; i < mc; i++)
+	{
+	  callsite_stats_t *p = mv[i], *csp = NULL;
+
+	  mpiPi_query_src (p, qmpi_lvl, v);
+	  p->rank = p->phase;
+	  if (NULL == h_search (gs_ptr->mpiPi.global_phase_stats, p,
+				(void **) &csp, qmpi_lvl, v))
+	    h_insert (gs_ptr->mpiPi.global_phase_stats, p, qmpi_lvl, v);
+	  else
+	    {
+	      mpiPi_merge_individual_callsite_records (csp, p);
+	      free (p);
+	    }
+	}
+      free (mv);
+      h_close (merged);
     }
 
   return 1;
@@ -1008,6 +1621,8 @@ mpiPi_publishResults (int report_style, int qmpi_lvl , vector* v)
 	}
       else
 	{
+	  /* large reports are written in few system calls */
+	  setvbuf (fp, NULL, _IOFBF, MPIP_REPORT_BUFFER_SIZE);
 	  mpiPi_msg (qmpi_lvl,v,"\n");
 	  mpiPi_msg (qmpi_lvl,v,"Storing mpiP output in [%s].\n", gs_ptr->mpiPi.oFilename);
 	  mpiPi_msg (qmpi_lvl,v,"\n");
@@ -1022,6 +1637,46 @@ mpiPi_publishResults (int report_style, int qmpi_lvl , vector* v)
 }
 
 
+/*  Writes the merged statistics as a binary profile instead of the
+    report, for mpip-report to print later.  */
+static void
+mpiPi_publishProfile (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  static int printCount = 0;
+
+  if (gs_ptr->mpiPi.collectorRank != gs_ptr->mpiPi.rank)
+    return;
+
+  do
+    {
+      printCount++;
+      snprintf (gs_ptr->mpiPi.oFilename, 256, "%s/%s.%d.%d.%d.mpiPb",
+		gs_ptr->mpiPi.outputDir, gs_ptr->mpiPi.appName,
+		gs_ptr->mpiPi.size, gs_ptr->mpiPi.procID, printCount);
+    }
+  while (access (gs_ptr->mpiPi.oFilename, F_OK) == 0);
+
+  if (mpiPi_profile_write (gs_ptr->mpiPi.oFilename, qmpi_lvl, v))
+    {
+      mpiPi_msg (qmpi_lvl,v,"\n");
+      mpiPi_msg (qmpi_lvl,v,"Storing mpiP profile in [%s].\n",
+		 gs_ptr->mpiPi.oFilename);
+      mpiPi_msg (qmpi_lvl,v,"\n");
+    }
+  else
+    {
+      mpiPi_msg_warn (qmpi_lvl,v,"Could not write [%s], writing the report\n",
+		      gs_ptr->mpiPi.oFilename);
+      unlink (gs_ptr->mpiPi.oFilename);
+      gs_ptr->mpiPi.binaryProfile = 0;
+    }
+}
+
+
 /*
  * mpiPi_collect_basics() - all tasks send their basic info to the
  * collectorRank.
@@ -1099,6 +1754,11 @@ mpiPi_collect_basics (int report_style, int qmpi_lvl , vector* v)
 	       gs_ptr->mpiPi.global_task_app_time, 1, MPI_DOUBLE,
 	       gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
 
+  /* the report says when the MPI times are summed over threads */
+  PMPI_Reduce (&gs_ptr->mpiPi.threadCount, &gs_ptr->mpiPi.global_thread_max,
+	       1, MPI_INT, MPI_MAX, gs_ptr->mpiPi.collectorRank,
+	       gs_ptr->mpiPi.comm);
+
   if (report_style == mpiPi_style_verbose || report_style == mpiPi_style_both)
     {
       PMPI_Gather (gs_ptr->mpiPi.hostname, MPIPI_HOSTNAME_LEN_MAX, MPI_CHAR,
@@ -1106,6 +1766,9 @@ mpiPi_collect_basics (int report_style, int qmpi_lvl , vector* v)
 		   MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
     }
 
+  if (gs_ptr->mpiPi.do_thread_report)
+    mpiPi_thread_gather_times (qmpi_lvl, v);
+
   return;
 }
 
@@ -1119,7 +1782,7 @@ mpiPi_generateReport (int report_style, int qmpi_lvl , vector* v)
 
   mpiP_TIMER dur;
   mpiPi_TIME timer_start, timer_end;
-  int mergeResult;
+  int mergeResult, phased;
 
   mpiPi_GETTIME (&gs_ptr->mpiPi.endTime);
 
@@ -1137,6 +1800,9 @@ mpiPi_generateReport (int report_style, int qmpi_lvl , vector* v)
       mpiPi_msg_warn (qmpi_lvl,v,"Could not get time of day from time()\n");
     }
 
+  mpiPi_thread_merge (qmpi_lvl, v);
+  phased = mpiPi_phase_collapse (qmpi_lvl, v);
+
   /* collect results and publish */
   mpiPi_msg_debug0(qmpi_lvl,v,"starting collect_basics\n");
 
@@ -1157,12 +1823,33 @@ mpiPi_generateReport (int report_style, int qmpi_lvl , vector* v)
     mergeResult = mpiPi_mergeCollectiveStats (qmpi_lvl , v);
   if (mergeResult == 1)
     mergeResult = mpiPi_mergept2ptStats (qmpi_lvl , v);
+  if (mergeResult == 1 && phased)
+    mergeResult = mpiPi_mergePhaseStats (qmpi_lvl , v);
   mpiPi_GETTIME (&timer_end);
   dur = (mpiPi_GETTIMEDIFF (&timer_end, &timer_start) / 1000000.0);
 
   mpiPi_msg_debug0(qmpi_lvl,v,"TIMING : merge time is          %12.6f\n", dur);
   mpiPi_msg_debug0(qmpi_lvl,v,"starting publishResults\n");
 
+  if (mergeResult == 1 && gs_ptr->mpiPi.binaryProfile)
+    {
+      /* Only the single collector report has every task's records.  */
+      if (gs_ptr->mpiPi.collective_report == 0)
+	{
+	  mpiPi_publishProfile (qmpi_lvl , v);
+	  /* the report is printed if the collector could not write it */
+	  PMPI_Bcast (&gs_ptr->mpiPi.binaryProfile, 1, MPI_INT,
+		      gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+	  if (gs_ptr->mpiPi.binaryProfile)
+	    {
+	      mpiPi_phase_restore (qmpi_lvl, v);
+	      return;
+	    }
+	}
+      else if (gs_ptr->mpiPi.collectorRank == gs_ptr->mpiPi.rank)
+	mpiPi_msg_warn (qmpi_lvl,v,"-b requires -r, writing the report\n");
+    }
+
   if (mergeResult == 1)
     {
       mpiPi_GETTIME (&timer_start);
@@ -1177,6 +1864,7 @@ mpiPi_generateReport (int report_style, int qmpi_lvl , vector* v)
       dur = (mpiPi_GETTIMEDIFF (&timer_end, &timer_start) / 1000000.0);
       mpiPi_msg_debug0(qmpi_lvl,v,"TIMING : publish time is        %12.6f\n", dur);
     }
+  mpiPi_phase_restore (qmpi_lvl, v);
 }
 
 
@@ -1189,9 +1877,14 @@ mpiPi_finalize ( int qmpi_lvl , vector* v)
 
   if (gs_ptr->mpiPi.disable_finalize_report == 0)
     mpiPi_generateReport (gs_ptr->mpiPi.report_style, qmpi_lvl , v);
+  if (gs_ptr->mpiPi.traceRate > 0)
+    mpiPi_trace_finalize (qmpi_lvl, v);
 
   /* clean up data structures, etc */
   h_close (gs_ptr->mpiPi.task_callsite_stats);
+  mpiPi_latency_free (&gs_ptr->mpiPi.latency);
+  mpiPi_hist_cells_free (&gs_ptr->mpiPi.coll_time_stats);
+  mpiPi_hist_cells_free (&gs_ptr->mpiPi.pt2pt_send_stats);
 
   if (gs_ptr->mpiPi.global_task_app_time != NULL)
     free (gs_ptr->mpiPi.global_task_app_time);
@@ -1202,15 +1895,17 @@ mpiPi_finalize ( int qmpi_lvl , vector* v)
   if (gs_ptr->mpiPi.global_task_hostnames != NULL)
     free (gs_ptr->mpiPi.global_task_hostnames);
 
+  free (gs_ptr->mpiPi.global_thread_times);
+  gs_ptr->mpiPi.global_thread_times = NULL;
+  free (gs_ptr->mpiPi.global_phases);
+  gs_ptr->mpiPi.global_phases = NULL;
+
   /*  Could do a lot of housekeeping before calling PMPI_Finalize()
    *  but is it worth the additional work?
    *  For instance:
    h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac, (void ***) &av);
-   for (i = 0; (i < 20) && (i < ac); i++)
-   {
-   if (av[i]->siteData != NULL )
-   free (av[i]->siteData);
-   }
+   for (i = 0; i < ac; i++)
+   free (av[i]);
    */
 
   return;
@@ -1226,43 +1921,48 @@ mpiPi_update_callsite_stats (unsigned op, unsigned rank, void **pc,
 	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
 	// CHANGE END
 
-  int i;
+  mpiPi_thread_t *self;
   callsite_stats_t *csp = NULL;
   callsite_stats_t key;
 
   if (!gs_ptr->mpiPi.enabled)
     return;
 
-  assert (gs_ptr->mpiPi.task_callsite_stats != NULL);
+  self = mpiPi_thread_self (qmpi_lvl, v);
+  assert (self->callsite_stats != NULL);
   assert (dur >= 0);
 
+  self->calls++;
+  self->mpiTime += dur;
+
 
   key.op = op;
   key.rank = rank;
+  key.phase = gs_ptr->mpiPi.phase;
   key.cookie = MPIP_CALLSITE_STATS_COOKIE;
-  for (i = 0; i < gs_ptr->mpiPi.stackDepth; i++)
-    {
-      key.pc[i] = pc[i];
-    }
+  key.path = mpiPi_callpath_intern (self->callpaths, pc);
+  if (key.path < 0)
+    mpiPi_abort (qmpi_lvl,v,"failed to allocate call paths\n");
 
-  if (NULL == h_search (gs_ptr->mpiPi.task_callsite_stats, &key, (void **) &csp,qmpi_lvl,v))
+  if (NULL == h_search (self->callsite_stats, &key, (void **) &csp,qmpi_lvl,v))
     {
       /* create and insert */
       csp = (callsite_stats_t *) malloc (sizeof (callsite_stats_t));
       bzero (csp, sizeof (callsite_stats_t));
       csp->op = op;
       csp->rank = rank;
-      for (i = 0; i < gs_ptr->mpiPi.stackDepth; i++)
-	{
-	  csp->pc[i] = pc[i];
-	}
+      csp->path = key.path;
+      csp->phase = key.phase;
       csp->cookie = MPIP_CALLSITE_STATS_COOKIE;
       csp->cumulativeTime = 0;
       csp->minDur = DBL_MAX;
       csp->minDataSent = DBL_MAX;
       csp->minIO = DBL_MAX;
       csp->arbitraryMessageCount = 0;
-      h_insert (gs_ptr->mpiPi.task_callsite_stats, csp,qmpi_lvl,v);
+      csp->lat = mpiPi_latency_new (self->latency);
+      if (csp->lat < 0)
+	mpiPi_abort (qmpi_lvl,v,"failed to allocate latency histograms\n");
+      h_insert (self->callsite_stats, csp,qmpi_lvl,v);
     }
   /* ASSUME: csp cannot be deleted from list */
   csp->count++;
@@ -1272,6 +1972,8 @@ mpiPi_update_callsite_stats (unsigned op, unsigned rank, void **pc,
   assert (csp->cumulativeTimeSquared >= 0);
   csp->maxDur = max (csp->maxDur, dur);
   csp->minDur = min (csp->minDur, dur);
+  if (csp->lat > 0)
+    mpiPi_latency_record (self->latency, csp->lat, dur);
   csp->cumulativeDataSent += sendSize;
   csp->cumulativeIO += ioSize;
   csp->cumulativeRMA += rmaSize;
@@ -1343,11 +2045,13 @@ mpiPi_update_collective_stats (int op, double dur, double size,
   size_bin = get_histogram_bin (&gs_ptr->mpiPi.coll_size_histogram, size);
 
   mpiPi_msg_debug
-    (qmpi_lvl,v,"Adding %.0f time to entry mpiPi.collective_stats[%d][%d][%d] value of %.0f\n",
-     dur, op_idx, comm_bin, size_bin,
-     gs_ptr->mpiPi.coll_time_stats[op_idx][comm_bin][size_bin]);
+    (qmpi_lvl,v,"Adding %.0f time to entry mpiPi.collective_stats[%d][%d][%d]\n",
+     dur, op_idx, comm_bin, size_bin);
 
-  gs_ptr->mpiPi.coll_time_stats[op_idx][comm_bin][size_bin] += dur;
+  if (mpiPi_hist_cells_add (mpiPi_thread_self (qmpi_lvl, v)->coll_time_stats,
+			    MPIP_HIST_KEY (op_idx, comm_bin, size_bin),
+			    dur) != 0)
+    mpiPi_msg_warn (qmpi_lvl,v,"failed to allocate collective histogram cell\n");
 }
 
 
@@ -1368,11 +2072,13 @@ mpiPi_update_pt2pt_stats (int op, double dur, double size, MPI_Comm * comm, int
   size_bin = get_histogram_bin (&gs_ptr->mpiPi.pt2pt_size_histogram, size);
 
   mpiPi_msg_debug
-    (qmpi_lvl,v,"Adding %.0f send size to entry mpiPi.pt2pt_stats[%d][%d][%d] value of %.0f\n",
-     size, op_idx, comm_bin, size_bin,
-     gs_ptr->mpiPi.pt2pt_send_stats[op_idx][comm_bin][size_bin]);
+    (qmpi_lvl,v,"Adding %.0f send size to entry mpiPi.pt2pt_stats[%d][%d][%d]\n",
+     size, op_idx, comm_bin, size_bin);
 
-  gs_ptr->mpiPi.pt2pt_send_stats[op_idx][comm_bin][size_bin] += size;
+  if (mpiPi_hist_cells_add (mpiPi_thread_self (qmpi_lvl, v)->pt2pt_send_stats,
+			    MPIP_HIST_KEY (op_idx, comm_bin, size_bin),
+			    size) != 0)
+    mpiPi_msg_warn (qmpi_lvl,v,"failed to allocate point-to-point histogram cell\n");
 }
 
 
@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <malloc.h>
 #include <math.h>
+#include <pthread.h>
 #include <setjmp.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -49,6 +50,14 @@
 //#define MPIP_CALLSITE_STACK_DEPTH (mpiPi.stackDepth)
 #define MPIP_CALLSITE_STATS_COOKIE 518641
 #define MPIP_CALLSITE_STATS_COOKIE_ASSERT(f) {assert(MPIP_CALLSITE_STATS_COOKIE==((f)->cookie));}
+#define MPIP_WIRE_VERSION 3	/* of the packed records in wire.c */
+#define MPIP_LATENCY_SUB_BITS 3	/* default resolution of -h */
+#define MPIP_LOOKUP_CHUNK 64	/* pcs per task resolving report sources */
+#define MPIP_REPORT_BUFFER_SIZE (1 << 20)	/* stdio buffer of the report */
+#define MPIP_TRACE_BUFFER_EVENTS (1 << 16)	/* per buffer of the trace (-w) */
+#define MPIP_PHASES_MAX 64	/* phases of a task, see phase.c */
+#define MPIP_PHASE_NAME_MAX 32
+#define MPIP_PCONTROL_PHASE 100	/* MPI_Pcontrol flag entering phase 0 */
 
 #ifdef USE_MPI3_CONSTS
 typedef const void mpip_const_void_t;
@@ -83,16 +92,39 @@ typedef struct _callsite_stats
   double cumulativeIO;
   double cumulativeRMA;
   long long arbitraryMessageCount;
-  double *siteData;
-  int siteDataIdx;
-  void *pc[MPIP_CALLSITE_STACK_DEPTH_MAX];
-  char *filename[MPIP_CALLSITE_STACK_DEPTH_MAX];
-  char *functname[MPIP_CALLSITE_STACK_DEPTH_MAX];
-  int lineno[MPIP_CALLSITE_STACK_DEPTH_MAX];
+  long long siteCount;		/* task records merged into this one */
+  double siteMean;		/* of their cumulativeTime */
+  double siteM2;		/* squared deviations from siteMean */
+  int path;			/* call stack, an id in mpiPi.callpaths */
+  int lat;			/* durations, an id + 1 in mpiPi.latency or 0 */
+  int phase;			/* of the task, 0 outside any */
   long cookie;
 }
 callsite_stats_t;
 
+typedef struct _mpiPi_callpaths_t
+{
+  int depth;			/* return addresses per path */
+  int count;			/* paths interned */
+  int capacity;			/* paths the arena has room for */
+  void **pcs;			/* arena, path id at pcs[id * depth] */
+  int index_size;		/* slots in the index, a power of two */
+  unsigned *hashes;		/* hash of the path in each slot */
+  int *index;			/* path id + 1 in each slot, 0 if empty */
+}
+mpiPi_callpaths_t;
+
+/*  Log-linear duration histograms of callsites, see latency.c.  */
+typedef struct _mpiPi_latency_t
+{
+  int sub_bits;			/* log2 of the buckets per power of two */
+  int buckets;			/* per histogram, 0 if disabled */
+  int count;			/* histograms allocated */
+  int capacity;			/* histograms the arena has room for */
+  long long *counts;		/* arena, id at counts[(id - 1) * buckets] */
+}
+mpiPi_latency_t;
+
 typedef struct callsite_src_id_cache_entry_t
 {
   int id;			/* unique id for this src code/stack location */
@@ -133,21 +165,38 @@ enum
   MPIP_CALLSITE_MESS_SUMMARY_FMT, MPIP_CALLSITE_MESS_RANK_FMT,
   MPIP_CALLSITE_IO_SUMMARY_FMT, MPIP_CALLSITE_IO_RANK_FMT,
   MPIP_CALLSITE_TIME_CONCISE_FMT, MPIP_CALLSITE_MESS_CONCISE_FMT,
-  MPIP_HISTOGRAM_FMT
+  MPIP_HISTOGRAM_FMT, MPIP_CALLSITE_LATENCY_FMT, MPIP_THREAD_TIME_FMT,
+  MPIP_PHASE_TIME_FMT, MPIP_PHASE_CALLSITE_FMT
 };
 
 typedef enum
 { MPIP_REPORT_SCI_FORMAT, MPIP_REPORT_FLT_FORMAT }
 MPIP_REPORT_FORMAT_TYPE;
 
+/*  Stack capture modes (-u), see record_stack.c  */
+enum
+{ MPIP_CAPTURE_FULL, MPIP_CAPTURE_FP, MPIP_CAPTURE_CACHE };
+#define MPIP_CAPTURE_REFRESH 128
+
 #ifdef ENABLE_BFD
+/*  A shared object with executable mappings, opened on its first
+    lookup and kept open.  */
 typedef struct SO_INFO
 {
-  void *lvma;
-  void *uvma;
   char *fpath;
   bfd *bfd;
+  asymbol **syms;
+  int open_failed;
 } so_info_t;
+
+/*  An executable mapping, in a table sorted by lvma.  */
+typedef struct SO_RANGE
+{
+  void *lvma;
+  void *uvma;			/* exclusive */
+  char *base;			/* address the object's vmas are relative to */
+  int so;			/* index into so_info */
+} so_range_t;
 #endif
 
 typedef struct _mpiPi_histogram
@@ -157,6 +206,59 @@ typedef struct _mpiPi_histogram
   int *bin_intervals;
 } mpiPi_histogram_t;
 
+/*  Sparse (op, comm size bin, data size bin) histogram, see hist_cells.c.
+    Only the cells an operation has touched are stored.  */
+#define MPIP_HIST_KEY(op_idx, comm_bin, size_bin) \
+  ((((unsigned) (op_idx) << 12) | ((comm_bin) << 6) | (size_bin)) + 1)
+#define MPIP_HIST_OP(key) (((key) - 1) >> 12)
+#define MPIP_HIST_COMM_BIN(key) ((((key) - 1) >> 6) & 63)
+#define MPIP_HIST_SIZE_BIN(key) (((key) - 1) & 63)
+
+typedef struct _mpiPi_hist_cell_t
+{
+  unsigned key;			/* 0 if the slot is unused */
+  double value;
+} mpiPi_hist_cell_t;
+
+typedef struct _mpiPi_hist_cells_t
+{
+  int count;
+  int size;			/* slots, a power of two or 0 */
+  mpiPi_hist_cell_t *cells;
+} mpiPi_hist_cells_t;
+
+/*  The callsite tables a thread records into, see thread.c.  The thread
+    that initialized mpiP uses the task's own tables.  */
+typedef struct _mpiPi_thread_t
+{
+  int id;			/* 0 for the thread that initialized mpiP */
+  int depth;			/* of nested mpiP wrappers */
+  long long calls;
+  double mpiTime;		/* microseconds */
+  h_t *callsite_stats;
+  mpiPi_callpaths_t *callpaths;
+  mpiPi_latency_t *latency;
+  mpiPi_hist_cells_t *coll_time_stats;
+  mpiPi_hist_cells_t *pt2pt_send_stats;
+  struct _mpiPi_thread_t *next;
+} mpiPi_thread_t;
+
+typedef struct _mpiPi_thread_time_t
+{
+  int task;
+  int thread;
+  long long calls;
+  double mpiTime;		/* microseconds */
+} mpiPi_thread_time_t;
+
+typedef struct _mpiPi_phase_t
+{
+  char name[MPIP_PHASE_NAME_MAX];
+  double appTime;		/* seconds, summed over tasks */
+  double mpiTime;		/* microseconds */
+  long long calls;
+} mpiPi_phase_t;
+
 
 typedef struct _mpiPi_t
 {
@@ -177,6 +279,7 @@ typedef struct _mpiPi_t
 #endif
   int hostnamelen;
   char *outputDir;
+  char *symcacheDir;		/* -i, NULL if unused */
   char *envStr;
   FILE *stdout_;
   FILE *stderr_;
@@ -205,8 +308,9 @@ typedef struct _mpiPi_t
   long long global_time_callsite_count;
 
   int tableSize;
+  mpiPi_callpaths_t callpaths;
+  mpiPi_latency_t latency;	/* -h */
   h_t *task_callsite_stats;
-  callsite_stats_t *rawCallsiteData;
   h_t *global_callsite_stats;
   h_t *global_callsite_stats_agg;
   h_t *global_MPI_stats_agg;
@@ -229,20 +333,45 @@ typedef struct _mpiPi_t
   int print_callsite_detail;
   int collective_report;
 #ifdef SO_LOOKUP
-  so_info_t **so_info;
+  so_info_t *so_info;
   int so_count;
+  so_range_t *so_ranges;
+  int so_range_count;
 #endif
   int disable_finalize_report;
+  int binaryProfile;		/* -b */
+  int traceRate;		/* -w, every n-th call is traced, 0 if none */
+  struct _mpiPi_trace_t *trace;	/* see trace.c */
+
+  pthread_key_t threadKey;	/* the mpiPi_thread_t of the calling thread */
+  pthread_mutex_t threadLock;	/* held while a thread is added */
+  mpiPi_thread_t *threads;	/* newest first, NULL before mpiPi_init */
+  int threadCount;
+  int do_thread_report;		/* -j */
+  int global_thread_count;
+  int global_thread_max;	/* most threads of a task calling MPI */
+  mpiPi_thread_time_t *global_thread_times;	/* by task, then thread */
+
+  int phase;			/* current, see phase.c */
+  int phaseUsed;		/* a phase other than 0 was entered */
+  mpiPi_TIME phaseStart;	/* of the current phase */
+  double phaseTime[MPIP_PHASES_MAX];	/* seconds, before phaseStart */
+  char *phaseNames[MPIP_PHASES_MAX];	/* -a and mpiP_enter_phase */
+  h_t *phaseTable;		/* the task's records while collapsed */
+  int phaseLatencyCount;	/* histograms in use before the collapse */
+  int global_phase_count;
+  mpiPi_phase_t *global_phases;
+  h_t *global_phase_stats;	/* per phase, the phase in place of the rank */
 
   int do_collective_stats_report;
   mpiPi_histogram_t coll_comm_histogram;
   mpiPi_histogram_t coll_size_histogram;
-  double coll_time_stats[(mpiPi_DEF_END - mpiPi_BASE)][32][32];
+  mpiPi_hist_cells_t coll_time_stats;
 
   int do_pt2pt_stats_report;
   mpiPi_histogram_t pt2pt_comm_histogram;
   mpiPi_histogram_t pt2pt_size_histogram;
-  double pt2pt_send_stats[(mpiPi_DEF_END - mpiPi_BASE)][32][32];
+  mpiPi_hist_cells_t pt2pt_send_stats;
 
 }
 mpiPi_t;
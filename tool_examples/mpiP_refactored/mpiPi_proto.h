@@ -23,7 +23,7 @@ extern void mpiPi_msg_debug0 (int i, vector* v,char *fmt, ...);
 extern void mpiP_init_api (int qmpi_lvl,vector* v);
 extern int mpiP_record_traceback (void *pc_array[], int max_stack,int qmpi_lvl,vector* v);
 extern int mpiP_open_executable (char *filename,int qmpi_lvl,vector* v);
-extern void mpiP_close_executable (void);
+extern void mpiP_close_executable (int qmpi_lvl,vector* v);
 extern mpiP_TIMER mpiP_gettime (void);
 extern char *mpiP_get_executable_name (int qmpi_lvl,vector* v);
 extern char *mpiP_format_address (void *pval, char *addr_buf);
@@ -35,8 +35,81 @@ extern void *h_search (h_t * ht, void *key, void **ptr,int qmpi_lvl, vector* v);
 extern void *h_delete (h_t * ht, void *key, void **ptr,int qmpi_lvl, vector* v);
 extern int h_gather_data (h_t * ht, int *ac, void ***ptr);
 extern void mpiPi_init (char *appName, int qmpi_lvl , vector* v);
+extern void mpiPi_callpath_init (mpiPi_callpaths_t * cp, int depth);
+extern void mpiPi_callpath_free (mpiPi_callpaths_t * cp);
+extern int mpiPi_callpath_intern (mpiPi_callpaths_t * cp, void **pc);
+extern void **mpiPi_callpath_pcs (mpiPi_callpaths_t * cp, int id);
+extern void mpiPi_latency_init (mpiPi_latency_t * lt, int sub_bits);
+extern void mpiPi_latency_free (mpiPi_latency_t * lt);
+extern int mpiPi_latency_new (mpiPi_latency_t * lt);
+extern long long *mpiPi_latency_counts (mpiPi_latency_t * lt, int id);
+extern int mpiPi_latency_bucket (mpiPi_latency_t * lt, double dur);
+extern void mpiPi_latency_record (mpiPi_latency_t * lt, int id, double dur);
+extern void mpiPi_latency_merge (mpiPi_latency_t * lt, int a, int b);
+extern double mpiPi_latency_quantile (mpiPi_latency_t * lt, int id, double q);
+extern int mpiPi_wire_pack (callsite_stats_t ** av, int ac,
+			    mpiPi_callpaths_t * cp, mpiPi_latency_t * lt,
+			    char **buf);
+extern int mpiPi_wire_unpack (const char *buf, int len, mpiPi_callpaths_t * cp,
+			      mpiPi_latency_t * lt, callsite_stats_t ** av);
+extern double *mpiPi_hist_cells_get (mpiPi_hist_cells_t * h, unsigned key);
+extern int mpiPi_hist_cells_add (mpiPi_hist_cells_t * h, unsigned key,
+				 double value);
+extern int mpiPi_hist_cells_gather (mpiPi_hist_cells_t * h,
+				    mpiPi_hist_cell_t ** cells);
+extern void mpiPi_hist_cells_free (mpiPi_hist_cells_t * h);
+extern int mpiPi_symcache_open (const char *dir, const char *app);
+extern const char *mpiPi_symcache_path (void);
+extern int mpiPi_symcache_find (void *pc, char **filename, char **functname,
+				int *lineno);
+extern void mpiPi_symcache_add (void *pc, const char *filename,
+				const char *functname, int lineno);
+extern void mpiPi_symcache_close (void);
+extern void mpiPi_open_lookup (int qmpi_lvl, vector * v);
+extern void mpiPi_close_lookup (int qmpi_lvl, vector* v);
 extern int mpiPi_query_pc (int qmpi_lvl,vector* v, void *pc, char **filename, char **functname, int *lineno);
 extern int mpiPi_query_src (callsite_stats_t * p, int qmpi_lvl , vector* v);
+extern void mpiPi_bcast_callsite (callsite_stats_t * p, int qmpi_lvl , vector* v);
+extern void mpiPi_open_report_tables (int qmpi_lvl, vector * v);
+extern void mpiPi_sort_runs (void **av, int ac,
+			     int (*cmp) (const void *, const void *),
+			     int nruns);
+extern int mpiPi_profile_write (const char *path, int qmpi_lvl, vector * v);
+extern int mpiPi_profile_read (const char *path, int qmpi_lvl, vector * v);
+extern void mpiPi_trace_init (int qmpi_lvl, vector * v);
+extern void mpiPi_trace_record (unsigned op, mpiPi_TIME * start,
+				mpiPi_TIME * end, void **pc, MPI_Comm * comm,
+				int peer, double bytes, int qmpi_lvl,
+				vector * v);
+extern int mpiPi_trace_convert (FILE * fp, int count, char **paths,
+				int resolve, int qmpi_lvl, vector * v);
+extern void mpiPi_trace_finalize (int qmpi_lvl, vector * v);
+extern void mpiPi_thread_init (int qmpi_lvl, vector * v);
+extern mpiPi_thread_t *mpiPi_thread_self (int qmpi_lvl, vector * v);
+extern int mpiPi_thread_enter (int qmpi_lvl, vector * v);
+extern void mpiPi_thread_leave (int qmpi_lvl, vector * v);
+extern void mpiPi_thread_merge (int qmpi_lvl, vector * v);
+extern void mpiPi_thread_reset (int qmpi_lvl, vector * v);
+extern void mpiPi_thread_gather_times (int qmpi_lvl, vector * v);
+extern void mpiPi_phase_init (int qmpi_lvl, vector * v);
+extern void mpiPi_phase_set_names (const char *list, int qmpi_lvl,
+				   vector * v);
+extern void mpiPi_phase_label (int n, char *buf, int len, int qmpi_lvl,
+			       vector * v);
+extern void mpiPi_phase_enter (int n, int qmpi_lvl, vector * v);
+extern int mpiPi_phase_enter_named (const char *name, int qmpi_lvl,
+				    vector * v);
+extern void mpiPi_phase_reset (int qmpi_lvl, vector * v);
+extern void mpiPi_phase_times (double *times, int qmpi_lvl, vector * v);
+extern int mpiPi_phase_collapse (int qmpi_lvl, vector * v);
+extern void mpiPi_phase_restore (int qmpi_lvl, vector * v);
+extern int mpiPi_callsite_stats_path_hashkey (const void *p, int qmpi_lvl,
+					      vector * v);
+extern int mpiPi_callsite_stats_path_comparator (const void *p1,
+						 const void *p2,
+						 int qmpi_lvl, vector * v);
+extern void mpiPi_merge_individual_callsite_records (callsite_stats_t * a,
+						     callsite_stats_t * b);
 extern void mpiPi_generateReport (int report_style, int qmpi_lvl , vector* v);
 extern void mpiPi_finalize (int qmpi_lvl , vector* v);
 extern void mpiPi_update_callsite_stats (unsigned op, unsigned rank,
@@ -45,9 +118,10 @@ extern void mpiPi_update_callsite_stats (unsigned op, unsigned rank,
 					 double rmaSize,int qmpi_lvl , vector* v );
 extern char *mpiPdemangle (const char *mangledSym);
 extern int mpiP_find_src_loc (void *i_addr_hex, char **o_file_str,
-			      int *o_lineno, char **o_funct_str);
-extern int open_bfd_executable (char *filename);
-extern void close_bfd_executable (void);
+			      int *o_lineno, char **o_funct_str,
+			      int qmpi_lvl, vector* v);
+extern int open_bfd_executable (char *filename, int qmpi_lvl, vector* v);
+extern void close_bfd_executable (int qmpi_lvl, vector* v);
 extern int MPI_Pcontrol (const int flag, ...);
 extern int mpi_pcontrol_ (int *flag,int i,vector* v);
 extern void mpiPi_profile_print (FILE * fp, int report_style,int qmpi_lvl ,vector * v);
@@ -57,13 +131,14 @@ extern int mpiPi_RecordTraceBack (void *pc, void *pc_array[], int max_back);
 #else
 extern int mpiPi_RecordTraceBack (jmp_buf jb, void *pc_array[], int max_back);
 #endif
+extern void mpiPi_set_stack_capture (int mode, int refresh);
 extern void mpiPi_getenv (int i ,vector* v);
 extern char *getProcExeLink (int i, vector* v);
 extern void getProcCmdLine (int *ac, char **av);
 extern void mpiPi_copy_args (int *ac, char **av, int av_len);
 extern void mpiPi_copy_given_args (int *ac, char **av, int av_len, int argc,
 				   char **argv);
-extern unsigned long long mpiPi_get_text_start (char *filename);
+extern unsigned long long mpiPi_get_text_start (char *filename, int qmpi_lvl, vector* v);
 extern void mpiPi_update_collective_stats (int op, double dur, double size,
 					   MPI_Comm * comm,int qmpi_lvl , vector* v);
 extern void mpiPi_update_pt2pt_stats (int op, double dur, double size,
@@ -0,0 +1,720 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   mpip-report.c -- prints reports from binary profiles (-b)
+
+   mpip-report [-c | -v] [-f text|csv|json] [-o file] profile.mpiPb
+   mpip-report -d base.mpiPb [-o file] profile.mpiPb
+   mpip-report -t [-o file] trace.mpiPt...
+
+   The text report is the one mpiP prints at MPI_Finalize, in the style
+   the run asked for unless -c or -v is given.  The CSV and JSON formats
+   hold the callsite statistics of every task and of the aggregate.
+   With -d, the time of each callsite is compared with that of the same
+   call at the same source location in the base profile.  With -t, the
+   traces of tasks written with -w are converted to one Chrome trace
+   event JSON file, their callsites named by address.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <float.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+enum
+{ REPORT_TEXT, REPORT_CSV, REPORT_JSON };
+
+/*  Profiles are read into the contexts of a two level tool stack: the
+    profile at level 0 and the base of a comparison at level 1.  */
+static gst report_gs[2];
+static struct dynamic_lib report_libs[2];
+static struct dynamic_lib *report_items[2] = { &report_libs[0],
+  &report_libs[1]
+};
+static vector report_v = { report_items, 2, 2 };
+
+typedef struct
+{
+  char *key;			/* call and source location */
+  callsite_stats_t *stats;
+} report_site_t;
+
+typedef struct
+{
+  report_site_t *site, *base;
+  double delta;
+} report_diff_t;
+
+
+static void
+usage (void)
+{
+  fprintf (stderr,
+	   "usage: mpip-report [-c | -v] [-f text|csv|json] [-o file] profile\n"
+	   "       mpip-report -d base [-o file] profile\n"
+	   "       mpip-report -t [-o file] trace...\n");
+  exit (2);
+}
+
+static int
+report_load (const char *path, int lvl)
+{
+  gst *gs_ptr = &report_gs[lvl];
+  int i;
+
+  report_libs[lvl].context = gs_ptr;
+  gs_ptr->mpiPi.toolname = "mpip-report";
+  gs_ptr->mpiPi.stdout_ = stderr;
+  gs_ptr->mpiPi.stderr_ = stderr;
+  if (!mpiPi_profile_read (path, lvl, &report_v))
+    return 0;
+
+  /* the report computes this while printing the task times */
+  gs_ptr->mpiPi.global_app_time = 0;
+  for (i = 0; i < gs_ptr->mpiPi.size; i++)
+    gs_ptr->mpiPi.global_app_time += gs_ptr->mpiPi.global_task_app_time[i];
+  return 1;
+}
+
+static const char *
+report_call (gst * gs_ptr, int op)
+{
+  return &gs_ptr->mpiPi.lookup[op - mpiPi_BASE].name[4];
+}
+
+/*  Returns the sites of a profile indexed by id, and their number in
+    *count.  */
+static callsite_src_id_cache_entry_t **
+report_sites (gst * gs_ptr, int *count)
+{
+  callsite_src_id_cache_entry_t **av, **sites;
+  int i, ac, max_id = 0;
+
+  h_gather_data (gs_ptr->callsite_src_id_cache, &ac, (void ***) &av);
+  for (i = 0; i < ac; i++)
+    if (av[i]->id > max_id)
+      max_id = av[i]->id;
+  sites = (callsite_src_id_cache_entry_t **)
+    calloc (max_id + 1, sizeof (callsite_src_id_cache_entry_t *));
+  if (sites == NULL)
+    {
+      fprintf (stderr, "mpip-report: out of memory\n");
+      exit (1);
+    }
+  for (i = 0; i < ac; i++)
+    if (av[i]->id >= 0)
+      sites[av[i]->id] = av[i];
+  free (av);
+  *count = max_id + 1;
+  return sites;
+}
+
+static int
+report_sort_by_site_rank (const void *a, const void *b)
+{
+  callsite_stats_t *p1 = *(callsite_stats_t **) a;
+  callsite_stats_t *p2 = *(callsite_stats_t **) b;
+
+  if (p1->csid != p2->csid)
+    return p1->csid < p2->csid ? -1 : 1;
+  if (p1->op != p2->op)
+    return p1->op < p2->op ? -1 : 1;
+  if (p1->rank != p2->rank)
+    return (int) p1->rank < (int) p2->rank ? -1 : 1;
+  return 0;
+}
+
+/*  Returns the per task and then the aggregate records of a profile,
+    ordered by site and rank.  Aggregate records have rank -1.  */
+static callsite_stats_t **
+report_records (gst * gs_ptr, int *count)
+{
+  callsite_stats_t **tv, **av, **rv;
+  int i, tc, ac;
+
+  h_gather_data (gs_ptr->mpiPi.global_callsite_stats, &tc, (void ***) &tv);
+  h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac,
+		 (void ***) &av);
+  rv = (callsite_stats_t **) malloc ((tc + ac + 1) * sizeof (void *));
+  if (rv == NULL)
+    {
+      fprintf (stderr, "mpip-report: out of memory\n");
+      exit (1);
+    }
+  memcpy (rv, tv, tc * sizeof (void *));
+  for (i = 0; i < ac; i++)
+    {
+      av[i]->rank = -1;
+      rv[tc + i] = av[i];
+    }
+  free (tv);
+  free (av);
+  qsort (rv, tc + ac, sizeof (void *), report_sort_by_site_rank);
+  *count = tc + ac;
+  return rv;
+}
+
+/*  Percentages of the task's (or with rank -1, all tasks') time.  */
+static void
+report_pcts (gst * gs_ptr, callsite_stats_t * p, double *app_pct,
+	     double *mpi_pct)
+{
+  double app, mpi;
+
+  if ((int) p->rank < 0)
+    {
+      app = gs_ptr->mpiPi.global_app_time;
+      mpi = gs_ptr->mpiPi.global_mpi_time;
+    }
+  else
+    {
+      app = gs_ptr->mpiPi.global_task_app_time[p->rank];
+      mpi = gs_ptr->mpiPi.global_task_mpi_time[p->rank];
+    }
+  *app_pct = app > 0 ? 100.0 * p->cumulativeTime / (app * 1e6) : 0;
+  *mpi_pct = mpi > 0 ? 100.0 * p->cumulativeTime / mpi : 0;
+}
+
+static void
+csv_str (FILE * fp, const char *s)
+{
+  fputc ('"', fp);
+  for (; s != NULL && *s != '\0'; s++)
+    {
+      if (*s == '"')
+	fputc ('"', fp);
+      fputc (*s, fp);
+    }
+  fputc ('"', fp);
+}
+
+static void
+json_str (FILE * fp, const char *s)
+{
+  if (s == NULL)
+    {
+      fprintf (fp, "null");
+      return;
+    }
+  fputc ('"', fp);
+  for (; *s != '\0'; s++)
+    {
+      if (*s == '"' || *s == '\\')
+	fprintf (fp, "\\%c", *s);
+      else if ((unsigned char) *s < 0x20)
+	fprintf (fp, "\\u%04x", (unsigned char) *s);
+      else
+	fputc (*s, fp);
+    }
+  fputc ('"', fp);
+}
+
+static void
+report_csv (FILE * fp)
+{
+  gst *gs_ptr = &report_gs[0];
+  callsite_src_id_cache_entry_t **sites;
+  callsite_stats_t **rv;
+  int i, nsites, count;
+
+  sites = report_sites (gs_ptr, &nsites);
+  rv = report_records (gs_ptr, &count);
+
+  fprintf (fp, "call,site,rank,count,time_ms,max_ms,mean_ms,min_ms,"
+	   "app_pct,mpi_pct,sent_bytes,max_sent,min_sent,io_bytes,"
+	   "rma_bytes,file,line,function\n");
+  for (i = 0; i < count; i++)
+    {
+      callsite_stats_t *p = rv[i];
+      callsite_src_id_cache_entry_t *s;
+      double app_pct, mpi_pct;
+
+      s = p->csid >= 0 && p->csid < nsites ? sites[p->csid] : NULL;
+      report_pcts (gs_ptr, p, &app_pct, &mpi_pct);
+      fprintf (fp, "%s,%d,", report_call (gs_ptr, p->op), p->csid);
+      if ((int) p->rank < 0)
+	fprintf (fp, "*,");
+      else
+	fprintf (fp, "%u,", p->rank);
+      fprintf (fp, "%lld,%.9g,%.9g,%.9g,%.9g,%.6g,%.6g,%.17g,%.17g,%.17g,"
+	       "%.17g,%.17g,", p->count, p->cumulativeTime / 1000.0,
+	       p->maxDur / 1000.0,
+	       p->count > 0 ? p->cumulativeTime / (p->count * 1000.0) : 0,
+	       p->minDur / 1000.0, app_pct, mpi_pct, p->cumulativeDataSent,
+	       p->cumulativeDataSent > 0 ? p->maxDataSent : 0,
+	       p->cumulativeDataSent > 0 ? p->minDataSent : 0,
+	       p->cumulativeIO, p->cumulativeRMA);
+      if (s != NULL && gs_ptr->mpiPi.stackDepth > 0 && s->filename[0] != NULL)
+	{
+	  csv_str (fp, s->filename[0]);
+	  fprintf (fp, ",%d,", s->line[0]);
+	  csv_str (fp, s->functname[0]);
+	}
+      else
+	fprintf (fp, ",,");
+      fprintf (fp, "\n");
+    }
+  free (rv);
+  free (sites);
+}
+
+static void
+report_json (FILE * fp)
+{
+  gst *gs_ptr = &report_gs[0];
+  callsite_src_id_cache_entry_t **sites;
+  callsite_stats_t **rv;
+  char addr_buf[24];
+  int i, j, nsites, count, first;
+
+  sites = report_sites (gs_ptr, &nsites);
+  rv = report_records (gs_ptr, &count);
+
+  fprintf (fp, "{\n  \"command\": [");
+  for (i = 0; i < gs_ptr->mpiPi.ac; i++)
+    {
+      fprintf (fp, i > 0 ? ", " : "");
+      json_str (fp, gs_ptr->mpiPi.av[i]);
+    }
+  fprintf (fp, "],\n  \"env\": ");
+  json_str (fp, gs_ptr->mpiPi.envStr);
+  fprintf (fp, ",\n  \"start\": %lld,\n  \"stop\": %lld,\n",
+	   (long long) gs_ptr->mpiPi.start_timeofday,
+	   (long long) gs_ptr->mpiPi.stop_timeofday);
+  fprintf (fp, "  \"collector_rank\": %d,\n  \"stack_depth\": %d,\n",
+	   gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.stackDepth);
+  fprintf (fp, "  \"app_time\": %.9g,\n  \"mpi_time\": %.9g,\n",
+	   gs_ptr->mpiPi.global_app_time, gs_ptr->mpiPi.global_mpi_time / 1e6);
+
+  fprintf (fp, "  \"tasks\": [");
+  for (i = 0; i < gs_ptr->mpiPi.size; i++)
+    {
+      fprintf (fp, "%s\n    {\"rank\": %d, \"host\": ", i > 0 ? "," : "",
+	       i);
+      json_str (fp, gs_ptr->mpiPi.global_task_hostnames != NULL ?
+		gs_ptr->mpiPi.global_task_hostnames[i] : NULL);
+      fprintf (fp, ", \"app_time\": %.9g, \"mpi_time\": %.9g}",
+	       gs_ptr->mpiPi.global_task_app_time[i],
+	       gs_ptr->mpiPi.global_task_mpi_time[i] / 1e6);
+    }
+  fprintf (fp, "\n  ],\n");
+
+  fprintf (fp, "  \"callsites\": [");
+  for (i = 0, first = 1; i < nsites; i++)
+    {
+      callsite_src_id_cache_entry_t *s = sites[i];
+
+      if (s == NULL)
+	continue;
+      fprintf (fp, "%s\n    {\"id\": %d, \"call\": ", first ? "" : ",",
+	       s->id);
+      json_str (fp, report_call (gs_ptr, s->op));
+      fprintf (fp, ", \"stack\": [");
+      for (j = 0; j < gs_ptr->mpiPi.stackDepth && s->filename[j] != NULL;
+	   j++)
+	{
+	  fprintf (fp, "%s{\"file\": ", j > 0 ? ", " : "");
+	  json_str (fp, s->filename[j]);
+	  fprintf (fp, ", \"line\": %d, \"function\": ", s->line[j]);
+	  json_str (fp, s->functname[j]);
+	  fprintf (fp, ", \"pc\": ");
+	  json_str (fp, mpiP_format_address (s->pc[j], addr_buf));
+	  fprintf (fp, "}");
+	}
+      fprintf (fp, "]}");
+      first = 0;
+    }
+  fprintf (fp, "\n  ],\n");
+
+  fprintf (fp, "  \"stats\": [");
+  for (i = 0; i < count; i++)
+    {
+      callsite_stats_t *p = rv[i];
+
+      fprintf (fp, "%s\n    {\"call\": ", i > 0 ? "," : "");
+      json_str (fp, report_call (gs_ptr, p->op));
+      fprintf (fp, ", \"site\": %d, \"rank\": ", p->csid);
+      if ((int) p->rank < 0)
+	fprintf (fp, "null");
+      else
+	fprintf (fp, "%u", p->rank);
+      fprintf (fp, ", \"count\": %lld, \"time\": %.17g, \"max\": %.17g, "
+	       "\"min\": %.17g, \"sent\": %.17g, \"max_sent\": %.17g, "
+	       "\"min_sent\": %.17g, \"io\": %.17g, \"rma\": %.17g}",
+	       p->count, p->cumulativeTime / 1e6, p->maxDur / 1e6,
+	       p->minDur / 1e6, p->cumulativeDataSent,
+	       p->cumulativeDataSent > 0 ? p->maxDataSent : 0,
+	       p->cumulativeDataSent > 0 ? p->minDataSent : 0,
+	       p->cumulativeIO, p->cumulativeRMA);
+    }
+  fprintf (fp, "\n  ]\n}\n");
+  free (rv);
+  free (sites);
+}
+
+/*  Keys the aggregate callsites of a profile by call and source
+    location, since site ids differ between runs.  */
+static report_site_t *
+report_site_keys (gst * gs_ptr, int *count)
+{
+  callsite_src_id_cache_entry_t **sites;
+  callsite_stats_t **av;
+  report_site_t *rs;
+  int i, j, nsites, ac;
+
+  sites = report_sites (gs_ptr, &nsites);
+  h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac,
+		 (void ***) &av);
+  rs = (report_site_t *) malloc ((ac + 1) * sizeof (report_site_t));
+  if (rs == NULL)
+    {
+      fprintf (stderr, "mpip-report: out of memory\n");
+      exit (1);
+    }
+  for (i = 0; i < ac; i++)
+    {
+      callsite_src_id_cache_entry_t *s;
+      char key[1024], addr_buf[24];
+      int len;
+
+      s = av[i]->csid >= 0 && av[i]->csid < nsites ? sites[av[i]->csid]
+	: NULL;
+      len = snprintf (key, sizeof (key), "%s", report_call (gs_ptr,
+							    av[i]->op));
+      for (j = 0; s != NULL && j < gs_ptr->mpiPi.stackDepth
+	   && s->filename[j] != NULL && len < (int) sizeof (key); j++)
+	{
+	  if (s->line[j] == 0 && strcmp (s->filename[j], "[unknown]") == 0)
+	    len += snprintf (key + len, sizeof (key) - len, " %s",
+			     mpiP_format_address (s->pc[j], addr_buf));
+	  else
+	    len += snprintf (key + len, sizeof (key) - len, " %s:%d:%s",
+			     s->filename[j], s->line[j], s->functname[j]);
+	}
+      rs[i].key = strdup (key);
+      rs[i].stats = av[i];
+    }
+  free (av);
+  free (sites);
+  *count = ac;
+  return rs;
+}
+
+static int
+report_site_key_cmp (const void *a, const void *b)
+{
+  return strcmp (((report_site_t *) a)->key, ((report_site_t *) b)->key);
+}
+
+static int
+report_diff_cmp (const void *a, const void *b)
+{
+  double d1 = ((report_diff_t *) a)->delta;
+  double d2 = ((report_diff_t *) b)->delta;
+
+  d1 = d1 < 0 ? -d1 : d1;
+  d2 = d2 < 0 ? -d2 : d2;
+  return d1 < d2 ? 1 : d1 > d2 ? -1 : 0;
+}
+
+static void
+print_heading (FILE * fp, char *str)
+{
+  int slen;
+
+  for (slen = 0; slen < 75; slen++)
+    fputc ('-', fp);
+  fprintf (fp, "\n@--- %s ", str);
+  for (slen = strlen (str) + 6; slen < 75; slen++)
+    fputc ('-', fp);
+  fprintf (fp, "\n");
+  for (slen = 0; slen < 75; slen++)
+    fputc ('-', fp);
+  fprintf (fp, "\n");
+}
+
+static void
+report_diff (FILE * fp, const char *base_path, const char *path)
+{
+  gst *gs_ptr = &report_gs[0];
+  gst *base = &report_gs[1];
+  report_site_t *rs, *bs;
+  report_diff_t *dv;
+  int i, rc, bc, n = 0;
+  double app[2], mpi[2];
+
+  rs = report_site_keys (gs_ptr, &rc);
+  bs = report_site_keys (base, &bc);
+  qsort (bs, bc, sizeof (report_site_t), report_site_key_cmp);
+
+  dv = (report_diff_t *) calloc (rc + bc + 1, sizeof (report_diff_t));
+  if (dv == NULL)
+    {
+      fprintf (stderr, "mpip-report: out of memory\n");
+      exit (1);
+    }
+  for (i = 0; i < rc; i++)
+    {
+      report_site_t *b = (report_site_t *) bsearch (&rs[i], bs, bc,
+						    sizeof (report_site_t),
+						    report_site_key_cmp);
+      dv[n].site = &rs[i];
+      dv[n].base = b;
+      dv[n].delta = rs[i].stats->cumulativeTime;
+      if (b != NULL)
+	{
+	  dv[n].delta -= b->stats->cumulativeTime;
+	  b->stats->cookie = 0;	/* matched */
+	}
+      n++;
+    }
+  for (i = 0; i < bc; i++)
+    if (bs[i].stats->cookie != 0)
+      {
+	dv[n].base = &bs[i];
+	dv[n].delta = -bs[i].stats->cumulativeTime;
+	n++;
+      }
+  qsort (dv, n, sizeof (report_diff_t), report_diff_cmp);
+
+  fprintf (fp, "@ mpip-report difference\n");
+  fprintf (fp, "@ Base                     : %s\n", base_path);
+  fprintf (fp, "@ Profile                  : %s\n", path);
+
+  app[0] = base->mpiPi.global_app_time;
+  app[1] = gs_ptr->mpiPi.global_app_time;
+  mpi[0] = base->mpiPi.global_mpi_time / 1e6;
+  mpi[1] = gs_ptr->mpiPi.global_mpi_time / 1e6;
+  print_heading (fp, "Time (seconds)");
+  fprintf (fp, "%-8s %12s %12s %12s %8s\n", "", "Base", "Profile", "Delta",
+	   "Delta%");
+  fprintf (fp, "%-8s %12.4g %12.4g %12.4g %8.2f\n", "AppTime", app[0],
+	   app[1], app[1] - app[0],
+	   app[0] > 0 ? 100.0 * (app[1] - app[0]) / app[0] : 0);
+  fprintf (fp, "%-8s %12.4g %12.4g %12.4g %8.2f\n", "MPITime", mpi[0],
+	   mpi[1], mpi[1] - mpi[0],
+	   mpi[0] > 0 ? 100.0 * (mpi[1] - mpi[0]) / mpi[0] : 0);
+
+  print_heading (fp, "Callsite Time difference (ms, by size of change)");
+  fprintf (fp, "%-17s %4s %4s %12s %12s %12s %8s  %s\n", "Call", "Base",
+	   "Site", "Base", "Profile", "Delta", "Delta%", "Location");
+  for (i = 0; i < n; i++)
+    {
+      report_site_t *s = dv[i].site != NULL ? dv[i].site : dv[i].base;
+      double t0 = dv[i].base != NULL ? dv[i].base->stats->cumulativeTime : 0;
+      double t1 = dv[i].site != NULL ? dv[i].site->stats->cumulativeTime : 0;
+      const char *loc = strchr (s->key, ' ');
+      char site[2][16];
+
+      if (dv[i].base != NULL)
+	snprintf (site[0], 16, "%d", dv[i].base->stats->csid);
+      else
+	strcpy (site[0], "-");
+      if (dv[i].site != NULL)
+	snprintf (site[1], 16, "%d", dv[i].site->stats->csid);
+      else
+	strcpy (site[1], "-");
+      fprintf (fp, "%-17s %4s %4s %12.4g %12.4g %12.4g ",
+	       dv[i].site != NULL ?
+	       report_call (gs_ptr, s->stats->op) :
+	       report_call (base, s->stats->op),
+	       site[0], site[1], t0 / 1000.0, t1 / 1000.0,
+	       (t1 - t0) / 1000.0);
+      if (t0 > 0)
+	fprintf (fp, "%8.2f", 100.0 * (t1 - t0) / t0);
+      else
+	fprintf (fp, "%8s", "new");
+      fprintf (fp, "  %s\n", loc != NULL ? loc + 1 : "");
+    }
+
+  for (i = 0; i < rc; i++)
+    free (rs[i].key);
+  for (i = 0; i < bc; i++)
+    free (bs[i].key);
+  free (rs);
+  free (bs);
+  free (dv);
+}
+
+int
+main (int argc, char *argv[])
+{
+  char *out = NULL, *base = NULL;
+  int c, format = REPORT_TEXT, style = -1, trace = 0;
+  FILE *fp = stdout;
+
+  while ((c = getopt (argc, argv, "cd:f:o:tv")) != -1)
+    {
+      switch (c)
+	{
+	case 'c':
+	  style = mpiPi_style_concise;
+	  break;
+	case 'v':
+	  style = mpiPi_style_verbose;
+	  break;
+	case 'd':
+	  base = optarg;
+	  break;
+	case 'f':
+	  if (strcmp (optarg, "text") == 0)
+	    format = REPORT_TEXT;
+	  else if (strcmp (optarg, "csv") == 0)
+	    format = REPORT_CSV;
+	  else if (strcmp (optarg, "json") == 0)
+	    format = REPORT_JSON;
+	  else
+	    usage ();
+	  break;
+	case 'o':
+	  out = optarg;
+	  break;
+	case 't':
+	  trace = 1;
+	  break;
+	default:
+	  usage ();
+	}
+    }
+  if (trace ? optind == argc : optind != argc - 1)
+    usage ();
+
+  if (trace)
+    {
+      int converted;
+
+      report_libs[0].context = &report_gs[0];
+      report_gs[0].mpiPi.toolname = "mpip-report";
+      report_gs[0].mpiPi.stdout_ = stderr;
+      report_gs[0].mpiPi.stderr_ = stderr;
+      if (out != NULL && (fp = fopen (out, "w")) == NULL)
+	{
+	  fprintf (stderr, "mpip-report: could not open [%s]\n", out);
+	  return 1;
+	}
+      setvbuf (fp, NULL, _IOFBF, MPIP_REPORT_BUFFER_SIZE);
+      converted = mpiPi_trace_convert (fp, argc - optind, &argv[optind], 0,
+				       0, &report_v);
+      if (fp != stdout && fclose (fp) != 0)
+	return 1;
+      return converted == argc - optind ? 0 : 1;
+    }
+
+  if (!report_load (argv[optind], 0)
+      || (base != NULL && !report_load (base, 1)))
+    return 1;
+
+  if (out != NULL && (fp = fopen (out, "w")) == NULL)
+    {
+      fprintf (stderr, "mpip-report: could not open [%s]\n", out);
+      return 1;
+    }
+
+  setvbuf (fp, NULL, _IOFBF, MPIP_REPORT_BUFFER_SIZE);
+  if (base != NULL)
+    report_diff (fp, base, argv[optind]);
+  else if (format == REPORT_CSV)
+    report_csv (fp);
+  else if (format == REPORT_JSON)
+    report_json (fp);
+  else
+    {
+      if (style < 0)
+	style = report_gs[0].mpiPi.report_style;
+      if (style == mpiPi_style_both)
+	{
+	  mpiPi_profile_print (fp, mpiPi_style_concise, 0, &report_v);
+	  style = mpiPi_style_verbose;
+	}
+      mpiPi_profile_print (fp, style, 0, &report_v);
+    }
+
+  if (fp != stdout && fclose (fp) != 0)
+    return 1;
+  return 0;
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
@@ -32,17 +32,18 @@ static char *svnid = "$Id$";
 #ifdef ENABLE_BFD
 #ifndef CEXTRACT
 #include "bfd.h"
-#ifdef SO_LOOKUP
-#include <search.h>
-#endif
 #endif
-static asymbol **syms;
+static asymbol **syms;		/* of the object being searched */
+static asymbol **exe_syms;
 static bfd_vma pc;
 static const char *filename;
 static const char *functionname;
 static unsigned int line;
 static bfd *abfd = NULL;
-static bfd *open_bfd_object (char *filename);
+static int lookup_lvl;		/* tool level of the running lookup */
+static vector *lookup_v;
+static bfd *open_bfd_object (char *filename, asymbol *** symsp,
+			     int qmpi_lvl, vector * v);
 
 /*  BFD boolean and bfd_boolean types have changed through versions.
     It looks like bfd_boolean will be preferred.                     */
@@ -121,6 +122,9 @@ find_address_in_section (abfd, section, data)
   bfd_size_type size;
   bfd_vma local_pc = pc;
   char addr_buf1[24], addr_buf2[24], addr_buf3[24];
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(lookup_v,lookup_lvl)).context));
+	// CHANGE END
 
   assert (abfd);
   if (found)
@@ -133,14 +137,15 @@ find_address_in_section (abfd, section, data)
   local_pc = pc & 0xFFFFFFFF;
 #elif defined(AIX)
   local_pc = pc;
-  if (mpiPi.obj_mode == 32)
+  if (gs_ptr->mpiPi.obj_mode == 32)
     local_pc -= 0x10000000;
   else
     local_pc &= 0x00000000FFFFFFFF;
-  local_pc += mpiPi.text_start;
-  mpiPi_msg_debug ("pc is %s, text_start is %s, local_pc is %s\n",
+  local_pc += gs_ptr->mpiPi.text_start;
+  mpiPi_msg_debug (lookup_lvl,lookup_v,"pc is %s, text_start is %s, local_pc is %s\n",
 		   mpiP_format_address ((void *) pc, addr_buf1),
-		   mpiP_format_address ((void *) mpiPi.text_start, addr_buf2),
+		   mpiP_format_address ((void *) gs_ptr->mpiPi.text_start,
+					addr_buf2),
 		   mpiP_format_address ((void *) local_pc, addr_buf3));
 #else
   local_pc = pc /*& (~0x10000000) */ ;
@@ -148,7 +153,7 @@ find_address_in_section (abfd, section, data)
 
   if ((bfd_get_section_flags (abfd, section) & SEC_ALLOC) == 0)
     {
-      mpiPi_msg_debug ("failed bfd_get_section_flags\n");
+      mpiPi_msg_debug (lookup_lvl,lookup_v,"failed bfd_get_section_flags\n");
       return;
     }
   vma = bfd_get_section_vma (abfd, section);
@@ -160,7 +165,7 @@ find_address_in_section (abfd, section, data)
 	  sprintf_vma (addr_buf1, local_pc);
 	  sprintf_vma (addr_buf2, vma);
 	  mpiPi_msg_debug
-	    ("failed bfd_get_section_vma: local_pc=%s  vma=%s\n",
+	    (lookup_lvl,lookup_v,"failed bfd_get_section_vma: local_pc=%s  vma=%s\n",
 	     addr_buf1, addr_buf2);
 	}
       return;
@@ -185,7 +190,7 @@ find_address_in_section (abfd, section, data)
 	  sprintf_vma (addr_buf1, local_pc);
 	  sprintf_vma (addr_buf2, vma);
 	  sprintf_vma (addr_buf3, (vma + size));
-	  mpiPi_msg_debug ("PC not in section: pc=%s vma=%s-%s\n",
+	  mpiPi_msg_debug (lookup_lvl,lookup_v,"PC not in section: pc=%s vma=%s-%s\n",
 			   addr_buf1, addr_buf2, addr_buf3);
 	}
       return;
@@ -200,7 +205,7 @@ find_address_in_section (abfd, section, data)
       sprintf_vma (addr_buf1, local_pc);
       sprintf_vma (addr_buf2, vma);
       sprintf_vma (addr_buf3, (vma + size));
-      mpiPi_msg_debug ("bfd_find_nearest_line failed for : pc=%s vma=%s-%s\n",
+      mpiPi_msg_debug (lookup_lvl,lookup_v,"bfd_find_nearest_line failed for : pc=%s vma=%s-%s\n",
 		       addr_buf1, addr_buf2, addr_buf3);
     }
 
@@ -209,10 +214,10 @@ find_address_in_section (abfd, section, data)
       sprintf_vma (addr_buf1, local_pc);
       sprintf_vma (addr_buf2, vma);
       sprintf_vma (addr_buf3, (vma + size));
-      mpiPi_msg_debug ("bfd_find_nearest_line for : pc=%s vma=%s-%s\n",
+      mpiPi_msg_debug (lookup_lvl,lookup_v,"bfd_find_nearest_line for : pc=%s vma=%s-%s\n",
 		       addr_buf1, addr_buf2, addr_buf3);
 
-      mpiPi_msg_debug ("                 returned : %s:%s:%u\n",
+      mpiPi_msg_debug (lookup_lvl,lookup_v,"                 returned : %s:%s:%u\n",
 		       filename, functionname, line);
     }
 }
@@ -222,93 +227,93 @@ find_address_in_section (abfd, section, data)
 
 /*******************************************************************************
   The following functions support source code lookup for shared objects
-   with SO info stored in a tree. 
+   with the executable mappings kept in an array sorted by address.
 *******************************************************************************/
 
-/*  Used with twalk to print SO tree entries  */
+/*  Print SO mappings  */
 static void
-mpiPi_print_so_node_info (const void *so_node, VISIT which, int depth)
+mpiPi_print_sos (int qmpi_lvl, vector * v)
 {
-  so_info_t *cso;
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
 
-  if ((so_info_t **) so_node == NULL)
-    return;
-  else
-    cso = *(so_info_t **) so_node;
+  int i;
 
-  switch (which)
-    {
-    case preorder:
-      break;
-    case postorder:
-      printf ("%p - %p : %s\n", cso->lvma, cso->uvma, cso->fpath);
-      break;
-    case endorder:
-      break;
-    case leaf:
-      printf ("%p - %p : %s\n", cso->lvma, cso->uvma, cso->fpath);
-      break;
-    }
-}
-
-
-/*  Print SO tree entries  */
-static void
-mpiPi_print_sos ()
-{
-  if (mpiPi.so_info == NULL)
-    mpiPi_msg_warn ("Cannot print SOs as mpiPi.so_info is NULL\n");
+  if (gs_ptr->mpiPi.so_ranges == NULL)
+    mpiPi_msg_warn (qmpi_lvl,v,"Cannot print SOs as mpiPi.so_ranges is NULL\n");
   else
-    twalk (mpiPi.so_info, mpiPi_print_so_node_info);
+    for (i = 0; i < gs_ptr->mpiPi.so_range_count; i++)
+      printf ("%p - %p : %s\n", gs_ptr->mpiPi.so_ranges[i].lvma,
+	      gs_ptr->mpiPi.so_ranges[i].uvma,
+	      gs_ptr->mpiPi.so_info[gs_ptr->mpiPi.so_ranges[i].so].fpath);
 }
 
 
-/*  For inserting into and searching SO tree  */
 static int
-mpiPi_so_info_compare (const void *n1, const void *n2)
+mpiPi_so_range_compare (const void *n1, const void *n2)
 {
-  so_info_t *sn1, *sn2;
-  int retval;
+  const so_range_t *sn1 = (const so_range_t *) n1;
+  const so_range_t *sn2 = (const so_range_t *) n2;
 
-  sn1 = (so_info_t *) n1;
-  sn2 = (so_info_t *) n2;
+  if ((char *) sn1->lvma < (char *) sn2->lvma)
+    return -1;
+  return (char *) sn1->lvma > (char *) sn2->lvma;
+}
 
 
-  if (sn1->lvma < sn2->lvma)
-    retval = -1;
-  else if (sn1->lvma > sn2->uvma)
-    retval = 1;
-  else
-    retval = 0;
+/*  Returns the mapping holding addr.  The loop has no data-dependent
+    branch, so the search costs the same log2(n) steps for any pc.  */
+static so_range_t *
+mpiPi_find_so_range (void *addr, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
 
-  mpiPi_msg_debug
-    ("info_compare returning %d after comparing sn1->lvma %p to (sn2->lvma - sn2->uvma)  %p - %p\n",
-     retval, sn1->lvma, sn2->lvma, sn2->uvma);
+  so_range_t *r = gs_ptr->mpiPi.so_ranges;
+  int n = gs_ptr->mpiPi.so_range_count;
 
-  return retval;
+  if (n == 0)
+    return NULL;
+  while (n > 1)
+    {
+      int half = n / 2;
+      r = ((char *) r[half].lvma <= (char *) addr) ? r + half : r;
+      n -= half;
+    }
+  if ((char *) r->lvma <= (char *) addr && (char *) addr < (char *) r->uvma)
+    return r;
+  return NULL;
 }
 
 
-/*  Load map info for SOs  */
+/*  Load map info for SOs.  Each file gets one so_info entry however
+    many executable mappings it has.  */
 static int
-mpiPi_parse_maps ()
+mpiPi_parse_maps (int qmpi_lvl, vector * v)
 {
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
   char fbuf[64];
   FILE *fh;
   void *lvma, *uvma;
   char *fpath, *inbuf = NULL, *tokptr;
-  so_info_t *cso = NULL;
+  unsigned long long offset;
   size_t inbufsize;
   char *delim = " \n";
   char *scan_str;
   char *sp;
+  int range_cap = 0, so_cap = 0;
 
   snprintf (fbuf, 64, "/proc/%d/maps", (int) getpid ());
 
   fh = fopen (fbuf, "r");
   if (fh == NULL)
     {
-      mpiPi_msg_warn ("Failed to get process map info from %s\n", fbuf);
+      mpiPi_msg_warn (qmpi_lvl,v,"Failed to get process map info from %s\n", fbuf);
       return 0;
     }
 
@@ -317,21 +322,26 @@ mpiPi_parse_maps ()
   else
     scan_str = "%llx-%llx";
 
-  mpiPi.so_info = NULL;
+  gs_ptr->mpiPi.so_info = NULL;
+  gs_ptr->mpiPi.so_count = 0;
+  gs_ptr->mpiPi.so_ranges = NULL;
+  gs_ptr->mpiPi.so_range_count = 0;
 
   while (getline (&inbuf, &inbufsize, fh) != -1)
     {
+      so_range_t *r;
+
       /* sanity check input buffer */
       if (inbuf == NULL)
 	return 0;
 
-      mpiPi_msg_debug ("maps getline is %s\n", inbuf);
+      mpiPi_msg_debug (qmpi_lvl,v,"maps getline is %s\n", inbuf);
 
       /* scan address range */
       if (sscanf (inbuf, scan_str, &lvma, &uvma) < 2)
 	return 0;
 
-      mpiPi_msg_debug ("Parsed range as %lx - %lx\n", lvma, uvma);
+      mpiPi_msg_debug (qmpi_lvl,v,"Parsed range as %lx - %lx\n", lvma, uvma);
 
       /* get pointer to address range */
       tokptr = strtok_r (inbuf, delim, &sp);
@@ -345,6 +355,7 @@ mpiPi_parse_maps ()
 
       /* get pointer to offset */
       tokptr = strtok_r (NULL, delim, &sp);
+      offset = tokptr != NULL ? strtoull (tokptr, NULL, 16) : 0;
 
       /* get pointer to device */
       tokptr = strtok_r (NULL, delim, &sp);
@@ -358,19 +369,46 @@ mpiPi_parse_maps ()
       /* Process file info */
       if (fpath == NULL || fpath[0] != '/')
 	continue;
-      mpiPi_msg_debug ("maps fpath is %s\n", fpath);
+      mpiPi_msg_debug (qmpi_lvl,v,"maps fpath is %s\n", fpath);
 
-      /* copy info into structure */
-      cso = (so_info_t *) malloc (sizeof (so_info_t));
-      if (cso == NULL)
-	return 0;
-      cso->lvma = lvma;
-      cso->uvma = uvma;
-      cso->fpath = strdup (fpath);
-      cso->bfd = NULL;
-      if (tsearch (cso, (void **) &(mpiPi.so_info), mpiPi_so_info_compare) !=
-	  NULL)
-	mpiPi.so_count++;
+      if (gs_ptr->mpiPi.so_range_count == range_cap)
+	{
+	  range_cap = range_cap == 0 ? 64 : 2 * range_cap;
+	  r = (so_range_t *) realloc (gs_ptr->mpiPi.so_ranges,
+				      range_cap * sizeof (so_range_t));
+	  if (r == NULL)
+	    return 0;
+	  gs_ptr->mpiPi.so_ranges = r;
+	}
+
+      /* the mappings of a file are listed together */
+      if (gs_ptr->mpiPi.so_count == 0
+	  || strcmp (gs_ptr->mpiPi.so_info[gs_ptr->mpiPi.so_count - 1].fpath, fpath) != 0)
+	{
+	  if (gs_ptr->mpiPi.so_count == so_cap)
+	    {
+	      so_info_t *so;
+
+	      so_cap = so_cap == 0 ? 64 : 2 * so_cap;
+	      so = (so_info_t *) realloc (gs_ptr->mpiPi.so_info,
+					  so_cap * sizeof (so_info_t));
+	      if (so == NULL)
+		return 0;
+	      gs_ptr->mpiPi.so_info = so;
+	    }
+	  gs_ptr->mpiPi.so_info[gs_ptr->mpiPi.so_count].fpath = strdup (fpath);
+	  gs_ptr->mpiPi.so_info[gs_ptr->mpiPi.so_count].bfd = NULL;
+	  gs_ptr->mpiPi.so_info[gs_ptr->mpiPi.so_count].syms = NULL;
+	  gs_ptr->mpiPi.so_info[gs_ptr->mpiPi.so_count].open_failed = 0;
+	  gs_ptr->mpiPi.so_count++;
+	}
+
+      /* vmas of shared objects are file offsets */
+      r = &gs_ptr->mpiPi.so_ranges[gs_ptr->mpiPi.so_range_count++];
+      r->lvma = lvma;
+      r->uvma = uvma;
+      r->base = (char *) lvma - offset;
+      r->so = gs_ptr->mpiPi.so_count - 1;
     }
 
   fclose (fh);
@@ -378,8 +416,11 @@ mpiPi_parse_maps ()
   if (inbuf != NULL)
     free (inbuf);
 
+  qsort (gs_ptr->mpiPi.so_ranges, gs_ptr->mpiPi.so_range_count, sizeof (so_range_t),
+	 mpiPi_so_range_compare);
+
   if (mpiPi_debug)
-    mpiPi_print_sos ();
+    mpiPi_print_sos (qmpi_lvl, v);
 
   return 1;
 }
@@ -387,15 +428,19 @@ mpiPi_parse_maps ()
 
 int
 mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
-		   char **o_funct_str)
+		   char **o_funct_str, int qmpi_lvl, vector * v)
 {
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
   char buf[128];
   char addr_buf[24];
 
   if (i_addr_hex == NULL)
     {
       mpiPi_msg_debug
-	("mpiP_find_src_loc returning failure as i_addr_hex == NULL\n");
+	(qmpi_lvl,v,"mpiP_find_src_loc returning failure as i_addr_hex == NULL\n");
       return 1;
     }
 
@@ -405,7 +450,7 @@ mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
   if (abfd == NULL)
     {
       mpiPi_msg_debug
-	("mpiP_find_src_loc returning failure as abfd == NULL\n");
+	(qmpi_lvl,v,"mpiP_find_src_loc returning failure as abfd == NULL\n");
       return 1;
     }
 
@@ -413,50 +458,47 @@ mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
   pc = bfd_scan_vma (buf, NULL, 16);
 
   found = FALSE;
+  lookup_lvl = qmpi_lvl;
+  lookup_v = v;
 
+  syms = exe_syms;
   bfd_map_over_sections (abfd, find_address_in_section, (PTR) NULL);
 
 #ifdef SO_LOOKUP
   if (!found)
     {
-      so_info_t cso, *fso, **pfso;
+      so_range_t *r;
+      so_info_t *fso;
 
-      if (mpiPi.so_info == NULL)
-	if (mpiPi_parse_maps () == 0)
+      if (gs_ptr->mpiPi.so_ranges == NULL)
+	if (mpiPi_parse_maps (qmpi_lvl, v) == 0)
 	  {
-	    mpiPi_msg_debug ("Failed to parse SO maps.\n");
+	    mpiPi_msg_debug (qmpi_lvl,v,"Failed to parse SO maps.\n");
 	    return 1;
 	  }
 
-      cso.lvma = (void *) i_addr_hex;
-
-      mpiPi_msg_debug
-	("At SO tfind, &cso is %p, &so_info is %p, &mpiPi_so_info_compare is %p\n",
-	 &cso, &(mpiPi.so_info), mpiPi_so_info_compare);
-      pfso =
-	(so_info_t **) tfind ((void *) &cso, (void **) &(mpiPi.so_info),
-			      mpiPi_so_info_compare);
-      mpiPi_msg_debug ("After SO tfind\n");
-
-      if (pfso != NULL)
+      r = mpiPi_find_so_range (i_addr_hex, qmpi_lvl, v);
+      if (r != NULL)
 	{
-	  fso = *pfso;
-	  if (fso->bfd == NULL)
+	  fso = &gs_ptr->mpiPi.so_info[r->so];
+	  if (fso->bfd == NULL && !fso->open_failed)
 	    {
-	      mpiPi_msg_debug ("opening SO filename %s\n", fso->fpath);
-	      fso->bfd = (bfd *) open_bfd_object (fso->fpath);
+	      mpiPi_msg_debug (qmpi_lvl,v,"opening SO filename %s\n", fso->fpath);
+	      fso->bfd = open_bfd_object (fso->fpath, &fso->syms, qmpi_lvl, v);
+	      fso->open_failed = fso->bfd == NULL;
 	    }
 
-	  pc = (char *) i_addr_hex - (char *) fso->lvma;
-	  mpiPi_msg_debug
-	    ("Calling bfd_map_over_sections with new bfd for %p\n", pc);
-
-	  found = FALSE;
-
-	  mpiPi_msg_debug ("fso->bfd->sections is %p\n",
-			   ((bfd *) (fso->bfd))->sections);
-	  bfd_map_over_sections (fso->bfd, find_address_in_section,
-				 (PTR) NULL);
+	  if (fso->bfd != NULL)
+	    {
+	      pc = (char *) i_addr_hex - r->base;
+	      mpiPi_msg_debug
+		(qmpi_lvl,v,"Calling bfd_map_over_sections with new bfd for %p\n", pc);
+
+	      found = FALSE;
+	      syms = fso->syms;
+	      bfd_map_over_sections (fso->bfd, find_address_in_section,
+				     (PTR) NULL);
+	    }
 	}
 
     }
@@ -487,13 +529,13 @@ mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
 	}
 
 #if defined(DEMANGLE_IBM) || defined(DEMANGLE_Compaq) || defined(DEMANGLE_GNU)
-      mpiPi_msg_debug ("attempted demangle %s->%s\n", functionname,
+      mpiPi_msg_debug (qmpi_lvl,v,"attempted demangle %s->%s\n", functionname,
 		       *o_funct_str);
 #endif
     }
 
   /* set the filename and line no */
-  if (mpiPi.baseNames == 0 && filename != NULL)
+  if (gs_ptr->mpiPi.baseNames == 0 && filename != NULL)
     {
       char *h;
       h = strrchr (filename, '/');
@@ -504,16 +546,21 @@ mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
   *o_lineno = line;
   *o_file_str = strdup (filename ? filename : "[unknown]");
 
-  mpiPi_msg_debug ("BFD: %s -> %s:%u:%s\n", buf, *o_file_str, *o_lineno,
+  mpiPi_msg_debug (qmpi_lvl,v,"BFD: %s -> %s:%u:%s\n", buf, *o_file_str, *o_lineno,
 		   *o_funct_str);
 
   return 0;
 }
 
 
+/*  Opens an object and reads its symbols into *symsp.  */
 static bfd *
-open_bfd_object (char *filename)
+open_bfd_object (char *filename, asymbol *** symsp, int qmpi_lvl, vector * v)
 {
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
   char *target = NULL;
   char **matching = NULL;
   long storage;
@@ -524,9 +571,9 @@ open_bfd_object (char *filename)
 
   if (filename == NULL)
     {
-      mpiPi_msg_warn ("BFD Object filename is NULL!\n");
+      mpiPi_msg_warn (qmpi_lvl,v,"BFD Object filename is NULL!\n");
       mpiPi_msg_warn
-	("If this is a Fortran application, you may be using the incorrect mpiP library.\n");
+	(qmpi_lvl,v,"If this is a Fortran application, you may be using the incorrect mpiP library.\n");
       return NULL;
     }
 
@@ -535,7 +582,7 @@ open_bfd_object (char *filename)
   /*  Kludge to get XCOFF text_start value to feed an approriate address
      value to bfd for looking up source info
    */
-  mpiPi.text_start = mpiPi_get_text_start (filename);
+  gs_ptr->mpiPi.text_start = mpiPi_get_text_start (filename, qmpi_lvl, v);
 #endif
 
   if (!bfd_initialized)
@@ -546,16 +593,16 @@ open_bfd_object (char *filename)
 
   /* set_default_bfd_target (); */
 
-  mpiPi_msg_debug ("opening filename %s\n", filename);
+  mpiPi_msg_debug (qmpi_lvl,v,"opening filename %s\n", filename);
   new_bfd = bfd_openr (filename, target);
   if (new_bfd == NULL)
     {
-      mpiPi_msg_warn ("BFD could not open filename %s", filename);
+      mpiPi_msg_warn (qmpi_lvl,v,"BFD could not open filename %s", filename);
       return NULL;
     }
   if (bfd_check_format (new_bfd, bfd_archive))
     {
-      mpiPi_msg_warn ("can not get addresses from archive");
+      mpiPi_msg_warn (qmpi_lvl,v,"can not get addresses from archive");
       bfd_close (new_bfd);
       return NULL;
     }
@@ -565,17 +612,17 @@ open_bfd_object (char *filename)
       if (matching != NULL)
 	{
 	  for (curr_match = matching[0]; curr_match != NULL; curr_match++)
-	    mpiPi_msg_debug ("found matching type %s\n", curr_match);
+	    mpiPi_msg_debug (qmpi_lvl,v,"found matching type %s\n", curr_match);
 	  free (matching);
 	}
-      mpiPi_msg_warn ("BFD format matching failed");
+      mpiPi_msg_warn (qmpi_lvl,v,"BFD format matching failed");
       bfd_close (new_bfd);
       return NULL;
     }
 
   if ((bfd_get_file_flags (new_bfd) & HAS_SYMS) == 0)
     {
-      mpiPi_msg_warn ("No symbols in the executable\n");
+      mpiPi_msg_warn (qmpi_lvl,v,"No symbols in the executable\n");
       bfd_close (new_bfd);
       return NULL;
     }
@@ -585,36 +632,36 @@ open_bfd_object (char *filename)
   storage = bfd_get_symtab_upper_bound (new_bfd);
   if (storage < 0)
     {
-      mpiPi_msg_warn ("storage < 0");
+      mpiPi_msg_warn (qmpi_lvl,v,"storage < 0");
       bfd_close (new_bfd);
       return NULL;
     }
 
-  symcount = bfd_read_minisymbols (new_bfd, FALSE, (void *) &syms, &size);
+  symcount = bfd_read_minisymbols (new_bfd, FALSE, (void *) symsp, &size);
   if (symcount == 0)
     symcount =
-      bfd_read_minisymbols (new_bfd, TRUE /* dynamic */ , (void *) &syms,
+      bfd_read_minisymbols (new_bfd, TRUE /* dynamic */ , (void *) symsp,
 			    &size);
 
   if (symcount < 0)
     {
-      mpiPi_msg_warn ("symcount < 0");
+      mpiPi_msg_warn (qmpi_lvl,v,"symcount < 0");
       bfd_close (new_bfd);
       return NULL;
     }
   else
     {
-      mpiPi_msg_debug ("\n");
-      mpiPi_msg_debug ("found %d symbols in file [%s]\n", symcount, filename);
+      mpiPi_msg_debug (qmpi_lvl,v,"\n");
+      mpiPi_msg_debug (qmpi_lvl,v,"found %d symbols in file [%s]\n", symcount, filename);
     }
 
   return new_bfd;
 }
 
 int
-open_bfd_executable (char *filename)
+open_bfd_executable (char *filename, int qmpi_lvl, vector * v)
 {
-  abfd = open_bfd_object (filename);
+  abfd = open_bfd_object (filename, &exe_syms, qmpi_lvl, v);
   if (abfd == NULL)
     return 0;
   else
@@ -629,17 +676,43 @@ close_bfd_object (bfd * close_bfd)
 }
 
 void
-close_bfd_executable ()
+close_bfd_executable (int qmpi_lvl, vector * v)
 {
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
   assert (abfd);
   bfd_close (abfd);
+  free (exe_syms);
+  abfd = NULL;
+  exe_syms = NULL;
+#ifdef SO_LOOKUP
+  {
+    int i;
+
+    for (i = 0; i < gs_ptr->mpiPi.so_count; i++)
+      {
+	if (gs_ptr->mpiPi.so_info[i].bfd != NULL)
+	  bfd_close (gs_ptr->mpiPi.so_info[i].bfd);
+	free (gs_ptr->mpiPi.so_info[i].syms);
+	free (gs_ptr->mpiPi.so_info[i].fpath);
+      }
+    free (gs_ptr->mpiPi.so_info);
+    free (gs_ptr->mpiPi.so_ranges);
+    gs_ptr->mpiPi.so_info = NULL;
+    gs_ptr->mpiPi.so_ranges = NULL;
+    gs_ptr->mpiPi.so_count = 0;
+    gs_ptr->mpiPi.so_range_count = 0;
+  }
+#endif
 }
 
 #elif !defined(USE_LIBDWARF)
 
 int
 mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
-		   char **o_funct_str)
+		   char **o_funct_str, int qmpi_lvl, vector * v)
 {
   return 1;			/*  failure  */
 }
@@ -658,8 +731,12 @@ mpiP_find_src_loc (void *i_addr_hex, char **o_file_str, int *o_lineno,
 #include <scnhdr.h>
 
 static unsigned long long
-mpiPi_get_text_start (char *filename)
+mpiPi_get_text_start (char *filename, int qmpi_lvl, vector * v)
 {
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
   int fh;
   short magic;
   FILHDR FileHeader32;
@@ -677,22 +754,22 @@ mpiPi_get_text_start (char *filename)
     return 0;
 
   read (fh, &magic, 2);
-  mpiPi_msg_debug ("magic is 0x%x\n", magic);
+  mpiPi_msg_debug (qmpi_lvl,v,"magic is 0x%x\n", magic);
   lseek (fh, 0, 0);
 
   if (magic == 0x01DF)		/* 32-bit  */
     {
-      mpiPi.obj_mode = 32;
+      gs_ptr->mpiPi.obj_mode = 32;
       read (fh, &FileHeader32, sizeof (FILHDR));
-      mpiPi_msg_debug ("aout size is %d\n", FileHeader32.f_opthdr);
+      mpiPi_msg_debug (qmpi_lvl,v,"aout size is %d\n", FileHeader32.f_opthdr);
       read (fh, &AoutHeader32, FileHeader32.f_opthdr);
-      mpiPi_msg_debug ("text start is 0x%0x\n", AoutHeader32.o_text_start);
+      mpiPi_msg_debug (qmpi_lvl,v,"text start is 0x%0x\n", AoutHeader32.o_text_start);
 
       while (count++ < FileHeader32.f_nscns)
 	{
 	  read (fh, &SectHeader32, sizeof (SCNHDR));
-	  mpiPi_msg_debug ("found header name %s\n", SectHeader32.s_name);
-	  mpiPi_msg_debug ("found header raw ptr 0x%0x\n",
+	  mpiPi_msg_debug (qmpi_lvl,v,"found header name %s\n", SectHeader32.s_name);
+	  mpiPi_msg_debug (qmpi_lvl,v,"found header raw ptr 0x%0x\n",
 			   SectHeader32.s_scnptr);
 
 	  if (SectHeader32.s_flags & STYP_TEXT)
@@ -701,17 +778,17 @@ mpiPi_get_text_start (char *filename)
     }
   else if (magic == 0x01EF || magic == 0x01F7)	/*  64-bit  */
     {
-      mpiPi.obj_mode = 64;
+      gs_ptr->mpiPi.obj_mode = 64;
       read (fh, &FileHeader64, sizeof (FILHDR_64));
-      mpiPi_msg_debug ("aout size is %d\n", FileHeader64.f_opthdr);
+      mpiPi_msg_debug (qmpi_lvl,v,"aout size is %d\n", FileHeader64.f_opthdr);
       read (fh, &AoutHeader64, FileHeader64.f_opthdr);
-      mpiPi_msg_debug ("text start is 0x%0llx\n", AoutHeader64.o_text_start);
+      mpiPi_msg_debug (qmpi_lvl,v,"text start is 0x%0llx\n", AoutHeader64.o_text_start);
 
       while (count++ < FileHeader64.f_nscns)
 	{
 	  read (fh, &SectHeader64, sizeof (SCNHDR_64));
-	  mpiPi_msg_debug ("found header name %s\n", SectHeader64.s_name);
-	  mpiPi_msg_debug ("found header raw ptr 0x%0llx\n",
+	  mpiPi_msg_debug (qmpi_lvl,v,"found header name %s\n", SectHeader64.s_name);
+	  mpiPi_msg_debug (qmpi_lvl,v,"found header raw ptr 0x%0llx\n",
 			   SectHeader64.s_scnptr);
 
 	  if (SectHeader64.s_flags & STYP_TEXT)
@@ -720,11 +797,11 @@ mpiPi_get_text_start (char *filename)
     }
   else
     {
-      mpiPi_msg_debug ("invalid magic number.\n");
+      mpiPi_msg_debug (qmpi_lvl,v,"invalid magic number.\n");
       return 0;
     }
 
-  mpiPi_msg_debug ("text_start is 0x%0llx\n", text_start);
+  mpiPi_msg_debug (qmpi_lvl,v,"text_start is 0x%0llx\n", text_start);
   close (fh);
 
   return text_start;
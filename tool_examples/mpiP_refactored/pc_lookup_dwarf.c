@@ -1126,8 +1126,13 @@ close_dwarf_executable (void)
 
 int
 mpiP_find_src_loc (void *i_addr_hex,
-		   char **o_file_str, int *o_lineno, char **o_funct_str)
+		   char **o_file_str, int *o_lineno, char **o_funct_str,
+		   int qmpi_lvl, vector * v)
 {
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
   const struct AddrToSourceInfo *addrToSrcMapping = NULL;
   const struct FunctionInfo *functionInfo = NULL;
   char addr_buf[24];
@@ -1150,7 +1155,7 @@ mpiP_find_src_loc (void *i_addr_hex,
       *o_file_str = addrToSrcMapping->fileName;
       *o_lineno = addrToSrcMapping->lineNumber;
 
-      if (mpiPi.baseNames == 0 && *o_file_str != NULL)
+      if (gs_ptr->mpiPi.baseNames == 0 && *o_file_str != NULL)
 	{
 	  char *h;
 	  h = strrchr (*o_file_str, '/');
@@ -1160,7 +1165,7 @@ mpiP_find_src_loc (void *i_addr_hex,
     }
   else
     {
-      mpiPi_msg_warn ("unable to find source line info for address 0x%p\n",
+      mpiPi_msg_warn (qmpi_lvl,v,"unable to find source line info for address 0x%p\n",
 		      i_addr_hex);
       /*
        * the rest of the mpiP code seems to expect that the filename
@@ -1177,7 +1182,7 @@ mpiP_find_src_loc (void *i_addr_hex,
     }
   else
     {
-      mpiPi_msg_warn ("unable to find function info for address %s\n",
+      mpiPi_msg_warn (qmpi_lvl,v,"unable to find function info for address %s\n",
 		      mpiP_format_address (i_addr_hex, addr_buf));
     }
 
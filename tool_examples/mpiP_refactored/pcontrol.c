@@ -32,6 +32,11 @@ mpiPi_reset_callsite_data (int i , vector * v)
   callsite_stats_t **av;
   callsite_stats_t *csp = NULL;
 
+  /* the records of the other threads are cleared with the task's */
+  mpiPi_thread_merge (i, v);
+  mpiPi_thread_reset (i, v);
+  mpiPi_phase_reset (i, v);
+
   /* gather local task data */
   h_gather_data (gs_ptr->mpiPi.task_callsite_stats, &ac, (void ***) &av);
 
@@ -53,6 +58,10 @@ mpiPi_reset_callsite_data (int i , vector * v)
       csp->cumulativeIO = 0;
 
       csp->arbitraryMessageCount = 0;
+
+      if (csp->lat > 0)
+	bzero (mpiPi_latency_counts (&gs_ptr->mpiPi.latency, csp->lat),
+	       gs_ptr->mpiPi.latency.buckets * sizeof (long long));
     }
 
   if (time (&gs_ptr->mpiPi.start_timeofday) == (time_t) - 1)
@@ -113,6 +122,11 @@ mpiPi_MPI_Pcontrol (const int flag, int i , vector * v)
       mpiPi_generateReport (mpiPi_style_concise,i,v);
       mpiPi_GETTIME (&gs_ptr->mpiPi.startTime);
     }
+  else if (flag >= MPIP_PCONTROL_PHASE
+	   && flag < MPIP_PCONTROL_PHASE + MPIP_PHASES_MAX)
+    {
+      mpiPi_phase_enter (flag - MPIP_PCONTROL_PHASE, i, v);
+    }
   else
     {
       if (gs_ptr->mpiPi.enabled)
@@ -0,0 +1,350 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   phase.c -- callsite statistics per program phase
+
+   MPI_Pcontrol (MPIP_PCONTROL_PHASE + n) enters phase n of the task,
+   and mpiP_enter_phase enters one by name; phase 0 holds the calls
+   outside any.  The current phase is part of the key of the callsite
+   records, so each phase gets records of its own at no extra cost per
+   call.  For a report the records of a task are collapsed into one per
+   callsite, from which the usual sections are printed, and the phase
+   records are merged across tasks for the phase sections.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+void
+mpiPi_phase_init (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  int i;
+
+  gs_ptr->mpiPi.phase = 0;
+  gs_ptr->mpiPi.phaseUsed = 0;
+  for (i = 0; i < MPIP_PHASES_MAX; i++)
+    {
+      gs_ptr->mpiPi.phaseTime[i] = 0;
+      gs_ptr->mpiPi.phaseNames[i] = NULL;
+    }
+  gs_ptr->mpiPi.phaseTable = NULL;
+  gs_ptr->mpiPi.global_phase_count = 0;
+  gs_ptr->mpiPi.global_phases = NULL;
+  gs_ptr->mpiPi.global_phase_stats = NULL;
+  mpiPi_GETTIME (&gs_ptr->mpiPi.phaseStart);
+}
+
+
+/*  Names phases 1, 2, ... from a colon separated list (-a), as commas
+    separate the options in MPIP.  */
+void
+mpiPi_phase_set_names (const char *list, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  char *names, *name, *save = NULL;
+  int n = 1;
+
+  names = strdup (list);
+  if (names == NULL)
+    return;
+  for (name = strtok_r (names, ":", &save); name != NULL;
+       name = strtok_r (NULL, ":", &save))
+    {
+      if (n == MPIP_PHASES_MAX)
+	{
+	  mpiPi_msg_warn (qmpi_lvl,v,"Ignoring phase names past %d\n",
+			  MPIP_PHASES_MAX - 1);
+	  break;
+	}
+      free (gs_ptr->mpiPi.phaseNames[n]);
+      gs_ptr->mpiPi.phaseNames[n++] = strdup (name);
+    }
+  free (names);
+}
+
+
+/*  Copies the name of phase n into buf, "main" for phase 0 and "-" for
+    one without a name.  */
+void
+mpiPi_phase_label (int n, char *buf, int len, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  if (gs_ptr->mpiPi.phaseNames[n] != NULL)
+    snprintf (buf, len, "%s", gs_ptr->mpiPi.phaseNames[n]);
+  else
+    snprintf (buf, len, "%s", n == 0 ? "main" : "-");
+}
+
+
+void
+mpiPi_phase_enter (int n, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_TIME now;
+
+  if (n < 0 || n >= MPIP_PHASES_MAX)
+    {
+      mpiPi_msg_warn (qmpi_lvl,v,"Ignoring phase %d, the maximum is %d\n", n,
+		      MPIP_PHASES_MAX - 1);
+      return;
+    }
+
+  mpiPi_GETTIME (&now);
+  gs_ptr->mpiPi.phaseTime[gs_ptr->mpiPi.phase] +=
+    mpiPi_GETTIMEDIFF (&now, &gs_ptr->mpiPi.phaseStart) / 1000000.0;
+  gs_ptr->mpiPi.phaseStart = now;
+  gs_ptr->mpiPi.phase = n;
+  if (n != 0)
+    gs_ptr->mpiPi.phaseUsed = 1;
+}
+
+
+/*  Enters the phase of the name, numbering a new name after the last
+    phase named, or phase 0 for NULL.  Returns the phase, or -1 if all
+    are taken.  */
+int
+mpiPi_phase_enter_named (const char *name, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  int n;
+
+  if (name == NULL)
+    {
+      mpiPi_phase_enter (0, qmpi_lvl, v);
+      return 0;
+    }
+
+  for (n = 1; n < MPIP_PHASES_MAX; n++)
+    if (gs_ptr->mpiPi.phaseNames[n] == NULL
+	|| strcmp (gs_ptr->mpiPi.phaseNames[n], name) == 0)
+      break;
+  if (n == MPIP_PHASES_MAX)
+    {
+      mpiPi_msg_warn (qmpi_lvl,v,"No phase left for %s\n", name);
+      return -1;
+    }
+  if (gs_ptr->mpiPi.phaseNames[n] == NULL)
+    gs_ptr->mpiPi.phaseNames[n] = strdup (name);
+
+  mpiPi_phase_enter (n, qmpi_lvl, v);
+  return n;
+}
+
+
+void
+mpiPi_phase_reset (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  bzero (gs_ptr->mpiPi.phaseTime, sizeof (gs_ptr->mpiPi.phaseTime));
+  mpiPi_GETTIME (&gs_ptr->mpiPi.phaseStart);
+}
+
+
+/*  The wall time of each phase of the task so far, in seconds.  */
+void
+mpiPi_phase_times (double *times, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_TIME now;
+
+  memcpy (times, gs_ptr->mpiPi.phaseTime, sizeof (gs_ptr->mpiPi.phaseTime));
+  mpiPi_GETTIME (&now);
+  times[gs_ptr->mpiPi.phase] +=
+    mpiPi_GETTIMEDIFF (&now, &gs_ptr->mpiPi.phaseStart) / 1000000.0;
+}
+
+
+/*  Replaces the records of the task by one per callsite over all phases,
+    keeping the phase records for mpiPi_phase_restore.  Collective.
+    Returns whether any task entered a phase; if none did, the records
+    are left as they are.  */
+int
+mpiPi_phase_collapse (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_latency_t *lt = &gs_ptr->mpiPi.latency;
+  callsite_stats_t **av;
+  h_t *collapsed;
+  int ac, i, used;
+
+  PMPI_Allreduce (&gs_ptr->mpiPi.phaseUsed, &used, 1, MPI_INT, MPI_MAX,
+		  gs_ptr->mpiPi.comm);
+  if (!used)
+    return 0;
+
+  /* the histograms from here on are only used by this report */
+  gs_ptr->mpiPi.phaseLatencyCount = lt->count;
+  collapsed = h_open (gs_ptr->mpiPi.tableSize,
+		      mpiPi_callsite_stats_path_hashkey,
+		      mpiPi_callsite_stats_path_comparator);
+  h_gather_data (gs_ptr->mpiPi.task_callsite_stats, &ac, (void ***) &av);
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t *p = av[i], *csp = NULL;
+      callsite_stats_t key = *p;
+
+      key.phase = 0;
+      if (NULL == h_search (collapsed, &key, (void **) &csp, qmpi_lvl, v))
+	{
+	  csp = (callsite_stats_t *) malloc (sizeof (callsite_stats_t));
+	  if (csp == NULL)
+	    mpiPi_abort (qmpi_lvl,v,"failed to allocate callsite records\n");
+	  memcpy (csp, &key, sizeof (callsite_stats_t));
+	  /* the phase record keeps its histogram */
+	  csp->lat = mpiPi_latency_new (lt);
+	  if (csp->lat < 0)
+	    mpiPi_abort (qmpi_lvl,v,"failed to allocate latency histograms\n");
+	  if (csp->lat > 0 && p->lat > 0)
+	    mpiPi_latency_merge (lt, csp->lat, p->lat);
+	  h_insert (collapsed, csp, qmpi_lvl, v);
+	  continue;
+	}
+
+      mpiPi_merge_individual_callsite_records (csp, p);
+      csp->maxRMA = max (csp->maxRMA, p->maxRMA);
+      csp->minRMA = min (csp->minRMA, p->minRMA);
+      if (csp->lat > 0 && p->lat > 0)
+	mpiPi_latency_merge (lt, csp->lat, p->lat);
+    }
+  free (av);
+
+  gs_ptr->mpiPi.phaseTable = gs_ptr->mpiPi.task_callsite_stats;
+  gs_ptr->mpiPi.task_callsite_stats = collapsed;
+  return 1;
+}
+
+
+/*  Puts back the records mpiPi_phase_collapse replaced, if it did, and
+    returns the latency histograms allocated since to the task's buffer.  */
+void
+mpiPi_phase_restore (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  callsite_stats_t **av;
+  int ac, i;
+
+  if (gs_ptr->mpiPi.phaseTable == NULL)
+    return;
+
+  h_gather_data (gs_ptr->mpiPi.task_callsite_stats, &ac, (void ***) &av);
+  for (i = 0; i < ac; i++)
+    free (av[i]);
+  free (av);
+  h_close (gs_ptr->mpiPi.task_callsite_stats);
+
+  gs_ptr->mpiPi.task_callsite_stats = gs_ptr->mpiPi.phaseTable;
+  gs_ptr->mpiPi.phaseTable = NULL;
+  gs_ptr->mpiPi.latency.count = gs_ptr->mpiPi.phaseLatencyCount;
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
@@ -0,0 +1,1157 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   profile.c -- binary profile written at finalize (-b)
+
+   The collector stores the merged statistics the report is printed
+   from, and mpip-report prints the report from them later.  The file
+   is a header and a list of tagged sections, the last of which holds
+   the strings the others refer to by offset.  Readers skip sections
+   they do not know.  MPI calls are stored by name, so that a profile
+   can be read by a build that numbers them differently.  Numbers are
+   in the writer's byte order, which the header records.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+#define PROFILE_MAGIC "mPprof\0\0"
+#define PROFILE_MAGIC_LEN 8
+#define PROFILE_VERSION 1
+#define PROFILE_BYTE_ORDER 0x01020304u
+#define PROFILE_NO_STRING 0xffffffffu
+
+enum
+{
+  PROFILE_END,
+  PROFILE_INFO,
+  PROFILE_OPS,
+  PROFILE_TASKS,
+  PROFILE_COLL_HIST,
+  PROFILE_PT2PT_HIST,
+  PROFILE_SITES,
+  PROFILE_RECORDS,		/* per task, for the single collector report */
+  PROFILE_AGG,			/* per callsite */
+  PROFILE_MPI_AGG,		/* per MPI call, with a stack depth of 0 */
+  PROFILE_STRINGS,
+  PROFILE_LATENCY,		/* histograms of the per callsite records */
+  PROFILE_THREADS,		/* MPI time per thread (-j) */
+  PROFILE_PHASES,		/* phase totals and records, see phase.c */
+  PROFILE_SECTIONS
+};
+
+typedef struct
+{
+  char *buf;
+  size_t len, cap;
+  int failed;
+} profile_buf_t;
+
+/*  The strings, each stored once, and an index of their offsets.  */
+typedef struct
+{
+  profile_buf_t blob;
+  unsigned *index;		/* offset + 1 in each slot, 0 if empty */
+  unsigned index_size;
+  unsigned count;
+} profile_strings_t;
+
+typedef struct
+{
+  const char *p, *end;
+  int failed;
+} profile_in_t;
+
+
+static void
+profile_put (profile_buf_t * b, const void *p, size_t n)
+{
+  if (b->len + n > b->cap)
+    {
+      size_t cap = b->cap == 0 ? 4096 : b->cap;
+      char *buf;
+      while (cap < b->len + n)
+	cap *= 2;
+      buf = (char *) realloc (b->buf, cap);
+      if (buf == NULL)
+	{
+	  b->failed = 1;
+	  return;
+	}
+      b->buf = buf;
+      b->cap = cap;
+    }
+  memcpy (b->buf + b->len, p, n);
+  b->len += n;
+}
+
+static void
+profile_put_u32 (profile_buf_t * b, unsigned x)
+{
+  profile_put (b, &x, sizeof (x));
+}
+
+static void
+profile_put_i64 (profile_buf_t * b, long long x)
+{
+  profile_put (b, &x, sizeof (x));
+}
+
+static void
+profile_put_double (profile_buf_t * b, double d)
+{
+  profile_put (b, &d, sizeof (d));
+}
+
+static unsigned
+profile_string_hash (const char *s)
+{
+  unsigned h = 2166136261u;
+  while (*s != '\0')
+    h = (h ^ (unsigned char) *s++) * 16777619u;
+  return h;
+}
+
+/*  Returns the offset of s in the string section, adding it if new.  */
+static unsigned
+profile_intern (profile_strings_t * st, const char *s)
+{
+  unsigned i, mask, off;
+
+  if (s == NULL)
+    return PROFILE_NO_STRING;
+
+  if (2 * (st->count + 1) > st->index_size)
+    {
+      unsigned size = st->index_size == 0 ? 256 : 2 * st->index_size;
+      unsigned *index = (unsigned *) calloc (size, sizeof (unsigned));
+
+      if (index == NULL)
+	{
+	  st->blob.failed = 1;
+	  return PROFILE_NO_STRING;
+	}
+      for (i = 0; i < st->index_size; i++)
+	if (st->index[i] != 0)
+	  {
+	    unsigned j =
+	      profile_string_hash (st->blob.buf + st->index[i] - 1);
+	    while (index[j & (size - 1)] != 0)
+	      j++;
+	    index[j & (size - 1)] = st->index[i];
+	  }
+      free (st->index);
+      st->index = index;
+      st->index_size = size;
+    }
+
+  mask = st->index_size - 1;
+  for (i = profile_string_hash (s) & mask; st->index[i] != 0;
+       i = (i + 1) & mask)
+    if (strcmp (st->blob.buf + st->index[i] - 1, s) == 0)
+      return st->index[i] - 1;
+
+  off = (unsigned) st->blob.len;
+  profile_put (&st->blob, s, strlen (s) + 1);
+  if (st->blob.failed)
+    return PROFILE_NO_STRING;
+  st->index[i] = off + 1;
+  st->count++;
+  return off;
+}
+
+static void
+profile_put_str (profile_buf_t * b, profile_strings_t * st, const char *s)
+{
+  profile_put_u32 (b, profile_intern (st, s));
+}
+
+static void
+profile_write_section (FILE * fp, int tag, profile_buf_t * b)
+{
+  unsigned sh[2] = { tag, 0 };
+  unsigned long long len = b != NULL ? b->len : 0;
+
+  fwrite (sh, sizeof (unsigned), 2, fp);
+  fwrite (&len, sizeof (len), 1, fp);
+  if (len > 0)
+    fwrite (b->buf, 1, len, fp);
+}
+
+static void
+profile_put_histogram (profile_buf_t * b, mpiPi_histogram_t * h)
+{
+  int i;
+
+  profile_put_u32 (b, (unsigned) h->first_bin_max);
+  profile_put_u32 (b, (unsigned) h->hist_size);
+  profile_put_u32 (b, h->bin_intervals != NULL ? h->hist_size : 0);
+  if (h->bin_intervals != NULL)
+    for (i = 0; i < h->hist_size; i++)
+      profile_put_u32 (b, (unsigned) h->bin_intervals[i]);
+}
+
+static void
+profile_put_hist_cells (profile_buf_t * b, mpiPi_histogram_t * comm,
+			mpiPi_histogram_t * size, mpiPi_hist_cells_t * h)
+{
+  int i;
+
+  profile_put_histogram (b, comm);
+  profile_put_histogram (b, size);
+  profile_put_u32 (b, (unsigned) h->count);
+  for (i = 0; i < h->size; i++)
+    if (h->cells[i].key != 0)
+      {
+	profile_put_u32 (b, h->cells[i].key);
+	profile_put_double (b, h->cells[i].value);
+      }
+}
+
+static void
+profile_put_records (profile_buf_t * b, h_t * ht)
+{
+  int i, ac;
+  callsite_stats_t **av;
+
+  h_gather_data (ht, &ac, (void ***) &av);
+  profile_put_u32 (b, (unsigned) ac);
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t *p = av[i];
+
+      profile_put_u32 (b, p->op);
+      profile_put_u32 (b, p->rank);
+      profile_put_u32 (b, (unsigned) p->csid);
+      profile_put_i64 (b, p->count);
+      profile_put_i64 (b, p->arbitraryMessageCount);
+      profile_put_i64 (b, p->siteCount);
+      profile_put_double (b, p->cumulativeTime);
+      profile_put_double (b, p->cumulativeTimeSquared);
+      profile_put_double (b, p->maxDur);
+      profile_put_double (b, p->minDur);
+      profile_put_double (b, p->maxDataSent);
+      profile_put_double (b, p->minDataSent);
+      profile_put_double (b, p->maxIO);
+      profile_put_double (b, p->minIO);
+      profile_put_double (b, p->maxRMA);
+      profile_put_double (b, p->minRMA);
+      profile_put_double (b, p->cumulativeDataSent);
+      profile_put_double (b, p->cumulativeIO);
+      profile_put_double (b, p->cumulativeRMA);
+      profile_put_double (b, p->siteMean);
+      profile_put_double (b, p->siteM2);
+    }
+  free (av);
+}
+
+/*  The buckets in use of the latency histograms of the records in ht,
+    by op and site.  */
+static void
+profile_put_latency (profile_buf_t * b, h_t * ht, mpiPi_latency_t * lt)
+{
+  int i, j, ac, used;
+  callsite_stats_t **av;
+
+  h_gather_data (ht, &ac, (void ***) &av);
+  profile_put_u32 (b, (unsigned) lt->sub_bits);
+  for (i = 0, used = 0; i < ac; i++)
+    used += av[i]->lat > 0;
+  profile_put_u32 (b, (unsigned) used);
+  for (i = 0; i < ac; i++)
+    {
+      long long *c;
+
+      if (av[i]->lat <= 0)
+	continue;
+      c = mpiPi_latency_counts (lt, av[i]->lat);
+      for (j = 0, used = 0; j < lt->buckets; j++)
+	used += c[j] != 0;
+      profile_put_u32 (b, av[i]->op);
+      profile_put_u32 (b, (unsigned) av[i]->csid);
+      profile_put_u32 (b, (unsigned) used);
+      for (j = 0; j < lt->buckets; j++)
+	if (c[j] != 0)
+	  {
+	    profile_put_u32 (b, (unsigned) j);
+	    profile_put_i64 (b, c[j]);
+	  }
+    }
+  free (av);
+}
+
+
+/*  Writes the merged statistics of the collector to path.  Returns 1 on
+    success.  */
+int
+mpiPi_profile_write (const char *path, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  profile_buf_t sec[PROFILE_SECTIONS];
+  profile_strings_t st;
+  profile_buf_t *b;
+  FILE *fp;
+  int i, tag, ok = 1;
+
+  memset (sec, 0, sizeof (sec));
+  memset (&st, 0, sizeof (st));
+
+  b = &sec[PROFILE_INFO];
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.ac);
+  for (i = 0; i < gs_ptr->mpiPi.ac; i++)
+    profile_put_str (b, &st, gs_ptr->mpiPi.av[i]);
+  profile_put_str (b, &st, gs_ptr->mpiPi.toolname);
+  profile_put_str (b, &st, gs_ptr->mpiPi.appName);
+  profile_put_str (b, &st, gs_ptr->mpiPi.outputDir);
+  profile_put_str (b, &st, gs_ptr->mpiPi.envStr);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.procID);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.size);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.collectorRank);
+  profile_put_i64 (b, (long long) gs_ptr->mpiPi.start_timeofday);
+  profile_put_i64 (b, (long long) gs_ptr->mpiPi.stop_timeofday);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.stackDepth);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.reportFormat);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.calcCOV);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.messageCountThreshold);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.report_style);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.print_callsite_detail);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.do_collective_stats_report);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.do_pt2pt_stats_report);
+  profile_put_double (b, gs_ptr->mpiPi.reportPrintThreshold);
+  profile_put_double (b, gs_ptr->mpiPi.global_app_time);
+  profile_put_double (b, gs_ptr->mpiPi.global_mpi_time);
+  profile_put_double (b, gs_ptr->mpiPi.global_mpi_size);
+  profile_put_double (b, gs_ptr->mpiPi.global_mpi_io);
+  profile_put_double (b, gs_ptr->mpiPi.global_mpi_rma);
+  profile_put_i64 (b, gs_ptr->mpiPi.global_mpi_msize_threshold_count);
+  profile_put_i64 (b, gs_ptr->mpiPi.global_mpi_sent_count);
+  profile_put_i64 (b, gs_ptr->mpiPi.global_time_callsite_count);
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.global_thread_max);
+
+  b = &sec[PROFILE_OPS];
+  for (i = 0; gs_ptr->mpiPi.lookup[i].name != NULL; i++)
+    ;
+  profile_put_u32 (b, mpiPi_BASE);
+  profile_put_u32 (b, (unsigned) i);
+  for (i = 0; gs_ptr->mpiPi.lookup[i].name != NULL; i++)
+    profile_put_str (b, &st, gs_ptr->mpiPi.lookup[i].name);
+
+  b = &sec[PROFILE_TASKS];
+  profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.size);
+  for (i = 0; i < gs_ptr->mpiPi.size; i++)
+    profile_put_double (b, gs_ptr->mpiPi.global_task_app_time[i]);
+  for (i = 0; i < gs_ptr->mpiPi.size; i++)
+    profile_put_double (b, gs_ptr->mpiPi.global_task_mpi_time[i]);
+  profile_put_u32 (b, gs_ptr->mpiPi.global_task_hostnames != NULL);
+  if (gs_ptr->mpiPi.global_task_hostnames != NULL)
+    for (i = 0; i < gs_ptr->mpiPi.size; i++)
+      profile_put_str (b, &st, gs_ptr->mpiPi.global_task_hostnames[i]);
+
+  if (gs_ptr->mpiPi.do_collective_stats_report)
+    profile_put_hist_cells (&sec[PROFILE_COLL_HIST],
+			    &gs_ptr->mpiPi.coll_comm_histogram,
+			    &gs_ptr->mpiPi.coll_size_histogram,
+			    &gs_ptr->mpiPi.coll_time_stats);
+  if (gs_ptr->mpiPi.do_pt2pt_stats_report)
+    profile_put_hist_cells (&sec[PROFILE_PT2PT_HIST],
+			    &gs_ptr->mpiPi.pt2pt_comm_histogram,
+			    &gs_ptr->mpiPi.pt2pt_size_histogram,
+			    &gs_ptr->mpiPi.pt2pt_send_stats);
+
+  if (gs_ptr->callsite_src_id_cache != NULL)
+    {
+      int ac, j;
+      callsite_src_id_cache_entry_t **av;
+
+      b = &sec[PROFILE_SITES];
+      h_gather_data (gs_ptr->callsite_src_id_cache, &ac, (void ***) &av);
+      profile_put_u32 (b, MPIP_CALLSITE_STACK_DEPTH_MAX);
+      profile_put_u32 (b, (unsigned) ac);
+      for (i = 0; i < ac; i++)
+	{
+	  profile_put_u32 (b, (unsigned) av[i]->id);
+	  profile_put_u32 (b, (unsigned) av[i]->op);
+	  for (j = 0; j < MPIP_CALLSITE_STACK_DEPTH_MAX; j++)
+	    {
+	      profile_put_str (b, &st, av[i]->filename[j]);
+	      profile_put_str (b, &st, av[i]->functname[j]);
+	      profile_put_u32 (b, (unsigned) av[i]->line[j]);
+	      profile_put_i64 (b, (long long) (size_t) av[i]->pc[j]);
+	    }
+	}
+      free (av);
+    }
+
+  if (gs_ptr->mpiPi.global_callsite_stats != NULL)
+    profile_put_records (&sec[PROFILE_RECORDS],
+			 gs_ptr->mpiPi.global_callsite_stats);
+  if (gs_ptr->mpiPi.global_callsite_stats_agg != NULL)
+    profile_put_records (&sec[PROFILE_AGG],
+			 gs_ptr->mpiPi.global_callsite_stats_agg);
+  if (gs_ptr->mpiPi.global_MPI_stats_agg != NULL)
+    profile_put_records (&sec[PROFILE_MPI_AGG],
+			 gs_ptr->mpiPi.global_MPI_stats_agg);
+  if (gs_ptr->mpiPi.global_callsite_stats_agg != NULL
+      && gs_ptr->mpiPi.latency.buckets > 0)
+    profile_put_latency (&sec[PROFILE_LATENCY],
+			 gs_ptr->mpiPi.global_callsite_stats_agg,
+			 &gs_ptr->mpiPi.latency);
+
+  if (gs_ptr->mpiPi.do_thread_report
+      && gs_ptr->mpiPi.global_thread_times != NULL)
+    {
+      b = &sec[PROFILE_THREADS];
+      profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.global_thread_count);
+      for (i = 0; i < gs_ptr->mpiPi.global_thread_count; i++)
+	{
+	  mpiPi_thread_time_t *t = &gs_ptr->mpiPi.global_thread_times[i];
+
+	  profile_put_u32 (b, (unsigned) t->task);
+	  profile_put_u32 (b, (unsigned) t->thread);
+	  profile_put_i64 (b, t->calls);
+	  profile_put_double (b, t->mpiTime);
+	}
+    }
+
+  if (gs_ptr->mpiPi.global_phases != NULL)
+    {
+      b = &sec[PROFILE_PHASES];
+      profile_put_u32 (b, (unsigned) gs_ptr->mpiPi.global_phase_count);
+      for (i = 0; i < gs_ptr->mpiPi.global_phase_count; i++)
+	{
+	  mpiPi_phase_t *ph = &gs_ptr->mpiPi.global_phases[i];
+
+	  profile_put_str (b, &st, ph->name);
+	  profile_put_double (b, ph->appTime);
+	  profile_put_double (b, ph->mpiTime);
+	  profile_put_i64 (b, ph->calls);
+	}
+      profile_put_records (b, gs_ptr->mpiPi.global_phase_stats);
+    }
+
+  sec[PROFILE_STRINGS] = st.blob;
+
+  for (tag = 0; tag < PROFILE_SECTIONS; tag++)
+    if (sec[tag].failed)
+      ok = 0;
+
+  fp = ok ? fopen (path, "wb") : NULL;
+  if (fp != NULL)
+    {
+      unsigned hdr[2] = { PROFILE_VERSION, PROFILE_BYTE_ORDER };
+
+      fwrite (PROFILE_MAGIC, 1, PROFILE_MAGIC_LEN, fp);
+      fwrite (hdr, sizeof (unsigned), 2, fp);
+      for (tag = PROFILE_INFO; tag < PROFILE_SECTIONS; tag++)
+	if (sec[tag].len > 0)
+	  profile_write_section (fp, tag, &sec[tag]);
+      profile_write_section (fp, PROFILE_END, NULL);
+      if (ferror (fp))
+	ok = 0;
+      if (fclose (fp) != 0)
+	ok = 0;
+    }
+  else
+    ok = 0;
+
+  for (tag = 0; tag < PROFILE_SECTIONS; tag++)
+    free (sec[tag].buf);
+  free (st.index);
+
+  return ok;
+}
+
+
+static void
+profile_get (profile_in_t * in, void *p, size_t n)
+{
+  if (in->failed || (size_t) (in->end - in->p) < n)
+    {
+      in->failed = 1;
+      memset (p, 0, n);
+      return;
+    }
+  memcpy (p, in->p, n);
+  in->p += n;
+}
+
+static unsigned
+profile_get_u32 (profile_in_t * in)
+{
+  unsigned x;
+  profile_get (in, &x, sizeof (x));
+  return x;
+}
+
+static int
+profile_get_int (profile_in_t * in)
+{
+  return (int) profile_get_u32 (in);
+}
+
+static long long
+profile_get_i64 (profile_in_t * in)
+{
+  long long x;
+  profile_get (in, &x, sizeof (x));
+  return x;
+}
+
+static double
+profile_get_double (profile_in_t * in)
+{
+  double d;
+  profile_get (in, &d, sizeof (d));
+  return d;
+}
+
+/*  Returns a copy of the string the next offset refers to, NULL if it
+    is PROFILE_NO_STRING.  */
+static char *
+profile_get_str (profile_in_t * in, profile_in_t * strings)
+{
+  unsigned off = profile_get_u32 (in);
+  const char *s;
+
+  if (off == PROFILE_NO_STRING || in->failed)
+    return NULL;
+  s = strings->p + off;
+  if (off >= (size_t) (strings->end - strings->p)
+      || memchr (s, '\0', strings->end - s) == NULL)
+    {
+      in->failed = 1;
+      return NULL;
+    }
+  return strdup (s);
+}
+
+static void
+profile_get_histogram (profile_in_t * in, mpiPi_histogram_t * h)
+{
+  int i, n;
+
+  h->first_bin_max = profile_get_int (in);
+  h->hist_size = profile_get_int (in);
+  n = profile_get_int (in);
+  h->bin_intervals = NULL;
+  if (n <= 0 || in->failed)
+    return;
+  h->bin_intervals = (int *) malloc (n * sizeof (int));
+  if (h->bin_intervals == NULL)
+    {
+      in->failed = 1;
+      return;
+    }
+  for (i = 0; i < n; i++)
+    h->bin_intervals[i] = profile_get_int (in);
+}
+
+/*  Maps the writer's op numbers to this build's, -1 for calls that this
+    build does not know.  */
+typedef struct
+{
+  unsigned base;
+  unsigned count;
+  int *op;
+} profile_ops_t;
+
+static int
+profile_op (profile_ops_t * ops, unsigned op)
+{
+  if (op - ops->base >= ops->count)
+    return -1;
+  return ops->op[op - ops->base];
+}
+
+static void
+profile_get_hist_cells (profile_in_t * in, profile_ops_t * ops,
+			mpiPi_histogram_t * comm, mpiPi_histogram_t * size,
+			mpiPi_hist_cells_t * h)
+{
+  unsigned i, n;
+
+  profile_get_histogram (in, comm);
+  profile_get_histogram (in, size);
+  n = profile_get_u32 (in);
+  for (i = 0; i < n && !in->failed; i++)
+    {
+      unsigned key = profile_get_u32 (in);
+      double value = profile_get_double (in);
+      int op = profile_op (ops, ops->base + MPIP_HIST_OP (key));
+
+      if (op >= 0
+	  && mpiPi_hist_cells_add (h, MPIP_HIST_KEY (op - mpiPi_BASE,
+						     MPIP_HIST_COMM_BIN (key),
+						     MPIP_HIST_SIZE_BIN (key)),
+				   value) != 0)
+	in->failed = 1;
+    }
+}
+
+static void
+profile_get_records (profile_in_t * in, profile_ops_t * ops, h_t * ht,
+		     int by_op, int qmpi_lvl, vector * v)
+{
+  unsigned i, n;
+
+  n = profile_get_u32 (in);
+  for (i = 0; i < n && !in->failed; i++)
+    {
+      callsite_stats_t *p;
+      int op;
+
+      p = (callsite_stats_t *) malloc (sizeof (callsite_stats_t));
+      if (p == NULL)
+	{
+	  in->failed = 1;
+	  return;
+	}
+      op = profile_op (ops, profile_get_u32 (in));
+      p->op = op;
+      p->rank = profile_get_u32 (in);
+      p->csid = profile_get_int (in);
+      p->count = profile_get_i64 (in);
+      p->arbitraryMessageCount = profile_get_i64 (in);
+      p->siteCount = profile_get_i64 (in);
+      p->cumulativeTime = profile_get_double (in);
+      p->cumulativeTimeSquared = profile_get_double (in);
+      p->maxDur = profile_get_double (in);
+      p->minDur = profile_get_double (in);
+      p->maxDataSent = profile_get_double (in);
+      p->minDataSent = profile_get_double (in);
+      p->maxIO = profile_get_double (in);
+      p->minIO = profile_get_double (in);
+      p->maxRMA = profile_get_double (in);
+      p->minRMA = profile_get_double (in);
+      p->cumulativeDataSent = profile_get_double (in);
+      p->cumulativeIO = profile_get_double (in);
+      p->cumulativeRMA = profile_get_double (in);
+      p->siteMean = profile_get_double (in);
+      p->siteM2 = profile_get_double (in);
+      p->path = 0;
+      p->lat = 0;
+      p->phase = 0;
+      p->cookie = MPIP_CALLSITE_STATS_COOKIE;
+
+      /* records of the MPI calls are identified by the call */
+      if (by_op)
+	p->csid = op - mpiPi_BASE;
+
+      if (op < 0 || in->failed)
+	free (p);
+      else
+	h_insert (ht, p, qmpi_lvl, v);
+    }
+}
+
+static void
+profile_get_latency (profile_in_t * in, profile_ops_t * ops, h_t * ht,
+		     mpiPi_latency_t * lt, int qmpi_lvl, vector * v)
+{
+  unsigned i, j, n, used;
+  int sub_bits = profile_get_int (in);
+
+  if (sub_bits < 1 || sub_bits > 7)
+    {
+      in->failed = 1;
+      return;
+    }
+  mpiPi_latency_init (lt, sub_bits);
+  n = profile_get_u32 (in);
+  for (i = 0; i < n && !in->failed; i++)
+    {
+      callsite_stats_t key, *p = NULL;
+      long long *c = NULL;
+
+      key.op = profile_op (ops, profile_get_u32 (in));
+      key.csid = profile_get_int (in);
+      key.cookie = MPIP_CALLSITE_STATS_COOKIE;
+      used = profile_get_u32 (in);
+      if (!in->failed && (int) key.op >= 0
+	  && h_search (ht, &key, (void **) &p, qmpi_lvl, v) != NULL)
+	{
+	  p->lat = mpiPi_latency_new (lt);
+	  if (p->lat < 0)
+	    {
+	      p->lat = 0;
+	      in->failed = 1;
+	    }
+	  else
+	    c = mpiPi_latency_counts (lt, p->lat);
+	}
+      for (j = 0; j < used && !in->failed; j++)
+	{
+	  unsigned bucket = profile_get_u32 (in);
+	  long long count = profile_get_i64 (in);
+
+	  if (bucket >= (unsigned) lt->buckets)
+	    in->failed = 1;
+	  else if (c != NULL)
+	    c[bucket] = count;
+	}
+    }
+}
+
+
+/*  Loads a profile written by mpiPi_profile_write, into a context that
+    has not been initialized for profiling.  The report of the collector
+    can then be printed with mpiPi_profile_print.  Returns 1 on
+    success.  */
+int
+mpiPi_profile_read (const char *path, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  profile_in_t sec[PROFILE_SECTIONS];
+  profile_in_t file, *in, *strings;
+  profile_ops_t ops;
+  unsigned hdr[2];
+  char *buf = NULL;
+  size_t len = 0, cap = 0;
+  FILE *fp;
+  int i, tag;
+
+  fp = fopen (path, "rb");
+  if (fp == NULL)
+    {
+      mpiPi_msg_warn (qmpi_lvl, v, "Could not open [%s]\n", path);
+      return 0;
+    }
+  for (;;)
+    {
+      if (len == cap)
+	{
+	  char *nbuf;
+
+	  cap = cap == 0 ? 65536 : 2 * cap;
+	  nbuf = (char *) realloc (buf, cap);
+	  if (nbuf == NULL)
+	    break;
+	  buf = nbuf;
+	}
+      i = fread (buf + len, 1, cap - len, fp);
+      if (i <= 0)
+	break;
+      len += i;
+    }
+  fclose (fp);
+
+  memset (sec, 0, sizeof (sec));
+  file.p = buf;
+  file.end = buf + len;
+  file.failed = buf == NULL;
+
+  if (len < PROFILE_MAGIC_LEN
+      || memcmp (buf, PROFILE_MAGIC, PROFILE_MAGIC_LEN) != 0)
+    {
+      mpiPi_msg_warn (qmpi_lvl, v, "[%s] is not an mpiP profile\n", path);
+      free (buf);
+      return 0;
+    }
+  file.p += PROFILE_MAGIC_LEN;
+  hdr[0] = profile_get_u32 (&file);
+  hdr[1] = profile_get_u32 (&file);
+  if (hdr[1] != PROFILE_BYTE_ORDER || hdr[0] > PROFILE_VERSION)
+    {
+      mpiPi_msg_warn (qmpi_lvl, v,
+		      "[%s] has version %u or another byte order\n", path,
+		      hdr[0]);
+      free (buf);
+      return 0;
+    }
+
+  /* Find the sections.  */
+  while (!file.failed)
+    {
+      unsigned long long slen;
+
+      tag = profile_get_int (&file);
+      profile_get_u32 (&file);
+      slen = profile_get_i64 (&file);
+      if (file.failed || tag == PROFILE_END)
+	break;
+      if (slen > (unsigned long long) (file.end - file.p))
+	{
+	  file.failed = 1;
+	  break;
+	}
+      if (tag > PROFILE_END && tag < PROFILE_SECTIONS)
+	{
+	  sec[tag].p = file.p;
+	  sec[tag].end = file.p + slen;
+	}
+      file.p += slen;
+    }
+  strings = &sec[PROFILE_STRINGS];
+  if (file.failed || sec[PROFILE_INFO].p == NULL || sec[PROFILE_OPS].p == NULL)
+    {
+      mpiPi_msg_warn (qmpi_lvl, v, "[%s] is truncated\n", path);
+      free (buf);
+      return 0;
+    }
+
+  in = &sec[PROFILE_INFO];
+  gs_ptr->mpiPi.ac = profile_get_int (in);
+  if (gs_ptr->mpiPi.ac > 32)
+    in->failed = 1;
+  for (i = 0; i < gs_ptr->mpiPi.ac && !in->failed; i++)
+    gs_ptr->mpiPi.av[i] = profile_get_str (in, strings);
+  gs_ptr->mpiPi.toolname = profile_get_str (in, strings);
+  gs_ptr->mpiPi.appName = profile_get_str (in, strings);
+  gs_ptr->mpiPi.outputDir = profile_get_str (in, strings);
+  gs_ptr->mpiPi.envStr = profile_get_str (in, strings);
+  gs_ptr->mpiPi.procID = profile_get_int (in);
+  gs_ptr->mpiPi.size = profile_get_int (in);
+  gs_ptr->mpiPi.collectorRank = profile_get_int (in);
+  gs_ptr->mpiPi.start_timeofday = (time_t) profile_get_i64 (in);
+  gs_ptr->mpiPi.stop_timeofday = (time_t) profile_get_i64 (in);
+  gs_ptr->mpiPi.stackDepth = profile_get_int (in);
+  gs_ptr->mpiPi.reportFormat = profile_get_int (in);
+  gs_ptr->mpiPi.calcCOV = profile_get_int (in);
+  gs_ptr->mpiPi.messageCountThreshold = profile_get_int (in);
+  gs_ptr->mpiPi.report_style = profile_get_int (in);
+  gs_ptr->mpiPi.print_callsite_detail = profile_get_int (in);
+  gs_ptr->mpiPi.do_collective_stats_report = profile_get_int (in);
+  gs_ptr->mpiPi.do_pt2pt_stats_report = profile_get_int (in);
+  gs_ptr->mpiPi.reportPrintThreshold = profile_get_double (in);
+  gs_ptr->mpiPi.global_app_time = profile_get_double (in);
+  gs_ptr->mpiPi.global_mpi_time = profile_get_double (in);
+  gs_ptr->mpiPi.global_mpi_size = profile_get_double (in);
+  gs_ptr->mpiPi.global_mpi_io = profile_get_double (in);
+  gs_ptr->mpiPi.global_mpi_rma = profile_get_double (in);
+  gs_ptr->mpiPi.global_mpi_msize_threshold_count = profile_get_i64 (in);
+  gs_ptr->mpiPi.global_mpi_sent_count = profile_get_i64 (in);
+  gs_ptr->mpiPi.global_time_callsite_count = profile_get_i64 (in);
+  /* older profiles end here */
+  gs_ptr->mpiPi.global_thread_max = 1;
+  if (in->p < in->end)
+    gs_ptr->mpiPi.global_thread_max = profile_get_int (in);
+  if (gs_ptr->mpiPi.toolname == NULL)
+    gs_ptr->mpiPi.toolname = "mpiP";
+  if (gs_ptr->mpiPi.size <= 0)
+    in->failed = 1;
+
+  /* The report is printed as by the collector of a single collector
+     report.  */
+  gs_ptr->mpiPi.rank = gs_ptr->mpiPi.collectorRank;
+  gs_ptr->mpiPi.collective_report = 0;
+  gs_ptr->mpiPi.lookup = mpiPi_lookup;
+  if (gs_ptr->mpiPi.tableSize <= 0)
+    gs_ptr->mpiPi.tableSize = 256;
+
+  in = &sec[PROFILE_OPS];
+  ops.base = profile_get_u32 (in);
+  ops.count = profile_get_u32 (in);
+  ops.op = NULL;
+  if (!in->failed && ops.count <= (size_t) (in->end - in->p) / sizeof (unsigned))
+    ops.op = (int *) malloc ((ops.count + 1) * sizeof (int));
+  if (ops.op == NULL)
+    in->failed = 1;
+  for (i = 0; i < (int) ops.count && !in->failed; i++)
+    {
+      char *name = profile_get_str (in, strings);
+      int j;
+
+      ops.op[i] = -1;
+      for (j = 0; name != NULL && mpiPi_lookup[j].name != NULL; j++)
+	if (strcmp (mpiPi_lookup[j].name, name) == 0)
+	  {
+	    ops.op[i] = mpiPi_lookup[j].op;
+	    break;
+	  }
+      free (name);
+    }
+
+  in = &sec[PROFILE_TASKS];
+  if (in->p != NULL)
+    {
+      int n = profile_get_int (in);
+
+      if (n != gs_ptr->mpiPi.size)
+	in->failed = 1;
+      gs_ptr->mpiPi.global_task_app_time =
+	(double *) calloc (gs_ptr->mpiPi.size, sizeof (double));
+      gs_ptr->mpiPi.global_task_mpi_time =
+	(double *) calloc (gs_ptr->mpiPi.size, sizeof (double));
+      if (gs_ptr->mpiPi.global_task_app_time == NULL
+	  || gs_ptr->mpiPi.global_task_mpi_time == NULL)
+	in->failed = 1;
+      for (i = 0; i < gs_ptr->mpiPi.size && !in->failed; i++)
+	gs_ptr->mpiPi.global_task_app_time[i] = profile_get_double (in);
+      for (i = 0; i < gs_ptr->mpiPi.size && !in->failed; i++)
+	gs_ptr->mpiPi.global_task_mpi_time[i] = profile_get_double (in);
+      if (profile_get_u32 (in) && !in->failed)
+	{
+	  gs_ptr->mpiPi.global_task_hostnames =
+	    (mpiPi_hostname_t *) calloc (gs_ptr->mpiPi.size,
+					 sizeof (mpiPi_hostname_t));
+	  if (gs_ptr->mpiPi.global_task_hostnames == NULL)
+	    in->failed = 1;
+	  for (i = 0; i < gs_ptr->mpiPi.size && !in->failed; i++)
+	    {
+	      char *host = profile_get_str (in, strings);
+
+	      if (host != NULL)
+		snprintf (gs_ptr->mpiPi.global_task_hostnames[i],
+			  MPIPI_HOSTNAME_LEN_MAX, "%s", host);
+	      free (host);
+	    }
+	}
+    }
+
+  if (sec[PROFILE_COLL_HIST].p != NULL)
+    profile_get_hist_cells (&sec[PROFILE_COLL_HIST], &ops,
+			    &gs_ptr->mpiPi.coll_comm_histogram,
+			    &gs_ptr->mpiPi.coll_size_histogram,
+			    &gs_ptr->mpiPi.coll_time_stats);
+  if (sec[PROFILE_PT2PT_HIST].p != NULL)
+    profile_get_hist_cells (&sec[PROFILE_PT2PT_HIST], &ops,
+			    &gs_ptr->mpiPi.pt2pt_comm_histogram,
+			    &gs_ptr->mpiPi.pt2pt_size_histogram,
+			    &gs_ptr->mpiPi.pt2pt_send_stats);
+
+  mpiPi_open_report_tables (qmpi_lvl, v);
+  gs_ptr->callsite_src_id_counter = 1;
+
+  in = &sec[PROFILE_SITES];
+  if (in->p != NULL)
+    {
+      unsigned depth = profile_get_u32 (in);
+      unsigned n = profile_get_u32 (in);
+      unsigned j, k;
+
+      for (j = 0; j < n && !in->failed; j++)
+	{
+	  callsite_src_id_cache_entry_t *csp;
+
+	  csp = (callsite_src_id_cache_entry_t *)
+	    calloc (1, sizeof (callsite_src_id_cache_entry_t));
+	  if (csp == NULL)
+	    {
+	      in->failed = 1;
+	      break;
+	    }
+	  csp->id = profile_get_int (in);
+	  csp->op = profile_op (&ops, profile_get_u32 (in));
+	  for (k = 0; k < depth; k++)
+	    {
+	      char *file = profile_get_str (in, strings);
+	      char *funct = profile_get_str (in, strings);
+	      int line = profile_get_int (in);
+	      void *pc = (void *) (size_t) profile_get_i64 (in);
+
+	      if (k >= MPIP_CALLSITE_STACK_DEPTH_MAX)
+		{
+		  free (file);
+		  free (funct);
+		  continue;
+		}
+	      csp->filename[k] = file;
+	      csp->functname[k] = funct;
+	      csp->line[k] = line;
+	      csp->pc[k] = pc;
+	    }
+	  if (in->failed || csp->op < 0)
+	    {
+	      /* sites of calls this mpiP does not know are dropped */
+	      for (k = 0; k < depth && k < MPIP_CALLSITE_STACK_DEPTH_MAX; k++)
+		{
+		  free (csp->filename[k]);
+		  free (csp->functname[k]);
+		}
+	      free (csp);
+	      if (in->failed)
+		break;
+	      continue;
+	    }
+	  h_insert (gs_ptr->callsite_src_id_cache, csp, qmpi_lvl, v);
+	  if (csp->id >= gs_ptr->callsite_src_id_counter)
+	    gs_ptr->callsite_src_id_counter = csp->id + 1;
+	}
+    }
+
+  if (sec[PROFILE_RECORDS].p != NULL)
+    profile_get_records (&sec[PROFILE_RECORDS], &ops,
+			 gs_ptr->mpiPi.global_callsite_stats, 0, qmpi_lvl, v);
+  if (sec[PROFILE_AGG].p != NULL)
+    profile_get_records (&sec[PROFILE_AGG], &ops,
+			 gs_ptr->mpiPi.global_callsite_stats_agg, 0,
+			 qmpi_lvl, v);
+  if (sec[PROFILE_MPI_AGG].p != NULL)
+    profile_get_records (&sec[PROFILE_MPI_AGG], &ops,
+			 gs_ptr->mpiPi.global_MPI_stats_agg, 1, qmpi_lvl, v);
+  /* without histograms the report has no percentiles */
+  mpiPi_latency_init (&gs_ptr->mpiPi.latency, 0);
+  if (sec[PROFILE_LATENCY].p != NULL)
+    profile_get_latency (&sec[PROFILE_LATENCY], &ops,
+			 gs_ptr->mpiPi.global_callsite_stats_agg,
+			 &gs_ptr->mpiPi.latency, qmpi_lvl, v);
+
+  in = &sec[PROFILE_THREADS];
+  if (in->p != NULL)
+    {
+      unsigned n = profile_get_u32 (in);
+
+      if (!in->failed && n <= (size_t) (in->end - in->p)
+	  / (2 * sizeof (unsigned) + sizeof (long long) + sizeof (double)))
+	gs_ptr->mpiPi.global_thread_times =
+	  (mpiPi_thread_time_t *) calloc (n + 1,
+					  sizeof (mpiPi_thread_time_t));
+      if (gs_ptr->mpiPi.global_thread_times == NULL)
+	in->failed = 1;
+      for (i = 0; i < (int) n && !in->failed; i++)
+	{
+	  mpiPi_thread_time_t *t = &gs_ptr->mpiPi.global_thread_times[i];
+
+	  t->task = profile_get_int (in);
+	  t->thread = profile_get_int (in);
+	  t->calls = profile_get_i64 (in);
+	  t->mpiTime = profile_get_double (in);
+	  if (t->task < 0 || t->task >= gs_ptr->mpiPi.size)
+	    in->failed = 1;
+	}
+      gs_ptr->mpiPi.global_thread_count = n;
+      gs_ptr->mpiPi.do_thread_report = !in->failed;
+    }
+
+  in = &sec[PROFILE_PHASES];
+  if (in->p != NULL)
+    {
+      unsigned n = profile_get_u32 (in);
+      callsite_stats_t **av;
+      int ac;
+
+      if (!in->failed && n <= MPIP_PHASES_MAX)
+	gs_ptr->mpiPi.global_phases =
+	  (mpiPi_phase_t *) calloc (MPIP_PHASES_MAX, sizeof (mpiPi_phase_t));
+      if (gs_ptr->mpiPi.global_phases == NULL)
+	in->failed = 1;
+      for (i = 0; i < (int) n && !in->failed; i++)
+	{
+	  mpiPi_phase_t *ph = &gs_ptr->mpiPi.global_phases[i];
+	  char *name = profile_get_str (in, strings);
+
+	  snprintf (ph->name, sizeof (ph->name), "%s",
+		    name != NULL ? name : "-");
+	  free (name);
+	  ph->appTime = profile_get_double (in);
+	  ph->mpiTime = profile_get_double (in);
+	  ph->calls = profile_get_i64 (in);
+	}
+      gs_ptr->mpiPi.global_phase_count = n;
+      profile_get_records (in, &ops, gs_ptr->mpiPi.global_phase_stats, 0,
+			   qmpi_lvl, v);
+
+      /* the records hold their phase as the rank */
+      h_gather_data (gs_ptr->mpiPi.global_phase_stats, &ac, (void ***) &av);
+      for (i = 0; i < ac; i++)
+	if (av[i]->rank < 0 || av[i]->rank >= (int) n)
+	  in->failed = 1;
+      free (av);
+      if (in->failed)
+	{
+	  free (gs_ptr->mpiPi.global_phases);
+	  gs_ptr->mpiPi.global_phases = NULL;
+	}
+    }
+
+  free (ops.op);
+  free (buf);
+
+  for (tag = PROFILE_INFO; tag < PROFILE_SECTIONS; tag++)
+    if (sec[tag].failed)
+      {
+	mpiPi_msg_warn (qmpi_lvl, v, "[%s] is corrupt\n", path);
+	return 0;
+      }
+  return 1;
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
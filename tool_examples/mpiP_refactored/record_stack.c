@@ -15,6 +15,9 @@
 static char *svnid = "$Id$";
 #endif
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE		/* pthread_getattr_np */
+#endif
 #include <setjmp.h>
 #include <errno.h>
 #include <stdlib.h>
@@ -32,6 +35,173 @@ static char *svnid = "$Id$";
 #endif
 
 
+/*  Fast stack capture (-u).  Both modes walk the frame pointer chain,
+    which mpiP and QMPI are built to keep.  "fp" reports the walked
+    return addresses directly, so the application must keep frame
+    pointers too.  "cache" only hashes them, with the stack address they
+    were found at, into a key and reuses the stack the unwinder produced
+    for that key, unwinding again on a miss and on every n-th hit.  Both
+    fall back to the unwinder when the chain leaves the thread's stack.
+    Each thread has its own cache, so threads calling MPI concurrently
+    never update an entry at the same time.  */
+
+#define CAPTURE_CACHE_SIZE 1024	/* entries, a power of two */
+
+typedef struct _capture_cache_entry_t
+{
+  unsigned long long key;	/* 0 if unused */
+  int hits;
+  int frames;
+  void *pc[MPIP_CALLSITE_STACK_DEPTH_MAX];
+}
+capture_cache_entry_t;
+
+static int capture_mode = MPIP_CAPTURE_FULL;
+static int capture_refresh = MPIP_CAPTURE_REFRESH;
+
+void
+mpiPi_set_stack_capture (int mode, int refresh)
+{
+  capture_mode = mode;
+  capture_refresh = refresh > 0 ? refresh : MPIP_CAPTURE_REFRESH;
+}
+
+#if defined(__GNUC__) && defined(__linux__) \
+  && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+
+#include <pthread.h>
+
+/*  On these targets a frame pointer addresses the caller's frame pointer,
+    followed by the return address.  */
+#define FRAME_ADDRESS() ((void **) __builtin_frame_address (0))
+
+static __thread char *stack_lo, *stack_hi;
+static __thread capture_cache_entry_t capture_cache[CAPTURE_CACHE_SIZE];
+
+static int
+thread_stack_bounds (void)
+{
+  pthread_attr_t attr;
+  void *addr;
+  size_t size;
+
+  if (stack_hi != NULL)
+    return 1;
+  if (pthread_getattr_np (pthread_self (), &attr) != 0)
+    return 0;
+  if (pthread_attr_getstack (&attr, &addr, &size) == 0)
+    {
+      stack_lo = (char *) addr;
+      stack_hi = (char *) addr + size;
+    }
+  pthread_attr_destroy (&attr);
+  return stack_hi != NULL;
+}
+
+/*  Stores the return addresses of up to max_back frames, after skipping
+    skip frames above fp, less adjust bytes.  Returns the number stored,
+    or -1 if the chain ends within the skipped frames.  *last is set to
+    the last frame read.  */
+static int
+frame_walk (void **fp, int skip, int adjust, void *pc_array[],
+	    int max_back, void ***last)
+{
+  int i, n = 0;
+
+  if (!thread_stack_bounds ())
+    return -1;
+  for (i = 0; i < skip + max_back; i++)
+    {
+      void **next;
+      if ((char *) fp < stack_lo || (char *) (fp + 2) > stack_hi
+	  || ((size_t) fp & (sizeof (void *) - 1)) != 0 || fp[1] == NULL)
+	break;
+      if (i >= skip)
+	pc_array[n++] = (char *) fp[1] - adjust;
+      *last = fp;
+      next = (void **) fp[0];
+      if (next <= fp)
+	break;
+      fp = next;
+    }
+  return i < skip ? -1 : n;
+}
+
+/*  Fills pc_array without unwinding if the mode allows.  Returns the
+    frame count, or -1 if the caller must unwind; then *slot, if not
+    NULL, is the cache entry to pass to capture_cache_store.  */
+static int
+fast_traceback (void **fp, int skip, int adjust, void *pc_array[],
+		int max_back, capture_cache_entry_t ** slot)
+{
+  void *walked[MPIP_CALLSITE_STACK_DEPTH_MAX];
+  void **last = fp;
+  unsigned long long key;
+  capture_cache_entry_t *e;
+  int i, n;
+
+  *slot = NULL;
+  if (capture_mode == MPIP_CAPTURE_FULL)
+    return -1;
+  n = frame_walk (fp, skip, adjust, walked, max_back, &last);
+  if (n < 0)
+    return -1;
+
+  if (capture_mode == MPIP_CAPTURE_FP)
+    {
+      for (i = 0; i < max_back; i++)
+	pc_array[i] = i < n ? walked[i] : NULL;
+      return n;
+    }
+
+  key = (unsigned long long) (size_t) last;
+  for (i = 0; i < n; i++)
+    key = (key ^ (unsigned long long) (size_t) walked[i])
+      * 0x9E3779B97F4A7C15ULL;
+  key = (key ^ (key >> 29)) | 1;
+
+  e = &capture_cache[(key >> 32) & (CAPTURE_CACHE_SIZE - 1)];
+  *slot = e;
+  if (e->key != key)
+    {
+      e->key = key;
+      e->hits = 0;
+      return -1;
+    }
+  if (++e->hits % capture_refresh == 0)
+    return -1;
+  for (i = 0; i < max_back; i++)
+    pc_array[i] = i < e->frames ? e->pc[i] : NULL;
+  return e->frames;
+}
+
+#else
+
+#define FRAME_ADDRESS() ((void **) NULL)
+
+static int
+fast_traceback (void **fp, int skip, int adjust, void *pc_array[],
+		int max_back, capture_cache_entry_t ** slot)
+{
+  *slot = NULL;
+  return -1;
+}
+
+#endif
+
+static void
+capture_cache_store (capture_cache_entry_t * e, void *pc_array[],
+		     int frames)
+{
+  int i;
+  if (e == NULL)
+    return;
+  e->frames = frames;
+  for (i = 0; i < frames && i < MPIP_CALLSITE_STACK_DEPTH_MAX; i++)
+    e->pc[i] = pc_array[i];
+}
+
+
 
 #ifdef HAVE_LIBUNWIND
 
@@ -42,17 +212,24 @@ mpiPi_RecordTraceBack (jmp_buf jb, void *pc_array[], int max_back)
   unw_context_t uc;
   unw_cursor_t cursor;
   unw_word_t pc;
+  capture_cache_entry_t *slot;
 
   assert(pc_array != NULL);
 
-  //  If we are unable to get a stack trace, ensure that the first frame PC is NULL
-  pc_array[0] = NULL;
-
   if (mpiPi.inAPIrtb)		/*  API unwinds fewer frames  */
     parent_frame_start = 1;
   else
     parent_frame_start = 2;
 
+  frame_count = fast_traceback (FRAME_ADDRESS (), parent_frame_start, 1,
+				pc_array, max_back, &slot);
+  if (frame_count >= 0)
+    return frame_count;
+  frame_count = 0;
+
+  //  If we are unable to get a stack trace, ensure that the first frame PC is NULL
+  pc_array[0] = NULL;
+
   if (unw_getcontext (&uc) != 0)
     {
       mpiPi_msg_debug ("Failed unw_getcontext!\n");
@@ -95,6 +272,7 @@ mpiPi_RecordTraceBack (jmp_buf jb, void *pc_array[], int max_back)
 	      valid_cursor = 0;
 	    }
 	}
+      capture_cache_store (slot, pc_array, frame_count);
     }
 
   return frame_count;
@@ -167,6 +345,7 @@ mpiPi_RecordTraceBack (jmp_buf jb, void *pc_array[], int report_back)
   static void *temp_stack_trace[MPIP_MAX_TEMP_FRAMES];
   int all_frame_count, user_frame_count;
   void **cp;
+  capture_cache_entry_t *slot;
 
   /*  backtrace() will provide us with the 3 internal mpiP stack frames,
      as well as the user stack frames.  We need to make sure that the
@@ -180,6 +359,17 @@ mpiPi_RecordTraceBack (jmp_buf jb, void *pc_array[], int report_back)
      o memcpy backtrace results - 3 frames
    */
 
+#if defined(DO_PC_SUBTRACTION)
+  user_frame_count = fast_traceback (FRAME_ADDRESS (), MPIP_INTERNAL_FRAMES - 1,
+				     sizeof (void *), pc_array, report_back,
+				     &slot);
+#else
+  user_frame_count = fast_traceback (FRAME_ADDRESS (), MPIP_INTERNAL_FRAMES - 1,
+				     0, pc_array, report_back, &slot);
+#endif
+  if (user_frame_count >= 0)
+    return user_frame_count;
+
   if ((report_back + MPIP_INTERNAL_FRAMES) < max_temp_back)
     max_temp_back = report_back + MPIP_INTERNAL_FRAMES;
 
@@ -204,6 +394,7 @@ mpiPi_RecordTraceBack (jmp_buf jb, void *pc_array[], int report_back)
     *cp = *cp - sizeof (cp);
 #endif
 
+  capture_cache_store (slot, pc_array, user_frame_count);
   return user_frame_count;
 }
 
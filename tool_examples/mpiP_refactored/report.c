@@ -16,12 +16,14 @@ static char *svnid = "$Id$";
 
 #include <math.h>
 #include <float.h>
+#include <pthread.h>
 #include <search.h>
 #include <setjmp.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "mpiPi.h"
 
@@ -50,12 +52,15 @@ static int callsite_sort_by_cumulative_io (const void *a, const void *b);
 static int callsite_sort_by_cumulative_rma (const void *a, const void *b);
 static int callsite_sort_by_name_id_rank (const void *a, const void *b,int qmpi_lvl, vector* v);
 static int for_qsort_callsite_sort_by_name_id_rank (const void *a, const void *b);
+static void report_sort (void **av, int ac,
+			 int (*cmp) (const void *, const void *));
 static void print_intro_line (FILE * fp, char *name, char *fmt, ...);
-static double calc_COV (double *data, int dataSize);
+static double calc_COV (long long n, double mean, double m2);
 static void mpiPi_print_report_header (FILE * fp,int qmpi_lvl, vector* v);
 static void mpiPi_print_task_assignment (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_verbose_task_info (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_concise_task_info (FILE * fp,int qmpi_lvl ,vector * v);
+static void mpiPi_print_thread_info (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_callsites (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_top_time_sites (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_top_sent_sites (FILE * fp,int qmpi_lvl ,vector * v);
@@ -72,6 +77,7 @@ static void mpiPi_print_all_callsite_sent_info (FILE * fp,int qmpi_lvl ,vector *
 static void mpiPi_print_concise_callsite_sent_info (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_all_callsite_io_info (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_all_callsite_rma_info (FILE * fp,int qmpi_lvl ,vector * v);
+static void mpiPi_print_callsite_latency_info (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_concise_callsite_io_info (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_print_concise_callsite_rma_info (FILE * fp,int qmpi_lvl ,vector * v);
 static void mpiPi_coll_print_all_callsite_time_info (FILE * fp,int qmpi_lvl ,vector * v);
@@ -147,7 +153,23 @@ static char *mpiP_Report_Formats[][2] = {
   {
    /*  MPIP_HISTOGRAM_FMT  */
    "%-20s %10.3g  %20s  %20s\n",
-   "%-20s %10.3f  %20s  %20s\n"}
+   "%-20s %10.3f  %20s  %20s\n"},
+  {
+   /*  MPIP_CALLSITE_LATENCY_FMT  */
+   "%-17s %4d %7lld %9.4g %9.4g %9.4g %9.4g %9.4g\n",
+   "%-17s %4d %7lld %9.4f %9.4f %9.4f %9.4f %9.4f\n"},
+  {
+   /*  MPIP_THREAD_TIME_FMT  */
+   "%4d %6d %10lld %10.3g    %5.2lf\n",
+   "%4d %6d %10lld %10.3f    %5.2lf\n"},
+  {
+   /*  MPIP_PHASE_TIME_FMT  */
+   "%5d %-16s %10.3g %10.3g    %5.2lf %10lld\n",
+   "%5d %-16s %10.3f %10.3f    %5.2lf %10lld\n"},
+  {
+   /*  MPIP_PHASE_CALLSITE_FMT  */
+   "%5d %-20s %4d %12.3g  %6.2lf %10lld\n",
+   "%5d %-20s %4d %12.3f  %6.2lf %10lld\n"}
 };
 
 static void
@@ -216,6 +238,19 @@ callsite_sort_by_cumulative_time (const void *a, const void *b)
   return 0;
 }
 
+/*  By phase, which the phase records hold as their rank, then by
+    descending time.  */
+static int
+callsite_sort_by_phase_time (const void *a, const void *b)
+{
+  callsite_stats_t **a1 = (callsite_stats_t **) a;
+  callsite_stats_t **b1 = (callsite_stats_t **) b;
+
+  if ((*a1)->rank != (*b1)->rank)
+    return (*a1)->rank < (*b1)->rank ? -1 : 1;
+  return callsite_sort_by_cumulative_time (a, b);
+}
+
 static int
 callsite_sort_by_cumulative_size (const void *a, const void *b)
 {
@@ -237,15 +272,15 @@ callsite_sort_by_cumulative_size (const void *a, const void *b)
 static int
 histogram_sort_by_value (const void *a, const void *b)
 {
-  double **a1 = (double **) a;
-  double **b1 = (double **) b;
+  mpiPi_hist_cell_t *a1 = (mpiPi_hist_cell_t *) a;
+  mpiPi_hist_cell_t *b1 = (mpiPi_hist_cell_t *) b;
 
   /* NOTE: want descending sort, so compares are reveresed */
-  if (**a1 < **b1)
+  if (a1->value < b1->value)
     {
       return 1;
     }
-  if (**a1 > **b1)
+  if (a1->value > b1->value)
     {
       return -1;
     }
@@ -316,24 +351,55 @@ callsite_sort_by_name_id_rank (const void *a, const void *b,int qmpi_lvl, vector
   return 0;
 }
 
+/*  Position of each call in mpiPi_lookup when ordered by name, so that
+    the record sorts compare integers rather than names.  Filled by
+    report_order_ops before the first sort.  */
+static int *report_op_order = NULL;
+
 static int
-for_qsort_callsite_sort_by_name_id_rank (const void *a, const void *b)
+report_sort_by_name (const void *a, const void *b)
 {
+  return strcmp ((*(mpiPi_lookup_t **) a)->name,
+		 (*(mpiPi_lookup_t **) b)->name);
+}
 
+static void
+report_order_ops (int qmpi_lvl, vector * v)
+{
+  mpiPi_lookup_t **ops;
+  int i, n;
 
+  if (report_op_order != NULL)
+    return;
+  for (n = 0; mpiPi_lookup[n].name != NULL; n++);
+  ops = (mpiPi_lookup_t **) malloc (n * sizeof (mpiPi_lookup_t *));
+  report_op_order = (int *) malloc (n * sizeof (int));
+  if (ops == NULL || report_op_order == NULL)
+    {
+      mpiPi_abort (qmpi_lvl, v, "failed to allocate the call order table\n");
+    }
+  for (i = 0; i < n; i++)
+    ops[i] = &mpiPi_lookup[i];
+  qsort (ops, n, sizeof (mpiPi_lookup_t *), report_sort_by_name);
+  for (i = 0; i < n; i++)
+    report_op_order[ops[i] - mpiPi_lookup] = i;
+  free (ops);
+}
 
-
-  int rc;
+static int
+for_qsort_callsite_sort_by_name_id_rank (const void *a, const void *b)
+{
   callsite_stats_t *csp_1 = *(callsite_stats_t **) a;
   callsite_stats_t *csp_2 = *(callsite_stats_t **) b;
 
   MPIP_CALLSITE_STATS_COOKIE_ASSERT (csp_1);
   MPIP_CALLSITE_STATS_COOKIE_ASSERT (csp_2);
 
-  if ((rc = strcmp (mpiPi_lookup[csp_1->op - mpiPi_BASE].name,
-		  mpiPi_lookup[csp_2->op - mpiPi_BASE].name)) != 0)
+  if (report_op_order[csp_1->op - mpiPi_BASE]
+      != report_op_order[csp_2->op - mpiPi_BASE])
     {
-      return rc;
+      return report_op_order[csp_1->op - mpiPi_BASE]
+	< report_op_order[csp_2->op - mpiPi_BASE] ? -1 : 1;
     }
 
 #define express(f) {if ((csp_1->f) > (csp_2->f)) {return 1;} if ((csp_1->f) < (csp_2->f)) {return -1;}}
@@ -344,6 +410,118 @@ for_qsort_callsite_sort_by_name_id_rank (const void *a, const void *b)
   return 0;
 }
 
+/*  Reports of many tasks sort arrays of (callsite x rank) records.
+    Arrays of at least MPIP_REPORT_PAR_SORT_MIN pointers are split into
+    runs that threads sort with qsort, and the runs are then merged.  */
+#define MPIP_REPORT_PAR_SORT_MIN 16384
+#define MPIP_REPORT_SORT_THREADS_MAX 16
+
+typedef struct
+{
+  void **av;
+  size_t ac;
+  int (*cmp) (const void *, const void *);
+}
+report_sort_run_t;
+
+static void *
+report_sort_run (void *arg)
+{
+  report_sort_run_t *run = (report_sort_run_t *) arg;
+
+  qsort (run->av, run->ac, sizeof (void *), run->cmp);
+  return NULL;
+}
+
+/*  Sorts av in nruns runs, each but the first on a thread of its own,
+    and merges them.  The threads are created for the call and joined
+    before it returns.  Separate from report_sort so that the parallel
+    path can be checked on any machine (see testing/sort-check.c).  */
+void
+mpiPi_sort_runs (void **av, int ac, int (*cmp) (const void *, const void *),
+		 int nruns)
+{
+  report_sort_run_t run[MPIP_REPORT_SORT_THREADS_MAX];
+  pthread_t tid[MPIP_REPORT_SORT_THREADS_MAX];
+  int started[MPIP_REPORT_SORT_THREADS_MAX];
+  size_t bound[MPIP_REPORT_SORT_THREADS_MAX + 1];
+  void **src, **dst, **tmp;
+  int i, width;
+
+  if (nruns > MPIP_REPORT_SORT_THREADS_MAX)
+    nruns = MPIP_REPORT_SORT_THREADS_MAX;
+  if (nruns < 2 || ac < 2
+      || (tmp = (void **) malloc (ac * sizeof (void *))) == NULL)
+    {
+      qsort (av, ac, sizeof (void *), cmp);
+      return;
+    }
+
+  for (i = 0; i <= nruns; i++)
+    bound[i] = (size_t) ac * i / nruns;
+  for (i = 0; i < nruns; i++)
+    {
+      run[i].av = av + bound[i];
+      run[i].ac = bound[i + 1] - bound[i];
+      run[i].cmp = cmp;
+      /* run 0 is sorted by this thread, as is any run without a thread */
+      started[i] = i > 0
+	&& pthread_create (&tid[i], NULL, report_sort_run, &run[i]) == 0;
+    }
+  report_sort_run (&run[0]);
+  for (i = 1; i < nruns; i++)
+    {
+      if (started[i])
+	pthread_join (tid[i], NULL);
+      else
+	report_sort_run (&run[i]);
+    }
+
+  /* merge pairs of runs until one is left */
+  src = av;
+  dst = tmp;
+  for (width = 1; width < nruns; width *= 2)
+    {
+      for (i = 0; i < nruns; i += 2 * width)
+	{
+	  size_t lo = bound[i];
+	  size_t mid = bound[i + width < nruns ? i + width : nruns];
+	  size_t hi = bound[i + 2 * width < nruns ? i + 2 * width : nruns];
+	  size_t l = lo, r = mid, k = lo;
+
+	  while (l < mid && r < hi)
+	    dst[k++] = cmp (&src[r], &src[l]) < 0 ? src[r++] : src[l++];
+	  while (l < mid)
+	    dst[k++] = src[l++];
+	  while (r < hi)
+	    dst[k++] = src[r++];
+	}
+      tmp = src;
+      src = dst;
+      dst = tmp;
+    }
+  if (src != av)
+    {
+      memcpy (av, src, ac * sizeof (void *));
+      free (src);
+    }
+  else
+    free (dst);
+}
+
+static void
+report_sort (void **av, int ac, int (*cmp) (const void *, const void *))
+{
+  long ncpu;
+
+  ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+  if (ac < MPIP_REPORT_PAR_SORT_MIN || ncpu < 2)
+    qsort (av, ac, sizeof (void *), cmp);
+  else
+    mpiPi_sort_runs (av, ac, cmp, ncpu < MPIP_REPORT_SORT_THREADS_MAX
+		     ? (int) ncpu : MPIP_REPORT_SORT_THREADS_MAX);
+}
+
 #include <stdarg.h>
 
 /* proto -- print_intro_line(filep, name, "fmt to print value", args for fmt ) */
@@ -363,34 +541,13 @@ print_intro_line (FILE * fp, char *name, char *fmt, ...)
 }
 
 
+/*  Coefficient of variation of n values with the given mean and sum of
+    squared deviations from it.  */
 static double
-calc_COV (double *data, int dataSize)
+calc_COV (long long n, double mean, double m2)
 {
-  int idx;
-  double tot, avrg, var, std;
-
-  tot = 0.0;
-  avrg = 0.0;
-  var = 0.0;
-  std = 0.0;
-
-  if (dataSize <= 1)
-    return 0;
-
-  for (idx = 0; idx < dataSize; idx++)
-    tot += data[idx];
-
-  avrg = tot / dataSize;
-
-  for (idx = 0; idx < dataSize; idx++)
-    var += (data[idx] - avrg) * (data[idx] - avrg);
-
-  if (avrg > 0 && dataSize > 1)
-    {
-      var /= dataSize - 1;
-      std = sqrt (var);
-      return std / avrg;
-    }
+  if (mean > 0 && n > 1)
+    return sqrt (m2 / (n - 1)) / mean;
   else
     return 0;
 }
@@ -441,6 +598,10 @@ mpiPi_print_report_header (FILE * fp,int qmpi_lvl, vector* v)
   print_intro_line (fp, "Report generation", "%s",
 		    gs_ptr->mpiPi.collective_report ==
 		    0 ? "Single collector task" : "Collective");
+  if (gs_ptr->mpiPi.global_thread_max > 1)
+    print_intro_line (fp, "MPI Threads per Task", "up to %d, MPI times "
+		      "are summed over threads",
+		      gs_ptr->mpiPi.global_thread_max);
 }
 
 static void
@@ -479,7 +640,9 @@ mpiPi_print_verbose_task_info (FILE * fp,int qmpi_lvl,vector * v)
 
 
   /* -- print the mpi/app times */
-  print_section_heading (fp, "MPI Time (seconds)");
+  print_section_heading (fp, gs_ptr->mpiPi.global_thread_max > 1 ?
+			 "MPI Time (seconds, MPITime summed over threads)" :
+			 "MPI Time (seconds)");
   fprintf (fp, "%-4s %10s %10s    %5s\n", "Task", "AppTime", "MPITime",
 	   "MPI%");
   for (i = 0; i < gs_ptr->mpiPi.size; i++)
@@ -569,7 +732,9 @@ mpiPi_print_concise_task_info (FILE * fp,int qmpi_lvl,vector * v)
   var_app_time /= gs_ptr->mpiPi.size - 1;
   var_mpi_time /= gs_ptr->mpiPi.size - 1;
 
-  print_section_heading (fp, "Task Time Statistics (seconds)");
+  print_section_heading (fp, gs_ptr->mpiPi.global_thread_max > 1 ?
+			 "Task Time Statistics (seconds, MPI summed over threads)" :
+			 "Task Time Statistics (seconds)");
   fprintf (fp, "%*s %*s %*s %*s %*s %*s\n",
 	   colw, " ",
 	   tcolw, "AppTime",
@@ -591,6 +756,106 @@ mpiPi_print_concise_task_info (FILE * fp,int qmpi_lvl,vector * v)
 }
 
 
+/*  MPI% is the share of the thread in the MPI time of its task.  */
+static void
+mpiPi_print_thread_info (FILE * fp,int qmpi_lvl,vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  int i;
+
+  if (gs_ptr->mpiPi.global_thread_times == NULL)
+    return;
+
+  print_section_heading (fp, "MPI Time per Thread (seconds)");
+  fprintf (fp, "%-4s %6s %10s %10s    %5s\n", "Task", "Thread", "Calls",
+	   "MPITime", "MPI%");
+  for (i = 0; i < gs_ptr->mpiPi.global_thread_count; i++)
+    {
+      mpiPi_thread_time_t *t = &gs_ptr->mpiPi.global_thread_times[i];
+      double task_time = gs_ptr->mpiPi.global_task_mpi_time[t->task];
+
+      fprintf (fp,
+	       mpiP_Report_Formats[MPIP_THREAD_TIME_FMT][gs_ptr->mpiPi.reportFormat],
+	       t->task, t->thread, t->calls, t->mpiTime / 1e6,
+	       task_time > 0 ? 100.0 * t->mpiTime / task_time : 0);
+    }
+}
+
+
+/*  MPI% is the share of the MPI time in the application time of the
+    phase, both summed over tasks.  */
+static void
+mpiPi_print_phase_info (FILE * fp,int qmpi_lvl,vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  int i;
+
+  print_section_heading (fp, "Phase Time (seconds)");
+  fprintf (fp, "%-5s %-16s %10s %10s    %5s %10s\n", "Phase", "Name",
+	   "AppTime", "MPITime", "MPI%", "Calls");
+  for (i = 0; i < gs_ptr->mpiPi.global_phase_count; i++)
+    {
+      mpiPi_phase_t *ph = &gs_ptr->mpiPi.global_phases[i];
+
+      fprintf (fp,
+	       mpiP_Report_Formats[MPIP_PHASE_TIME_FMT][gs_ptr->mpiPi.reportFormat],
+	       i, ph->name, ph->appTime, ph->mpiTime / 1e6,
+	       ph->appTime > 0 ? 100.0 * ph->mpiTime / 1e6 / ph->appTime : 0,
+	       ph->calls);
+    }
+}
+
+
+/*  The top twenty callsites of each phase by time.  MPI% is the share
+    of the callsite in the MPI time of the phase.  */
+static void
+mpiPi_print_top_phase_sites (FILE * fp,int qmpi_lvl,vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  int i, ac, shown = 0;
+  callsite_stats_t **av;
+
+  h_gather_data (gs_ptr->mpiPi.global_phase_stats, &ac, (void ***) &av);
+  report_sort ((void **) av, ac, callsite_sort_by_phase_time);
+
+  print_section_heading (fp,
+			 "Phase Time (top twenty per phase, descending, milliseconds)");
+  fprintf (fp, "%-5s %-20s %4s %12s  %6s %10s\n", "Phase", "Call", "Site",
+	   "Time  ", "MPI%", "Count");
+
+  for (i = 0; i < ac; i++)
+    {
+      double phase_time;
+
+      if (i > 0 && av[i]->rank != av[i - 1]->rank)
+	shown = 0;
+      if (shown == 20 || av[i]->cumulativeTime <= 0)
+	continue;
+      shown++;
+
+      phase_time = gs_ptr->mpiPi.global_phases[av[i]->rank].mpiTime;
+      fprintf (fp,
+	       mpiP_Report_Formats[MPIP_PHASE_CALLSITE_FMT]
+	       [gs_ptr->mpiPi.reportFormat], av[i]->rank,
+	       &(gs_ptr->mpiPi.lookup[av[i]->op - mpiPi_BASE].name[4]),
+	       av[i]->csid, av[i]->cumulativeTime / 1000.0,
+	       phase_time > 0 ? 100.0 * av[i]->cumulativeTime / phase_time : 0,
+	       av[i]->count);
+    }
+
+  free (av);
+}
+
+
 static void
 mpiPi_print_callsites (FILE * fp,int qmpi_lvl,vector * v)
 {
@@ -612,7 +877,7 @@ mpiPi_print_callsites (FILE * fp,int qmpi_lvl,vector * v)
 
   h_gather_data (gs_ptr->callsite_src_id_cache, &ac, (void ***) &av);
   sprintf (buf, "Callsites: %d", ac);
-  qsort (av, ac, sizeof (void *), callsite_src_id_cache_sort_by_id);
+  report_sort ((void **) av, ac, callsite_src_id_cache_sort_by_id);
   print_section_heading (fp, buf);
 
   /* Find longest file and function names for formatting */
@@ -698,9 +963,10 @@ mpiPi_print_top_time_sites (FILE * fp,int qmpi_lvl,vector * v)
   /* -- now that we have all the statistics in a queue, which is
    * pointers to the data, we can sort it however we need to.
    */
-  qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_time);
+  report_sort ((void **) av, ac, callsite_sort_by_cumulative_time);
 
-  print_section_heading (fp,
+  print_section_heading (fp, gs_ptr->mpiPi.global_thread_max > 1 ?
+			 "Aggregate Time (top twenty, descending, ms, summed over threads)" :
 			 "Aggregate Time (top twenty, descending, milliseconds)");
 
   if (gs_ptr->mpiPi.calcCOV)
@@ -720,7 +986,7 @@ mpiPi_print_top_time_sites (FILE * fp,int qmpi_lvl,vector * v)
 	{
 	  if (gs_ptr->mpiPi.calcCOV)
 	    {
-	      timeCOV = calc_COV (av[i]->siteData, av[i]->siteDataIdx);
+	      timeCOV = calc_COV (av[i]->siteCount, av[i]->siteMean, av[i]->siteM2);
 
 	      fprintf (fp,
 		       mpiP_Report_Formats[MPIP_AGGREGATE_COV_TIME_FMT]
@@ -776,7 +1042,7 @@ mpiPi_print_top_sent_sites (FILE * fp,int qmpi_lvl,vector * v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_size);
+      report_sort ((void **) av, ac, callsite_sort_by_cumulative_size);
 
       print_section_heading (fp,
 			     "Aggregate Sent Message Size (top twenty, descending, bytes)");
@@ -838,35 +1104,26 @@ mpiPi_print_top_collective_sent_sites (FILE * fp,int qmpi_lvl,vector * v)
 	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
 	// CHANGE END
 
-  int result_count, j, i;
-  double **result_ptrs;
+  int result_count, i, j;
+  mpiPi_hist_cell_t *cells;
   int x, y, z;
-  int all_call_count, matrix_size;
   char commbinbuf[32];
   char databinbuf[32];
 
   mpiPi_msg_debug (qmpi_lvl,v,"In mpiPi_print_top_collective_sent_sites\n");
 
-  all_call_count = mpiPi_DEF_END - mpiPi_BASE;
-  matrix_size =
-    all_call_count * gs_ptr->mpiPi.coll_comm_histogram.hist_size *
-    gs_ptr->mpiPi.coll_size_histogram.hist_size;
-
-  result_ptrs = (double **) malloc (sizeof (double *) * matrix_size);
-
-  result_count = 0;
-  for (x = 0; x < all_call_count; x++)
-    for (y = 0; y < gs_ptr->mpiPi.coll_comm_histogram.hist_size; y++)
-      for (z = 0; z < gs_ptr->mpiPi.coll_size_histogram.hist_size; z++)
-	{
-	  if (gs_ptr->mpiPi.coll_time_stats[x][y][z] > 0)
-	    {
-	      result_ptrs[result_count] = &gs_ptr->mpiPi.coll_time_stats[x][y][z];
-	      result_count++;
-	    }
-	}
+  result_count = mpiPi_hist_cells_gather (&gs_ptr->mpiPi.coll_time_stats, &cells);
+  if (result_count < 0)
+    {
+      mpiPi_msg_warn (qmpi_lvl,v,"Failed to allocate memory for histogram report\n");
+      return;
+    }
+  for (i = j = 0; i < result_count; i++)
+    if (cells[i].value > 0)
+      cells[j++] = cells[i];
+  result_count = j;
 
-  qsort (result_ptrs, result_count, sizeof (double *),
+  qsort (cells, result_count, sizeof (mpiPi_hist_cell_t),
 	 histogram_sort_by_value);
 
   if (gs_ptr->mpiPi.global_mpi_size > 0)
@@ -883,28 +1140,17 @@ mpiPi_print_top_collective_sent_sites (FILE * fp,int qmpi_lvl,vector * v)
       fprintf (fp, "%-20s %10s %21s %21s\n", "Call", "MPI Time %",
 	       "Comm Size", "Data Size");
 
-      mpiPi_msg_debug (qmpi_lvl,v,"Found max time of %6.3f at %p\n", *result_ptrs[0],
-		       result_ptrs[0]);
+      mpiPi_msg_debug (qmpi_lvl,v,"Found max time of %6.3f\n",
+		       cells[0].value);
 
-      j = 0;
       for (i = 0; (i < 20) && (i < result_count); i++)
 	{
-	  /* Find location in matrix */
-	  for (x = 0; x < all_call_count; x++)
-	    for (y = 0; y < gs_ptr->mpiPi.coll_comm_histogram.hist_size; y++)
-	      for (z = 0; z < gs_ptr->mpiPi.coll_size_histogram.hist_size; z++)
-		{
-		  if (&gs_ptr->mpiPi.coll_time_stats[x][y][z] == result_ptrs[j])
-		    {
-		      j++;
-		      goto print;
-		    }
-		}
-
-	print:
-	  if (gs_ptr->mpiPi.coll_time_stats[x][y][z] == 0)
+	  if (cells[i].value == 0)
 	    goto done;
 
+	  x = MPIP_HIST_OP (cells[i].key);
+	  y = MPIP_HIST_COMM_BIN (cells[i].key);
+	  z = MPIP_HIST_SIZE_BIN (cells[i].key);
 	  get_histogram_bin_str (&gs_ptr->mpiPi.coll_comm_histogram, y, commbinbuf);
 	  get_histogram_bin_str (&gs_ptr->mpiPi.coll_size_histogram, z, databinbuf);
 
@@ -912,13 +1158,14 @@ mpiPi_print_top_collective_sent_sites (FILE * fp,int qmpi_lvl,vector * v)
 		   mpiP_Report_Formats[MPIP_HISTOGRAM_FMT]
 		   [gs_ptr->mpiPi.reportFormat],
 		   &(gs_ptr->mpiPi.lookup[x].name[4]),
-		   gs_ptr->mpiPi.coll_time_stats[x][y][z] / gs_ptr->mpiPi.global_mpi_time *
+		   cells[i].value / gs_ptr->mpiPi.global_mpi_time *
 		   100, commbinbuf, databinbuf);
 	}
 
     }
 
 done:
+  free (cells);
   return;
 }
 
@@ -930,35 +1177,26 @@ mpiPi_print_top_pt2pt_sent_sites (FILE * fp,int qmpi_lvl,vector * v)
 	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
 	// CHANGE END
 
-  int result_count, j, i;
-  double **result_ptrs;
+  int result_count, i, j;
+  mpiPi_hist_cell_t *cells;
   int x, y, z;
-  int all_call_count, matrix_size;
   char commbinbuf[32];
   char databinbuf[32];
 
   mpiPi_msg_debug (qmpi_lvl,v,"In mpiPi_print_top_pt2pt_sent_sites\n");
 
-  all_call_count = mpiPi_DEF_END - mpiPi_BASE;
-  matrix_size =
-    all_call_count * gs_ptr->mpiPi.pt2pt_comm_histogram.hist_size *
-    gs_ptr->mpiPi.pt2pt_size_histogram.hist_size;
-
-  result_ptrs = (double **) malloc (sizeof (double *) * matrix_size);
-
-  result_count = 0;
-  for (x = 0; x < all_call_count; x++)
-    for (y = 0; y < gs_ptr->mpiPi.pt2pt_comm_histogram.hist_size; y++)
-      for (z = 0; z < gs_ptr->mpiPi.pt2pt_size_histogram.hist_size; z++)
-	{
-	  if (gs_ptr->mpiPi.pt2pt_send_stats[x][y][z] > 0)
-	    {
-	      result_ptrs[result_count] = &gs_ptr->mpiPi.pt2pt_send_stats[x][y][z];
-	      result_count++;
-	    }
-	}
+  result_count = mpiPi_hist_cells_gather (&gs_ptr->mpiPi.pt2pt_send_stats, &cells);
+  if (result_count < 0)
+    {
+      mpiPi_msg_warn (qmpi_lvl,v,"Failed to allocate memory for histogram report\n");
+      return;
+    }
+  for (i = j = 0; i < result_count; i++)
+    if (cells[i].value > 0)
+      cells[j++] = cells[i];
+  result_count = j;
 
-  qsort (result_ptrs, result_count, sizeof (double *),
+  qsort (cells, result_count, sizeof (mpiPi_hist_cell_t),
 	 histogram_sort_by_value);
 
   if (gs_ptr->mpiPi.global_mpi_size > 0)
@@ -975,28 +1213,17 @@ mpiPi_print_top_pt2pt_sent_sites (FILE * fp,int qmpi_lvl,vector * v)
       fprintf (fp, "%-20s %10s %21s %21s\n", "Call", "MPI Sent %",
 	       "Comm Size", "Data Size");
 
-      mpiPi_msg_debug (qmpi_lvl,v,"Found max sent of %6.3f at %p\n", *result_ptrs[0],
-		       result_ptrs[0]);
+      mpiPi_msg_debug (qmpi_lvl,v,"Found max sent of %6.3f\n",
+		       cells[0].value);
 
-      j = 0;
       for (i = 0; (i < 20) && (i < result_count); i++)
 	{
-	  /* Find location in matrix */
-	  for (x = 0; x < all_call_count; x++)
-	    for (y = 0; y < gs_ptr->mpiPi.pt2pt_comm_histogram.hist_size; y++)
-	      for (z = 0; z < gs_ptr->mpiPi.pt2pt_size_histogram.hist_size; z++)
-		{
-		  if (&gs_ptr->mpiPi.pt2pt_send_stats[x][y][z] == result_ptrs[j])
-		    {
-		      j++;
-		      goto print;
-		    }
-		}
-
-	print:
-	  if (gs_ptr->mpiPi.pt2pt_send_stats[x][y][z] == 0)
+	  if (cells[i].value == 0)
 	    goto done;
 
+	  x = MPIP_HIST_OP (cells[i].key);
+	  y = MPIP_HIST_COMM_BIN (cells[i].key);
+	  z = MPIP_HIST_SIZE_BIN (cells[i].key);
 	  get_histogram_bin_str (&gs_ptr->mpiPi.pt2pt_comm_histogram, y, commbinbuf);
 	  get_histogram_bin_str (&gs_ptr->mpiPi.pt2pt_size_histogram, z, databinbuf);
 
@@ -1004,13 +1231,14 @@ mpiPi_print_top_pt2pt_sent_sites (FILE * fp,int qmpi_lvl,vector * v)
 		   mpiP_Report_Formats[MPIP_HISTOGRAM_FMT]
 		   [gs_ptr->mpiPi.reportFormat],
 		   &(gs_ptr->mpiPi.lookup[x].name[4]),
-		   (gs_ptr->mpiPi.pt2pt_send_stats[x][y][z] * 100) /
+		   (cells[i].value * 100) /
 		   gs_ptr->mpiPi.global_mpi_size, commbinbuf, databinbuf);
 	}
 
     }
 
 done:
+  free (cells);
   return;
 }
 
@@ -1037,7 +1265,7 @@ mpiPi_print_top_io_sites (FILE * fp,int qmpi_lvl, vector* v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_io);
+      report_sort ((void **) av, ac, callsite_sort_by_cumulative_io);
 
       print_section_heading (fp,
 			     "Aggregate I/O Size (top twenty, descending, bytes)");
@@ -1086,7 +1314,7 @@ mpiPi_print_top_rma_sites (FILE * fp,int qmpi_lvl,vector * v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_rma);
+      report_sort ((void **) av, ac, callsite_sort_by_cumulative_rma);
 
       print_section_heading (fp,
 			     "Aggregate RMA Origin Size (top twenty, descending, bytes)");
@@ -1127,7 +1355,7 @@ mpiPi_print_all_callsite_time_info (FILE * fp,int qmpi_lvl,vector * v)
   /* -- now that we have all the statistics in a queue, which is
    * pointers to the data, we can sort it however we need to.
    */
-  qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+  report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 
   sprintf (buf, "Callsite Time statistics (all, milliseconds): %d", ac);
   print_section_heading (fp, buf);
@@ -1233,7 +1461,7 @@ mpiPi_print_concise_callsite_time_info (FILE * fp,int qmpi_lvl,vector * v)
   /* -- now that we have all the statistics in a queue, which is
    * pointers to the data, we can sort it however we need to.
    */
-  qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+  report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
   callsite_stats =
     (mpiPi_callsite_summary_t *) malloc (sizeof (mpiPi_callsite_summary_t) *
 					 gs_ptr->callsite_src_id_cache->count);
@@ -1363,7 +1591,7 @@ mpiPi_print_all_callsite_sent_info (FILE * fp,int qmpi_lvl,vector * v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+      report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 
       sprintf (buf, "Callsite Message Sent statistics (all, sent bytes)");
       print_section_heading (fp, buf);
@@ -1450,7 +1678,7 @@ mpiPi_print_concise_callsite_sent_info (FILE * fp,int qmpi_lvl,vector * v)
   /* -- now that we have all the statistics in a queue, which is
    * pointers to the data, we can sort it however we need to.
    */
-  qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+  report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
   callsite_stats =
     (mpiPi_callsite_summary_t *) malloc (sizeof (mpiPi_callsite_summary_t) *
 					 gs_ptr->callsite_src_id_cache->count);
@@ -1583,7 +1811,7 @@ mpiPi_print_all_callsite_io_info (FILE * fp,int qmpi_lvl,vector * v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+      report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 
       sprintf (buf, "Callsite I/O statistics (all, I/O bytes)");
       print_section_heading (fp, buf);
@@ -1672,7 +1900,7 @@ mpiPi_print_all_callsite_rma_info (FILE * fp,int qmpi_lvl,vector * v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+      report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 
       sprintf (buf, "Callsite RMA statistics (all, origin bytes)");
       print_section_heading (fp, buf);
@@ -1763,7 +1991,7 @@ mpiPi_print_concise_callsite_io_info (FILE * fp,int qmpi_lvl,vector * v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+      report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
       callsite_stats =
 	(mpiPi_callsite_summary_t *) malloc (sizeof (mpiPi_callsite_summary_t)
 					     * (gs_ptr->callsite_src_id_cache)->count);
@@ -1899,7 +2127,7 @@ mpiPi_print_concise_callsite_rma_info (FILE * fp,int qmpi_lvl,vector * v)
       /* -- now that we have all the statistics in a queue, which is
        * pointers to the data, we can sort it however we need to.
        */
-      qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+      report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
       callsite_stats =
 	(mpiPi_callsite_summary_t *) malloc (sizeof (mpiPi_callsite_summary_t)
 					     * gs_ptr->callsite_src_id_cache->count);
@@ -2035,7 +2263,7 @@ mpiPi_coll_print_all_callsite_time_info (FILE * fp,int qmpi_lvl, vector* v)
   if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
     {
       h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac, (void ***) &av);
-      qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+      report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 
       task_data = malloc (sizeof (callsite_stats_t) * gs_ptr->mpiPi.size);
       if (task_data == NULL)
@@ -2074,8 +2302,7 @@ mpiPi_coll_print_all_callsite_time_info (FILE * fp,int qmpi_lvl, vector* v)
       else
 	task_stats = &cs_buf;
 
-      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-		  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
       task_stats->rank = gs_ptr->mpiPi.rank;
 
@@ -2190,7 +2417,7 @@ mpiPi_coll_print_concise_callsite_time_info (FILE * fp,int qmpi_lvl,vector * v)
     {
       /*  Sort aggregate callsite stats by descending cumulative time   */
       h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac, (void ***) &av);
-      qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_time);
+      report_sort ((void **) av, ac, callsite_sort_by_cumulative_time);
 
       snprintf (buf, 256,
 		"Callsite Time statistics (all callsites, milliseconds): %d",
@@ -2215,8 +2442,7 @@ mpiPi_coll_print_concise_callsite_time_info (FILE * fp,int qmpi_lvl,vector * v)
 	task_stats = &cs_buf;
 
       /*  Broadcast current call site to all tasks   */
-      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-		  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
 
       /*  Search for task local entry for the current call site   */
@@ -2310,7 +2536,7 @@ mpiPi_coll_print_concise_callsite_sent_info (FILE * fp, int qmpi_lvl, vector* v)
     {
       /*  Sort aggregate callsite stats by descending cumulative sent   */
       h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac, (void ***) &av);
-      qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_size);
+      report_sort ((void **) av, ac, callsite_sort_by_cumulative_size);
       for (i = 0, callsite_count = 0; i < ac; i++)
 	{
 	  if (av[i]->cumulativeDataSent > 0)
@@ -2350,8 +2576,7 @@ mpiPi_coll_print_concise_callsite_sent_info (FILE * fp, int qmpi_lvl, vector* v)
 	task_stats = &cs_buf;
 
       /*  Broadcast current call site to all tasks   */
-      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-		  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
 
       /*  Search for task local entry for the current call site   */
@@ -2449,7 +2674,7 @@ mpiPi_coll_print_concise_callsite_io_info (FILE * fp,int qmpi_lvl,vector * v)
     {
       /*  Sort aggregate callsite stats by descending cumulative io   */
       h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac, (void ***) &av);
-      qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_io);
+      report_sort ((void **) av, ac, callsite_sort_by_cumulative_io);
       for (i = 0, callsite_count = 0; i < ac; i++)
 	{
 	  if (av[i]->cumulativeIO > 0)
@@ -2490,8 +2715,7 @@ mpiPi_coll_print_concise_callsite_io_info (FILE * fp,int qmpi_lvl,vector * v)
 	task_stats = &cs_buf;
 
       /*  Broadcast current call site to all tasks   */
-      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-		  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
 
       /*  Search for task local entry for the current call site   */
@@ -2584,7 +2808,7 @@ mpiPi_coll_print_concise_callsite_rma_info (FILE * fp,int qmpi_lvl,vector* v)
     {
       /*  Sort aggregate callsite stats by descending cumulative sent   */
       h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac, (void ***) &av);
-      qsort (av, ac, sizeof (void *), callsite_sort_by_cumulative_rma);
+      report_sort ((void **) av, ac, callsite_sort_by_cumulative_rma);
       for (i = 0, callsite_count = 0; i < ac; i++)
 	{
 	  if (av[i]->cumulativeRMA > 0)
@@ -2624,8 +2848,7 @@ mpiPi_coll_print_concise_callsite_rma_info (FILE * fp,int qmpi_lvl,vector* v)
 	task_stats = &cs_buf;
 
       /*  Broadcast current call site to all tasks   */
-      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-		  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
 
       /*  Search for task local entry for the current call site   */
@@ -2724,7 +2947,7 @@ mpiPi_coll_print_all_callsite_sent_info (FILE * fp,int qmpi_lvl,vector * v){
 	{
 	  h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac,
 			 (void ***) &av);
-	  qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+	  report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 	  task_data = malloc (sizeof (callsite_stats_t) * gs_ptr->mpiPi.size);
 
 	  if (task_data == NULL)
@@ -2770,8 +2993,7 @@ mpiPi_coll_print_all_callsite_sent_info (FILE * fp,int qmpi_lvl,vector * v){
 
 	  if (tot_data_sent > 0)
 	    {
-	      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-			  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+	      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
 	      task_stats->rank = gs_ptr->mpiPi.rank;
 
@@ -2887,7 +3109,7 @@ mpiPi_coll_print_all_callsite_io_info (FILE * fp,int qmpi_lvl,vector * v)
 	{
 	  h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac,
 			 (void ***) &av);
-	  qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+	  report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 	  task_data = malloc (sizeof (callsite_stats_t) * gs_ptr->mpiPi.size);
 
 	  if (task_data == NULL)
@@ -2930,8 +3152,7 @@ mpiPi_coll_print_all_callsite_io_info (FILE * fp,int qmpi_lvl,vector * v)
 
 	  if (tot_data_sent > 0)
 	    {
-	      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-			  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+	      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
 	      task_stats->rank = gs_ptr->mpiPi.rank;
 
@@ -3041,7 +3262,7 @@ mpiPi_coll_print_all_callsite_rma_info (FILE * fp,int qmpi_lvl,vector * v)
 	{
 	  h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac,
 			 (void ***) &av);
-	  qsort (av, ac, sizeof (void *), for_qsort_callsite_sort_by_name_id_rank);
+	  report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
 	  task_data = malloc (sizeof (callsite_stats_t) * gs_ptr->mpiPi.size);
 
 	  if (task_data == NULL)
@@ -3084,8 +3305,7 @@ mpiPi_coll_print_all_callsite_rma_info (FILE * fp,int qmpi_lvl,vector * v)
 
 	  if (tot_data_sent > 0)
 	    {
-	      PMPI_Bcast (task_stats, sizeof (callsite_stats_t),
-			  MPI_CHAR, gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+	      mpiPi_bcast_callsite (task_stats,qmpi_lvl,v);
 
 	      task_stats->rank = gs_ptr->mpiPi.rank;
 
@@ -3168,12 +3388,66 @@ mpiPi_coll_print_all_callsite_rma_info (FILE * fp,int qmpi_lvl,vector * v)
 }
 
 
+/*  Percentiles of the durations of each callsite, from its latency
+    histogram merged across tasks (-h).  */
+static void
+mpiPi_print_callsite_latency_info (FILE * fp,int qmpi_lvl,vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  static const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+  mpiPi_latency_t *lt = &gs_ptr->mpiPi.latency;
+  int i, j, ac, sites = 0;
+  char buf[256];
+  callsite_stats_t **av;
+
+  if (lt->buckets == 0)
+    return;
+
+  h_gather_data (gs_ptr->mpiPi.global_callsite_stats_agg, &ac, (void ***) &av);
+  report_sort ((void **) av, ac, for_qsort_callsite_sort_by_name_id_rank);
+  for (i = 0; i < ac; i++)
+    if (av[i]->lat > 0 && av[i]->count > 0)
+      sites++;
+
+  sprintf (buf, "Callsite Latency percentiles (milliseconds): %d", sites);
+  print_section_heading (fp, buf);
+  fprintf (fp, "%-17s %4s %7s %9s %9s %9s %9s %9s\n", "Name", "Site",
+	   "Count", "50%", "90%", "99%", "99.9%", "Max");
+
+  for (i = 0; i < ac; i++)
+    {
+      double p[4];
+
+      if (av[i]->lat <= 0 || av[i]->count == 0)
+	continue;
+      /* the middle of a bucket may lie past the extremes */
+      for (j = 0; j < 4; j++)
+	{
+	  p[j] = mpiPi_latency_quantile (lt, av[i]->lat, quantiles[j]);
+	  p[j] = min (max (p[j], av[i]->minDur), av[i]->maxDur);
+	}
+      fprintf (fp,
+	       mpiP_Report_Formats[MPIP_CALLSITE_LATENCY_FMT]
+	       [gs_ptr->mpiPi.reportFormat],
+	       &(gs_ptr->mpiPi.lookup[av[i]->op - mpiPi_BASE].name[4]),
+	       av[i]->csid, av[i]->count, p[0] / 1000.0, p[1] / 1000.0,
+	       p[2] / 1000.0, p[3] / 1000.0, av[i]->maxDur / 1000.0);
+    }
+
+  free (av);
+}
+
+
 void
 mpiPi_profile_print (FILE * fp, int report_style,int qmpi_lvl, vector* v)
 {
 	//CHANGE BEGIN
 		gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
 		// CHANGE END
+  report_order_ops (qmpi_lvl, v);
   if (gs_ptr->mpiPi.collectorRank == gs_ptr->mpiPi.rank)
     {
       assert (fp);
@@ -3202,6 +3476,10 @@ mpiPi_profile_print_concise (FILE * fp,int qmpi_lvl, vector* v)
     {
       fprintf (fp, "\n");
       mpiPi_print_concise_task_info (fp,qmpi_lvl,v);
+      if (gs_ptr->mpiPi.do_thread_report)
+	mpiPi_print_thread_info (fp,qmpi_lvl,v);
+      if (gs_ptr->mpiPi.global_phases != NULL)
+	mpiPi_print_phase_info (fp,qmpi_lvl,v);
 
       mpiPi_print_top_time_sites (fp,qmpi_lvl,v);
       mpiPi_print_top_sent_sites (fp,qmpi_lvl,v);
@@ -3211,6 +3489,8 @@ mpiPi_profile_print_concise (FILE * fp,int qmpi_lvl, vector* v)
 	mpiPi_print_top_pt2pt_sent_sites (fp,qmpi_lvl,v);
       mpiPi_print_top_io_sites (fp,qmpi_lvl,v);
       mpiPi_print_top_rma_sites (fp,qmpi_lvl,v);
+      if (gs_ptr->mpiPi.global_phases != NULL)
+	mpiPi_print_top_phase_sites (fp,qmpi_lvl,v);
 
 
       if (gs_ptr->mpiPi.collective_report == 0)
@@ -3238,6 +3518,10 @@ mpiPi_profile_print_concise (FILE * fp,int qmpi_lvl, vector* v)
 	  mpiPi_coll_print_concise_callsite_rma_info (fp,qmpi_lvl,v);
 	}
     }
+
+  if (gs_ptr->mpiPi.print_callsite_detail
+      && gs_ptr->mpiPi.collectorRank == gs_ptr->mpiPi.rank)
+    mpiPi_print_callsite_latency_info (fp,qmpi_lvl,v);
 }
 
 static void
@@ -3252,6 +3536,10 @@ mpiPi_profile_print_verbose (FILE * fp,int qmpi_lvl, vector* v)
       fprintf (fp, "\n");
 
       mpiPi_print_verbose_task_info (fp,qmpi_lvl,v);
+      if (gs_ptr->mpiPi.do_thread_report)
+	mpiPi_print_thread_info (fp,qmpi_lvl,v);
+      if (gs_ptr->mpiPi.global_phases != NULL)
+	mpiPi_print_phase_info (fp,qmpi_lvl,v);
 
       if (gs_ptr->mpiPi.print_callsite_detail)
 	mpiPi_print_callsites (fp,qmpi_lvl,v);
@@ -3264,6 +3552,8 @@ mpiPi_profile_print_verbose (FILE * fp,int qmpi_lvl, vector* v)
 	mpiPi_print_top_pt2pt_sent_sites (fp,qmpi_lvl,v);
       mpiPi_print_top_io_sites (fp,qmpi_lvl,v);
       mpiPi_print_top_rma_sites (fp,qmpi_lvl,v);
+      if (gs_ptr->mpiPi.global_phases != NULL)
+	mpiPi_print_top_phase_sites (fp,qmpi_lvl,v);
     }
 
   if (gs_ptr->mpiPi.print_callsite_detail)
@@ -3298,6 +3588,9 @@ mpiPi_profile_print_verbose (FILE * fp,int qmpi_lvl, vector* v)
 	}
     }
 
+  if (gs_ptr->mpiPi.print_callsite_detail
+      && gs_ptr->mpiPi.collectorRank == gs_ptr->mpiPi.rank)
+    mpiPi_print_callsite_latency_info (fp,qmpi_lvl,v);
 }
 
 
@@ -0,0 +1,512 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   symcache.c -- persistent source lookup cache (-i)
+
+   Resolved source locations are kept in <dir>/<app>.<build-id>.mpiPsym,
+   named by the executable's build-id, so that later runs of the same
+   build need not read debug info.  The file is a header followed by
+   records of a hash of the build-id of the object a pc is in, the pc's
+   offset from the object's load address, the line, and the file and
+   function names.  It is mapped and indexed when opened.  A run only appends to it, with one write for
+   all of its new records, and the first run creates it by linking a
+   complete temporary file into place, so concurrent runs cannot leave
+   a partial header.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE		/* dl_iterate_phdr */
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mpiPi.h"
+
+#ifdef __linux__
+#include <elf.h>
+#include <link.h>
+#endif
+
+#define SYMCACHE_MAGIC "mPsym\0\0\1"	/* last byte is the version */
+#define SYMCACHE_MAGIC_LEN 8
+#define SYMCACHE_BUILD_ID_MAX 64
+
+typedef struct
+{
+  unsigned long long object;
+  unsigned long long offset;
+  int line;
+  unsigned short file_len;
+  unsigned short funct_len;
+} symcache_rec_t;		/* followed by the file and function names */
+
+typedef struct
+{
+  unsigned long long object;
+  unsigned long long offset;
+  const char *rec;
+} symcache_index_t;
+
+/*  A loaded object with a build-id.  */
+typedef struct
+{
+  char *lo, *hi;		/* mapped range */
+  char *base;			/* load address */
+  unsigned long long id;	/* hash of the build-id */
+} symcache_object_t;
+
+static char *symcache_path = NULL;
+static char *symcache_map = NULL;
+static size_t symcache_map_len = 0;
+static symcache_index_t *symcache_index = NULL;
+static int symcache_count = 0;
+static char *symcache_new = NULL;	/* records to append */
+static size_t symcache_new_len = 0;
+static size_t symcache_new_cap = 0;
+static int symcache_enabled = 0;
+static symcache_object_t *symcache_objects = NULL;
+static int symcache_object_count = 0;
+
+#ifdef __linux__
+static unsigned char symcache_build_id[SYMCACHE_BUILD_ID_MAX];
+static int symcache_build_id_len = 0;	/* of the executable */
+
+/*  Records the load range and GNU build-id of a loaded object.  The
+    executable is reported first.  */
+static int
+symcache_phdr (struct dl_phdr_info *info, size_t size, void *data)
+{
+  symcache_object_t o;
+  unsigned char *id = NULL;
+  int i, id_len = 0;
+
+  o.base = (char *) info->dlpi_addr;
+  o.lo = NULL;
+  o.hi = NULL;
+  for (i = 0; i < info->dlpi_phnum; i++)
+    {
+      const ElfW (Phdr) * ph = &info->dlpi_phdr[i];
+      char *start = (char *) info->dlpi_addr + ph->p_vaddr;
+
+      if (ph->p_type == PT_LOAD)
+	{
+	  if (o.lo == NULL || start < o.lo)
+	    o.lo = start;
+	  if (start + ph->p_memsz > o.hi)
+	    o.hi = start + ph->p_memsz;
+	}
+      else if (ph->p_type == PT_NOTE)
+	{
+	  size_t align = ph->p_align == 8 ? 8 : 4;
+	  char *p = start, *end = start + ph->p_memsz;
+
+	  while (p + sizeof (ElfW (Nhdr)) <= end)
+	    {
+	      ElfW (Nhdr) * n = (ElfW (Nhdr) *) p;
+	      char *name = p + sizeof (ElfW (Nhdr));
+	      char *desc = name + ((n->n_namesz + align - 1) & ~(align - 1));
+
+	      if (n->n_type == NT_GNU_BUILD_ID && n->n_namesz == 4
+		  && memcmp (name, "GNU", 4) == 0
+		  && n->n_descsz <= SYMCACHE_BUILD_ID_MAX
+		  && desc + n->n_descsz <= end)
+		{
+		  id = (unsigned char *) desc;
+		  id_len = n->n_descsz;
+		}
+	      p = desc + ((n->n_descsz + align - 1) & ~(align - 1));
+	    }
+	}
+    }
+
+  if (symcache_object_count == 0)
+    {
+      if (id_len == 0)
+	return 1;		/* no build-id to name the cache by */
+      memcpy (symcache_build_id, id, id_len);
+      symcache_build_id_len = id_len;
+    }
+  if (id_len > 0 && o.lo != NULL)
+    {
+      symcache_object_t *objects;
+
+      o.id = 14695981039346656037ULL;	/* FNV-1a */
+      for (i = 0; i < id_len; i++)
+	o.id = (o.id ^ id[i]) * 1099511628211ULL;
+      objects = (symcache_object_t *)
+	realloc (symcache_objects,
+		 (symcache_object_count + 1) * sizeof (symcache_object_t));
+      if (objects == NULL)
+	return 1;
+      symcache_objects = objects;
+      symcache_objects[symcache_object_count++] = o;
+    }
+  return 0;
+}
+#endif
+
+
+/*  Returns the object pc is in, or NULL if it is not cacheable.  */
+static symcache_object_t *
+symcache_object (void *pc)
+{
+  int i;
+
+  for (i = 0; i < symcache_object_count; i++)
+    if ((char *) pc >= symcache_objects[i].lo
+	&& (char *) pc < symcache_objects[i].hi)
+      return &symcache_objects[i];
+  return NULL;
+}
+
+
+static int
+symcache_index_sort (const void *a, const void *b)
+{
+  const symcache_index_t *ia = (const symcache_index_t *) a;
+  const symcache_index_t *ib = (const symcache_index_t *) b;
+
+  if (ia->object != ib->object)
+    return ia->object < ib->object ? -1 : 1;
+  return ia->offset < ib->offset ? -1 : ia->offset > ib->offset;
+}
+
+
+/*  Maps and indexes the cache file.  A record cut short by a failed
+    append ends the index.  */
+static void
+symcache_load (void)
+{
+  struct stat st;
+  const char *p, *end;
+  int fd, cap = 0;
+
+  fd = open (symcache_path, O_RDONLY);
+  if (fd < 0)
+    return;
+  if (fstat (fd, &st) != 0 || st.st_size < SYMCACHE_MAGIC_LEN)
+    {
+      close (fd);
+      return;
+    }
+  symcache_map = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (symcache_map == MAP_FAILED)
+    {
+      symcache_map = NULL;
+      return;
+    }
+  symcache_map_len = st.st_size;
+  if (memcmp (symcache_map, SYMCACHE_MAGIC, SYMCACHE_MAGIC_LEN) != 0)
+    {
+      symcache_enabled = 0;	/* not ours, leave it alone */
+      return;
+    }
+
+  p = symcache_map + SYMCACHE_MAGIC_LEN;
+  end = symcache_map + symcache_map_len;
+  while (p + sizeof (symcache_rec_t) <= end)
+    {
+      symcache_rec_t r;
+
+      memcpy (&r, p, sizeof (r));
+      if (p + sizeof (r) + r.file_len + r.funct_len > end)
+	break;
+      if (symcache_count == cap)
+	{
+	  symcache_index_t *index;
+
+	  cap = cap == 0 ? 256 : 2 * cap;
+	  index = (symcache_index_t *) realloc (symcache_index,
+						cap * sizeof (*index));
+	  if (index == NULL)
+	    break;
+	  symcache_index = index;
+	}
+      symcache_index[symcache_count].object = r.object;
+      symcache_index[symcache_count].offset = r.offset;
+      symcache_index[symcache_count].rec = p;
+      symcache_count++;
+      p += sizeof (r) + r.file_len + r.funct_len;
+    }
+  qsort (symcache_index, symcache_count, sizeof (symcache_index_t),
+	 symcache_index_sort);
+}
+
+
+/*  Opens the cache of the running executable in dir.  Returns 0, or -1
+    if it has no build-id or the cache cannot be used.  */
+int
+mpiPi_symcache_open (const char *dir, const char *app)
+{
+#ifdef __linux__
+  char *s;
+  int i;
+
+  dl_iterate_phdr (symcache_phdr, NULL);
+  if (symcache_object_count == 0 || dir == NULL || app == NULL)
+    return -1;
+
+  symcache_path = (char *) malloc (strlen (dir) + strlen (app)
+				   + 2 * symcache_build_id_len + 16);
+  if (symcache_path == NULL)
+    return -1;
+  s = symcache_path + sprintf (symcache_path, "%s/%s.", dir, app);
+  for (i = 0; i < symcache_build_id_len; i++)
+    s += sprintf (s, "%02x", symcache_build_id[i]);
+  strcpy (s, ".mpiPsym");
+
+  symcache_enabled = 1;
+  symcache_load ();
+  return symcache_enabled ? 0 : -1;
+#else
+  return -1;
+#endif
+}
+
+
+const char *
+mpiPi_symcache_path (void)
+{
+  return symcache_path;
+}
+
+
+/*  Looks pc up in the cache.  On a hit, sets newly allocated file and
+    function names and the line, unless filename is NULL, and returns
+    0.  */
+int
+mpiPi_symcache_find (void *pc, char **filename, char **functname,
+		     int *lineno)
+{
+  symcache_object_t *o;
+  symcache_index_t key, *hit;
+  symcache_rec_t r;
+  const char *names;
+
+  if (!symcache_enabled || symcache_count == 0
+      || (o = symcache_object (pc)) == NULL)
+    return -1;
+  key.object = o->id;
+  key.offset = (char *) pc - o->base;
+  hit = (symcache_index_t *) bsearch (&key, symcache_index, symcache_count,
+				      sizeof (symcache_index_t),
+				      symcache_index_sort);
+  if (hit == NULL)
+    return -1;
+
+  if (filename == NULL)
+    return 0;
+  memcpy (&r, hit->rec, sizeof (r));
+  names = hit->rec + sizeof (r);
+  *filename = strndup (names, r.file_len);
+  *functname = strndup (names + r.file_len, r.funct_len);
+  *lineno = r.line;
+  return 0;
+}
+
+
+/*  Queues a resolution for the cache file.  */
+void
+mpiPi_symcache_add (void *pc, const char *filename, const char *functname,
+		    int lineno)
+{
+  symcache_object_t *o;
+  symcache_rec_t r;
+  size_t need;
+
+  if (!symcache_enabled || (o = symcache_object (pc)) == NULL)
+    return;
+
+  memset (&r, 0, sizeof (r));
+  r.object = o->id;
+  r.offset = (char *) pc - o->base;
+  r.line = lineno;
+  r.file_len = strnlen (filename, 0xffff);
+  r.funct_len = strnlen (functname, 0xffff);
+  need = sizeof (r) + r.file_len + r.funct_len;
+  if (symcache_new_len + need > symcache_new_cap)
+    {
+      size_t cap = 2 * (symcache_new_len + need) + 1024;
+      char *buf = (char *) realloc (symcache_new, cap);
+
+      if (buf == NULL)
+	return;
+      symcache_new = buf;
+      symcache_new_cap = cap;
+    }
+  memcpy (symcache_new + symcache_new_len, &r, sizeof (r));
+  memcpy (symcache_new + symcache_new_len + sizeof (r), filename,
+	  r.file_len);
+  memcpy (symcache_new + symcache_new_len + sizeof (r) + r.file_len,
+	  functname, r.funct_len);
+  symcache_new_len += need;
+}
+
+
+/*  Writes all of buf, or returns -1.  */
+static int
+symcache_write (int fd, const char *buf, size_t len)
+{
+  while (len > 0)
+    {
+      ssize_t n = write (fd, buf, len);
+
+      if (n < 0 && errno == EINTR)
+	continue;
+      if (n <= 0)
+	return -1;
+      buf += n;
+      len -= n;
+    }
+  return 0;
+}
+
+
+/*  Creates the cache file holding the queued records, unless another
+    run got there first.  Returns 0 if it was created.  */
+static int
+symcache_create (void)
+{
+  char *tmp;
+  int fd, rc = -1;
+
+  tmp = (char *) malloc (strlen (symcache_path) + 32);
+  if (tmp == NULL)
+    return -1;
+  sprintf (tmp, "%s.%d.tmp", symcache_path, (int) getpid ());
+  fd = open (tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0)
+    {
+      if (symcache_write (fd, SYMCACHE_MAGIC, SYMCACHE_MAGIC_LEN) == 0
+	  && symcache_write (fd, symcache_new, symcache_new_len) == 0
+	  && close (fd) == 0)
+	rc = link (tmp, symcache_path);
+      else
+	close (fd);
+      unlink (tmp);
+    }
+  free (tmp);
+  return rc;
+}
+
+
+/*  Appends the queued records and releases the cache.  */
+void
+mpiPi_symcache_close (void)
+{
+  if (symcache_enabled && symcache_new_len > 0
+      && (symcache_map != NULL || symcache_create () != 0))
+    {
+      int fd = open (symcache_path, O_WRONLY | O_APPEND);
+
+      if (fd >= 0)
+	{
+	  symcache_write (fd, symcache_new, symcache_new_len);
+	  close (fd);
+	}
+    }
+
+  if (symcache_map != NULL)
+    munmap (symcache_map, symcache_map_len);
+  free (symcache_index);
+  free (symcache_new);
+  free (symcache_objects);
+  free (symcache_path);
+  symcache_map = NULL;
+  symcache_index = NULL;
+  symcache_new = NULL;
+  symcache_path = NULL;
+  symcache_count = 0;
+  symcache_objects = NULL;
+  symcache_object_count = 0;
+  symcache_new_len = symcache_new_cap = 0;
+  symcache_enabled = 0;
+}
+
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
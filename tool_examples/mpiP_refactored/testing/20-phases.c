@@ -0,0 +1,150 @@
+/*
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   20-phases.c  -- test phases entered with MPI_Pcontrol (100 + n) and
+                   mpiP_enter_phase, named with -a
+
+*/
+
+#ifndef lint
+static char *svnid =
+  "$Id$";
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <dlfcn.h>
+#include "mpi.h"
+#include "qmpi.h"
+#include "mpiP-API.h"
+
+typedef int (*enter_phase_func) (const char *name, int qmpi_lvl,
+				 vector * v);
+
+extern vector v;		/*  the tools loaded by QMPI  */
+
+/*  Calls mpiP_enter_phase at the level mpiP was loaded at.  */
+static int
+enter_phase (const char *name)
+{
+  int i;
+
+  for (i = 0; i < vector_total (&v); i++)
+    {
+      enter_phase_func f = (enter_phase_func)
+	dlsym ((*VECTOR_GET (&v, i)).handle, "mpiP_enter_phase");
+
+      if (f != NULL)
+	return f (name, i, &v);
+    }
+  fprintf (stderr, "mpiP is not loaded\n");
+  MPI_Abort (MPI_COMM_WORLD, 1);
+  return -1;
+}
+
+int
+main (int argc, char **argv)
+{
+  int i, x = 1, y;
+
+  MPI_Init (&argc, &argv);
+  MPI_Barrier (MPI_COMM_WORLD);	/*  phase 0  */
+
+  MPI_Pcontrol (101);		/*  phase 1, named setup by -a  */
+  for (i = 0; i < 3; i++)
+    MPI_Barrier (MPI_COMM_WORLD);
+
+  MPI_Pcontrol (102);		/*  phase 2, named solve by -a  */
+  for (i = 0; i < 4; i++)
+    MPI_Allreduce (&x, &y, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  /*  a new name takes the first unnamed phase, a known one its own  */
+  if (enter_phase ("output") != 3 || enter_phase ("solve") != 2)
+    {
+      fprintf (stderr, "unexpected phase\n");
+      MPI_Abort (MPI_COMM_WORLD, 1);
+    }
+  MPI_Allreduce (&x, &y, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  enter_phase ("output");
+  for (i = 0; i < 5; i++)
+    MPI_Bcast (&x, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+  enter_phase (NULL);		/*  back to phase 0  */
+  MPI_Barrier (MPI_COMM_WORLD);
+  MPI_Finalize ();
+  return 0;
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
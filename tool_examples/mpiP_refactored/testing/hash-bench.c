@@ -0,0 +1,245 @@
+/*
+ 
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   hash-bench.c -- callsite hash table microbenchmark
+
+   Builds a table of synthetic callsites keyed like the task callsite
+   table (operation, rank and a stack of return addresses clustered in a
+   text segment), then times lookups whose callsites follow a Zipf
+   distribution, since a few hot loops make most MPI calls.
+
+   usage: hash-bench.exe [callsites [lookups [stack depth]]]
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "mpiP-hash.h"
+
+#define STACK_DEPTH_MAX 8
+#define TEXT_BASE 0x400000
+#define TEXT_SIZE (4 << 20)
+#define CALLERS 64		/* functions that appear in the outer frames */
+
+typedef struct _bench_key_t
+{
+  int op;
+  int rank;
+  void *pc[STACK_DEPTH_MAX];
+}
+bench_key_t;
+
+static int stack_depth = 1;
+
+/*  Same mixing as mpiPi_callsite_stats_pc_hashkey  */
+static int
+bench_hashkey (const void *p, int qmpi_lvl, vector * v)
+{
+  const bench_key_t *k = (const bench_key_t *) p;
+  int i, res = 0;
+  for (i = 0; i < stack_depth; i++)
+    res ^= (unsigned) (long) k->pc[i];
+  return 52271 ^ k->op ^ res ^ k->rank;
+}
+
+static int
+bench_comparator (const void *p1, const void *p2, int qmpi_lvl, vector * v)
+{
+  const bench_key_t *k1 = (const bench_key_t *) p1;
+  const bench_key_t *k2 = (const bench_key_t *) p2;
+  int i;
+#define express(f) {if ((k1->f) > (k2->f)) {return 1;} if ((k1->f) < (k2->f)) {return -1;}}
+  express (op);
+  express (rank);
+  for (i = 0; i < stack_depth; i++)
+    {
+      express (pc[i]);
+    }
+#undef express
+  return 0;
+}
+
+static double
+now (void)
+{
+  struct timeval tv;
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+/*  Return addresses are call instructions inside functions, so the low
+    bits vary little and the high bits not at all.  */
+static void *
+random_pc (long text_size)
+{
+  long func = (rand () % (text_size / 256)) * 256;
+  return (void *) (long) (TEXT_BASE + func + 5 + rand () % 200);
+}
+
+int
+main (int argc, char **argv)
+{
+  int callsites = argc > 1 ? atoi (argv[1]) : 4096;
+  long lookups = argc > 2 ? atol (argv[2]) : 10000000;
+  h_t *ht;
+  bench_key_t *keys, key;
+  void *callers[CALLERS];
+  double *cdf, sum, start, insert_time, lookup_time;
+  int *order;
+  long i, found = 0;
+  int j;
+
+  if (argc > 3)
+    stack_depth = atoi (argv[3]);
+  if (callsites < 1 || lookups < 1 || stack_depth < 1
+      || stack_depth > STACK_DEPTH_MAX)
+    {
+      fprintf (stderr, "usage: %s [callsites [lookups [stack depth]]]\n",
+	       argv[0]);
+      return 1;
+    }
+
+  srand (12345);
+  for (j = 0; j < CALLERS; j++)
+    callers[j] = random_pc (TEXT_SIZE);
+
+  keys = (bench_key_t *) calloc (callsites, sizeof (bench_key_t));
+  for (i = 0; i < callsites; i++)
+    {
+      keys[i].op = 1000 + rand () % 40;
+      keys[i].rank = 0;
+      keys[i].pc[0] = random_pc (TEXT_SIZE);
+      for (j = 1; j < stack_depth; j++)
+	keys[i].pc[j] = callers[rand () % CALLERS];
+    }
+
+  /*  Zipf (s = 1) over the callsites, visited in a random order  */
+  cdf = (double *) malloc (sizeof (double) * callsites);
+  for (i = 0, sum = 0; i < callsites; i++)
+    cdf[i] = (sum += 1.0 / (i + 1));
+  order = (int *) malloc (sizeof (int) * 65536);
+  for (i = 0; i < 65536; i++)
+    {
+      double u = sum * rand () / ((double) RAND_MAX + 1);
+      int lo = 0, hi = callsites - 1;
+      while (lo < hi)
+	{
+	  int mid = (lo + hi) / 2;
+	  if (cdf[mid] < u)
+	    lo = mid + 1;
+	  else
+	    hi = mid;
+	}
+      order[i] = lo;
+    }
+
+  ht = h_open (256, bench_hashkey, bench_comparator);
+  start = now ();
+  for (i = 0; i < callsites; i++)
+    {
+      void *p;
+      if (h_search (ht, &keys[i], &p, 0, NULL) == NULL)
+	h_insert (ht, &keys[i], 0, NULL);
+    }
+  insert_time = now () - start;
+
+  start = now ();
+  for (i = 0; i < lookups; i++)
+    {
+      void *p;
+      key = keys[order[i & 65535]];
+      if (h_search (ht, &key, &p, 0, NULL) != NULL)
+	found++;
+    }
+  lookup_time = now () - start;
+
+  printf ("callsites %d, stack depth %d, table entries %d\n",
+	  callsites, stack_depth, h_count (ht));
+  printf ("insert: %8.1f ns/op\n", 1e9 * insert_time / callsites);
+  printf ("lookup: %8.1f ns/op (%ld found)\n", 1e9 * lookup_time / lookups,
+	  found);
+
+  h_close (ht);
+  free (order);
+  free (cdf);
+  free (keys);
+  return found == lookups ? 0 : 1;
+}
+
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+/* EOF */
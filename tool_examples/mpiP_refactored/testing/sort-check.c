@@ -0,0 +1,216 @@
+/*
+ 
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   sort-check.c -- check the parallel report sort against qsort
+
+   Sorts arrays of records with mpiPi_sort_runs for several run counts,
+   so that the threaded path runs even on a single processor, and
+   compares each result with qsort.  Records are ordered like the report
+   records, by (op, site, rank), which is a total order; a comparator on
+   op alone checks that runs with ties still merge into a sorted
+   permutation.
+
+   usage: sort-check.exe [records]
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern void mpiPi_sort_runs (void **av, int ac,
+			     int (*cmp) (const void *, const void *),
+			     int nruns);
+
+typedef struct _check_rec_t
+{
+  int op;
+  int csid;
+  int rank;
+}
+check_rec_t;
+
+static int
+check_by_op_site_rank (const void *a, const void *b)
+{
+  const check_rec_t *r1 = *(const check_rec_t **) a;
+  const check_rec_t *r2 = *(const check_rec_t **) b;
+#define express(f) {if ((r1->f) > (r2->f)) {return 1;} if ((r1->f) < (r2->f)) {return -1;}}
+  express (op);
+  express (csid);
+  express (rank);
+#undef express
+  return 0;
+}
+
+static int
+check_by_op (const void *a, const void *b)
+{
+  const check_rec_t *r1 = *(const check_rec_t **) a;
+  const check_rec_t *r2 = *(const check_rec_t **) b;
+  return r1->op > r2->op ? 1 : r1->op < r2->op ? -1 : 0;
+}
+
+static int
+check_pointer (const void *a, const void *b)
+{
+  const void *p1 = *(void *const *) a;
+  const void *p2 = *(void *const *) b;
+  return p1 > p2 ? 1 : p1 < p2 ? -1 : 0;
+}
+
+/*  Returns the number of failures of one records x nruns case.  */
+static int
+check_case (check_rec_t * recs, int n, int nruns)
+{
+  void **expect, **got, **perm;
+  int i, failed = 0;
+
+  expect = (void **) malloc (sizeof (void *) * (n + 1));
+  got = (void **) malloc (sizeof (void *) * (n + 1));
+  perm = (void **) malloc (sizeof (void *) * (n + 1));
+  for (i = 0; i < n; i++)
+    expect[i] = &recs[(i * 7919L) % n];
+
+  /*  A total order has one result: it must be qsort's.  */
+  memcpy (got, expect, sizeof (void *) * n);
+  qsort (expect, n, sizeof (void *), check_by_op_site_rank);
+  mpiPi_sort_runs (got, n, check_by_op_site_rank, nruns);
+  if (n > 0 && memcmp (got, expect, sizeof (void *) * n) != 0)
+    {
+      printf ("FAILED: %d records, %d runs: differs from qsort\n", n, nruns);
+      failed++;
+    }
+
+  /*  With ties the result must be sorted and a permutation.  */
+  mpiPi_sort_runs (got, n, check_by_op, nruns);
+  for (i = 1; i < n; i++)
+    if (check_by_op (&got[i - 1], &got[i]) > 0)
+      break;
+  memcpy (perm, got, sizeof (void *) * n);
+  qsort (perm, n, sizeof (void *), check_pointer);
+  qsort (expect, n, sizeof (void *), check_pointer);
+  if (i < n || (n > 0 && memcmp (perm, expect, sizeof (void *) * n) != 0))
+    {
+      printf ("FAILED: %d records, %d runs: ties not sorted\n", n, nruns);
+      failed++;
+    }
+
+  free (perm);
+  free (got);
+  free (expect);
+  return failed;
+}
+
+int
+main (int argc, char **argv)
+{
+  int records = argc > 1 ? atoi (argv[1]) : 100000;
+  int sizes[] = { 0, 1, 2, 3, 17, 1000, 0 };
+  int runs[] = { 2, 3, 4, 7, 16, 64 };
+  check_rec_t *recs;
+  int i, j, n, failed = 0;
+
+  if (records < 1)
+    {
+      fprintf (stderr, "usage: %s [records]\n", argv[0]);
+      return 1;
+    }
+  sizes[sizeof (sizes) / sizeof (sizes[0]) - 1] = records;
+
+  srand (12345);
+  recs = (check_rec_t *) malloc (sizeof (check_rec_t) * records);
+  for (i = 0; i < records; i++)
+    {
+      recs[i].op = 1000 + rand () % 40;
+      recs[i].csid = rand () % 100;
+      recs[i].rank = i;
+    }
+
+  for (i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++)
+    for (j = 0; j < sizeof (runs) / sizeof (runs[0]); j++)
+      {
+	n = sizes[i] < records ? sizes[i] : records;
+	failed += check_case (recs, n, runs[j]);
+      }
+
+  free (recs);
+  printf ("sort-check: %s\n", failed == 0 ? "ok" : "FAILED");
+  return failed == 0 ? 0 : 1;
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+/* EOF */
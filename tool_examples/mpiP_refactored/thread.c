@@ -0,0 +1,414 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   thread.c -- callsite statistics of the threads of a task
+
+   The wrappers find the state of the calling thread through a
+   thread-specific key, so threads record their MPI calls without locks
+   under MPI_THREAD_MULTIPLE.  The thread that initialized mpiP records
+   into the task's tables; every other thread gets its own tables on its
+   first MPI call.  These are merged into the task's at the report
+   points, MPI_Finalize and MPI_Pcontrol, while the other threads must
+   be outside MPI calls.
+
+   Threads are numbered in the order of their first MPI call, and with
+   -j the report shows the MPI time of each.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+/*  A thread other than the first, with the tables it records into.  */
+typedef struct
+{
+  mpiPi_thread_t thread;
+  mpiPi_callpaths_t callpaths;
+  mpiPi_latency_t latency;
+  mpiPi_hist_cells_t coll_time_stats;
+  mpiPi_hist_cells_t pt2pt_send_stats;
+} thread_tables_t;
+
+
+static void
+thread_add (mpiPi_thread_t * t, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  pthread_mutex_lock (&gs_ptr->mpiPi.threadLock);
+  t->id = gs_ptr->mpiPi.threadCount++;
+  t->next = gs_ptr->mpiPi.threads;
+  gs_ptr->mpiPi.threads = t;
+  pthread_mutex_unlock (&gs_ptr->mpiPi.threadLock);
+
+  if (pthread_setspecific (gs_ptr->mpiPi.threadKey, t) != 0)
+    mpiPi_abort (qmpi_lvl,v,"failed to register thread statistics\n");
+}
+
+
+/*  Makes the calling thread the first, which uses the task's tables.  */
+void
+mpiPi_thread_init (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_thread_t *t = (mpiPi_thread_t *) calloc (1, sizeof (mpiPi_thread_t));
+
+  if (t == NULL || pthread_key_create (&gs_ptr->mpiPi.threadKey, NULL) != 0)
+    mpiPi_abort (qmpi_lvl,v,"failed to allocate thread statistics\n");
+  pthread_mutex_init (&gs_ptr->mpiPi.threadLock, NULL);
+  gs_ptr->mpiPi.threads = NULL;
+  gs_ptr->mpiPi.threadCount = 0;
+  gs_ptr->mpiPi.global_thread_count = 0;
+  gs_ptr->mpiPi.global_thread_max = 1;
+  gs_ptr->mpiPi.global_thread_times = NULL;
+
+  t->callsite_stats = gs_ptr->mpiPi.task_callsite_stats;
+  t->callpaths = &gs_ptr->mpiPi.callpaths;
+  t->latency = &gs_ptr->mpiPi.latency;
+  t->coll_time_stats = &gs_ptr->mpiPi.coll_time_stats;
+  t->pt2pt_send_stats = &gs_ptr->mpiPi.pt2pt_send_stats;
+  thread_add (t, qmpi_lvl, v);
+}
+
+
+mpiPi_thread_t *
+mpiPi_thread_self (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_thread_t *t;
+  thread_tables_t *tt;
+
+  t = (mpiPi_thread_t *) pthread_getspecific (gs_ptr->mpiPi.threadKey);
+  if (t != NULL)
+    return t;
+
+  tt = (thread_tables_t *) calloc (1, sizeof (thread_tables_t));
+  if (tt == NULL)
+    mpiPi_abort (qmpi_lvl,v,"failed to allocate thread statistics\n");
+  mpiPi_callpath_init (&tt->callpaths, gs_ptr->mpiPi.callpaths.depth);
+  mpiPi_latency_init (&tt->latency, gs_ptr->mpiPi.latency.sub_bits);
+  t = &tt->thread;
+  t->callsite_stats = h_open (gs_ptr->mpiPi.tableSize,
+			      mpiPi_callsite_stats_path_hashkey,
+			      mpiPi_callsite_stats_path_comparator);
+  t->callpaths = &tt->callpaths;
+  t->latency = &tt->latency;
+  t->coll_time_stats = &tt->coll_time_stats;
+  t->pt2pt_send_stats = &tt->pt2pt_send_stats;
+  thread_add (t, qmpi_lvl, v);
+  mpiPi_msg_debug (qmpi_lvl,v,"added thread %d\n", t->id);
+
+  return t;
+}
+
+
+/*  Called on entry to a wrapper: returns whether the call is recorded.
+    Calls made within another, as by a lower tool layer, are not.  */
+int
+mpiPi_thread_enter (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_thread_t *t = mpiPi_thread_self (qmpi_lvl, v);
+
+  return t->depth++ == 0 && gs_ptr->mpiPi.enabled;
+}
+
+
+void
+mpiPi_thread_leave (int qmpi_lvl, vector * v)
+{
+  mpiPi_thread_self (qmpi_lvl, v)->depth--;
+}
+
+
+static void
+thread_merge_cells (mpiPi_hist_cells_t * to, mpiPi_hist_cells_t * from,
+		    int qmpi_lvl, vector * v)
+{
+  mpiPi_hist_cell_t *cells;
+  int i, n;
+
+  if (from->count == 0)
+    return;
+  n = mpiPi_hist_cells_gather (from, &cells);
+  if (n < 0)
+    {
+      mpiPi_msg_warn (qmpi_lvl,v,"failed to merge thread histogram cells\n");
+      return;
+    }
+  for (i = 0; i < n; i++)
+    if (mpiPi_hist_cells_add (to, cells[i].key, cells[i].value) != 0)
+      mpiPi_msg_warn (qmpi_lvl,v,"failed to allocate histogram cell\n");
+  free (cells);
+  mpiPi_hist_cells_free (from);
+}
+
+
+/*  Moves the records of thread t into the task's tables, leaving t's
+    empty.  */
+static void
+thread_merge_one (mpiPi_thread_t * t, int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_latency_t *lt = &gs_ptr->mpiPi.latency;
+  callsite_stats_t **av;
+  int ac, i, j;
+
+  h_gather_data (t->callsite_stats, &ac, (void ***) &av);
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t *p = av[i], *csp = NULL;
+      callsite_stats_t key;
+      int lat = p->lat;
+
+      /* the path ids of the thread are not the task's */
+      key.op = p->op;
+      key.rank = p->rank;
+      key.phase = p->phase;
+      key.cookie = MPIP_CALLSITE_STATS_COOKIE;
+      key.path = mpiPi_callpath_intern (&gs_ptr->mpiPi.callpaths,
+					mpiPi_callpath_pcs (t->callpaths,
+							    p->path));
+      if (key.path < 0)
+	mpiPi_abort (qmpi_lvl,v,"failed to allocate call paths\n");
+
+      if (NULL == h_search (gs_ptr->mpiPi.task_callsite_stats, &key,
+			    (void **) &csp, qmpi_lvl, v))
+	{
+	  /* the record itself moves to the task */
+	  p->path = key.path;
+	  p->lat = mpiPi_latency_new (lt);
+	  if (p->lat < 0)
+	    mpiPi_abort (qmpi_lvl,v,"failed to allocate latency histograms\n");
+	  if (p->lat > 0 && lat > 0)
+	    memcpy (mpiPi_latency_counts (lt, p->lat),
+		    mpiPi_latency_counts (t->latency, lat),
+		    lt->buckets * sizeof (long long));
+	  h_insert (gs_ptr->mpiPi.task_callsite_stats, p, qmpi_lvl, v);
+	  continue;
+	}
+
+      mpiPi_merge_individual_callsite_records (csp, p);
+      csp->maxRMA = max (csp->maxRMA, p->maxRMA);
+      csp->minRMA = min (csp->minRMA, p->minRMA);
+      if (csp->lat > 0 && lat > 0)
+	{
+	  long long *a = mpiPi_latency_counts (lt, csp->lat);
+	  long long *b = mpiPi_latency_counts (t->latency, lat);
+
+	  for (j = 0; j < lt->buckets; j++)
+	    a[j] += b[j];
+	}
+      free (p);
+    }
+  free (av);
+
+  thread_merge_cells (&gs_ptr->mpiPi.coll_time_stats, t->coll_time_stats,
+		      qmpi_lvl, v);
+  thread_merge_cells (&gs_ptr->mpiPi.pt2pt_send_stats, t->pt2pt_send_stats,
+		      qmpi_lvl, v);
+
+  h_close (t->callsite_stats);
+  t->callsite_stats = h_open (gs_ptr->mpiPi.tableSize,
+			      mpiPi_callsite_stats_path_hashkey,
+			      mpiPi_callsite_stats_path_comparator);
+  mpiPi_callpath_free (t->callpaths);
+  mpiPi_latency_free (t->latency);
+}
+
+
+/*  Merges the records of all threads into the task's tables.  */
+void
+mpiPi_thread_merge (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_thread_t *t;
+
+  pthread_mutex_lock (&gs_ptr->mpiPi.threadLock);
+  for (t = gs_ptr->mpiPi.threads; t != NULL; t = t->next)
+    if (t->id != 0)
+      thread_merge_one (t, qmpi_lvl, v);
+  pthread_mutex_unlock (&gs_ptr->mpiPi.threadLock);
+}
+
+
+/*  Clears the MPI time of all threads, for MPI_Pcontrol (2).  */
+void
+mpiPi_thread_reset (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_thread_t *t;
+
+  pthread_mutex_lock (&gs_ptr->mpiPi.threadLock);
+  for (t = gs_ptr->mpiPi.threads; t != NULL; t = t->next)
+    {
+      t->calls = 0;
+      t->mpiTime = 0;
+    }
+  pthread_mutex_unlock (&gs_ptr->mpiPi.threadLock);
+}
+
+
+/*  Gathers the MPI time of every thread of every task at the collector
+    for the report (-j).  */
+void
+mpiPi_thread_gather_times (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  mpiPi_thread_time_t *local;
+  mpiPi_thread_t *t;
+  int i, n, len, total = 0, *counts = NULL, *displs = NULL;
+  int collector = gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank;
+
+  pthread_mutex_lock (&gs_ptr->mpiPi.threadLock);
+  n = gs_ptr->mpiPi.threadCount;
+  local = (mpiPi_thread_time_t *) calloc (n, sizeof (mpiPi_thread_time_t));
+  for (t = gs_ptr->mpiPi.threads; t != NULL && local != NULL; t = t->next)
+    {
+      local[t->id].task = gs_ptr->mpiPi.rank;
+      local[t->id].thread = t->id;
+      local[t->id].calls = t->calls;
+      local[t->id].mpiTime = t->mpiTime;
+    }
+  pthread_mutex_unlock (&gs_ptr->mpiPi.threadLock);
+
+  if (collector)
+    {
+      counts = (int *) malloc (gs_ptr->mpiPi.size * sizeof (int));
+      displs = (int *) malloc (gs_ptr->mpiPi.size * sizeof (int));
+    }
+  if (local == NULL || (collector && (counts == NULL || displs == NULL)))
+    mpiPi_abort (qmpi_lvl,v,"failed to allocate thread times\n");
+
+  len = n * sizeof (mpiPi_thread_time_t);
+  PMPI_Gather (&len, 1, MPI_INT, counts, 1, MPI_INT,
+	       gs_ptr->mpiPi.collectorRank, gs_ptr->mpiPi.comm);
+  if (collector)
+    {
+      for (i = 0; i < gs_ptr->mpiPi.size; i++)
+	{
+	  displs[i] = total;
+	  total += counts[i];
+	}
+      free (gs_ptr->mpiPi.global_thread_times);
+      gs_ptr->mpiPi.global_thread_times =
+	(mpiPi_thread_time_t *) malloc (total);
+      if (gs_ptr->mpiPi.global_thread_times == NULL)
+	mpiPi_abort (qmpi_lvl,v,"failed to allocate thread times\n");
+      gs_ptr->mpiPi.global_thread_count =
+	total / sizeof (mpiPi_thread_time_t);
+    }
+  PMPI_Gatherv (local, len, MPI_CHAR, gs_ptr->mpiPi.global_thread_times,
+		counts, displs, MPI_CHAR, gs_ptr->mpiPi.collectorRank,
+		gs_ptr->mpiPi.comm);
+
+  free (local);
+  free (counts);
+  free (displs);
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
@@ -0,0 +1,589 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   trace.c -- event timeline of the MPI calls of each task (-w)
+
+   With -w n every n-th MPI call of a task, made by the thread that
+   initialized mpiP, is stored as a fixed size event in one of two
+   preallocated buffers.  A full buffer is handed to a writer thread,
+   which appends it to the task's .mpiPt file while the other buffer
+   fills.  At MPI_Finalize each task adds the call paths its
+   events refer to, and the collector converts the files of all tasks,
+   which must be in a directory it can read, to one Chrome trace event
+   JSON file (chrome://tracing, Perfetto) with a process per task.
+   mpip-report -t converts them after the run.
+
+   Times are nanoseconds since the collective in mpiPi_trace_init, so
+   the timelines of the tasks are aligned as closely as its exits are.
+   Files are in the writer's byte order and name calls by their number
+   in this build, so they are converted by the same build.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+#define TRACE_MAGIC "mPtrace\0"
+#define TRACE_MAGIC_LEN 8
+#define TRACE_VERSION 1
+
+typedef struct
+{
+  long long start;
+  long long end;
+  long long bytes;		/* sent, read or written, or moved by RMA */
+  int op;
+  int path;			/* call stack, an id in mpiPi.callpaths */
+  int comm;			/* MPI_Comm_c2f of the communicator, -1 if none */
+  int peer;			/* rank in comm, -1 if none */
+} trace_event_t;
+
+/*  The header is followed by the events and then by the pcs of the
+    call paths.  */
+typedef struct
+{
+  char magic[TRACE_MAGIC_LEN];
+  int version;
+  int pointer_size;
+  int rank;
+  int size;
+  int depth;			/* pcs per call path */
+  int paths;
+  long long events;
+} trace_header_t;
+
+struct _mpiPi_trace_t
+{
+  int skip;			/* calls until the next traced one */
+  mpiPi_TIME origin;
+  int procID;			/* of the collector, in the file names */
+  char path[256];
+  FILE *fp;
+  trace_event_t *buf[2];
+  int cur;			/* the buffer being filled */
+  int fill;			/* events in it */
+  long long events;
+  long long stalls;		/* spills that waited for the writer */
+
+  /*  The writer owns buf[full] while pending is not 0.  */
+  pthread_t writer;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  int full;
+  int pending;
+  int stop;
+  int failed;
+};
+
+
+static void *
+trace_writer (void *arg)
+{
+  struct _mpiPi_trace_t *t = (struct _mpiPi_trace_t *) arg;
+
+  pthread_mutex_lock (&t->lock);
+  for (;;)
+    {
+      trace_event_t *buf;
+      int n, ok;
+
+      while (t->pending == 0 && !t->stop)
+	pthread_cond_wait (&t->cond, &t->lock);
+      if (t->pending == 0)
+	break;
+      buf = t->buf[t->full];
+      n = t->pending;
+      pthread_mutex_unlock (&t->lock);
+      ok = fwrite (buf, sizeof (trace_event_t), n, t->fp) == n;
+      pthread_mutex_lock (&t->lock);
+      if (!ok)
+	t->failed = 1;
+      t->pending = 0;
+      pthread_cond_broadcast (&t->cond);
+    }
+  pthread_mutex_unlock (&t->lock);
+  return NULL;
+}
+
+/*  Hands the buffer being filled to the writer.  */
+static void
+trace_spill (struct _mpiPi_trace_t *t)
+{
+  pthread_mutex_lock (&t->lock);
+  if (t->pending != 0)
+    {
+      t->stalls++;
+      while (t->pending != 0)
+	pthread_cond_wait (&t->cond, &t->lock);
+    }
+  t->full = t->cur;
+  t->pending = t->fill;
+  pthread_cond_broadcast (&t->cond);
+  pthread_mutex_unlock (&t->lock);
+  t->cur ^= 1;
+  t->fill = 0;
+}
+
+static void
+trace_free (struct _mpiPi_trace_t *t)
+{
+  if (t->fp != NULL)
+    fclose (t->fp);
+  free (t->buf[0]);
+  free (t);
+}
+
+static void
+trace_file_name (char *buf, int len, int procID, int rank, int qmpi_lvl,
+		 vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  snprintf (buf, len, "%s/%s.%d.%d.%d.mpiPt", gs_ptr->mpiPi.outputDir,
+	    gs_ptr->mpiPi.appName, gs_ptr->mpiPi.size, procID, rank);
+}
+
+
+/*  Opens the trace file of this task and starts its writer.  Tracing
+    stops on every task if one of them cannot trace.  Collective.  */
+void
+mpiPi_trace_init (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  struct _mpiPi_trace_t *t;
+  trace_header_t h;
+  int procID = gs_ptr->mpiPi.procID;
+  int ok, all_ok;
+
+  /* the files are named by the collector's pid, like the report */
+  PMPI_Bcast (&procID, 1, MPI_INT, gs_ptr->mpiPi.collectorRank,
+	      gs_ptr->mpiPi.comm);
+
+  bzero (&h, sizeof (h));
+  t = (struct _mpiPi_trace_t *) calloc (1, sizeof (struct _mpiPi_trace_t));
+  ok = t != NULL;
+  if (ok)
+    {
+      t->procID = procID;
+      trace_file_name (t->path, sizeof (t->path), procID,
+		       gs_ptr->mpiPi.rank, qmpi_lvl, v);
+      t->buf[0] = (trace_event_t *)
+	malloc (2 * MPIP_TRACE_BUFFER_EVENTS * sizeof (trace_event_t));
+      t->buf[1] = t->buf[0] + MPIP_TRACE_BUFFER_EVENTS;
+      ok = t->buf[0] != NULL && (t->fp = fopen (t->path, "wb")) != NULL
+	&& fwrite (&h, sizeof (h), 1, t->fp) == 1;
+      if (!ok)
+	mpiPi_msg_warn (qmpi_lvl,v,"Could not open trace [%s]\n", t->path);
+    }
+  if (ok)
+    {
+      pthread_mutex_init (&t->lock, NULL);
+      pthread_cond_init (&t->cond, NULL);
+      ok = pthread_create (&t->writer, NULL, trace_writer, t) == 0;
+      if (!ok)
+	mpiPi_msg_warn (qmpi_lvl,v,"Could not start the trace writer\n");
+    }
+
+  PMPI_Allreduce (&ok, &all_ok, 1, MPI_INT, MPI_MIN, gs_ptr->mpiPi.comm);
+  if (!all_ok)
+    {
+      if (ok)
+	{
+	  pthread_mutex_lock (&t->lock);
+	  t->stop = 1;
+	  pthread_cond_broadcast (&t->cond);
+	  pthread_mutex_unlock (&t->lock);
+	  pthread_join (t->writer, NULL);
+	}
+      if (t != NULL)
+	{
+	  if (t->fp != NULL)
+	    unlink (t->path);
+	  trace_free (t);
+	}
+      if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+	mpiPi_msg_warn (qmpi_lvl,v,"Tracing disabled.\n");
+      gs_ptr->mpiPi.traceRate = 0;
+      return;
+    }
+
+  t->skip = 1;
+  mpiPi_GETTIME (&t->origin);
+  gs_ptr->mpiPi.trace = t;
+}
+
+
+void
+mpiPi_trace_record (unsigned op, mpiPi_TIME * start, mpiPi_TIME * end,
+		    void **pc, MPI_Comm * comm, int peer, double bytes,
+		    int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  struct _mpiPi_trace_t *t = gs_ptr->mpiPi.trace;
+  trace_event_t *e;
+
+  /* only the thread that initialized mpiP is traced */
+  if (mpiPi_thread_self (qmpi_lvl, v)->id != 0)
+    return;
+  if (--t->skip > 0)
+    return;
+  t->skip = gs_ptr->mpiPi.traceRate;
+
+  e = &t->buf[t->cur][t->fill];
+  e->start = (long long) (mpiPi_GETTIMEDIFF (start, &t->origin) * 1000);
+  e->end = (long long) (mpiPi_GETTIMEDIFF (end, &t->origin) * 1000);
+  e->bytes = (long long) bytes;
+  e->op = op;
+  e->path = mpiPi_callpath_intern (&gs_ptr->mpiPi.callpaths, pc);
+  if (e->path < 0)
+    mpiPi_abort (qmpi_lvl,v,"failed to allocate call paths\n");
+  e->comm = comm != NULL ? MPI_Comm_c2f (*comm) : -1;
+  e->peer = peer;
+  t->events++;
+  if (++t->fill == MPIP_TRACE_BUFFER_EVENTS)
+    trace_spill (t);
+}
+
+
+static void
+trace_json_str (FILE * fp, const char *s)
+{
+  fputc ('"', fp);
+  for (; *s != '\0'; s++)
+    {
+      if (*s == '"' || *s == '\\')
+	fprintf (fp, "\\%c", *s);
+      else if ((unsigned char) *s < 0x20)
+	fprintf (fp, "\\u%04x", (unsigned char) *s);
+      else
+	fputc (*s, fp);
+    }
+  fputc ('"', fp);
+}
+
+/*  The innermost frame of a call path.  */
+typedef struct
+{
+  void *pc;
+  char *filename, *functname;	/* NULL if not looked up */
+  int line;
+} trace_site_t;
+
+static const char *
+trace_call_name (int op)
+{
+  static int calls = -1;
+
+  if (calls < 0)
+    for (calls = 0; mpiPi_lookup[calls].name != NULL; calls++);
+  if (op < mpiPi_BASE || op - mpiPi_BASE >= calls)
+    return "MPI_[unknown]";
+  return mpiPi_lookup[op - mpiPi_BASE].name;
+}
+
+/*  Appends the events of one trace file to the JSON array in fp, each
+    named by the innermost frame of its call path.  The frames are
+    looked up in the source if resolve is set.  Returns 0 if the file
+    could not be read.  */
+static int
+trace_convert_file (FILE * fp, const char *path, int *first, int resolve,
+		    int qmpi_lvl, vector * v)
+{
+  FILE *in;
+  trace_header_t h;
+  trace_site_t *sites = NULL;
+  trace_event_t *buf = NULL;
+  void **pcs = NULL;
+  long long done;
+  size_t npcs;
+  int i, ok;
+
+  in = fopen (path, "rb");
+  ok = in != NULL && fread (&h, sizeof (h), 1, in) == 1
+    && memcmp (h.magic, TRACE_MAGIC, TRACE_MAGIC_LEN) == 0
+    && h.version == TRACE_VERSION && h.pointer_size == sizeof (void *)
+    && h.paths >= 0 && h.depth >= 0 && h.events >= 0;
+  if (ok)
+    {
+      npcs = (size_t) h.paths * h.depth;
+      pcs = (void **) malloc ((npcs + 1) * sizeof (void *));
+      sites = (trace_site_t *) calloc (h.paths + 1, sizeof (trace_site_t));
+      buf = (trace_event_t *)
+	malloc (MPIP_TRACE_BUFFER_EVENTS * sizeof (trace_event_t));
+      ok = pcs != NULL && sites != NULL && buf != NULL
+	&& fseek (in, sizeof (h) + h.events * sizeof (trace_event_t),
+		  SEEK_SET) == 0
+	&& fread (pcs, sizeof (void *), npcs, in) == npcs
+	&& fseek (in, sizeof (h), SEEK_SET) == 0;
+    }
+  if (!ok)
+    {
+      mpiPi_msg_warn (qmpi_lvl,v,"Could not read trace [%s]\n", path);
+      if (in != NULL)
+	fclose (in);
+      free (pcs);
+      free (sites);
+      free (buf);
+      return 0;
+    }
+
+  for (i = 0; i < h.paths && h.depth > 0; i++)
+    {
+      trace_site_t *s = &sites[i];
+
+      s->pc = pcs[(size_t) i * h.depth];
+      if (s->pc != NULL && resolve
+	  && mpiPi_query_pc (qmpi_lvl, v, s->pc, &s->filename,
+			     &s->functname, &s->line) != 0)
+	s->filename = NULL;
+    }
+
+  fprintf (fp, "%s\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+	   "\"args\":{\"name\":\"rank %d\"}}", *first ? "" : ",", h.rank,
+	   h.rank);
+  *first = 0;
+  for (done = 0; done < h.events;)
+    {
+      int n = h.events - done < MPIP_TRACE_BUFFER_EVENTS ?
+	h.events - done : MPIP_TRACE_BUFFER_EVENTS;
+
+      if (fread (buf, sizeof (trace_event_t), n, in) != n)
+	{
+	  mpiPi_msg_warn (qmpi_lvl,v,"Trace [%s] is truncated\n", path);
+	  break;
+	}
+      for (i = 0; i < n; i++)
+	{
+	  trace_event_t *e = &buf[i];
+	  long long dur = e->end - e->start;
+	  trace_site_t *s = e->path >= 0 && e->path < h.paths ?
+	    &sites[e->path] : &sites[h.paths];
+
+	  fprintf (fp, ",\n{\"name\":\"%s\",\"cat\":\"MPI\",\"ph\":\"X\","
+		   "\"pid\":%d,\"tid\":0,\"ts\":%lld.%03lld,"
+		   "\"dur\":%lld.%03lld,\"args\":{\"comm\":%d,\"peer\":%d,"
+		   "\"bytes\":%lld", trace_call_name (e->op), h.rank,
+		   e->start / 1000, e->start % 1000, dur / 1000, dur % 1000,
+		   e->comm, e->peer, e->bytes);
+	  if (s->filename != NULL)
+	    {
+	      fprintf (fp, ",\"callsite\":");
+	      trace_json_str (fp, s->filename);
+	      fprintf (fp, ",\"line\":%d,\"function\":", s->line);
+	      trace_json_str (fp, s->functname);
+	    }
+	  else if (s->pc != NULL)
+	    {
+	      char addr_buf[24];
+	      fprintf (fp, ",\"pc\":\"%s\"",
+		       mpiP_format_address (s->pc, addr_buf));
+	    }
+	  fprintf (fp, "}}");
+	}
+      done += n;
+    }
+
+  fclose (in);
+  free (pcs);
+  free (sites);
+  free (buf);
+  return 1;
+}
+
+/*  Writes the trace files in paths as one Chrome trace event JSON
+    file.  Returns the number of files converted.  */
+int
+mpiPi_trace_convert (FILE * fp, int count, char **paths, int resolve,
+		     int qmpi_lvl, vector * v)
+{
+  int i, first = 1, converted = 0;
+
+  fprintf (fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (i = 0; i < count; i++)
+    converted += trace_convert_file (fp, paths[i], &first, resolve,
+				     qmpi_lvl, v);
+  fprintf (fp, "\n]}\n");
+  return converted;
+}
+
+
+/*  Writes the rest of the trace of this task, and has the collector
+    convert the traces of all tasks.  Collective.  */
+void
+mpiPi_trace_finalize (int qmpi_lvl, vector * v)
+{
+	//CHANGE BEGIN
+	gst* gs_ptr = (( gst*)((*VECTOR_GET(v,qmpi_lvl)).context));
+	// CHANGE END
+
+  struct _mpiPi_trace_t *t = gs_ptr->mpiPi.trace;
+  mpiPi_callpaths_t *cp = &gs_ptr->mpiPi.callpaths;
+  trace_header_t h;
+  size_t npcs = (size_t) cp->count * cp->depth;
+  if (t->fill > 0)
+    trace_spill (t);
+  pthread_mutex_lock (&t->lock);
+  t->stop = 1;
+  pthread_cond_broadcast (&t->cond);
+  pthread_mutex_unlock (&t->lock);
+  pthread_join (t->writer, NULL);
+  pthread_mutex_destroy (&t->lock);
+  pthread_cond_destroy (&t->cond);
+
+  bzero (&h, sizeof (h));
+  memcpy (h.magic, TRACE_MAGIC, TRACE_MAGIC_LEN);
+  h.version = TRACE_VERSION;
+  h.pointer_size = sizeof (void *);
+  h.rank = gs_ptr->mpiPi.rank;
+  h.size = gs_ptr->mpiPi.size;
+  h.depth = cp->depth;
+  h.paths = cp->count;
+  h.events = t->events;
+  if (fwrite (cp->pcs, sizeof (void *), npcs, t->fp) != npcs
+      || fseek (t->fp, 0, SEEK_SET) != 0
+      || fwrite (&h, sizeof (h), 1, t->fp) != 1)
+    t->failed = 1;
+  if (fclose (t->fp) != 0)
+    t->failed = 1;
+  t->fp = NULL;
+  if (t->failed)
+    mpiPi_msg_warn (qmpi_lvl,v,"Could not write trace [%s]\n", t->path);
+  mpiPi_msg_debug (qmpi_lvl,v,"traced %lld calls, %lld waits for the "
+		   "writer\n", t->events, t->stalls);
+
+  PMPI_Barrier (gs_ptr->mpiPi.comm);
+  if (gs_ptr->mpiPi.rank == gs_ptr->mpiPi.collectorRank)
+    {
+      char **paths, name[256];
+      FILE *fp;
+      int i, converted = 0;
+
+      snprintf (name, sizeof (name), "%s/%s.%d.%d.trace.json",
+		gs_ptr->mpiPi.outputDir, gs_ptr->mpiPi.appName,
+		gs_ptr->mpiPi.size, t->procID);
+      paths = (char **) malloc (gs_ptr->mpiPi.size * sizeof (char *));
+      for (i = 0; paths != NULL && i < gs_ptr->mpiPi.size; i++)
+	{
+	  paths[i] = (char *) malloc (256);
+	  trace_file_name (paths[i], 256, t->procID, i, qmpi_lvl, v);
+	}
+      if (paths != NULL && (fp = fopen (name, "w")) != NULL)
+	{
+	  int resolve = gs_ptr->mpiPi.do_lookup && gs_ptr->mpiPi.stackDepth > 0;
+
+	  setvbuf (fp, NULL, _IOFBF, MPIP_REPORT_BUFFER_SIZE);
+	  if (resolve)
+	    mpiPi_open_lookup (qmpi_lvl, v);
+	  converted = mpiPi_trace_convert (fp, gs_ptr->mpiPi.size, paths,
+					   resolve, qmpi_lvl, v);
+	  if (resolve)
+	    mpiPi_close_lookup (qmpi_lvl, v);
+	  if (fclose (fp) != 0)
+	    converted = 0;
+	}
+      if (converted > 0)
+	mpiPi_msg (qmpi_lvl,v,"Storing mpiP trace of %d tasks in [%s].\n",
+		   converted, name);
+      else
+	mpiPi_msg_warn (qmpi_lvl,v,"Could not write trace [%s]\n", name);
+      for (i = 0; paths != NULL && i < gs_ptr->mpiPi.size; i++)
+	free (paths[i]);
+      free (paths);
+    }
+
+  trace_free (t);
+  gs_ptr->mpiPi.trace = NULL;
+  gs_ptr->mpiPi.traceRate = 0;
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
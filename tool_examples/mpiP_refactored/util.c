@@ -82,6 +82,7 @@ mpiPi_getenv (int i, vector* v)
   char *ep = NULL;
 
   gs_ptr->mpiPi.outputDir = ".";
+  gs_ptr->mpiPi.symcacheDir = NULL;
 
   ep = getenv ("MPIP");
   gs_ptr->mpiPi.envStr = (ep ? strdup (ep) : 0);
@@ -106,10 +107,18 @@ mpiPi_getenv (int i, vector* v)
 
       av[ac] = NULL;
 
-      for (; ((c = getopt (ac, av, "cdef:gk:lm:noprs:t:vx:yz")) != EOF);)
+      for (; ((c = getopt (ac, av, "a:bcdef:gh:i:jk:lm:noprs:t:u:vw:x:yz")) != EOF);)
 	{
 	  switch (c)
 	    {
+	    case 'a':
+	      mpiPi_phase_set_names (optarg, i, v);
+	      break;
+
+	    case 'b':
+	      gs_ptr->mpiPi.binaryProfile = 1;
+	      break;
+
 	    case 'f':
 	      gs_ptr->mpiPi.outputDir = optarg;
 	      if (gs_ptr->mpiPi.rank == 0)
@@ -117,12 +126,43 @@ mpiPi_getenv (int i, vector* v)
 			   gs_ptr->mpiPi.outputDir);
 	      break;
 
+	    case 'i':
+	      gs_ptr->mpiPi.symcacheDir = optarg;
+	      if (gs_ptr->mpiPi.rank == 0)
+		mpiPi_msg (i,v,"Set the symbol cache directory to [%s].\n",
+			   gs_ptr->mpiPi.symcacheDir);
+	      break;
+
 	    case 'g':
 	      mpiPi_debug = 1;
 	      if (gs_ptr->mpiPi.rank == 0)
 		mpiPi_msg (i,v,"Enabled mpiPi debug mode.\n");
 	      break;
 
+	    case 'h':
+	      {
+		int sub_bits = atoi (optarg);
+		if (sub_bits < 0 || sub_bits > 7)
+		  {
+		    if (gs_ptr->mpiPi.rank == 0)
+		      mpiPi_msg_warn
+			(i,v,"-h resolution invalid %d. Using %d.\n",
+			 sub_bits, MPIP_LATENCY_SUB_BITS);
+		    sub_bits = MPIP_LATENCY_SUB_BITS;
+		  }
+		mpiPi_latency_init (&gs_ptr->mpiPi.latency, sub_bits);
+		if (gs_ptr->mpiPi.rank == 0)
+		  {
+		    if (sub_bits == 0)
+		      mpiPi_msg (i,v,"Disabled callsite latency percentiles.\n");
+		    else
+		      mpiPi_msg
+			(i,v,"Set the latency histogram resolution to [%d] "
+			 "buckets per power of 2.\n", 1 << sub_bits);
+		  }
+	      }
+	      break;
+
 	    case 's':
 	      {
 		int defaultSize = gs_ptr->mpiPi.tableSize;
@@ -279,23 +319,57 @@ mpiPi_getenv (int i, vector* v)
 	      gs_ptr->mpiPi.disable_finalize_report = 1;
 	      break;
 
+	    case 'u':
+	      {
+		/*  full, fp, or cache[:n] to unwind every n-th hit  */
+		char *refresh = strchr (optarg, ':');
+		int len = refresh != NULL ? refresh - optarg : strlen (optarg);
+
+		if (len == 4 && strncmp (optarg, "full", 4) == 0)
+		  mpiPi_set_stack_capture (MPIP_CAPTURE_FULL, 0);
+		else if (len == 2 && strncmp (optarg, "fp", 2) == 0)
+		  mpiPi_set_stack_capture (MPIP_CAPTURE_FP, 0);
+		else if (len == 5 && strncmp (optarg, "cache", 5) == 0)
+		  mpiPi_set_stack_capture (MPIP_CAPTURE_CACHE,
+					   refresh != NULL ?
+					   atoi (refresh + 1) : 0);
+		else
+		  {
+		    if (gs_ptr->mpiPi.rank == 0)
+		      mpiPi_msg_warn
+			(i,v,"-u capture mode %s invalid. Using full.\n",
+			 optarg);
+		    mpiPi_set_stack_capture (MPIP_CAPTURE_FULL, 0);
+		    break;
+		  }
+		if (gs_ptr->mpiPi.rank == 0)
+		  mpiPi_msg (i,v,"Set the stack capture mode to [%s].\n", optarg);
+	      }
+	      break;
+
+	    case 'w':
+	      gs_ptr->mpiPi.traceRate = atoi (optarg);
+	      if (gs_ptr->mpiPi.traceRate < 0)
+		gs_ptr->mpiPi.traceRate = 0;
+	      if (gs_ptr->mpiPi.rank == 0 && gs_ptr->mpiPi.traceRate > 0)
+		mpiPi_msg (i,v,"Tracing every [%d] MPI call(s).\n",
+			   gs_ptr->mpiPi.traceRate);
+	      break;
+
 	    case 'y':
 	      gs_ptr->mpiPi.do_collective_stats_report = 1;
 	      break;
 
+	    case 'j':
+	      gs_ptr->mpiPi.do_thread_report = 1;
+	      break;
+
 	    case 'p':
 	    	 printf("First here !!!! \n");
 	      gs_ptr->mpiPi.do_pt2pt_stats_report = 1;
 	      break;
 
-	    case 'a':
-	    case 'b':
-	    case 'h':
-	    case 'i':
-	    case 'j':
 	    case 'q':
-	    case 'u':
-	    case 'w':
 	    default:
 	      if (gs_ptr->mpiPi.rank == 0)
 		mpiPi_msg_warn
@@ -0,0 +1,481 @@
+/* -*- C -*- 
+
+   mpiP MPI Profiler ( http://llnl.github.io/mpiP )
+
+   Please see COPYRIGHT AND LICENSE information at the end of this file.
+
+   ----- 
+
+   wire.c -- packed callsite records for the finalize merge
+
+   A message holds a header, the call paths its records use, and the
+   records.  Integers are LEB128 varints.  A statistic that is zero is
+   omitted, an integral one is a varint, and any other is a raw double.
+   Addresses are zigzag varint deltas from the previous one.  A latency
+   histogram follows its record as the number of buckets in use plus one
+   (0 for none) and, for each, its index as a delta from the previous
+   one and its count.  Tasks are assumed to share the byte order and
+   double format, as before.
+
+ */
+
+#ifndef lint
+static char *svnid = "$Id$";
+#endif
+
+#include <float.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpiPi.h"
+
+#define WIRE_MAGIC_0 'm'
+#define WIRE_MAGIC_1 'P'
+
+/*  How each statistic is encoded, two bits per field in a record's mask.  */
+enum
+{ WIRE_ZERO, WIRE_VARINT, WIRE_DOUBLE, WIRE_DBL_MAX };
+
+/*  The statistics that are doubles.  */
+static const size_t wire_fields[] = {
+  offsetof (callsite_stats_t, cumulativeTime),
+  offsetof (callsite_stats_t, cumulativeTimeSquared),
+  offsetof (callsite_stats_t, maxDur),
+  offsetof (callsite_stats_t, minDur),
+  offsetof (callsite_stats_t, maxDataSent),
+  offsetof (callsite_stats_t, minDataSent),
+  offsetof (callsite_stats_t, maxIO),
+  offsetof (callsite_stats_t, minIO),
+  offsetof (callsite_stats_t, maxRMA),
+  offsetof (callsite_stats_t, minRMA),
+  offsetof (callsite_stats_t, cumulativeDataSent),
+  offsetof (callsite_stats_t, cumulativeIO),
+  offsetof (callsite_stats_t, cumulativeRMA),
+  offsetof (callsite_stats_t, siteMean),
+  offsetof (callsite_stats_t, siteM2)
+};
+
+#define WIRE_FIELDS (sizeof (wire_fields) / sizeof (wire_fields[0]))
+#define WIRE_FIELD(p, f) ((double *) ((char *) (p) + wire_fields[f]))
+
+typedef struct
+{
+  unsigned char *buf;
+  size_t len, cap;
+} wire_out_t;
+
+static int
+wire_reserve (wire_out_t * w, size_t n)
+{
+  if (w->len + n > w->cap)
+    {
+      size_t cap = w->cap == 0 ? 4096 : w->cap;
+      unsigned char *buf;
+      while (cap < w->len + n)
+	cap *= 2;
+      buf = (unsigned char *) realloc (w->buf, cap);
+      if (buf == NULL)
+	return 0;
+      w->buf = buf;
+      w->cap = cap;
+    }
+  return 1;
+}
+
+static int
+wire_put_varint (wire_out_t * w, unsigned long long x)
+{
+  if (!wire_reserve (w, 10))
+    return 0;
+  while (x >= 0x80)
+    {
+      w->buf[w->len++] = (unsigned char) (x | 0x80);
+      x >>= 7;
+    }
+  w->buf[w->len++] = (unsigned char) x;
+  return 1;
+}
+
+static int
+wire_put_double (wire_out_t * w, double d)
+{
+  if (!wire_reserve (w, sizeof (double)))
+    return 0;
+  memcpy (&w->buf[w->len], &d, sizeof (double));
+  w->len += sizeof (double);
+  return 1;
+}
+
+static int
+wire_put_pc (wire_out_t * w, void *pc, unsigned long long *prev)
+{
+  unsigned long long x = (unsigned long long) (size_t) pc;
+  long long delta = (long long) (x - *prev);
+
+  *prev = x;
+  return wire_put_varint (w, ((unsigned long long) delta << 1) ^ (delta >> 63));
+}
+
+static int
+wire_kind (double d)
+{
+  if (d == 0)
+    return WIRE_ZERO;
+  if (d == DBL_MAX)
+    return WIRE_DBL_MAX;
+  if (d > 0 && d < 9.0e15 && d == (double) (unsigned long long) d)
+    return WIRE_VARINT;
+  return WIRE_DOUBLE;
+}
+
+/*  Packs records av[0..ac), the call paths they use and, unless lt is
+    NULL, their latency histograms into a new buffer *buf.  Returns its
+    length, or -1 if memory ran out.  */
+int
+mpiPi_wire_pack (callsite_stats_t ** av, int ac, mpiPi_callpaths_t * cp,
+		 mpiPi_latency_t * lt, char **buf)
+{
+  wire_out_t w = { NULL, 0, 0 };
+  int *wire_id = NULL, *paths = NULL;
+  int i, j, npaths = 0, buckets = lt != NULL ? lt->buckets : 0;
+  size_t f;
+  unsigned long long prev = 0;
+
+  wire_id = (int *) malloc (cp->count * sizeof (int) + 1);
+  paths = (int *) malloc (cp->count * sizeof (int) + 1);
+  if (wire_id == NULL || paths == NULL)
+    goto fail;
+  for (i = 0; i < cp->count; i++)
+    wire_id[i] = -1;
+  for (i = 0; i < ac; i++)
+    if (wire_id[av[i]->path] < 0)
+      {
+	wire_id[av[i]->path] = npaths;
+	paths[npaths++] = av[i]->path;
+      }
+
+  if (!wire_reserve (&w, 3))
+    goto fail;
+  w.buf[w.len++] = WIRE_MAGIC_0;
+  w.buf[w.len++] = WIRE_MAGIC_1;
+  w.buf[w.len++] = MPIP_WIRE_VERSION;
+  if (!wire_put_varint (&w, cp->depth) || !wire_put_varint (&w, buckets)
+      || !wire_put_varint (&w, npaths) || !wire_put_varint (&w, ac))
+    goto fail;
+
+  for (i = 0; i < npaths; i++)
+    {
+      void **pc = mpiPi_callpath_pcs (cp, paths[i]);
+      for (j = 0; j < cp->depth; j++)
+	if (!wire_put_pc (&w, pc[j], &prev))
+	  goto fail;
+    }
+
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t *p = av[i];
+      unsigned long long mask = 0;
+
+      for (f = 0; f < WIRE_FIELDS; f++)
+	mask |= (unsigned long long) wire_kind (*WIRE_FIELD (p, f)) << (2 * f);
+
+      /*  rank -1 marks records merged across tasks  */
+      if (!wire_put_varint (&w, p->op)
+	  || !wire_put_varint (&w, (unsigned) (p->rank + 1))
+	  || !wire_put_varint (&w, wire_id[p->path])
+	  || !wire_put_varint (&w, p->phase)
+	  || !wire_put_varint (&w, p->count)
+	  || !wire_put_varint (&w, p->arbitraryMessageCount)
+	  || !wire_put_varint (&w, p->siteCount)
+	  || !wire_put_varint (&w, mask))
+	goto fail;
+
+      for (f = 0; f < WIRE_FIELDS; f++)
+	{
+	  double d = *WIRE_FIELD (p, f);
+	  int ok = 1;
+
+	  switch ((mask >> (2 * f)) & 3)
+	    {
+	    case WIRE_VARINT:
+	      ok = wire_put_varint (&w, (unsigned long long) d);
+	      break;
+	    case WIRE_DOUBLE:
+	      ok = wire_put_double (&w, d);
+	      break;
+	    }
+	  if (!ok)
+	    goto fail;
+	}
+
+      if (buckets > 0 && p->lat > 0)
+	{
+	  long long *c = mpiPi_latency_counts (lt, p->lat);
+	  int used = 0, last = 0;
+
+	  for (j = 0; j < buckets; j++)
+	    used += c[j] != 0;
+	  if (!wire_put_varint (&w, used + 1))
+	    goto fail;
+	  for (j = 0; j < buckets; j++)
+	    if (c[j] != 0)
+	      {
+		if (!wire_put_varint (&w, j - last)
+		    || !wire_put_varint (&w, c[j]))
+		  goto fail;
+		last = j;
+	      }
+	}
+      else if (!wire_put_varint (&w, 0))
+	goto fail;
+    }
+
+  free (wire_id);
+  free (paths);
+  *buf = (char *) w.buf;
+  return (int) w.len;
+
+fail:
+  free (wire_id);
+  free (paths);
+  free (w.buf);
+  return -1;
+}
+
+typedef struct
+{
+  const unsigned char *buf;
+  size_t len, pos;
+  int bad;
+} wire_in_t;
+
+static unsigned long long
+wire_get_varint (wire_in_t * r)
+{
+  unsigned long long x = 0;
+  int shift = 0;
+
+  while (r->pos < r->len && shift < 64)
+    {
+      unsigned char b = r->buf[r->pos++];
+      x |= (unsigned long long) (b & 0x7f) << shift;
+      if ((b & 0x80) == 0)
+	return x;
+      shift += 7;
+    }
+  r->bad = 1;
+  return 0;
+}
+
+static double
+wire_get_double (wire_in_t * r)
+{
+  double d = 0;
+
+  if (r->pos + sizeof (double) > r->len)
+    r->bad = 1;
+  else
+    {
+      memcpy (&d, &r->buf[r->pos], sizeof (double));
+      r->pos += sizeof (double);
+    }
+  return d;
+}
+
+/*  Unpacks a buffer made by mpiPi_wire_pack into a new array *av of
+    records whose paths are interned in cp and, unless lt is NULL, whose
+    latency histograms are added to lt.  Returns the number of records,
+    or -1 if the buffer is malformed, of another version, depth or
+    histogram resolution, or memory ran out.  */
+int
+mpiPi_wire_unpack (const char *buf, int len, mpiPi_callpaths_t * cp,
+		   mpiPi_latency_t * lt, callsite_stats_t ** av)
+{
+  wire_in_t r = { (const unsigned char *) buf, (size_t) len, 3, 0 };
+  void *pc[MPIP_CALLSITE_STACK_DEPTH_MAX + 1];
+  unsigned long long prev = 0, buckets, npaths, ac;
+  callsite_stats_t *recs = NULL;
+  int *local_id = NULL;
+  unsigned long long i;
+  int j;
+  size_t f;
+
+  *av = NULL;
+  if (len < 3 || r.buf[0] != WIRE_MAGIC_0 || r.buf[1] != WIRE_MAGIC_1
+      || r.buf[2] != MPIP_WIRE_VERSION
+      || wire_get_varint (&r) != (unsigned long long) cp->depth)
+    return -1;
+  buckets = wire_get_varint (&r);
+  if (buckets != 0 && lt != NULL
+      && buckets != (unsigned long long) lt->buckets)
+    return -1;
+  npaths = wire_get_varint (&r);
+  ac = wire_get_varint (&r);
+  /*  every path takes a byte per address and every record at least eight  */
+  if (r.bad || npaths * cp->depth > r.len || ac * 8 > r.len)
+    return -1;
+
+  local_id = (int *) malloc (npaths * sizeof (int) + 1);
+  recs = (callsite_stats_t *) calloc (ac + 1, sizeof (callsite_stats_t));
+  if (local_id == NULL || recs == NULL)
+    goto fail;
+
+  for (i = 0; i < npaths; i++)
+    {
+      for (j = 0; j < cp->depth; j++)
+	{
+	  unsigned long long z = wire_get_varint (&r);
+	  prev += (unsigned long long) ((long long) (z >> 1) ^ -(long long) (z & 1));
+	  pc[j] = (void *) (size_t) prev;
+	}
+      local_id[i] = mpiPi_callpath_intern (cp, pc);
+      if (r.bad || local_id[i] < 0)
+	goto fail;
+    }
+
+  for (i = 0; i < ac; i++)
+    {
+      callsite_stats_t *p = &recs[i];
+      unsigned long long path, phase, mask;
+
+      p->op = (unsigned) wire_get_varint (&r);
+      p->rank = (unsigned) wire_get_varint (&r) - 1;
+      path = wire_get_varint (&r);
+      phase = wire_get_varint (&r);
+      p->count = (long long) wire_get_varint (&r);
+      p->arbitraryMessageCount = (long long) wire_get_varint (&r);
+      p->siteCount = (long long) wire_get_varint (&r);
+      mask = wire_get_varint (&r);
+      if (r.bad || path >= npaths || phase >= MPIP_PHASES_MAX)
+	goto fail;
+      p->path = local_id[path];
+      p->phase = (int) phase;
+      p->cookie = MPIP_CALLSITE_STATS_COOKIE;
+
+      for (f = 0; f < WIRE_FIELDS; f++)
+	{
+	  double *d = WIRE_FIELD (p, f);
+	  switch ((mask >> (2 * f)) & 3)
+	    {
+	    case WIRE_VARINT:
+	      *d = (double) wire_get_varint (&r);
+	      break;
+	    case WIRE_DOUBLE:
+	      *d = wire_get_double (&r);
+	      break;
+	    case WIRE_DBL_MAX:
+	      *d = DBL_MAX;
+	      break;
+	    }
+	}
+
+      /*  histograms are dropped if lt is NULL  */
+      {
+	unsigned long long used = wire_get_varint (&r), k, b = 0;
+	long long *c = NULL;
+
+	if (used > 0 && lt != NULL)
+	  {
+	    p->lat = mpiPi_latency_new (lt);
+	    if (p->lat < 0)
+	      goto fail;
+	    if (p->lat > 0)
+	      c = mpiPi_latency_counts (lt, p->lat);
+	  }
+	for (k = 1; k < used && !r.bad; k++)
+	  {
+	    b += wire_get_varint (&r);
+	    if (b >= buckets)
+	      goto fail;
+	    if (c != NULL)
+	      c[b] = (long long) wire_get_varint (&r);
+	    else
+	      wire_get_varint (&r);
+	  }
+      }
+      if (r.bad)
+	goto fail;
+    }
+
+  free (local_id);
+  *av = recs;
+  return (int) ac;
+
+fail:
+  free (local_id);
+  free (recs);
+  return -1;
+}
+
+/* 
+
+<license>
+
+Copyright (c) 2006, The Regents of the University of California. 
+Produced at the Lawrence Livermore National Laboratory 
+Written by Jeffery Vetter and Christopher Chambreau. 
+UCRL-CODE-223450. 
+All rights reserved. 
+ 
+This file is part of mpiP.  For details, see http://llnl.github.io/mpiP. 
+ 
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+ 
+* Redistributions of source code must retain the above copyright
+notice, this list of conditions and the disclaimer below.
+
+* Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the disclaimer (as noted below) in
+the documentation and/or other materials provided with the
+distribution.
+
+* Neither the name of the UC/LLNL nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OF
+THE UNIVERSITY OF CALIFORNIA, THE U.S. DEPARTMENT OF ENERGY OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ 
+Additional BSD Notice 
+ 
+1. This notice is required to be provided under our contract with the
+U.S. Department of Energy (DOE).  This work was produced at the
+University of California, Lawrence Livermore National Laboratory under
+Contract No. W-7405-ENG-48 with the DOE.
+ 
+2. Neither the United States Government nor the University of
+California nor any of their employees, makes any warranty, express or
+implied, or assumes any liability or responsibility for the accuracy,
+completeness, or usefulness of any information, apparatus, product, or
+process disclosed, or represents that its use would not infringe
+privately-owned rights.
+ 
+3.  Also, reference herein to any specific commercial products,
+process, or services by trade name, trademark, manufacturer or
+otherwise does not necessarily constitute or imply its endorsement,
+recommendation, or favoring by the United States Government or the
+University of California.  The views and opinions of authors expressed
+herein do not necessarily state or reflect those of the United States
+Government or the University of California, and shall not be used for
+advertising or product endorsement purposes.
+
+</license>
+
+*/
+
+
+/* eof */
@@ -33,21 +33,19 @@ static int mpiPif_MPI_Accumulate( jmp_buf * base_jbuf, mpip_const_void_t  *origi
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Accumulate( origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win);
 void* f=NULL;
 QMPI_Table_query( 1, &f, (*vector_get(v,i)).table);
 exec_func(f,i,1,v,origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -59,6 +57,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Accumulate");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Accumulate, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Accumulate, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -113,22 +113,20 @@ static int mpiPif_MPI_Allgather( jmp_buf * base_jbuf, mpip_const_void_t  *sendbu
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Allgather( sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * comm);
 printf("In MPIP Allgather \n");
 void* f=NULL;
 QMPI_Table_query( 6, &f, (*vector_get(v,i)).table);
 exec_func(f,i,6,v, sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -143,6 +141,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Allgather, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Allgather, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Allgather, dur, (double)messSize, comm,i,v); }
 }
 
@@ -197,21 +197,19 @@ static int mpiPif_MPI_Allgatherv( jmp_buf * base_jbuf, mpip_const_void_t  *sendb
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Allgatherv( sendbuf,  * sendcount,  * sendtype, recvbuf, recvcounts, displs,  * recvtype,  * comm);
 void* f=NULL;
 QMPI_Table_query( 7, &f, (*vector_get(v,i)).table);
 exec_func(f,i,7,v,sendbuf,  * sendcount,  * sendtype, recvbuf, recvcounts, displs,  * recvtype,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -226,6 +224,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Allgatherv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Allgatherv, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Allgatherv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -281,21 +281,19 @@ static int mpiPif_MPI_Allreduce( jmp_buf * base_jbuf, mpip_const_void_t  *sendbu
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Allreduce( sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm);
 void* f=NULL;
 QMPI_Table_query( 9, &f, (*vector_get(v,i)).table);
 exec_func(f,i,9,v,sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -310,6 +308,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Allreduce, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Allreduce, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Allreduce, dur, (double)messSize, comm,i,v); }
 }
 
@@ -365,21 +365,19 @@ static int mpiPif_MPI_Alltoall( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Alltoall( sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcnt,  * recvtype,  * comm);
 void* f=NULL;
 QMPI_Table_query( 10, &f, (*vector_get(v,i)).table);
 exec_func(f,i,10,v, sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcnt,  * recvtype,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -394,6 +392,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Alltoall, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Alltoall, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Alltoall, dur, (double)messSize, comm,i,v); }
 }
 
@@ -449,21 +449,19 @@ static int mpiPif_MPI_Alltoallv( jmp_buf * base_jbuf, mpip_const_void_t  *sendbu
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Alltoallv( sendbuf, sendcnts, sdispls,  * sendtype, recvbuf, recvcnts, rdispls,  * recvtype,  * comm);
 void* f=NULL;
 QMPI_Table_query( 11, &f, (*vector_get(v,i)).table);
 exec_func(f,i,11,v,sendbuf, sendcnts, sdispls,  * sendtype, recvbuf, recvcnts, rdispls,  * recvtype,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -473,6 +471,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Alltoallv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Alltoallv, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Alltoallv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -527,21 +527,19 @@ static int mpiPif_MPI_Attr_delete( jmp_buf * base_jbuf, MPI_Comm  * comm, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Attr_delete(  * comm,  * keyval);
 void* f=NULL;
 QMPI_Table_query( 13, &f, (*vector_get(v,i)).table);
 exec_func(f,i,13,v,* comm,  * keyval);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -550,6 +548,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Attr_delete");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Attr_delete, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Attr_delete, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -599,21 +599,19 @@ static int mpiPif_MPI_Attr_get( jmp_buf * base_jbuf, MPI_Comm  * comm, int  * ke
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Attr_get(  * comm,  * keyval, attr_value, flag);
 void* f=NULL;
 QMPI_Table_query( 14, &f, (*vector_get(v,i)).table);
 exec_func(f,i,14,v, * comm,  * keyval, attr_value, flag);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -622,6 +620,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Attr_get");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Attr_get, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Attr_get, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -671,21 +671,19 @@ static int mpiPif_MPI_Attr_put( jmp_buf * base_jbuf, MPI_Comm  * comm, int  * ke
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Attr_put(  * comm,  * keyval, attr_value);
 void* f=NULL;
 QMPI_Table_query( 15, &f, (*vector_get(v,i)).table);
 exec_func(f,i,15,v, * comm,  * keyval, attr_value);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -694,6 +692,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Attr_put");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Attr_put, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Attr_put, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -744,21 +744,19 @@ static int mpiPif_MPI_Barrier( jmp_buf * base_jbuf, MPI_Comm  * comm,int i, vect
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Barrier(  * comm);
 void* f=NULL;
 QMPI_Table_query( 16, &f, (*vector_get(v,i)).table);
 exec_func(f,i,16,v, * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -768,6 +766,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Barrier, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Barrier, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Barrier, dur, (double)messSize, comm,i,v); }
 }
 
@@ -818,21 +818,19 @@ static int mpiPif_MPI_Bcast( jmp_buf * base_jbuf, void  *buffer, int  * count, M
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Bcast( buffer,  * count,  * datatype,  * root,  * comm);
 void* f=NULL;
 QMPI_Table_query( 17, &f, (*vector_get(v,i)).table);
 exec_func(f,i,17,v,buffer,  * count,  * datatype,  * root,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -847,6 +845,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Bcast, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Bcast, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Bcast, dur, (double)messSize, comm,i,v); }
 }
 
@@ -899,21 +899,19 @@ static int mpiPif_MPI_Bsend( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Bsend( buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 void* f=NULL;
 QMPI_Table_query( 18, &f, (*vector_get(v,i)).table);
 exec_func(f,i,18,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -928,6 +926,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Bsend, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Bsend, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Bsend, dur, (double)messSize, comm,i,v); }
 }
 
@@ -980,21 +980,19 @@ static int mpiPif_MPI_Bsend_init( jmp_buf * base_jbuf, mpip_const_void_t  *buf,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Bsend_init( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 19, &f, (*vector_get(v,i)).table);
 exec_func(f,i,19,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1003,6 +1001,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Bsend_init");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Bsend_init, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Bsend_init, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1058,21 +1058,19 @@ static int mpiPif_MPI_Buffer_attach( jmp_buf * base_jbuf, void  *buffer, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Buffer_attach( buffer,  * size);
 void* f=NULL;
 QMPI_Table_query( 20, &f, (*vector_get(v,i)).table);
 exec_func(f,i,20,v,buffer,  * size);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1081,6 +1079,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Buffer_attach");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Buffer_attach, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Buffer_attach, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1128,21 +1128,19 @@ static int mpiPif_MPI_Buffer_detach( jmp_buf * base_jbuf, void  *bufferptr, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Buffer_detach( bufferptr, size);
 void* f=NULL;
 QMPI_Table_query( 21, &f, (*vector_get(v,i)).table);
 exec_func(f,i,21,v,bufferptr, size);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1151,6 +1149,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Buffer_detach");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Buffer_detach, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Buffer_detach, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1198,21 +1198,19 @@ static int mpiPif_MPI_Cancel( jmp_buf * base_jbuf, MPI_Request  *request,int i,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cancel( request);
 void* f=NULL;
 QMPI_Table_query( 22, &f, (*vector_get(v,i)).table);
 exec_func(f,i,22,v,request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1221,6 +1219,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cancel");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cancel, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cancel, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1270,21 +1270,19 @@ static int mpiPif_MPI_Cart_coords( jmp_buf * base_jbuf, MPI_Comm  * comm, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cart_coords(  * comm,  * rank,  * maxdims, coords);
 void* f=NULL;
 QMPI_Table_query( 23, &f, (*vector_get(v,i)).table);
 exec_func(f,i,23,v,* comm,  * rank,  * maxdims, coords);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1293,6 +1291,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cart_coords");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cart_coords, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cart_coords, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1342,21 +1342,19 @@ static int mpiPif_MPI_Cart_create( jmp_buf * base_jbuf, MPI_Comm  * comm_old, in
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cart_create(  * comm_old,  * ndims, dims, periods,  * reorder, comm_cart);
 void* f=NULL;
 QMPI_Table_query( 24, &f, (*vector_get(v,i)).table);
 exec_func(f,i,24,v, * comm_old,  * ndims, dims, periods,  * reorder, comm_cart);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1365,6 +1363,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cart_create");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cart_create, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cart_create, &start, &end, call_stack, comm_old, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1418,21 +1418,19 @@ static int mpiPif_MPI_Cart_get( jmp_buf * base_jbuf, MPI_Comm  * comm, int  * ma
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cart_get(  * comm,  * maxdims, dims, periods, coords);
 void* f=NULL;
 QMPI_Table_query( 25, &f, (*vector_get(v,i)).table);
 exec_func(f,i,25,v,* comm,  * maxdims, dims, periods, coords);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1441,6 +1439,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cart_get");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cart_get, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cart_get, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1490,21 +1490,19 @@ static int mpiPif_MPI_Cart_map( jmp_buf * base_jbuf, MPI_Comm  * comm_old, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cart_map(  * comm_old,  * ndims, dims, periods, newrank);
 void* f=NULL;
 QMPI_Table_query( 26, &f, (*vector_get(v,i)).table);
 exec_func(f,i,26,v, * comm_old,  * ndims, dims, periods, newrank);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1513,6 +1511,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cart_map");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cart_map, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cart_map, &start, &end, call_stack, comm_old, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1562,21 +1562,19 @@ static int mpiPif_MPI_Cart_rank( jmp_buf * base_jbuf, MPI_Comm  * comm, mpip_con
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cart_rank(  * comm, coords, rank);
 void* f=NULL;
 QMPI_Table_query( 27, &f, (*vector_get(v,i)).table);
 exec_func(f,i,27,v,* comm, coords, rank);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1585,6 +1583,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cart_rank");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cart_rank, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cart_rank, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1634,21 +1634,19 @@ static int mpiPif_MPI_Cart_shift( jmp_buf * base_jbuf, MPI_Comm  * comm, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cart_shift(  * comm,  * direction,  * displ, source, dest);
 void* f=NULL;
 QMPI_Table_query( 28, &f, (*vector_get(v,i)).table);
 exec_func(f,i,28,v,* comm,  * direction,  * displ, source, dest);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1657,6 +1655,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cart_shift");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cart_shift, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cart_shift, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1706,21 +1706,19 @@ static int mpiPif_MPI_Cart_sub( jmp_buf * base_jbuf, MPI_Comm  * comm, mpip_cons
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cart_sub(  * comm, remain_dims, comm_new);
 void* f=NULL;
 QMPI_Table_query( 29, &f, (*vector_get(v,i)).table);
 exec_func(f,i,29,v, * comm, remain_dims, comm_new);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1729,6 +1727,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cart_sub");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cart_sub, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cart_sub, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1782,21 +1782,19 @@ static int mpiPif_MPI_Cartdim_get( jmp_buf * base_jbuf, MPI_Comm  * comm, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Cartdim_get(  * comm, ndims);
 void* f=NULL;
 QMPI_Table_query( 30, &f, (*vector_get(v,i)).table);
 exec_func(f,i,30,v,* comm, ndims);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1805,6 +1803,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Cartdim_get");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Cartdim_get, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Cartdim_get, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1854,21 +1854,19 @@ static int mpiPif_MPI_Comm_create( jmp_buf * base_jbuf, MPI_Comm  * comm, MPI_Gr
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_create(  * comm,  * group, comm_out);
 void* f=NULL;
 QMPI_Table_query( 36, &f, (*vector_get(v,i)).table);
 exec_func(f,i,36,v, * comm,  * group, comm_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1877,6 +1875,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_create");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_create, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_create, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -1932,21 +1932,19 @@ static int mpiPif_MPI_Comm_dup( jmp_buf * base_jbuf, MPI_Comm  * comm, MPI_Comm
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_dup(  * comm, comm_out);
 void* f=NULL;
 QMPI_Table_query( 42, &f, (*vector_get(v,i)).table);
 exec_func(f,i,42,v, * comm, comm_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -1955,6 +1953,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_dup");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_dup, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_dup, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2008,21 +2008,19 @@ static int mpiPif_MPI_Comm_free( jmp_buf * base_jbuf, MPI_Comm  *commp,int i, ve
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_free( commp);
 void* f=NULL;
 QMPI_Table_query( 44, &f, (*vector_get(v,i)).table);
 exec_func(f,i,44,v,commp);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2031,6 +2029,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_free");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_free, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_free, &start, &end, call_stack, commp, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2083,21 +2083,19 @@ static int mpiPif_MPI_Comm_group( jmp_buf * base_jbuf, MPI_Comm  * comm, MPI_Gro
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_group(  * comm, group);
 void* f=NULL;
 QMPI_Table_query( 51, &f, (*vector_get(v,i)).table);
 exec_func(f,i,51,v,* comm, group);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2106,6 +2104,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_group");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_group, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_group, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2159,21 +2159,19 @@ static int mpiPif_MPI_Comm_remote_group( jmp_buf * base_jbuf, MPI_Comm  * comm,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_remote_group(  * comm, group);
 void* f=NULL;
 QMPI_Table_query( 55, &f, (*vector_get(v,i)).table);
 exec_func(f,i,55,v,* comm, group);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2182,6 +2180,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_remote_group");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_remote_group, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_remote_group, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2235,21 +2235,19 @@ static int mpiPif_MPI_Comm_remote_size( jmp_buf * base_jbuf, MPI_Comm  * comm, i
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_remote_size(  * comm, size);
 void* f=NULL;
 QMPI_Table_query( 56, &f, (*vector_get(v,i)).table);
 exec_func(f,i,56,v, * comm, size);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2258,6 +2256,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_remote_size");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_remote_size, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_remote_size, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2307,21 +2307,19 @@ static int mpiPif_MPI_Comm_split( jmp_buf * base_jbuf, MPI_Comm  * comm, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_split(  * comm,  * color,  * key, comm_out);
 void* f=NULL;
 QMPI_Table_query( 62, &f, (*vector_get(v,i)).table);
 exec_func(f,i,62,v, * comm,  * color,  * key, comm_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2330,6 +2328,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_split");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_split, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_split, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2383,21 +2383,19 @@ static int mpiPif_MPI_Comm_test_inter( jmp_buf * base_jbuf, MPI_Comm  * comm, in
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Comm_test_inter(  * comm, flag);
 void* f=NULL;
 QMPI_Table_query( 64, &f, (*vector_get(v,i)).table);
 exec_func(f,i,64,v,* comm, flag);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2406,6 +2404,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Comm_test_inter");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Comm_test_inter, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Comm_test_inter, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2455,21 +2455,19 @@ static int mpiPif_MPI_Compare_and_swap( jmp_buf * base_jbuf, mpip_const_void_t
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Compare_and_swap( origin_addr, compare_addr, result_addr,  * datatype,  * target_rank,  * target_disp,  * win);
 void* f=NULL;
 QMPI_Table_query( 65, &f, (*vector_get(v,i)).table);
 exec_func(f,i,65,v, origin_addr, compare_addr, result_addr,  * datatype,  * target_rank,  * target_disp,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2478,6 +2476,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Compare_and_swap");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Compare_and_swap, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Compare_and_swap, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2527,21 +2527,19 @@ static int mpiPif_MPI_Dims_create( jmp_buf * base_jbuf, int  * nnodes, int  * nd
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Dims_create(  * nnodes,  * ndims, dims);
 void* f=NULL;
 QMPI_Table_query( 66, &f, (*vector_get(v,i)).table);
 exec_func(f,i,66,v,* nnodes,  * ndims, dims);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2550,6 +2548,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Dims_create");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Dims_create, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Dims_create, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2597,21 +2597,19 @@ static int mpiPif_MPI_Error_class( jmp_buf * base_jbuf, int  * errorcode, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Error_class(  * errorcode, errorclass);
 void* f=NULL;
 QMPI_Table_query( 75, &f, (*vector_get(v,i)).table);
 exec_func(f,i,75,v, * errorcode, errorclass);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2620,6 +2618,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Error_class");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Error_class, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Error_class, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2667,21 +2667,19 @@ static int mpiPif_MPI_Fetch_and_op( jmp_buf * base_jbuf, mpip_const_void_t  *ori
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Fetch_and_op( origin_addr, result_addr,  * datatype,  * target_rank,  * target_disp,  * op,  * win);
 void* f=NULL;
 QMPI_Table_query( 78, &f, (*vector_get(v,i)).table);
 exec_func(f,i,78,v,origin_addr, result_addr,  * datatype,  * target_rank,  * target_disp,  * op,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2690,6 +2688,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Fetch_and_op");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Fetch_and_op, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Fetch_and_op, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2741,21 +2741,19 @@ static int mpiPif_MPI_File_close( jmp_buf * base_jbuf, MPI_File  *fh,int i, vect
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_close( fh);
 void* f=NULL;
 QMPI_Table_query( 80, &f, (*vector_get(v,i)).table);
 exec_func(f,i,80,v, fh);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2764,6 +2762,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_close");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_close, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_close, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2816,21 +2816,19 @@ static int mpiPif_MPI_File_open( jmp_buf * base_jbuf, MPI_Comm  * comm, mpip_con
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_open(  * comm, filename,  * amode,  * info, fh);
 void* f=NULL;
 QMPI_Table_query( 104, &f, (*vector_get(v,i)).table);
 exec_func(f,i,104,v,* comm, filename,  * amode,  * info, fh);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2839,6 +2837,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_open");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_open, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_open, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2894,21 +2894,19 @@ static int mpiPif_MPI_File_preallocate( jmp_buf * base_jbuf, MPI_File  * fh, MPI
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_preallocate(  * fh,  * size);
 void* f=NULL;
 QMPI_Table_query(105, &f, (*vector_get(v,i)).table);
 exec_func(f,i,105,v,* fh,  * size);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2917,6 +2915,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_preallocate");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_preallocate, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_preallocate, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -2966,21 +2966,19 @@ static int mpiPif_MPI_File_read( jmp_buf * base_jbuf, MPI_File  * fh, void  *buf
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_read(  * fh, buf,  * count,  * datatype, status);
 void* f=NULL;
 QMPI_Table_query( 106, &f, (*vector_get(v,i)).table);
 exec_func(f,i,106,v,* fh, buf,  * count,  * datatype, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -2992,6 +2990,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_read");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_read, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_read, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3043,21 +3043,19 @@ static int mpiPif_MPI_File_read_all( jmp_buf * base_jbuf, MPI_File  * fh, void
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_read_all(  * fh, buf,  * count,  * datatype, status);
 void* f=NULL;
 QMPI_Table_query( 107, &f, (*vector_get(v,i)).table);
 exec_func(f,i,107,v,* fh, buf,  * count,  * datatype, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3069,6 +3067,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_read_all");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_read_all, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_read_all, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3120,21 +3120,19 @@ static int mpiPif_MPI_File_read_at( jmp_buf * base_jbuf, MPI_File  * fh, MPI_Off
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_read_at(  * fh,  * offset, buf,  * count,  * datatype, status);
 void* f=NULL;
 QMPI_Table_query( 110, &f, (*vector_get(v,i)).table);
 exec_func(f,i,110,v,* fh,  * offset, buf,  * count,  * datatype, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3146,6 +3144,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_read_at");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_read_at, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_read_at, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3197,21 +3197,19 @@ static int mpiPif_MPI_File_seek( jmp_buf * base_jbuf, MPI_File  * fh, MPI_Offset
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_seek(  * fh,  * offset,  * whence);
 void* f=NULL;
 QMPI_Table_query( 118, &f, (*vector_get(v,i)).table);
 exec_func(f,i,118,v,* fh,  * offset,  * whence);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3220,6 +3218,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_seek");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_seek, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_seek, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3269,21 +3269,19 @@ static int mpiPif_MPI_File_set_view( jmp_buf * base_jbuf, MPI_File  * fh, MPI_Of
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_set_view(  * fh,  * disp,  * etype,  * filetype, datarep,  * info);
 void* f=NULL;
 QMPI_Table_query( 124, &f, (*vector_get(v,i)).table);
 exec_func(f,i,124,v,* fh,  * disp,  * etype,  * filetype, datarep,  * info);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3292,6 +3290,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_set_view");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_set_view, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_set_view, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3347,21 +3347,19 @@ static int mpiPif_MPI_File_write( jmp_buf * base_jbuf, MPI_File  * fh, mpip_cons
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_write(  * fh, buf,  * count,  * datatype, status);
 void* f=NULL;
 QMPI_Table_query( 126, &f, (*vector_get(v,i)).table);
 exec_func(f,i,126,v,* fh, buf,  * count,  * datatype, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3373,6 +3371,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_write");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_write, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_write, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3424,21 +3424,19 @@ static int mpiPif_MPI_File_write_all( jmp_buf * base_jbuf, MPI_File  * fh, mpip_
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_write_all(  * fh, buf,  * count,  * datatype, status);
 void* f=NULL;
 QMPI_Table_query( 127, &f, (*vector_get(v,i)).table);
 exec_func(f,i,127,v,* fh, buf,  * count,  * datatype, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3450,6 +3448,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_write_all");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_write_all, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_write_all, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3501,21 +3501,19 @@ static int mpiPif_MPI_File_write_at( jmp_buf * base_jbuf, MPI_File  * fh, MPI_Of
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_File_write_at(  * fh,  * offset, buf,  * count,  * datatype, status);
 void* f=NULL;
 QMPI_Table_query( 130, &f, (*vector_get(v,i)).table);
 exec_func(f,i,130,v,* fh,  * offset, buf,  * count,  * datatype, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3527,6 +3525,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_File_write_at");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_File_write_at, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_File_write_at, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3578,21 +3578,19 @@ static int mpiPif_MPI_Gather( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Gather( sendbuf,  * sendcnt,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm);
 void* f=NULL;
 QMPI_Table_query( 141, &f, (*vector_get(v,i)).table);
 exec_func(f,i,141,v, sendbuf,  * sendcnt,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3607,6 +3605,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Gather, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Gather, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Gather, dur, (double)messSize, comm,i,v); }
 }
 
@@ -3661,21 +3661,19 @@ static int mpiPif_MPI_Gatherv( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Gatherv( sendbuf,  * sendcnt,  * sendtype, recvbuf, recvcnts, displs,  * recvtype,  * root,  * comm);
 void* f=NULL;
 QMPI_Table_query( 142, &f, (*vector_get(v,i)).table);
 exec_func(f,i,142,v,sendbuf,  * sendcnt,  * sendtype, recvbuf, recvcnts, displs,  * recvtype,  * root,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3690,6 +3688,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Gatherv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Gatherv, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Gatherv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -3744,21 +3744,19 @@ static int mpiPif_MPI_Get( jmp_buf * base_jbuf, void  *origin_addr, int  * origi
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Get( origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win);
 void* f=NULL;
 QMPI_Table_query( 143, &f, (*vector_get(v,i)).table);
 exec_func(f,i,143,v,origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3767,6 +3765,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Get");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Get, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Get, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3818,21 +3818,19 @@ static int mpiPif_MPI_Get_accumulate( jmp_buf * base_jbuf, mpip_const_void_t  *o
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Get_accumulate( origin_addr,  * origin_count,  * origin_datatype, result_addr,  * result_count,  * result_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win);
 void* f=NULL;
 QMPI_Table_query( 144, &f, (*vector_get(v,i)).table);
 exec_func(f,i,144,v, origin_addr,  * origin_count,  * origin_datatype, result_addr,  * result_count,  * result_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3844,6 +3842,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Get_accumulate");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Get_accumulate, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Get_accumulate, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3899,21 +3899,19 @@ static int mpiPif_MPI_Graph_create( jmp_buf * base_jbuf, MPI_Comm  * comm_old, i
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Graph_create(  * comm_old,  * nnodes, index, edges,  * reorder, comm_graph);
 void* f=NULL;
 QMPI_Table_query( 152, &f, (*vector_get(v,i)).table);
 exec_func(f,i,152,v,* comm_old,  * nnodes, index, edges,  * reorder, comm_graph);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3922,6 +3920,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Graph_create");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Graph_create, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Graph_create, &start, &end, call_stack, comm_old, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -3975,21 +3975,19 @@ static int mpiPif_MPI_Graph_get( jmp_buf * base_jbuf, MPI_Comm  * comm, int  * m
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Graph_get(  * comm,  * maxindex,  * maxedges, index, edges);
 void* f=NULL;
 QMPI_Table_query( 153, &f, (*vector_get(v,i)).table);
 exec_func(f,i,153,v,* comm,  * maxindex,  * maxedges, index, edges);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -3998,6 +3996,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Graph_get");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Graph_get, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Graph_get, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4047,21 +4047,19 @@ static int mpiPif_MPI_Graph_map( jmp_buf * base_jbuf, MPI_Comm  * comm_old, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Graph_map(  * comm_old,  * nnodes, index, edges, newrank);
 void* f=NULL;
 QMPI_Table_query( 154, &f, (*vector_get(v,i)).table);
 exec_func(f,i,154,v,* comm_old,  * nnodes, index, edges, newrank);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4070,6 +4068,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Graph_map");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Graph_map, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Graph_map, &start, &end, call_stack, comm_old, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4119,21 +4119,19 @@ static int mpiPif_MPI_Graph_neighbors( jmp_buf * base_jbuf, MPI_Comm  * comm, in
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Graph_neighbors(  * comm,  * rank,  * maxneighbors, neighbors);
 void* f=NULL;
 QMPI_Table_query( 155, &f, (*vector_get(v,i)).table);
 exec_func(f,i,155,v, * comm,  * rank,  * maxneighbors, neighbors);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4142,6 +4140,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Graph_neighbors");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Graph_neighbors, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Graph_neighbors, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4191,21 +4191,19 @@ static int mpiPif_MPI_Graph_neighbors_count( jmp_buf * base_jbuf, MPI_Comm  * co
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Graph_neighbors_count(  * comm,  * rank, nneighbors);
 void* f=NULL;
 QMPI_Table_query( 156, &f, (*vector_get(v,i)).table);
 exec_func(f,i,156,v, * comm,  * rank, nneighbors);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4214,6 +4212,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Graph_neighbors_count");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Graph_neighbors_count, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Graph_neighbors_count, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4263,21 +4263,19 @@ static int mpiPif_MPI_Graphdims_get( jmp_buf * base_jbuf, MPI_Comm  * comm, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Graphdims_get(  * comm, nnodes, nedges);
 void* f=NULL;
 QMPI_Table_query( 157, &f, (*vector_get(v,i)).table);
 exec_func(f,i,157,v,* comm, nnodes, nedges);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4286,6 +4284,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Graphdims_get");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Graphdims_get, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Graphdims_get, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4335,21 +4335,19 @@ static int mpiPif_MPI_Group_compare( jmp_buf * base_jbuf, MPI_Group  * group1, M
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_compare(  * group1,  * group2, result);
 void* f=NULL;
 QMPI_Table_query( 160, &f, (*vector_get(v,i)).table);
 exec_func(f,i,160,v,* group1,  * group2, result);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4358,6 +4356,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_compare");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_compare, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_compare, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4409,21 +4409,19 @@ static int mpiPif_MPI_Group_difference( jmp_buf * base_jbuf, MPI_Group  * group1
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_difference(  * group1,  * group2, group_out);
 void* f=NULL;
 QMPI_Table_query( 161, &f, (*vector_get(v,i)).table);
 exec_func(f,i,161,v,* group1,  * group2, group_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4432,6 +4430,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_difference");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_difference, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_difference, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4487,21 +4487,19 @@ static int mpiPif_MPI_Group_excl( jmp_buf * base_jbuf, MPI_Group  * group, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_excl(  * group,  * n, ranks, newgroup);
 void* f=NULL;
 QMPI_Table_query( 162, &f, (*vector_get(v,i)).table);
 exec_func(f,i,162,v, * group,  * n, ranks, newgroup);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4510,6 +4508,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_excl");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_excl, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_excl, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4563,21 +4563,19 @@ static int mpiPif_MPI_Group_free( jmp_buf * base_jbuf, MPI_Group  *group,int i,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_free( group);
 void* f=NULL;
 QMPI_Table_query( 163, &f, (*vector_get(v,i)).table);
 exec_func(f,i,163,v,group);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4586,6 +4584,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_free");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_free, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_free, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4638,21 +4638,19 @@ static int mpiPif_MPI_Group_incl( jmp_buf * base_jbuf, MPI_Group  * group, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_incl(  * group,  * n, ranks, group_out);
 void* f=NULL;
 QMPI_Table_query( 164, &f, (*vector_get(v,i)).table);
 exec_func(f,i,164,v, * group,  * n, ranks, group_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4661,6 +4659,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_incl");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_incl, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_incl, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4714,21 +4714,19 @@ static int mpiPif_MPI_Group_intersection( jmp_buf * base_jbuf, MPI_Group  * grou
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_intersection(  * group1,  * group2, group_out);
 void* f=NULL;
 QMPI_Table_query( 165, &f, (*vector_get(v,i)).table);
 exec_func(f,i,165,v,* group1,  * group2, group_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4737,6 +4735,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_intersection");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_intersection, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_intersection, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4792,21 +4792,19 @@ static int mpiPif_MPI_Group_translate_ranks( jmp_buf * base_jbuf, MPI_Group  * g
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_translate_ranks(  * group_a,  * n, ranks_a,  * group_b, ranks_b);
 void* f=NULL;
 QMPI_Table_query( 170, &f, (*vector_get(v,i)).table);
 exec_func(f,i,170,v,  * group_a,  * n, ranks_a,  * group_b, ranks_b);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4815,6 +4813,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_translate_ranks");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_translate_ranks, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_translate_ranks, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4866,21 +4866,19 @@ static int mpiPif_MPI_Group_union( jmp_buf * base_jbuf, MPI_Group  * group1, MPI
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Group_union(  * group1,  * group2, group_out);
 void* f=NULL;
 QMPI_Table_query( 171, &f, (*vector_get(v,i)).table);
 exec_func(f,i,171,v,* group1,  * group2, group_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4889,6 +4887,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Group_union");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Group_union, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Group_union, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -4944,21 +4944,19 @@ static int mpiPif_MPI_Iallgather( jmp_buf * base_jbuf, const void  *sendbuf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iallgather( sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 172, &f, (*vector_get(v,i)).table);
 exec_func(f,i,172,v,sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -4973,6 +4971,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iallgather, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iallgather, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Iallgather, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5031,21 +5031,19 @@ static int mpiPif_MPI_Iallgatherv( jmp_buf * base_jbuf, const void  *sendbuf, in
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iallgatherv( sendbuf,  * sendcount,  * sendtype, recvbuf, recvcounts, displs,  * recvtype,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 173, &f, (*vector_get(v,i)).table);
 exec_func(f,i,173,v,sendbuf,  * sendcount,  * sendtype, recvbuf, recvcounts, displs,  * recvtype,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5060,6 +5058,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iallgatherv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iallgatherv, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Iallgatherv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5118,21 +5118,19 @@ static int mpiPif_MPI_Iallreduce( jmp_buf * base_jbuf, const void  *sendbuf, voi
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iallreduce( sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 174, &f, (*vector_get(v,i)).table);
 exec_func(f,i,174,v,sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5147,6 +5145,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iallreduce, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iallreduce, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Iallreduce, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5205,21 +5205,19 @@ static int mpiPif_MPI_Ialltoall( jmp_buf * base_jbuf, const void  *sendbuf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ialltoall( sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 175, &f, (*vector_get(v,i)).table);
 exec_func(f,i,175,v,sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5234,6 +5232,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ialltoall, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ialltoall, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ialltoall, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5292,21 +5292,19 @@ static int mpiPif_MPI_Ialltoallv( jmp_buf * base_jbuf, const void  *sendbuf, mpi
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ialltoallv( sendbuf, sendcounts, sdispls,  * sendtype, recvbuf, recvcounts, rdispls,  * recvtype,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 176, &f, (*vector_get(v,i)).table);
 exec_func(f,i,176,v, sendbuf, sendcounts, sdispls,  * sendtype, recvbuf, recvcounts, rdispls,  * recvtype,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5329,6 +5327,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ialltoallv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ialltoallv, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ialltoallv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5387,21 +5387,19 @@ static int mpiPif_MPI_Ialltoallw( jmp_buf * base_jbuf, const void  *sendbuf, mpi
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ialltoallw( sendbuf, sendcounts, sdispls, sendtypes, recvbuf, recvcounts, rdispls, recvtypes,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 177, &f, (*vector_get(v,i)).table);
 exec_func(f,i,177,v,sendbuf, sendcounts, sdispls, sendtypes, recvbuf, recvcounts, rdispls, recvtypes,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5426,6 +5424,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ialltoallw, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ialltoallw, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ialltoallw, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5480,21 +5480,19 @@ static int mpiPif_MPI_Ibarrier( jmp_buf * base_jbuf, MPI_Comm  * comm, MPI_Reque
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ibarrier(  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 178, &f, (*vector_get(v,i)).table);
 exec_func(f,i,178,v, * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5504,6 +5502,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ibarrier, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ibarrier, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ibarrier, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5558,21 +5558,19 @@ static int mpiPif_MPI_Ibcast( jmp_buf * base_jbuf, void  *buffer, int  * count,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ibcast( buffer,  * count,  * datatype,  * root,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 179, &f, (*vector_get(v,i)).table);
 exec_func(f,i,179,v,buffer,  * count,  * datatype,  * root,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5587,6 +5585,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ibcast, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ibcast, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ibcast, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5643,21 +5643,19 @@ static int mpiPif_MPI_Ibsend( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ibsend( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 180, &f, (*vector_get(v,i)).table);
 exec_func(f,i,180,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5672,6 +5670,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ibsend, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ibsend, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Ibsend, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5728,21 +5728,19 @@ static int mpiPif_MPI_Iexscan( jmp_buf * base_jbuf, const void  *sendbuf, void
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iexscan( sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 181, &f, (*vector_get(v,i)).table);
 exec_func(f,i,181,v,sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5757,6 +5755,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iexscan, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iexscan, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Iexscan, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5815,21 +5815,19 @@ static int mpiPif_MPI_Igather( jmp_buf * base_jbuf, const void  *sendbuf, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Igather( sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 182, &f, (*vector_get(v,i)).table);
 exec_func(f,i,182,v,sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5844,6 +5842,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Igather, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Igather, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Igather, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5902,21 +5902,19 @@ static int mpiPif_MPI_Igatherv( jmp_buf * base_jbuf, const void  *sendbuf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Igatherv( sendbuf,  * sendcount,  * sendtype, recvbuf, recvcounts, displs,  * recvtype,  * root,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 183, &f, (*vector_get(v,i)).table);
 exec_func(f,i,183,v,sendbuf,  * sendcount,  * sendtype, recvbuf, recvcounts, displs,  * recvtype,  * root,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -5931,6 +5929,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Igatherv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Igatherv, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Igatherv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -5989,21 +5989,19 @@ static int mpiPif_MPI_Intercomm_create( jmp_buf * base_jbuf, MPI_Comm  * local_c
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Intercomm_create(  * local_comm,  * local_leader,  * peer_comm,  * remote_leader,  * tag, comm_out);
 void* f=NULL;
 QMPI_Table_query( 203, &f, (*vector_get(v,i)).table);
 exec_func(f,i,203,v,* local_comm,  * local_leader,  * peer_comm,  * remote_leader,  * tag, comm_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6012,6 +6010,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Intercomm_create");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Intercomm_create, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Intercomm_create, &start, &end, call_stack, local_comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -6067,21 +6067,19 @@ static int mpiPif_MPI_Intercomm_merge( jmp_buf * base_jbuf, MPI_Comm  * comm, in
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Intercomm_merge(  * comm,  * high, comm_out);
 void* f=NULL;
 QMPI_Table_query( 204, &f, (*vector_get(v,i)).table);
 exec_func(f,i,204,v, * comm,  * high, comm_out);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6090,6 +6088,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Intercomm_merge");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Intercomm_merge, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Intercomm_merge, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -6143,21 +6143,19 @@ static int mpiPif_MPI_Iprobe( jmp_buf * base_jbuf, int  * source, int  * tag, MP
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iprobe(  * source,  * tag,  * comm, flag, status);
 void* f=NULL;
 QMPI_Table_query( 205, &f, (*vector_get(v,i)).table);
 exec_func(f,i,205,v, * source,  * tag,  * comm, flag, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6166,6 +6164,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Iprobe");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iprobe, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iprobe, &start, &end, call_stack, comm, *source, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -6215,21 +6215,19 @@ static int mpiPif_MPI_Irecv( jmp_buf * base_jbuf, void  *buf, int  * count, MPI_
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Irecv( buf,  * count,  * datatype,  * source,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 206, &f, (*vector_get(v,i)).table);
 exec_func(f,i,206,v,buf,  * count,  * datatype,  * source,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6238,6 +6236,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Irecv");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Irecv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Irecv, &start, &end, call_stack, comm, *source, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -6293,21 +6293,19 @@ static int mpiPif_MPI_Ireduce( jmp_buf * base_jbuf, const void  *sendbuf, void
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ireduce( sendbuf, recvbuf,  * count,  * datatype,  * op,  * root,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 207, &f, (*vector_get(v,i)).table);
 exec_func(f,i,207,v,sendbuf, recvbuf,  * count,  * datatype,  * op,  * root,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6322,6 +6320,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ireduce, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ireduce, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ireduce, dur, (double)messSize, comm,i,v); }
 }
 
@@ -6380,21 +6380,19 @@ static int mpiPif_MPI_Ireduce_scatter( jmp_buf * base_jbuf, const void  *sendbuf
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ireduce_scatter( sendbuf, recvbuf, recvcounts,  * datatype,  * op,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 208, &f, (*vector_get(v,i)).table);
 exec_func(f,i,208,v,sendbuf, recvbuf, recvcounts,  * datatype,  * op,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6417,6 +6415,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ireduce_scatter, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ireduce_scatter, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ireduce_scatter, dur, (double)messSize, comm,i,v); }
 }
 
@@ -6475,21 +6475,19 @@ static int mpiPif_MPI_Ireduce_scatter_block( jmp_buf * base_jbuf, const void  *s
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ireduce_scatter_block( sendbuf, recvbuf,  * recvcount,  * datatype,  * op,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 209, &f, (*vector_get(v,i)).table);
 exec_func(f,i,209,v,sendbuf, recvbuf,  * recvcount,  * datatype,  * op,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6504,6 +6502,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ireduce_scatter_block, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ireduce_scatter_block, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Ireduce_scatter_block, dur, (double)messSize, comm,i,v); }
 }
 
@@ -6562,21 +6562,19 @@ static int mpiPif_MPI_Irsend( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Irsend( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 210, &f, (*vector_get(v,i)).table);
 exec_func(f,i,210,v, buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6591,6 +6589,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Irsend, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Irsend, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Irsend, dur, (double)messSize, comm,i,v); }
 }
 
@@ -6647,21 +6647,19 @@ static int mpiPif_MPI_Iscan( jmp_buf * base_jbuf, const void  *sendbuf, void  *r
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iscan( sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 212, &f, (*vector_get(v,i)).table);
 exec_func(f,i,212,v,sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6676,6 +6674,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iscan, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iscan, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Iscan, dur, (double)messSize, comm,i,v); }
 }
 
@@ -6734,21 +6734,19 @@ static int mpiPif_MPI_Iscatter( jmp_buf * base_jbuf, const void  *sendbuf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iscatter( sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 213, &f, (*vector_get(v,i)).table);
 exec_func(f,i,213,v,sendbuf,  * sendcount,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6763,6 +6761,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iscatter, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iscatter, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Iscatter, dur, (double)messSize, comm,i,v); }
 }
 
@@ -6821,21 +6821,19 @@ static int mpiPif_MPI_Iscatterv( jmp_buf * base_jbuf, const void  *sendbuf, mpip
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Iscatterv( sendbuf, sendcounts, displs,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 214, &f, (*vector_get(v,i)).table);
 exec_func(f,i,214,v,sendbuf, sendcounts, displs,  * sendtype, recvbuf,  * recvcount,  * recvtype,  * root,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6858,6 +6856,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Iscatterv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Iscatterv, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Iscatterv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -6916,21 +6916,19 @@ static int mpiPif_MPI_Isend( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Isend( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 215, &f, (*vector_get(v,i)).table);
 exec_func(f,i,215,v, buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -6945,6 +6943,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Isend, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Isend, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Isend, dur, (double)messSize, comm,i,v); }
 }
 
@@ -7001,21 +7001,19 @@ static int mpiPif_MPI_Issend( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Issend( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 216, &f, (*vector_get(v,i)).table);
 exec_func(f,i,216,v, buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7030,6 +7028,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Issend, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Issend, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Issend, dur, (double)messSize, comm,i,v); }
 }
 
@@ -7086,21 +7086,19 @@ static int mpiPif_MPI_Keyval_create( jmp_buf * base_jbuf, MPI_Copy_function  *co
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Keyval_create( copy_fn, delete_fn, keyval, extra_state);
 void* f=NULL;
 QMPI_Table_query( 217, &f, (*vector_get(v,i)).table);
 exec_func(f,i,217,v,copy_fn, delete_fn, keyval, extra_state);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7109,6 +7107,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Keyval_create");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Keyval_create, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Keyval_create, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7156,21 +7156,19 @@ static int mpiPif_MPI_Keyval_free( jmp_buf * base_jbuf, int  *keyval,int i, vect
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Keyval_free( keyval);
 void* f=NULL;
 QMPI_Table_query( 218, &f, (*vector_get(v,i)).table);
 exec_func(f,i,218,v,keyval);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7179,6 +7177,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Keyval_free");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Keyval_free, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Keyval_free, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7226,21 +7226,19 @@ static int mpiPif_MPI_Pack( jmp_buf * base_jbuf, mpip_const_void_t  *inbuf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Pack( inbuf,  * incount,  * datatype, outbuf,  * count, position,  * comm);
 void* f=NULL;
 QMPI_Table_query( 231, &f, (*vector_get(v,i)).table);
 exec_func(f,i,231,v,inbuf,  * incount,  * datatype, outbuf,  * count, position,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7249,6 +7247,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Pack");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Pack, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Pack, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7300,21 +7300,19 @@ static int mpiPif_MPI_Probe( jmp_buf * base_jbuf, int  * source, int  * tag, MPI
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Probe(  * source,  * tag,  * comm, status);
 void* f=NULL;
 QMPI_Table_query( 236, &f, (*vector_get(v,i)).table);
 exec_func(f,i,236,v,* source,  * tag,  * comm, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7323,6 +7321,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Probe");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Probe, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Probe, &start, &end, call_stack, comm, *source, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7372,21 +7372,19 @@ static int mpiPif_MPI_Put( jmp_buf * base_jbuf, mpip_const_void_t  *origin_addr,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Put( origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win);
 void* f=NULL;
 QMPI_Table_query( 238, &f, (*vector_get(v,i)).table);
 exec_func(f,i,238,v,origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7398,6 +7396,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Put");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Put, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Put, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7449,21 +7449,19 @@ static int mpiPif_MPI_Raccumulate( jmp_buf * base_jbuf, mpip_const_void_t  *orig
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Raccumulate( origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win, request);
 void* f=NULL;
 QMPI_Table_query( 240, &f, (*vector_get(v,i)).table);
 exec_func(f,i,240,v,origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7475,6 +7473,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Raccumulate");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Raccumulate, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Raccumulate, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7530,21 +7530,19 @@ static int mpiPif_MPI_Recv( jmp_buf * base_jbuf, void  *buf, int  * count, MPI_D
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Recv( buf,  * count,  * datatype,  * source,  * tag,  * comm, status);
 void* f=NULL;
 QMPI_Table_query( 241, &f, (*vector_get(v,i)).table);
 exec_func(f,i,241,v,buf,  * count,  * datatype,  * source,  * tag,  * comm, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7553,6 +7551,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Recv");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Recv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Recv, &start, &end, call_stack, comm, *source, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7604,21 +7604,19 @@ static int mpiPif_MPI_Recv_init( jmp_buf * base_jbuf, void  *buf, int  * count,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Recv_init( buf,  * count,  * datatype,  * source,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 242, &f, (*vector_get(v,i)).table);
 exec_func(f,i,242,v,buf,  * count,  * datatype,  * source,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7627,6 +7625,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Recv_init");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Recv_init, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Recv_init, &start, &end, call_stack, comm, *source, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7682,21 +7682,19 @@ static int mpiPif_MPI_Reduce( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Reduce( sendbuf, recvbuf,  * count,  * datatype,  * op,  * root,  * comm);
 void* f=NULL;
 QMPI_Table_query( 243, &f, (*vector_get(v,i)).table);
 exec_func(f,i,243,v,sendbuf, recvbuf,  * count,  * datatype,  * op,  * root,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7711,6 +7709,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Reduce, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Reduce, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Reduce, dur, (double)messSize, comm,i,v); }
 }
 
@@ -7765,21 +7765,19 @@ static int mpiPif_MPI_Reduce_scatter( jmp_buf * base_jbuf, mpip_const_void_t  *s
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Reduce_scatter( sendbuf, recvbuf, recvcnts,  * datatype,  * op,  * comm);
 void* f=NULL;
 QMPI_Table_query( 245, &f, (*vector_get(v,i)).table);
 exec_func(f,i,245,v,sendbuf, recvbuf, recvcnts,  * datatype,  * op,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7789,6 +7787,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Reduce_scatter, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Reduce_scatter, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Reduce_scatter, dur, (double)messSize, comm,i,v); }
 }
 
@@ -7843,21 +7843,19 @@ static int mpiPif_MPI_Request_free( jmp_buf * base_jbuf, MPI_Request  *request,i
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Request_free( request);
 void* f=NULL;
 QMPI_Table_query( 248, &f, (*vector_get(v,i)).table);
 exec_func(f,i,248,v,request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7866,6 +7864,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Request_free");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Request_free, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Request_free, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7918,21 +7918,19 @@ static int mpiPif_MPI_Rget( jmp_buf * base_jbuf, void  *origin_addr, int  * orig
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Rget( origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win, request);
 void* f=NULL;
 QMPI_Table_query( 250, &f, (*vector_get(v,i)).table);
 exec_func(f,i,250,v, origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -7944,6 +7942,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Rget");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Rget, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Rget, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -7997,21 +7997,19 @@ static int mpiPif_MPI_Rget_accumulate( jmp_buf * base_jbuf, mpip_const_void_t  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Rget_accumulate( origin_addr,  * origin_count,  * origin_datatype, result_addr,  * result_count,  * result_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win, request);
 void* f=NULL;
 QMPI_Table_query( 251, &f, (*vector_get(v,i)).table);
 exec_func(f,i,251,v,origin_addr,  * origin_count,  * origin_datatype, result_addr,  * result_count,  * result_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * op,  * win, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8023,6 +8021,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Rget_accumulate");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Rget_accumulate, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Rget_accumulate, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -8080,21 +8080,19 @@ static int mpiPif_MPI_Rput( jmp_buf * base_jbuf, mpip_const_void_t  *origin_addr
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Rput( origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win, request);
 void* f=NULL;
 QMPI_Table_query( 252, &f, (*vector_get(v,i)).table);
 exec_func(f,i,252,v,origin_addr,  * origin_count,  * origin_datatype,  * target_rank,  * target_disp,  * target_count,  * target_datatype,  * win, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8106,6 +8104,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Rput");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Rput, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Rput, &start, &end, call_stack, NULL, *target_rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -8159,21 +8159,19 @@ static int mpiPif_MPI_Rsend( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Rsend( buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 void* f=NULL;
 QMPI_Table_query( 253, &f, (*vector_get(v,i)).table);
 exec_func(f,i,253,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8188,6 +8186,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Rsend, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Rsend, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Rsend, dur, (double)messSize, comm,i,v); }
 }
 
@@ -8240,21 +8240,19 @@ static int mpiPif_MPI_Rsend_init( jmp_buf * base_jbuf, mpip_const_void_t  *buf,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Rsend_init( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 254, &f, (*vector_get(v,i)).table);
 exec_func(f,i,254,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8263,6 +8261,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Rsend_init");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Rsend_init, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Rsend_init, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -8318,21 +8318,19 @@ static int mpiPif_MPI_Scan( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf, vo
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Scan( sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm);
 void* f=NULL;
 QMPI_Table_query( 255, &f, (*vector_get(v,i)).table);
 exec_func(f,i,255,v,sendbuf, recvbuf,  * count,  * datatype,  * op,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8346,6 +8344,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Scan");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Scan, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Scan, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -8399,21 +8399,19 @@ static int mpiPif_MPI_Scatter( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Scatter( sendbuf,  * sendcnt,  * sendtype, recvbuf,  * recvcnt,  * recvtype,  * root,  * comm);
 void* f=NULL;
 QMPI_Table_query( 256, &f, (*vector_get(v,i)).table);
 exec_func(f,i,256,v,sendbuf,  * sendcnt,  * sendtype, recvbuf,  * recvcnt,  * recvtype,  * root,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8428,6 +8426,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Scatter, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Scatter, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Scatter, dur, (double)messSize, comm,i,v); }
 }
 
@@ -8482,21 +8482,19 @@ static int mpiPif_MPI_Scatterv( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Scatterv( sendbuf, sendcnts, displs,  * sendtype, recvbuf,  * recvcnt,  * recvtype,  * root,  * comm);
 void* f=NULL;
 QMPI_Table_query( 257, &f, (*vector_get(v,i)).table);
 exec_func(f,i,257,v,sendbuf, sendcnts, displs,  * sendtype, recvbuf,  * recvcnt,  * recvtype,  * root,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8506,6 +8504,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Scatterv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Scatterv, &start, &end, call_stack, comm, *root, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_collective_stats_report) { mpiPi_update_collective_stats(mpiPi_MPI_Scatterv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -8560,21 +8560,19 @@ static int mpiPif_MPI_Send( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Send( buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 void* f=NULL;
 QMPI_Table_query( 258, &f, (*vector_get(v,i)).table);
 exec_func(f,i,258,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8589,6 +8587,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Send, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Send, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Send, dur, (double)messSize, comm,i,v); }
 }
 
@@ -8641,21 +8641,19 @@ static int mpiPif_MPI_Send_init( jmp_buf * base_jbuf, mpip_const_void_t  *buf, i
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Send_init( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 259, &f, (*vector_get(v,i)).table);
 exec_func(f,i,259,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8664,6 +8662,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Send_init");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Send_init, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Send_init, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -8719,21 +8719,19 @@ static int mpiPif_MPI_Sendrecv( jmp_buf * base_jbuf, mpip_const_void_t  *sendbuf
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Sendrecv( sendbuf,  * sendcount,  * sendtype,  * dest,  * sendtag, recvbuf,  * recvcount,  * recvtype,  * source,  * recvtag,  * comm, status);
 void* f=NULL;
 QMPI_Table_query( 260, &f, (*vector_get(v,i)).table);
 exec_func(f,i,260,v,sendbuf,  * sendcount,  * sendtype,  * dest,  * sendtag, recvbuf,  * recvcount,  * recvtype,  * source,  * recvtag,  * comm, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8748,6 +8746,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Sendrecv, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Sendrecv, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Sendrecv, dur, (double)messSize, comm,i,v); }
 }
 
@@ -8802,21 +8802,19 @@ static int mpiPif_MPI_Sendrecv_replace( jmp_buf * base_jbuf, void  *buf, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Sendrecv_replace( buf,  * count,  * datatype,  * dest,  * sendtag,  * source,  * recvtag,  * comm, status);
 void* f=NULL;
 QMPI_Table_query( 261, &f, (*vector_get(v,i)).table);
 exec_func(f,i,261,v,buf,  * count,  * datatype,  * dest,  * sendtag,  * source,  * recvtag,  * comm, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8831,6 +8829,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Sendrecv_replace, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Sendrecv_replace, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Sendrecv_replace, dur, (double)messSize, comm,i,v); }
 }
 
@@ -8883,21 +8883,19 @@ static int mpiPif_MPI_Ssend( jmp_buf * base_jbuf, mpip_const_void_t  *buf, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ssend( buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 void* f=NULL;
 QMPI_Table_query( 262, &f, (*vector_get(v,i)).table);
 exec_func(f,i,262,v, buf,  * count,  * datatype,  * dest,  * tag,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8912,6 +8910,8 @@ if ( dur < 0 )
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ssend, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
 
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ssend, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
+
 if (gs_ptr->mpiPi.do_pt2pt_stats_report) { mpiPi_update_pt2pt_stats(mpiPi_MPI_Ssend, dur, (double)messSize, comm,i,v); }
 }
 
@@ -8964,21 +8964,19 @@ static int mpiPif_MPI_Ssend_init( jmp_buf * base_jbuf, mpip_const_void_t  *buf,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Ssend_init( buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 void* f=NULL;
 QMPI_Table_query( 263, &f, (*vector_get(v,i)).table);
 exec_func(f,i,263,v,buf,  * count,  * datatype,  * dest,  * tag,  * comm, request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -8987,6 +8985,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Ssend_init");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Ssend_init, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Ssend_init, &start, &end, call_stack, comm, *dest, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9042,21 +9042,19 @@ static int mpiPif_MPI_Start( jmp_buf * base_jbuf, MPI_Request  *request,int i, v
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Start( request);
 void* f=NULL;
 QMPI_Table_query( 264, &f, (*vector_get(v,i)).table);
 exec_func(f,i,264,v,request);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9065,6 +9063,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Start");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Start, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Start, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9117,21 +9117,19 @@ static int mpiPif_MPI_Startall( jmp_buf * base_jbuf, int  * count, MPI_Request
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Startall(  * count, array_of_requests);
 void* f=NULL;
 QMPI_Table_query( 265, &f, (*vector_get(v,i)).table);
 exec_func(f,i,265,v,* count, array_of_requests);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9140,6 +9138,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Startall");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Startall, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Startall, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9205,21 +9205,19 @@ static int mpiPif_MPI_Test( jmp_buf * base_jbuf, MPI_Request  *request, int  *fl
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Test( request, flag, status);
 void* f=NULL;
 QMPI_Table_query( 269, &f, (*vector_get(v,i)).table);
 exec_func(f,i,269,v,request, flag, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9228,6 +9226,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Test");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Test, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Test, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9280,21 +9280,19 @@ static int mpiPif_MPI_Testall( jmp_buf * base_jbuf, int  * count, MPI_Request  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Testall(  * count, array_of_requests, flag, array_of_statuses);
 void* f=NULL;
 QMPI_Table_query( 271, &f, (*vector_get(v,i)).table);
 exec_func(f,i,271,v,* count, array_of_requests, flag, array_of_statuses);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9303,6 +9301,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Testall");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Testall, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Testall, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9368,21 +9368,19 @@ static int mpiPif_MPI_Testany( jmp_buf * base_jbuf, int  * count, MPI_Request  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Testany(  * count, array_of_requests, index, flag, status);
 void* f=NULL;
 QMPI_Table_query( 272, &f, (*vector_get(v,i)).table);
 exec_func(f,i,272,v, * count, array_of_requests, index, flag, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9391,6 +9389,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Testany");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Testany, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Testany, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9452,21 +9452,19 @@ static int mpiPif_MPI_Testsome( jmp_buf * base_jbuf, int  * incount, MPI_Request
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Testsome(  * incount, array_of_requests, count, array_of_indices, array_of_statuses);
 void* f=NULL;
 QMPI_Table_query( 273, &f, (*vector_get(v,i)).table);
 exec_func(f,i,273,v, * incount, array_of_requests, count, array_of_indices, array_of_statuses);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9475,6 +9473,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Testsome");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Testsome, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Testsome, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9541,21 +9541,19 @@ static int mpiPif_MPI_Topo_test( jmp_buf * base_jbuf, MPI_Comm  * comm, int  *to
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Topo_test(  * comm, top_type);
 void* f=NULL;
 QMPI_Table_query( 274, &f, (*vector_get(v,i)).table);
 exec_func(f,i,274,v, * comm, top_type);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9564,6 +9562,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Topo_test");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Topo_test, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Topo_test, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9613,21 +9613,19 @@ static int mpiPif_MPI_Type_commit( jmp_buf * base_jbuf, MPI_Datatype  *datatype,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Type_commit( datatype);
 void* f=NULL;
 QMPI_Table_query( 275, &f, (*vector_get(v,i)).table);
 exec_func(f,i,275,v,datatype);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9636,6 +9634,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Type_commit");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Type_commit, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Type_commit, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9688,21 +9688,19 @@ static int mpiPif_MPI_Type_free( jmp_buf * base_jbuf, MPI_Datatype  *datatype,in
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Type_free( datatype);
 void* f=NULL;
 QMPI_Table_query( 292, &f, (*vector_get(v,i)).table);
 exec_func(f,i,292,v,datatype);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9711,6 +9709,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Type_free");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Type_free, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Type_free, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9763,21 +9763,19 @@ static int mpiPif_MPI_Type_get_contents( jmp_buf * base_jbuf, MPI_Datatype  * da
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Type_get_contents(  * datatype,  * max_integers,  * max_addresses,  * max_datatypes, array_of_integers, array_of_addresses, array_of_datatypes);
 void* f=NULL;
 QMPI_Table_query( 295, &f, (*vector_get(v,i)).table);
 exec_func(f,i,295,v,* datatype,  * max_integers,  * max_addresses,  * max_datatypes, array_of_integers, array_of_addresses, array_of_datatypes);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9786,6 +9784,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Type_get_contents");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Type_get_contents, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Type_get_contents, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9847,21 +9847,19 @@ static int mpiPif_MPI_Type_get_envelope( jmp_buf * base_jbuf, MPI_Datatype  * da
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Type_get_envelope(  * datatype, num_integers, num_addresses, num_datatypes, combiner);
 void* f=NULL;
 QMPI_Table_query( 296, &f, (*vector_get(v,i)).table);
 exec_func(f,i,296,v, * datatype, num_integers, num_addresses, num_datatypes, combiner);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9870,6 +9868,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Type_get_envelope");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Type_get_envelope, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Type_get_envelope, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9919,21 +9919,19 @@ static int mpiPif_MPI_Unpack( jmp_buf * base_jbuf, mpip_const_void_t  *inbuf, in
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Unpack( inbuf,  * insize, position, outbuf,  * count,  * datatype,  * comm);
 void* f=NULL;
 QMPI_Table_query( 314, &f, (*vector_get(v,i)).table);
 exec_func(f,i,314,v,inbuf,  * insize, position, outbuf,  * count,  * datatype,  * comm);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -9942,6 +9940,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Unpack");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Unpack, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Unpack, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -9993,21 +9993,19 @@ static int mpiPif_MPI_Wait( jmp_buf * base_jbuf, MPI_Request  *request, MPI_Stat
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Wait( request, status);
 void* f=NULL;
 QMPI_Table_query( 317, &f, (*vector_get(v,i)).table);
 exec_func(f,i,317,v,request, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10016,6 +10014,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Wait");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Wait, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Wait, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10068,21 +10068,19 @@ static int mpiPif_MPI_Waitall( jmp_buf * base_jbuf, int  * count, MPI_Request  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Waitall(  * count, array_of_requests, array_of_statuses);
 void* f=NULL;
 QMPI_Table_query( 318, &f, (*vector_get(v,i)).table);
 exec_func(f,i,318,v, * count, array_of_requests, array_of_statuses);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10091,6 +10089,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Waitall");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Waitall, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Waitall, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10156,21 +10156,19 @@ static int mpiPif_MPI_Waitany( jmp_buf * base_jbuf, int  * count, MPI_Request  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Waitany(  * count, array_of_requests, index, status);
 void* f=NULL;
 QMPI_Table_query( 319, &f, (*vector_get(v,i)).table);
 exec_func(f,i,319,v,* count, array_of_requests, index, status);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10179,6 +10177,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Waitany");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Waitany, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Waitany, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10240,21 +10240,19 @@ static int mpiPif_MPI_Waitsome( jmp_buf * base_jbuf, int  * incount, MPI_Request
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Waitsome(  * incount, array_of_requests, count, array_of_indices, array_of_statuses);
 void* f=NULL;
 QMPI_Table_query( 320, &f, (*vector_get(v,i)).table);
 exec_func(f,i,320,v, * incount, array_of_requests, count, array_of_indices, array_of_statuses);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10263,6 +10261,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Waitsome");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Waitsome, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Waitsome, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10329,21 +10329,19 @@ static int mpiPif_MPI_Win_allocate( jmp_buf * base_jbuf, MPI_Aint  * size, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_allocate(  * size,  * disp_unit,  * info,  * comm, baseptr, win);
 void* f=NULL;
 QMPI_Table_query( 321, &f, (*vector_get(v,i)).table);
 exec_func(f,i,321,v,* size,  * disp_unit,  * info,  * comm, baseptr, win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10352,6 +10350,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_allocate");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_allocate, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_allocate, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10403,21 +10403,19 @@ static int mpiPif_MPI_Win_allocate_shared( jmp_buf * base_jbuf, MPI_Aint  * size
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_allocate_shared(  * size,  * disp_unit,  * info,  * comm, baseptr, win);
 void* f=NULL;
 QMPI_Table_query( 322, &f, (*vector_get(v,i)).table);
 exec_func(f,i,322,v,* size,  * disp_unit,  * info,  * comm, baseptr, win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10426,6 +10424,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_allocate_shared");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_allocate_shared, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_allocate_shared, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10477,21 +10477,19 @@ static int mpiPif_MPI_Win_attach( jmp_buf * base_jbuf, MPI_Win  * win, void  *ba
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_attach(  * win, base,  * size);
 void* f=NULL;
 QMPI_Table_query( 323, &f, (*vector_get(v,i)).table);
 exec_func(f,i,323,v, * win, base,  * size);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10500,6 +10498,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_attach");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_attach, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_attach, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10547,21 +10547,19 @@ static int mpiPif_MPI_Win_complete( jmp_buf * base_jbuf, MPI_Win  * win,int i, v
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_complete(  * win);
 void* f=NULL;
 QMPI_Table_query( 325, &f, (*vector_get(v,i)).table);
 exec_func(f,i,325,v,* win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10570,6 +10568,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_complete");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_complete, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_complete, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10617,21 +10617,19 @@ static int mpiPif_MPI_Win_create( jmp_buf * base_jbuf, void  *base, MPI_Aint  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_create( base,  * size,  * disp_unit,  * info,  * comm, win);
 void* f=NULL;
 QMPI_Table_query( 326, &f, (*vector_get(v,i)).table);
 exec_func(f,i,326,v,base,  * size,  * disp_unit,  * info,  * comm, win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10640,6 +10638,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_create");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_create, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_create, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10691,21 +10691,19 @@ static int mpiPif_MPI_Win_create_dynamic( jmp_buf * base_jbuf, MPI_Info  * info,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_create_dynamic(  * info,  * comm, win);
 void* f=NULL;
 QMPI_Table_query( 327, &f, (*vector_get(v,i)).table);
 exec_func(f,i,327,v, * info,  * comm, win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10714,6 +10712,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_create_dynamic");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_create_dynamic, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_create_dynamic, &start, &end, call_stack, comm, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10765,21 +10765,19 @@ static int mpiPif_MPI_Win_detach( jmp_buf * base_jbuf, MPI_Win  * win, mpip_cons
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_detach(  * win, base);
 void* f=NULL;
 QMPI_Table_query( 331, &f, (*vector_get(v,i)).table);
 exec_func(f,i,331,v,* win, base);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10788,6 +10786,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_detach");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_detach, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_detach, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10835,21 +10835,19 @@ static int mpiPif_MPI_Win_fence( jmp_buf * base_jbuf, int  * assert, MPI_Win  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_fence(  * assert,  * win);
 void* f=NULL;
 QMPI_Table_query( 332, &f, (*vector_get(v,i)).table);
 exec_func(f,i,332,v, * assert,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10858,6 +10856,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_fence");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_fence, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_fence, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10905,21 +10905,19 @@ static int mpiPif_MPI_Win_flush( jmp_buf * base_jbuf, int  * rank, MPI_Win  * wi
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_flush(  * rank,  * win);
 void* f=NULL;
 QMPI_Table_query( 333, &f, (*vector_get(v,i)).table);
 exec_func(f,i,333,v,* rank,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10928,6 +10926,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_flush");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_flush, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_flush, &start, &end, call_stack, NULL, *rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -10975,21 +10975,19 @@ static int mpiPif_MPI_Win_flush_all( jmp_buf * base_jbuf, MPI_Win  * win,int i,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_flush_all(  * win);
 void* f=NULL;
 QMPI_Table_query( 334, &f, (*vector_get(v,i)).table);
 exec_func(f,i,334,v, * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -10998,6 +10996,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_flush_all");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_flush_all, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_flush_all, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11045,21 +11045,19 @@ static int mpiPif_MPI_Win_flush_local( jmp_buf * base_jbuf, int  * rank, MPI_Win
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_flush_local(  * rank,  * win);
 void* f=NULL;
 QMPI_Table_query( 335, &f, (*vector_get(v,i)).table);
 exec_func(f,i,335,v, * rank,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11068,6 +11066,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_flush_local");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_flush_local, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_flush_local, &start, &end, call_stack, NULL, *rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11115,21 +11115,19 @@ static int mpiPif_MPI_Win_flush_local_all( jmp_buf * base_jbuf, MPI_Win  * win,i
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_flush_local_all(  * win);
 void* f=NULL;
 QMPI_Table_query( 336, &f, (*vector_get(v,i)).table);
 exec_func(f,i,336,v,* win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11138,6 +11136,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_flush_local_all");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_flush_local_all, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_flush_local_all, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11185,21 +11185,19 @@ static int mpiPif_MPI_Win_free( jmp_buf * base_jbuf, MPI_Win  *win,int i, vector
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_free( win);
 void* f=NULL;
 QMPI_Table_query( 337, &f, (*vector_get(v,i)).table);
 exec_func(f,i,337,v, win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11208,6 +11206,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_free");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_free, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_free, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11255,21 +11255,19 @@ static int mpiPif_MPI_Win_get_group( jmp_buf * base_jbuf, MPI_Win  * win, MPI_Gr
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_get_group(  * win, group);
 void* f=NULL;
 QMPI_Table_query( 341, &f, (*vector_get(v,i)).table);
 exec_func(f,i,341,v,* win, group);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11278,6 +11276,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_get_group");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_get_group, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_get_group, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11327,21 +11327,19 @@ static int mpiPif_MPI_Win_get_info( jmp_buf * base_jbuf, MPI_Win  * win, MPI_Inf
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_get_info(  * win, info_used);
 void* f=NULL;
 QMPI_Table_query( 342, &f, (*vector_get(v,i)).table);
 exec_func(f,i,342,v,* win, info_used);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11350,6 +11348,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_get_info");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_get_info, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_get_info, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11399,21 +11399,19 @@ static int mpiPif_MPI_Win_lock( jmp_buf * base_jbuf, int  * lock_type, int  * ra
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_lock(  * lock_type,  * rank,  * assert,  * win);
 void* f=NULL;
 QMPI_Table_query( 344, &f, (*vector_get(v,i)).table);
 exec_func(f,i,344,v,* lock_type,  * rank,  * assert,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11422,6 +11420,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_lock");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_lock, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_lock, &start, &end, call_stack, NULL, *rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11469,21 +11469,19 @@ static int mpiPif_MPI_Win_lock_all( jmp_buf * base_jbuf, int  * assert, MPI_Win
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_lock_all(  * assert,  * win);
 void* f=NULL;
 QMPI_Table_query( 345, &f, (*vector_get(v,i)).table);
 exec_func(f,i,345,v,* assert,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11492,6 +11490,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_lock_all");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_lock_all, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_lock_all, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11539,21 +11539,19 @@ static int mpiPif_MPI_Win_post( jmp_buf * base_jbuf, MPI_Group  * group, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_post(  * group,  * assert,  * win);
 void* f=NULL;
 QMPI_Table_query( 346, &f, (*vector_get(v,i)).table);
 exec_func(f,i,346,v,* group,  * assert,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11562,6 +11560,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_post");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_post, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_post, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11611,21 +11611,19 @@ static int mpiPif_MPI_Win_set_info( jmp_buf * base_jbuf, MPI_Win  * win, MPI_Inf
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_set_info(  * win,  * info);
 void* f=NULL;
 QMPI_Table_query( 349, &f, (*vector_get(v,i)).table);
 exec_func(f,i,349,v,* win,  * info);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11634,6 +11632,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_set_info");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_set_info, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_set_info, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11683,21 +11683,19 @@ static int mpiPif_MPI_Win_shared_query( jmp_buf * base_jbuf, MPI_Win  * win, int
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_shared_query(  * win,  * rank, size, disp_unit, baseptr);
 void* f=NULL;
 QMPI_Table_query( 351, &f, (*vector_get(v,i)).table);
 exec_func(f,i,351,v, * win,  * rank, size, disp_unit, baseptr);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11706,6 +11704,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_shared_query");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_shared_query, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_shared_query, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11753,21 +11753,19 @@ static int mpiPif_MPI_Win_start( jmp_buf * base_jbuf, MPI_Group  * group, int  *
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_start(  * group,  * assert,  * win);
 void* f=NULL;
 QMPI_Table_query( 352, &f, (*vector_get(v,i)).table);
 exec_func(f,i,352,v,* group,  * assert,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11776,6 +11774,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_start");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_start, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_start, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11825,21 +11825,19 @@ static int mpiPif_MPI_Win_sync( jmp_buf * base_jbuf, MPI_Win  * win,int i, vecto
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_sync(  * win);
 void* f=NULL;
 QMPI_Table_query( 353, &f, (*vector_get(v,i)).table);
 exec_func(f,i,353,v,* win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11848,6 +11846,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_sync");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_sync, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_sync, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11895,21 +11895,19 @@ static int mpiPif_MPI_Win_test( jmp_buf * base_jbuf, MPI_Win  * win, int  *flag,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_test(  * win, flag);
 void* f=NULL;
 QMPI_Table_query( 354, &f, (*vector_get(v,i)).table);
 exec_func(f,i,354,v, * win, flag);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11918,6 +11916,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_test");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_test, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_test, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -11965,21 +11965,19 @@ static int mpiPif_MPI_Win_unlock( jmp_buf * base_jbuf, int  * rank, MPI_Win  * w
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_unlock(  * rank,  * win);
 void* f=NULL;
 QMPI_Table_query( 355, &f, (*vector_get(v,i)).table);
 exec_func(f,i,355,v,* rank,  * win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -11988,6 +11986,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_unlock");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_unlock, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_unlock, &start, &end, call_stack, NULL, *rank, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -12035,21 +12035,19 @@ static int mpiPif_MPI_Win_unlock_all( jmp_buf * base_jbuf, MPI_Win  * win,int i,
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_unlock_all(  * win);
 void* f=NULL;
 QMPI_Table_query( 356, &f, (*vector_get(v,i)).table);
 exec_func(f,i,356,v,* win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -12058,6 +12056,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_unlock_all");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_unlock_all, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_unlock_all, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
@@ -12105,21 +12105,19 @@ static int mpiPif_MPI_Win_wait( jmp_buf * base_jbuf, MPI_Win  * win,int i, vecto
  mpiPi_TIME start, end;
  void *call_stack[MPIP_CALLSITE_STACK_DEPTH_MAX] = { NULL };
 
-if (gs_ptr->mpiPi.enabled) {
+enabledState = mpiPi_thread_enter (i, v);
+if (enabledState) {
 mpiPi_GETTIME (&start);
 if ( gs_ptr->mpiPi.stackDepth > 0 ) mpiPi_RecordTraceBack((*base_jbuf), call_stack, gs_ptr->mpiPi.stackDepth);
 }
 
-enabledState = gs_ptr->mpiPi.enabled;
-gs_ptr->mpiPi.enabled = 0;
-
 //rc = PMPI_Win_wait(  * win);
 void* f=NULL;
 QMPI_Table_query( 357, &f, (*vector_get(v,i)).table);
 exec_func(f,i,357,v,* win);
 //CHANGED ABOVE  ---------------------//
-gs_ptr->mpiPi.enabled = enabledState;
-if (gs_ptr->mpiPi.enabled) {
+mpiPi_thread_leave (i, v);
+if (enabledState) {
 
 mpiPi_GETTIME (&end);
 dur = mpiPi_GETTIMEDIFF (&end, &start);
@@ -12128,6 +12126,8 @@ if ( dur < 0 )
   mpiPi_msg_warn(i,v,"Rank %5d : Negative time difference : %11.9f in %s\n", gs_ptr->mpiPi.rank, dur, "MPI_Win_wait");
 else
   mpiPi_update_callsite_stats(mpiPi_MPI_Win_wait, gs_ptr->mpiPi.rank, call_stack, dur, (double)messSize,(double)ioSize,(double)rmaSize,i,v);
+
+if (gs_ptr->mpiPi.trace != NULL) { mpiPi_trace_record(mpiPi_MPI_Win_wait, &start, &end, call_stack, NULL, -1, messSize + ioSize + rmaSize, i, v); }
 }
 
 return rc;
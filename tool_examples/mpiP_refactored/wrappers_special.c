@@ -76,6 +76,7 @@ TMPI_Init (int *argc, char ***argv, int i , vector* v)
   /*if( ((*VECTOR_GET(v,i)).context)  == NULL )
   {*/
   	  gst gs ;
+  	  bzero (&gs, sizeof (gst));	/* fields mpiPi_init leaves alone stay 0 */
   	  size_t sz =sizeof(gst);
   	  QMPI_SET_CONTEXT(v,i,&gs,sz);
   //}
@@ -109,6 +110,7 @@ F77_MPI_INIT (int *ierr, int i ,vector* v)
     if( ((*VECTOR_GET(v,i)).context)  == NULL )
     {
         gst gs ;
+        bzero (&gs, sizeof (gst));
         size_t sz =sizeof(gst);
         QMPI_SET_CONTEXT(v,i,&gs,sz);
     }
@@ -182,11 +184,13 @@ TMPI_Init_thread (int *argc, char ***argv, int required, int *provided, int i ,
     if( ((*VECTOR_GET(v,i)).context)  == NULL )
     {
         gst gs ;
+        bzero (&gs, sizeof (gst));
         size_t sz =sizeof(gst);
         QMPI_SET_CONTEXT(v,i,&gs,sz);
     }
     gst* gs_ptr=(( gst*)((*VECTOR_GET(v,i)).context));
-    gs_ptr->mpiPi.toolname = "hello";
+    gs_ptr->callsite_src_id_cache = NULL;
+    gs_ptr->callsite_src_id_counter = 1;
     // CHANGE END
 
   int rc = 0;
@@ -216,6 +220,7 @@ F77_MPI_INIT_THREAD (int *required, int *provided, int *ierr, int i, vector * v)
     if( ((*VECTOR_GET(v,i)).context)  == NULL )
     {
         gst gs ;
+        bzero (&gs, sizeof (gst));
         size_t sz =sizeof(gst);
         QMPI_SET_CONTEXT(v,i,&gs,sz);
     }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <mpi.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Gathers fixed-size records of all ranks on rank 0 of `comm` and merges
+ * the records that compare equal. The records are sent as bytes, so they
+ * must not hold pointers; names are stored inline. */
+
+typedef int (*record_cmp_fn)(const void *, const void *);
+typedef void (*record_merge_fn)(void *into, const void *from);
+
+/* Gathers the `n_local` records of `size` bytes at `local`, sorts them with
+ * `cmp` and folds each run of equal records into its first with `merge`.
+ * On rank 0 *merged is set to the merged records, which the caller frees,
+ * and their number is returned; the other ranks get NULL and 0. Collective
+ * over `comm`. */
+static inline size_t records_gather(const void *local, size_t n_local,
+                                    size_t size, MPI_Comm comm,
+                                    record_cmp_fn cmp, record_merge_fn merge,
+                                    void **merged) {
+    *merged = NULL;
+    int rank, ranks;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &ranks);
+
+    int local_bytes = n_local * size;
+    int *counts = NULL, *displs = NULL;
+    if (rank == 0) {
+        counts = malloc(ranks * sizeof(int));
+        displs = malloc(ranks * sizeof(int));
+    }
+    PMPI_Gather(&local_bytes, 1, MPI_INT, counts, 1, MPI_INT, 0, comm);
+
+    char *all = NULL;
+    size_t total = 0;
+    if (rank == 0) {
+        for (int r = 0; r < ranks; r++) {
+            displs[r] = total * size;
+            total += counts[r] / size;
+        }
+        all = malloc((total > 0 ? total : 1) * size);
+    }
+    PMPI_Gatherv(local, local_bytes, MPI_BYTE, all, counts, displs, MPI_BYTE,
+                 0, comm);
+    free(counts);
+    free(displs);
+    if (rank != 0 || total == 0) {
+        free(all);
+        return 0;
+    }
+
+    qsort(all, total, size, cmp);
+    size_t n = 0;
+    for (size_t k = 0; k < total; k++) {
+        char *r = all + k * size;
+        if (n > 0 && cmp(all + (n - 1) * size, r) == 0) {
+            merge(all + (n - 1) * size, r);
+        } else {
+            if (n != k) {
+                memcpy(all + n * size, r, size);
+            }
+            n++;
+        }
+    }
+    *merged = all;
+    return n;
+}
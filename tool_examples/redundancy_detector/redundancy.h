@@ -0,0 +1,186 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "callsite.h"
+#include "key_map.h"
+#include "payload_hash.h"
+
+/* Detects payloads that are sent again unchanged. A stream is the traffic
+ * of one callsite to one peer (the root for broadcasts) on one
+ * communicator; each hashed payload is compared with the previous hashed
+ * payload of its stream. Hashing is limited by a token bucket refilled at
+ * REDUNDANCY_BYTES_PER_SEC, so messages arriving faster than the budget
+ * are skipped rather than slowing the application down. */
+
+#define REDUNDANCY_DEFAULT_RATE (256.0 * 1024 * 1024)
+
+enum { STREAM_SEND, STREAM_BCAST, STREAM_KINDS };
+
+const char *STREAM_NAMES[STREAM_KINDS] = {"send", "bcast"};
+
+typedef struct {
+    uint64_t payloads; // hashed payloads
+    uint64_t repeats;  // equal to the previous hashed payload
+    uint64_t bytes;    // hashed bytes
+    uint64_t wasted;   // bytes of the repeats
+} stream_stats;
+
+typedef struct {
+    uintptr_t callsite;
+    int kind;
+    uint64_t last_hash;
+    uint64_t last_bytes;
+    stream_stats stats;
+} stream_entry;
+
+key_map stream_pairs = {0, 0, NULL}; // callsite and communicator -> id + 1
+key_map stream_ids = {0, 0, NULL};   // pair id + 1, peer and kind -> index + 1
+
+struct {
+    size_t len, capacity;
+    stream_entry *entries;
+} streams = {0, 0, NULL};
+
+struct {
+    int state; // 0 not started, 1 running, -1 disabled
+    double rate, tokens, last_refill;
+    uint64_t skipped, skipped_bytes;
+} hash_budget = {0};
+
+/* The stream of the callsite to `peer` on `comm`, added if it is new;
+ * NULL if out of memory. */
+static stream_entry *stream_get(uintptr_t callsite, uintptr_t comm, int peer,
+                                int kind) {
+    key_map_entry *pair = key_map_get(&stream_pairs, callsite, comm);
+    if (pair == NULL) {
+        return NULL;
+    }
+    if (pair->value == 0) {
+        pair->value = stream_pairs.len;
+    }
+    key_map_entry *e =
+        key_map_get(&stream_ids, pair->value,
+                    (uint64_t)(uint32_t)peer * STREAM_KINDS + kind);
+    if (e == NULL) {
+        return NULL;
+    }
+    if (e->value == 0) {
+        if (!reserve((void **)&streams.entries, &streams.capacity,
+                     streams.len, sizeof(stream_entry))) {
+            key_map_remove(&stream_ids, e);
+            return NULL;
+        }
+        stream_entry *s = &streams.entries[streams.len];
+        memset(s, 0, sizeof(stream_entry));
+        s->callsite = callsite;
+        s->kind = kind;
+        e->value = ++streams.len;
+    }
+    return &streams.entries[e->value - 1];
+}
+
+/* Takes `bytes` from the budget if it holds that many. The bucket holds at
+ * most one second of budget, so larger messages are never hashed. */
+static int hash_budget_take(uint64_t bytes) {
+    if (hash_budget.state == 0) {
+        char *rate_env = getenv("REDUNDANCY_BYTES_PER_SEC");
+        hash_budget.rate =
+            rate_env != NULL ? atof(rate_env) : REDUNDANCY_DEFAULT_RATE;
+        hash_budget.tokens = hash_budget.rate;
+        hash_budget.last_refill = PMPI_Wtime();
+        hash_budget.state = hash_budget.rate > 0.0 ? 1 : -1;
+    }
+    if (hash_budget.state != 1) {
+        return 0;
+    }
+    double now = PMPI_Wtime();
+    hash_budget.tokens += (now - hash_budget.last_refill) * hash_budget.rate;
+    if (hash_budget.tokens > hash_budget.rate) {
+        hash_budget.tokens = hash_budget.rate;
+    }
+    hash_budget.last_refill = now;
+    if (bytes > hash_budget.tokens) {
+        hash_budget.skipped++;
+        hash_budget.skipped_bytes += bytes;
+        return 0;
+    }
+    hash_budget.tokens -= bytes;
+    return 1;
+}
+
+/* Hashes the payload of `count` elements of `datatype` at `buf`, packing it
+ * first if it is not contiguous. Returns 0 if it could not be hashed. */
+static int payload_hash(const void *buf, int count, MPI_Datatype datatype,
+                        MPI_Comm comm, uint64_t bytes, uint64_t *hash) {
+    MPI_Aint lb, extent, true_lb, true_extent;
+    PMPI_Type_get_extent(datatype, &lb, &extent);
+    PMPI_Type_get_true_extent(datatype, &true_lb, &true_extent);
+    if ((uint64_t)true_extent * count == bytes &&
+        (count == 1 || (uint64_t)extent * count == bytes)) {
+        *hash = xxh64((const char *)buf + true_lb, bytes, 0);
+        return 1;
+    }
+
+    int pack_size, position = 0;
+    void *packed;
+    if (PMPI_Pack_size(count, datatype, comm, &pack_size) != MPI_SUCCESS ||
+        (packed = malloc(pack_size > 0 ? pack_size : 1)) == NULL) {
+        return 0;
+    }
+    int ok = PMPI_Pack(buf, count, datatype, packed, pack_size, &position,
+                       comm) == MPI_SUCCESS;
+    if (ok) {
+        *hash = xxh64(packed, position, 0);
+    }
+    free(packed);
+    return ok;
+}
+
+/* True in the process whose buffer a broadcast sends. */
+static int is_bcast_root(int root, MPI_Comm comm) {
+    int inter = 0, rank;
+    if (root == MPI_ROOT) {
+        return 1;
+    }
+    PMPI_Comm_test_inter(comm, &inter);
+    if (inter) {
+        return 0;
+    }
+    PMPI_Comm_rank(comm, &rank);
+    return rank == root;
+}
+
+/* Called before a payload leaves this process towards `peer`. */
+static void redundancy_check(int kind, const void *buf, int count,
+                             MPI_Datatype datatype, int peer, MPI_Comm comm) {
+    int type_size;
+    if (count <= 0 || buf == MPI_IN_PLACE || peer == MPI_PROC_NULL ||
+        PMPI_Type_size(datatype, &type_size) != MPI_SUCCESS ||
+        type_size == 0) {
+        return;
+    }
+    uint64_t bytes = (uint64_t)count * type_size, hash;
+    if (!hash_budget_take(bytes) ||
+        !payload_hash(buf, count, datatype, comm, bytes, &hash)) {
+        return;
+    }
+
+    stream_entry *e =
+        stream_get(callsite_capture(), (uintptr_t)comm, peer, kind);
+    if (e == NULL) {
+        return;
+    }
+    if (e->stats.payloads > 0 && e->last_hash == hash &&
+        e->last_bytes == bytes) {
+        e->stats.repeats++;
+        e->stats.wasted += bytes;
+    }
+    e->stats.payloads++;
+    e->stats.bytes += bytes;
+    e->last_hash = hash;
+    e->last_bytes = bytes;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* log2 message size buckets: bucket 0 holds empty messages, bucket k holds
+ * [2^(k-1), 2^k) bytes and the last bucket everything from 2 GiB on. */
+#define SIZE_BUCKETS 33
+
+static inline unsigned size_bucket(uint64_t bytes) {
+    // 64 - clz is the bit width; the mask maps 0 bytes to bucket 0
+    unsigned width = 64 - __builtin_clzll(bytes | 1);
+    unsigned bucket = width & -(unsigned)(bytes != 0);
+    return bucket < SIZE_BUCKETS - 1 ? bucket : SIZE_BUCKETS - 1;
+}
+
+/* Writes a label like "[1 KiB, 2 KiB)" for the bucket into buf. */
+static inline void size_bucket_label(unsigned bucket, char *buf, size_t len) {
+    static const char *units[] = {"B", "KiB", "MiB", "GiB"};
+    if (bucket == 0) {
+        snprintf(buf, len, "0 B");
+        return;
+    }
+    if (bucket == SIZE_BUCKETS - 1) {
+        snprintf(buf, len, ">= 2 GiB");
+        return;
+    }
+    unsigned lo = bucket - 1, hi = bucket;
+    snprintf(buf, len, "[%u %s, %u %s)", 1u << (lo % 10), units[lo / 10],
+             1u << (hi % 10), units[hi / 10]);
+}
+
+/* Prints the non-empty buckets of a histogram as a distribution. */
+static inline void size_hist_print(const char *name,
+                                   const uint64_t hist[SIZE_BUCKETS]) {
+    uint64_t total = 0, peak = 0;
+    for (unsigned b = 0; b < SIZE_BUCKETS; b++) {
+        total += hist[b];
+        peak = hist[b] > peak ? hist[b] : peak;
+    }
+    if (total == 0) {
+        return;
+    }
+    printf("%s (%llu calls):\n", name, (unsigned long long)total);
+    for (unsigned b = 0; b < SIZE_BUCKETS; b++) {
+        if (hist[b] == 0) {
+            continue;
+        }
+        char label[32], bar[41];
+        size_bucket_label(b, label, sizeof(label));
+        // at least one mark, so rare buckets stay visible
+        int width = (int)(40 * hist[b] / peak);
+        width = width > 0 ? width : 1;
+        memset(bar, '#', width);
+        bar[width] = '\0';
+        printf("  %-22s %10llu %6.2f%% %s\n", label,
+               (unsigned long long)hist[b], 100.0 * hist[b] / total, bar);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <mpi.h>
+
+/* Maps MPI_Wtime to a clock shared by all ranks: rank 0's clock, counted
+ * from rank 0's call of clock_sync so that sums of times stay exact. Rank 0
+ * exchanges CLOCK_SYNC_ROUNDS ping-pongs with every other rank, which keeps
+ * the offset of the round with the shortest round trip (Cristian's
+ * algorithm). The offset is off by at most half that round trip; drift
+ * after the synchronization is not corrected. */
+
+#define CLOCK_SYNC_ROUNDS 8
+
+struct {
+    double offset; // added to MPI_Wtime
+    double error;  // bound of the offset error
+} sync_clock = {0.0, 0.0};
+
+static double clock_now(void) { return PMPI_Wtime() + sync_clock.offset; }
+
+/* Collective over `comm`, whose rank 0 keeps the reference clock. */
+static void clock_sync(MPI_Comm comm) {
+    int rank, size, flag, *is_global;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &size);
+    PMPI_Comm_get_attr(MPI_COMM_WORLD, MPI_WTIME_IS_GLOBAL, &is_global, &flag);
+
+    double start = PMPI_Wtime();
+    PMPI_Bcast(&start, 1, MPI_DOUBLE, 0, comm);
+    if (flag && *is_global) {
+        sync_clock.offset = -start;
+        sync_clock.error = 0.0;
+        return;
+    }
+
+    if (rank == 0) {
+        sync_clock.offset = -start;
+        for (int r = 1; r < size; r++) {
+            for (int k = 0; k < CLOCK_SYNC_ROUNDS; k++) {
+                double t;
+                PMPI_Recv(&t, 1, MPI_DOUBLE, r, 0, comm, MPI_STATUS_IGNORE);
+                t = clock_now();
+                PMPI_Send(&t, 1, MPI_DOUBLE, r, 0, comm);
+            }
+        }
+        return;
+    }
+    double best = -1.0;
+    for (int k = 0; k < CLOCK_SYNC_ROUNDS; k++) {
+        double t0 = PMPI_Wtime(), t;
+        PMPI_Send(&t0, 1, MPI_DOUBLE, 0, 0, comm);
+        PMPI_Recv(&t, 1, MPI_DOUBLE, 0, 0, comm, MPI_STATUS_IGNORE);
+        double t1 = PMPI_Wtime();
+        if (best < 0.0 || t1 - t0 < best) {
+            best = t1 - t0;
+            sync_clock.offset = t - (t0 + t1) / 2;
+        }
+    }
+    sync_clock.error = best / 2;
+}
@@ -0,0 +1,601 @@
+#pragma once
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "callsite.h"
+#include "clock_sync.h"
+#include "key_map.h"
+
+/* Classifies blocking time into wait states. Each tracked point-to-point
+ * message is followed by a companion message on a private duplicate of its
+ * communicator, with the same tag, carrying the entry and exit time of the
+ * send on the synchronized clock and the sending callsite. Messages of one
+ * source and tag are matched in the order they were sent on both
+ * communicators, so the receiver takes the companion of each message it
+ * receives and computes
+ *   late sender:   time the receive blocked before the send was entered,
+ *   late receiver: time a blocking send waited for the receive to be posted.
+ * After a synchronizing collective the ranks reduce their entry times on
+ * the private communicator; the time each rank waited for the last one is
+ * wait at NxN. Waits are charged to the callsite that waited and blamed on
+ * the callsite that arrived late. Blame on a callsite of another rank is
+ * sent back to that rank at finalize.
+ *
+ * WAIT_STATES_P2P_PERIOD samples every nth message of a (communicator,
+ * peer, tag) stream and WAIT_STATES_COLL_PERIOD every nth collective of a
+ * communicator; both sides count alike, so they agree on the samples
+ * without communicating. Receives have to go through the calls wrapped
+ * here, and only one thread may call MPI at a time. */
+
+#define WAIT_DEFAULT_P2P_PERIOD 1
+#define WAIT_DEFAULT_COLL_PERIOD 1
+#define WAIT_NO_SITE UINT32_MAX
+
+enum { WAIT_LATE_SENDER, WAIT_LATE_RECEIVER, WAIT_NXN, WAIT_STATES };
+
+const char *WAIT_STATE_NAMES[WAIT_STATES] = {"late sender", "late receiver",
+                                             "wait at NxN"};
+
+typedef struct {
+    uint64_t waits;  // instances the callsite waited in
+    uint64_t blamed; // instances it made others wait in
+    double wait, blame;
+} wait_stats;
+
+typedef struct {
+    uintptr_t callsite;
+    wait_stats states[WAIT_STATES];
+} wait_site;
+
+/* Waits and blame of a callsite of another rank. */
+typedef struct {
+    int rank; // in MPI_COMM_WORLD
+    int state;
+    uint32_t site; // id on that rank
+    wait_stats stats;
+} wait_remote;
+
+typedef struct {
+    MPI_Comm shadow;
+    uint64_t id; // never reused, unlike the handle
+    int inter, rank, size;
+    int *world; // MPI_COMM_WORLD ranks of the (remote) group, NULL if equal
+    uint64_t collectives;
+} wait_comm;
+
+typedef struct {
+    double enter, exit;
+    uint32_t site;
+    uint32_t blocking; // 0 if the send returned before completion
+} wait_companion;
+
+/* A posted receive, a persistent send or a matched probe. */
+typedef struct {
+    wait_comm *comm;
+    int is_send, persistent;
+    int peer, tag;      // of persistent sends
+    double post, ready; // ready: when a matched probe returned
+    uint32_t site;
+} wait_request;
+
+struct {
+    int state; // 0 not started, 1 running, -1 finalized
+    int p2p_period, coll_period;
+    MPI_Op nxn_op;
+    uint64_t comm_ids, companions;
+} waits = {0};
+
+key_map comms = {0, 0, NULL};    // handle -> wait_comm *
+key_map requests = {0, 0, NULL}; // handle -> wait_request *
+key_map messages = {0, 0, NULL}; // handle -> wait_request *
+key_map streams = {0, 0, NULL};  // comm id, peer and tag -> messages
+key_map site_ids = {0, 0, NULL}; // callsite -> id + 1
+key_map remote_ids = {0, 0, NULL};
+
+struct {
+    size_t len, capacity;
+    wait_site *sites;
+} wait_sites = {0, 0, NULL};
+
+struct {
+    size_t len, capacity;
+    wait_remote *records;
+} wait_remotes = {0, 0, NULL};
+
+/* Companions in flight; the buffers must stay put until they complete. */
+struct {
+    size_t len, capacity;
+    MPI_Request *requests;
+    wait_companion **buffers;
+} pending = {0, 0, NULL, NULL};
+
+#define HANDLE_KEY(h) handle_key(&(h), sizeof(h))
+
+static uint64_t handle_key(const void *handle, size_t size) {
+    uint64_t k = 0;
+    memcpy(&k, handle, size < sizeof(k) ? size : sizeof(k));
+    return k + 1;
+}
+
+static uint32_t site_id(uintptr_t callsite) {
+    key_map_entry *e = key_map_get(&site_ids, callsite, 0);
+    if (e == NULL) {
+        return WAIT_NO_SITE;
+    }
+    if (e->value == 0) {
+        if (!reserve((void **)&wait_sites.sites, &wait_sites.capacity,
+                     wait_sites.len, sizeof(wait_site))) {
+            key_map_remove(&site_ids, e);
+            return WAIT_NO_SITE;
+        }
+        wait_site *s = &wait_sites.sites[wait_sites.len];
+        memset(s, 0, sizeof(wait_site));
+        s->callsite = callsite;
+        e->value = ++wait_sites.len;
+    }
+    return e->value - 1;
+}
+
+/* The site of the calling MPI call, looked up once per call. */
+static uint32_t site_here(uint32_t *site) {
+    if (*site == WAIT_NO_SITE) {
+        *site = site_id(callsite_capture());
+    }
+    return *site;
+}
+
+static void stats_add(wait_stats *a, const wait_stats *b) {
+    a->waits += b->waits;
+    a->blamed += b->blamed;
+    a->wait += b->wait;
+    a->blame += b->blame;
+}
+
+static void stats_charge(wait_stats *s, double wait, double blame) {
+    if (wait > 0.0) {
+        s->waits++;
+        s->wait += wait;
+    }
+    if (blame > 0.0) {
+        s->blamed++;
+        s->blame += blame;
+    }
+}
+
+static void charge(uint32_t site, int state, double wait, double blame) {
+    if (site >= wait_sites.len) {
+        return;
+    }
+    stats_charge(&wait_sites.sites[site].states[state], wait, blame);
+}
+
+static void charge_remote(int rank, uint32_t site, int state, double wait,
+                          double blame) {
+    if (rank < 0 || site == WAIT_NO_SITE) {
+        return;
+    }
+    key_map_entry *e = key_map_get(&remote_ids, (uint64_t)rank + 1,
+                                     (uint64_t)site * WAIT_STATES + state);
+    if (e == NULL) {
+        return;
+    }
+    if (e->value == 0) {
+        if (!reserve((void **)&wait_remotes.records, &wait_remotes.capacity,
+                     wait_remotes.len, sizeof(wait_remote))) {
+            key_map_remove(&remote_ids, e);
+            return;
+        }
+        wait_remote *r = &wait_remotes.records[wait_remotes.len];
+        memset(r, 0, sizeof(wait_remote));
+        r->rank = rank;
+        r->state = state;
+        r->site = site;
+        e->value = ++wait_remotes.len;
+    }
+    stats_charge(&wait_remotes.records[e->value - 1].stats, wait, blame);
+}
+
+static wait_comm *comm_find(MPI_Comm comm) {
+    key_map_entry *e = key_map_find(&comms, HANDLE_KEY(comm), 0);
+    return e != NULL ? (wait_comm *)(uintptr_t)e->value : NULL;
+}
+
+/* Collective over `comm`, like the call that created it. */
+static void comm_track(MPI_Comm comm) {
+    if (waits.state != 1 || comm == MPI_COMM_NULL) {
+        return;
+    }
+    MPI_Comm shadow;
+    if (PMPI_Comm_dup(comm, &shadow) != MPI_SUCCESS) {
+        return;
+    }
+    wait_comm *c = calloc(1, sizeof(wait_comm));
+    key_map_entry *e;
+    if (c == NULL || (e = key_map_get(&comms, HANDLE_KEY(comm), 0)) == NULL) {
+        free(c);
+        PMPI_Comm_free(&shadow);
+        return;
+    }
+    c->shadow = shadow;
+    c->id = ++waits.comm_ids;
+    PMPI_Comm_rank(comm, &c->rank);
+    PMPI_Comm_test_inter(comm, &c->inter);
+    MPI_Group group, world_group;
+    if (c->inter) {
+        PMPI_Comm_remote_size(comm, &c->size);
+        PMPI_Comm_remote_group(comm, &group);
+    } else {
+        PMPI_Comm_size(comm, &c->size);
+        PMPI_Comm_group(comm, &group);
+    }
+    int *ranks = malloc(c->size * sizeof(int));
+    c->world = malloc(c->size * sizeof(int));
+    if (comm == MPI_COMM_WORLD || ranks == NULL || c->world == NULL) {
+        free(c->world);
+        c->world = NULL;
+    } else {
+        for (int r = 0; r < c->size; r++) {
+            ranks[r] = r;
+        }
+        PMPI_Comm_group(MPI_COMM_WORLD, &world_group);
+        PMPI_Group_translate_ranks(group, c->size, ranks, world_group,
+                                   c->world);
+        PMPI_Group_free(&world_group);
+    }
+    free(ranks);
+    PMPI_Group_free(&group);
+    e->value = (uintptr_t)c;
+}
+
+static void comm_untrack(MPI_Comm comm) {
+    key_map_entry *e = key_map_find(&comms, HANDLE_KEY(comm), 0);
+    if (e == NULL) {
+        return;
+    }
+    wait_comm *c = (wait_comm *)(uintptr_t)e->value;
+    key_map_remove(&comms, e);
+    PMPI_Comm_free(&c->shadow);
+    free(c->world);
+    free(c);
+}
+
+/* Whether this message of its stream carries a companion. */
+static int stream_sampled(wait_comm *c, int peer, int tag, int incoming) {
+    if (waits.p2p_period == 1) {
+        return 1;
+    }
+    key_map_entry *e =
+        key_map_get(&streams, 2 * c->id + incoming,
+                     (uint64_t)(uint32_t)peer << 32 | (uint32_t)tag);
+    return e != NULL && e->value++ % waits.p2p_period == 0;
+}
+
+static void pending_reap(void) {
+    size_t n = 0;
+    for (size_t k = 0; k < pending.len; k++) {
+        int done = 0;
+        PMPI_Test(&pending.requests[k], &done, MPI_STATUS_IGNORE);
+        if (done) {
+            free(pending.buffers[k]);
+        } else {
+            pending.requests[n] = pending.requests[k];
+            pending.buffers[n++] = pending.buffers[k];
+        }
+    }
+    pending.len = n;
+}
+
+/* Makes room for a companion, first by dropping the completed ones. */
+static int pending_reserve(void) {
+    if (pending.len < pending.capacity) {
+        return 1;
+    }
+    pending_reap();
+    if (2 * pending.len < pending.capacity) {
+        return 1;
+    }
+    size_t n = pending.capacity == 0 ? 64 : 2 * pending.capacity;
+    MPI_Request *requests = realloc(pending.requests, n * sizeof(MPI_Request));
+    if (requests == NULL) {
+        return 0;
+    }
+    pending.requests = requests;
+    wait_companion **buffers =
+        realloc(pending.buffers, n * sizeof(wait_companion *));
+    if (buffers == NULL) {
+        return 0;
+    }
+    pending.buffers = buffers;
+    pending.capacity = n;
+    return 1;
+}
+
+/* Sends the companion of a message to `dest` that was sent between `enter`
+ * and `exit`. */
+static void companion_send(wait_comm *c, int dest, int tag, double enter,
+                           double exit, int blocking, uint32_t site) {
+    if (c == NULL || dest == MPI_PROC_NULL ||
+        !stream_sampled(c, dest, tag, 0)) {
+        return;
+    }
+    wait_companion m = {enter, exit, site_here(&site), blocking != 0};
+    waits.companions++;
+    wait_companion *buffer = malloc(sizeof(wait_companion));
+    if (buffer == NULL || !pending_reserve()) {
+        // the receiver expects it in any case
+        free(buffer);
+        PMPI_Send(&m, sizeof(m), MPI_BYTE, dest, tag, c->shadow);
+        return;
+    }
+    *buffer = m;
+    PMPI_Isend(buffer, sizeof(m), MPI_BYTE, dest, tag, c->shadow,
+               &pending.requests[pending.len]);
+    pending.buffers[pending.len++] = buffer;
+}
+
+/* Takes the companion of a received message and charges its wait states.
+ * The receive was posted at `post` by `post_site` and waited for the
+ * message from `enter` to `exit` in the call at `site`. */
+static void companion_recv(wait_comm *c, const MPI_Status *status,
+                           double post, uint32_t post_site, double enter,
+                           double exit, uint32_t *site) {
+    int source = status->MPI_SOURCE, cancelled = 0;
+    if (c == NULL || source == MPI_PROC_NULL || source < 0) {
+        return;
+    }
+    PMPI_Test_cancelled(status, &cancelled);
+    if (cancelled || !stream_sampled(c, source, status->MPI_TAG, 1)) {
+        return;
+    }
+    wait_companion m;
+    PMPI_Recv(&m, sizeof(m), MPI_BYTE, source, status->MPI_TAG, c->shadow,
+              MPI_STATUS_IGNORE);
+    int peer = c->world != NULL ? c->world[source] : source;
+
+    double late = m.enter - enter;
+    if (late > exit - enter) {
+        late = exit - enter;
+    }
+    if (late > 0.0) {
+        charge(site_here(site), WAIT_LATE_SENDER, late, 0.0);
+        charge_remote(peer, m.site, WAIT_LATE_SENDER, 0.0, late);
+    }
+    if (m.blocking && post > m.enter && m.exit > post) {
+        if (post_site == WAIT_NO_SITE) {
+            post_site = site_here(site);
+        }
+        charge(post_site, WAIT_LATE_RECEIVER, 0.0, post - m.enter);
+        charge_remote(peer, m.site, WAIT_LATE_RECEIVER, post - m.enter, 0.0);
+    }
+}
+
+static void request_track(key_map *map, uint64_t key, wait_comm *c,
+                          int is_send, int persistent, int peer, int tag,
+                          double post) {
+    if (c == NULL) {
+        return;
+    }
+    wait_request *r = malloc(sizeof(wait_request));
+    key_map_entry *e;
+    if (r == NULL || (e = key_map_get(map, key, 0)) == NULL) {
+        free(r);
+        return;
+    }
+    if (e->value != 0) {
+        free((wait_request *)(uintptr_t)e->value);
+    }
+    *r = (wait_request){c, is_send, persistent, peer, tag, post, post,
+                        site_id(callsite_capture())};
+    e->value = (uintptr_t)r;
+}
+
+static void request_untrack(key_map *map, key_map_entry *e) {
+    free((wait_request *)(uintptr_t)e->value);
+    key_map_remove(map, e);
+}
+
+/* Called for a request, by its handle before the call, that a completion
+ * call between `enter` and `exit` completed with `status`. */
+static void request_complete(uint64_t key, const MPI_Status *status,
+                             double enter, double exit, uint32_t *site) {
+    key_map_entry *e = key_map_find(&requests, key, 0);
+    if (e == NULL) {
+        return;
+    }
+    wait_request *r = (wait_request *)(uintptr_t)e->value;
+    if (!r->is_send) {
+        companion_recv(r->comm, status, r->post, r->site, enter, exit, site);
+    }
+    if (!r->persistent) {
+        request_untrack(&requests, e);
+    }
+}
+
+/* Whether a request a multiple-completion call returned in `status`
+ * completed: on MPI_ERR_IN_STATUS each status carries its own error. */
+static int completion_ok(int ret, const MPI_Status *status) {
+    return ret == MPI_SUCCESS ||
+           (ret == MPI_ERR_IN_STATUS && status->MPI_ERROR == MPI_SUCCESS);
+}
+
+/* Statuses for a multiple-completion call the application called with
+ * MPI_STATUSES_IGNORE.  Without memory for them the keys are dropped, so
+ * the call goes ahead unattributed. */
+static MPI_Status *request_statuses(int count, uint64_t **keys) {
+    MPI_Status *local = malloc(count * sizeof(MPI_Status));
+    if (local == NULL) {
+        free(*keys);
+        *keys = NULL;
+    }
+    return local;
+}
+
+/* The handles of `count` requests before a completion call replaces them,
+ * or NULL if no request is tracked. */
+static uint64_t *request_keys(int count, const MPI_Request array[]) {
+    if (requests.len == 0 || count <= 0) {
+        return NULL;
+    }
+    uint64_t *keys = malloc(count * sizeof(uint64_t));
+    for (int k = 0; keys != NULL && k < count; k++) {
+        keys[k] = HANDLE_KEY(array[k]);
+    }
+    return keys;
+}
+
+/* Called when (re)starting a persistent request at `now`. */
+static void request_start(MPI_Request request, double now) {
+    key_map_entry *e = key_map_find(&requests, HANDLE_KEY(request), 0);
+    if (e == NULL) {
+        return;
+    }
+    wait_request *r = (wait_request *)(uintptr_t)e->value;
+    if (r->is_send) {
+        companion_send(r->comm, r->peer, r->tag, now, now, 0, r->site);
+    } else {
+        r->post = now;
+    }
+}
+
+/* Keeps the maximum of the entry times, the lowest rank that entered at
+ * that time and the sum of the entry times of triples of doubles. */
+static void nxn_reduce(void *in, void *inout, int *len, MPI_Datatype *type) {
+    const double *a = in;
+    double *b = inout;
+    for (int k = 0; k + 2 < *len; k += 3) {
+        if (a[k] > b[k] || (a[k] == b[k] && a[k + 1] < b[k + 1])) {
+            b[k] = a[k];
+            b[k + 1] = a[k + 1];
+        }
+        b[k + 2] += a[k + 2];
+    }
+}
+
+/* Called after a synchronizing collective on `comm` entered at `enter`. */
+static void collective_wait(MPI_Comm comm, double enter) {
+    wait_comm *c = comm_find(comm);
+    if (c == NULL || c->inter ||
+        c->collectives++ % (uint64_t)waits.coll_period != 0) {
+        return;
+    }
+    double entry[3] = {enter, c->rank, enter}, last[3];
+    PMPI_Allreduce(entry, last, 3, MPI_DOUBLE, waits.nxn_op, c->shadow);
+    uint32_t site = WAIT_NO_SITE;
+    if (last[0] > enter) {
+        charge(site_here(&site), WAIT_NXN, last[0] - enter, 0.0);
+    }
+    if ((int)last[1] == c->rank) {
+        charge(site_here(&site), WAIT_NXN, 0.0, c->size * last[0] - last[2]);
+    }
+}
+
+static int period_env(const char *name, int fallback) {
+    char *env = getenv(name);
+    return env != NULL && atoi(env) > 0 ? atoi(env) : fallback;
+}
+
+/* Called after MPI is initialized. */
+static void waits_start(void) {
+    waits.p2p_period =
+        period_env("WAIT_STATES_P2P_PERIOD", WAIT_DEFAULT_P2P_PERIOD);
+    waits.coll_period =
+        period_env("WAIT_STATES_COLL_PERIOD", WAIT_DEFAULT_COLL_PERIOD);
+    PMPI_Op_create(nxn_reduce, 1, &waits.nxn_op);
+    waits.state = 1;
+    comm_track(MPI_COMM_WORLD);
+    comm_track(MPI_COMM_SELF);
+    wait_comm *world = comm_find(MPI_COMM_WORLD);
+    clock_sync(world != NULL ? world->shadow : MPI_COMM_WORLD);
+}
+
+static int wait_remote_cmp(const void *a, const void *b) {
+    const wait_remote *ra = a, *rb = b;
+    return ra->rank - rb->rank;
+}
+
+/* Sends the waits and blame of other ranks' callsites to those ranks. */
+static void remote_return(MPI_Comm comm) {
+    int size;
+    PMPI_Comm_size(comm, &size);
+    int *counts = calloc(4 * size, sizeof(int));
+    int *sdispls = counts + size, *rcounts = counts + 2 * size,
+        *rdispls = counts + 3 * size;
+
+    qsort(wait_remotes.records, wait_remotes.len, sizeof(wait_remote),
+          wait_remote_cmp);
+    size_t n = 0;
+    for (size_t k = 0; k < wait_remotes.len; k++) {
+        wait_remote *r = &wait_remotes.records[k];
+        if (r->rank < size) {
+            counts[r->rank] += sizeof(wait_remote);
+            n++;
+        }
+    }
+    PMPI_Alltoall(counts, 1, MPI_INT, rcounts, 1, MPI_INT, comm);
+    size_t total = 0;
+    for (int r = 0; r < size; r++) {
+        sdispls[r] = r > 0 ? sdispls[r - 1] + counts[r - 1] : 0;
+        rdispls[r] = total;
+        total += rcounts[r];
+    }
+    wait_remote *received = malloc(total > 0 ? total : 1);
+    PMPI_Alltoallv(wait_remotes.records, counts, sdispls, MPI_BYTE, received,
+                   rcounts, rdispls, MPI_BYTE, comm);
+    for (size_t k = 0; k < total / sizeof(wait_remote); k++) {
+        wait_remote *r = &received[k];
+        if (r->site < wait_sites.len && r->state >= 0 &&
+            r->state < WAIT_STATES) {
+            stats_add(&wait_sites.sites[r->site].states[r->state], &r->stats);
+        }
+    }
+    free(received);
+    free(counts);
+}
+
+/* Stops tracking and settles the remote waits; the statistics in
+ * wait_sites are complete afterwards. Collective over MPI_COMM_WORLD. */
+static void waits_stop(void) {
+    wait_comm *world = comm_find(MPI_COMM_WORLD);
+    waits.state = -1;
+    pending_reap();
+    for (size_t k = 0; k < pending.len; k++) {
+        // delivered by MPI_Finalize; the buffers are left to it
+        PMPI_Request_free(&pending.requests[k]);
+    }
+    pending.len = 0;
+    remote_return(world != NULL ? world->shadow : MPI_COMM_WORLD);
+}
+
+static void waits_free(void) {
+    key_map *tables[] = {&requests, &messages};
+    for (int t = 0; t < 2; t++) {
+        for (size_t k = 0; k < tables[t]->capacity; k++) {
+            if (tables[t]->entries[k].k0 != 0) {
+                free((wait_request *)(uintptr_t)tables[t]->entries[k].value);
+            }
+        }
+        key_map_free(tables[t]);
+    }
+    for (size_t k = 0; k < comms.capacity; k++) {
+        if (comms.entries[k].k0 != 0) {
+            wait_comm *c = (wait_comm *)(uintptr_t)comms.entries[k].value;
+            PMPI_Comm_free(&c->shadow);
+            free(c->world);
+            free(c);
+        }
+    }
+    key_map_free(&comms);
+    key_map_free(&streams);
+    key_map_free(&site_ids);
+    key_map_free(&remote_ids);
+    free(wait_sites.sites);
+    free(wait_remotes.records);
+    free(pending.requests);
+    free(pending.buffers);
+    if (waits.state != 0) {
+        PMPI_Op_free(&waits.nxn_op);
+    }
+}